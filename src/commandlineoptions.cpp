@@ -22,6 +22,11 @@ CommandLineOptions::ParseResult CommandLineOptions::parse(const QStringList &p_a
     const QCommandLineOption verboseOpt("verbose", MainWindow::tr("Print more logs."));
     parser.addOption(verboseOpt);
 
+    const QCommandLineOption ioStatsOpt("io-stats",
+                                        MainWindow::tr("Record I/O of notebooks and dump them as JSON to file on exit."),
+                                        "file");
+    parser.addOption(ioStatsOpt);
+
     // WebEngine options.
     // No need to handle them. Just add them to the parser to avoid parse error.
     {
@@ -63,5 +68,9 @@ CommandLineOptions::ParseResult CommandLineOptions::parse(const QStringList &p_a
         m_verbose = true;
     }
 
+    if (parser.isSet(ioStatsOpt)) {
+        m_backendIoStatsFile = parser.value(ioStatsOpt);
+    }
+
     return ParseResult::Ok;
 }
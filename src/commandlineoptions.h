@@ -25,6 +25,9 @@ public:
     QStringList m_pathsToOpen;
 
     bool m_verbose = false;
+
+    // File to dump notebook backend I/O stats to on exit. Empty to disable the stats.
+    QString m_backendIoStatsFile;
 };
 
 #endif // COMMANDLINEOPTIONS_H
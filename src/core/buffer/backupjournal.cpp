@@ -0,0 +1,182 @@
+#include "backupjournal.h"
+
+#include <QFile>
+#include <QVector>
+#include <QDebug>
+
+#include <utils/fileutils.h>
+#include <core/exception.h>
+
+using namespace vnotex;
+
+const QByteArray BackupJournal::c_magic = "vnotex_journal 1\n";
+
+// Compact into a checkpoint once there are so many diffs.
+static const int c_maxDiffCount = 256;
+
+// Compact into a checkpoint once diffs exceed the content size or this size.
+static const qint64 c_minCompactBytes = 64 * 1024;
+
+BackupJournal::BackupJournal(const QString &p_filePath, const QString &p_head)
+    : m_filePath(p_filePath),
+      m_head(p_head)
+{
+}
+
+const QString &BackupJournal::getFilePath() const
+{
+    return m_filePath;
+}
+
+void BackupJournal::record(int p_revision, const QString &p_content)
+{
+    if (m_hasCheckpoint
+        && m_diffCount < c_maxDiffCount
+        && m_diffBytes < qMax(c_minCompactBytes, static_cast<qint64>(p_content.size()))) {
+        if (!appendDiff(p_revision, p_content)) {
+            return;
+        }
+    } else {
+        writeCheckpoint(p_revision, p_content);
+    }
+
+    m_content = p_content;
+}
+
+QByteArray BackupJournal::checkpointRecord(int p_revision, const QString &p_content)
+{
+    const auto data = p_content.toUtf8();
+    QByteArray rec = QStringLiteral("C %1 %2\n").arg(p_revision).arg(data.size()).toLatin1();
+    rec += data;
+    rec += '\n';
+    return rec;
+}
+
+void BackupJournal::writeCheckpoint(int p_revision, const QString &p_content)
+{
+    m_hasCheckpoint = false;
+
+    // Replace the whole file, which drops all the previous records.
+    FileUtils::writeFile(m_filePath, m_head.toUtf8() + c_magic + checkpointRecord(p_revision, p_content));
+
+    m_hasCheckpoint = true;
+    m_diffBytes = 0;
+    m_diffCount = 0;
+}
+
+bool BackupJournal::appendDiff(int p_revision, const QString &p_content)
+{
+    const int oldSize = m_content.size();
+    const int newSize = p_content.size();
+    const int minSize = qMin(oldSize, newSize);
+
+    int prefix = 0;
+    while (prefix < minSize && m_content[prefix] == p_content[prefix]) {
+        ++prefix;
+    }
+
+    if (prefix == oldSize && prefix == newSize) {
+        return false;
+    }
+
+    int suffix = 0;
+    while (suffix < minSize - prefix
+           && m_content[oldSize - 1 - suffix] == p_content[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+
+    // Do not split surrogate pairs, which could not be encoded in UTF-8 separately.
+    if (prefix > 0 && p_content[prefix - 1].isHighSurrogate()) {
+        --prefix;
+    }
+    if (suffix > 0 && p_content[newSize - suffix].isLowSurrogate()) {
+        --suffix;
+    }
+
+    const int removed = oldSize - prefix - suffix;
+    const auto inserted = p_content.midRef(prefix, newSize - prefix - suffix).toUtf8();
+
+    QByteArray rec = QStringLiteral("D %1 %2 %3 %4\n").arg(p_revision)
+                                                       .arg(prefix)
+                                                       .arg(removed)
+                                                       .arg(inserted.size()).toLatin1();
+    rec += inserted;
+    rec += '\n';
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(rec) != rec.size()) {
+        m_hasCheckpoint = false;
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to append to backup journal: %1").arg(m_filePath));
+    }
+
+    m_diffBytes += rec.size();
+    ++m_diffCount;
+    return true;
+}
+
+QString BackupJournal::replay(const QByteArray &p_data)
+{
+    // The head is a single line and the magic ends it.
+    const int magicPos = p_data.indexOf('|' + c_magic);
+    if (magicPos == -1 || magicPos > p_data.indexOf('\n')) {
+        // Legacy backup file.
+        const int headEnd = p_data.indexOf('|');
+        if (headEnd == -1) {
+            return QString();
+        }
+        return QString::fromUtf8(p_data.mid(headEnd + 1));
+    }
+
+    int pos = magicPos + 1 + c_magic.size();
+
+    QString content;
+    while (pos < p_data.size()) {
+        const int lineEnd = p_data.indexOf('\n', pos);
+        if (lineEnd == -1) {
+            break;
+        }
+
+        const auto fields = p_data.mid(pos, lineEnd - pos).split(' ');
+        pos = lineEnd + 1;
+
+        bool ok = true;
+        QVector<int> args;
+        for (int i = 1; i < fields.size() && ok; ++i) {
+            args.push_back(fields[i].toInt(&ok));
+        }
+
+        const auto type = fields[0];
+        if (!ok
+            || (type == "C" && args.size() != 2)
+            || (type == "D" && args.size() != 4)
+            || (type != "C" && type != "D")) {
+            qWarning() << "invalid record in backup journal" << fields;
+            break;
+        }
+
+        const int bytes = args.last();
+        if (bytes < 0 || pos + bytes + 1 > p_data.size()) {
+            // Truncated by a crash during appending.
+            qWarning() << "truncated record in backup journal";
+            break;
+        }
+
+        const auto text = QString::fromUtf8(p_data.constData() + pos, bytes);
+        pos += bytes + 1;
+
+        if (type == "C") {
+            content = text;
+        } else {
+            const int at = args[1];
+            const int removed = args[2];
+            if (at < 0 || removed < 0 || at + removed > content.size()) {
+                qWarning() << "invalid diff in backup journal" << fields;
+                break;
+            }
+            content.replace(at, removed, text);
+        }
+    }
+
+    return content;
+}
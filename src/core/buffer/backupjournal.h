@@ -0,0 +1,62 @@
+#ifndef BACKUPJOURNAL_H
+#define BACKUPJOURNAL_H
+
+#include <QString>
+#include <QByteArray>
+
+#include "../noncopyable.h"
+
+namespace vnotex
+{
+    // Append-only journal of buffer content used as the backup file.
+    // The file starts with a head, followed by records:
+    // - a checkpoint with the full content: "C <revision> <bytes>\n<content>\n";
+    // - a diff replacing @removed chars at @pos with the inserted text:
+    //   "D <revision> <pos> <removed> <bytes>\n<inserted text>\n".
+    // Texts are in UTF-8 and positions are in UTF-16 units.
+    // The journal is compacted into a new checkpoint once the diffs get large.
+    class BackupJournal : private Noncopyable
+    {
+    public:
+        // @p_head: the head of the backup file, which should end with '|'.
+        BackupJournal(const QString &p_filePath, const QString &p_head);
+
+        const QString &getFilePath() const;
+
+        // Record @p_content of @p_revision.
+        // Throw Exception on failure and the next record will write a checkpoint.
+        void record(int p_revision, const QString &p_content);
+
+        // Get the content of the backup file data @p_data by replaying the journal.
+        // Support legacy backup file with the full content after the head.
+        // A truncated tail is ignored.
+        static QString replay(const QByteArray &p_data);
+
+    private:
+        void writeCheckpoint(int p_revision, const QString &p_content);
+
+        // Return false if no need to append a diff.
+        bool appendDiff(int p_revision, const QString &p_content);
+
+        static QByteArray checkpointRecord(int p_revision, const QString &p_content);
+
+        QString m_filePath;
+
+        QString m_head;
+
+        // Content of the last record, shared implicitly with the buffer.
+        QString m_content;
+
+        bool m_hasCheckpoint = false;
+
+        // Size of diffs in bytes since last checkpoint.
+        qint64 m_diffBytes = 0;
+
+        int m_diffCount = 0;
+
+        // Marker after the head to distinguish from the legacy backup file.
+        static const QByteArray c_magic;
+    };
+} // ns vnotex
+
+#endif // BACKUPJOURNAL_H
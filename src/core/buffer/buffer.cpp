@@ -5,12 +5,15 @@
 #include <notebook/node.h>
 #include <utils/fileutils.h>
 #include <widgets/viewwindow.h>
+#include <widgets/largefileviewwindow.h>
 #include <utils/pathutils.h>
 
 #include <core/configmgr.h>
 #include <core/editorconfig.h>
 
 #include "bufferprovider.h"
+#include "buffersavequeue.h"
+#include "backupjournal.h"
 #include "exception.h"
 
 using namespace vnotex;
@@ -26,7 +29,9 @@ Buffer::Buffer(const BufferParameters &p_parameters,
     : QObject(p_parent),
       m_provider(p_parameters.m_provider),
       m_id(generateBufferID()),
-      m_readOnly(m_provider->isReadOnly())
+      m_readOnly(p_parameters.m_largeFile || m_provider->isReadOnly()),
+      m_largeFile(p_parameters.m_largeFile),
+      m_saveQueue(p_parameters.m_saveQueue)
 {
     m_autoSaveTimer = new QTimer(this);
     m_autoSaveTimer->setSingleShot(true);
@@ -34,9 +39,16 @@ Buffer::Buffer(const BufferParameters &p_parameters,
     connect(m_autoSaveTimer, &QTimer::timeout,
             this, &Buffer::autoSave);
 
+    if (m_saveQueue) {
+        connect(m_saveQueue, &BufferSaveQueue::saveFinished,
+                this, &Buffer::handleSaveFinished);
+    }
+
     readContent();
 
-    checkBackupFileOfPreviousSession();
+    if (!m_largeFile) {
+        checkBackupFileOfPreviousSession();
+    }
 }
 
 Buffer::~Buffer()
@@ -44,7 +56,7 @@ Buffer::~Buffer()
     Q_ASSERT(m_attachedViewWindowCount == 0);
     Q_ASSERT(!m_viewWindowToSync);
     Q_ASSERT(!isModified());
-    Q_ASSERT(m_backupFilePath.isEmpty());
+    Q_ASSERT(!m_backupJournal);
 }
 
 int Buffer::getAttachViewWindowCount() const
@@ -74,7 +86,12 @@ void Buffer::detachViewWindow(ViewWindow *p_win)
 
 ViewWindow *Buffer::createViewWindow(const QSharedPointer<FileOpenParameters> &p_paras, QWidget *p_parent)
 {
-    auto window = createViewWindowInternal(p_paras, p_parent);
+    ViewWindow *window = nullptr;
+    if (m_largeFile) {
+        window = new LargeFileViewWindow(p_parent);
+    } else {
+        window = createViewWindowInternal(p_paras, p_parent);
+    }
     Q_ASSERT(window);
     window->attachToBuffer(this, p_paras);
     return window;
@@ -159,7 +176,7 @@ void Buffer::syncContent()
 {
     if (m_viewWindowToSync) {
         // Need to sync content.
-        m_content = m_viewWindowToSync->getLatestContent();
+        m_viewWindowToSync->syncLatestContent(m_content);
         m_viewWindowToSync = nullptr;
     }
 }
@@ -184,6 +201,11 @@ bool Buffer::isReadOnly() const
     return m_readOnly;
 }
 
+bool Buffer::isLargeFile() const
+{
+    return m_largeFile;
+}
+
 Buffer::OperationCode Buffer::save(bool p_force)
 {
     Q_ASSERT(!m_readOnly);
@@ -210,6 +232,9 @@ Buffer::OperationCode Buffer::save(bool p_force)
             return OperationCode::FileChangedOutside;
         }
 
+        // The content to write is newer than the one being saved in background.
+        cancelBackgroundSave();
+
         try {
             m_provider->write(m_content);
         } catch (Exception &p_e) {
@@ -218,7 +243,7 @@ Buffer::OperationCode Buffer::save(bool p_force)
         }
 
         setModified(false);
-        m_state &= ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside);
+        updateState(m_state & ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside));
     }
     return OperationCode::Success;
 }
@@ -233,7 +258,10 @@ Buffer::OperationCode Buffer::reload()
 
     if (m_modified
         || m_state & (StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside)) {
+        cancelBackgroundSave();
+
         readContent();
+        updateState(m_state & ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside));
 
         emit modified(m_modified);
         emit contentsChanged();
@@ -243,7 +271,12 @@ Buffer::OperationCode Buffer::reload()
 
 void Buffer::readContent()
 {
-    m_content = m_provider->read();
+    if (m_largeFile) {
+        // View window of large file will map the file by itself.
+        m_provider->markAsRead();
+    } else {
+        m_content = m_provider->read();
+    }
     ++m_revision;
 
     // Reset state.
@@ -256,8 +289,9 @@ void Buffer::discard()
     Q_ASSERT(!(m_state & StateFlag::Discarded));
     Q_ASSERT(m_attachedViewWindowCount == 1);
     m_autoSaveTimer->stop();
+    cancelBackgroundSave();
     m_content.clear();
-    m_state |= StateFlag::Discarded;
+    updateState(m_state | StateFlag::Discarded);
     ++m_revision;
 
     m_viewWindowToSync = nullptr;
@@ -266,11 +300,14 @@ void Buffer::discard()
 
 void Buffer::close()
 {
-    // Delete the backup file if exists.
+    // Content to keep has been saved or discarded by now.
     m_autoSaveTimer->stop();
-    if (!m_backupFilePath.isEmpty()) {
-        FileUtils::removeFile(m_backupFilePath);
-        m_backupFilePath.clear();
+    cancelBackgroundSave();
+
+    // Delete the backup file if exists.
+    if (m_backupJournal) {
+        FileUtils::removeFile(m_backupJournal->getFilePath());
+        m_backupJournal.reset();
     }
 }
 
@@ -295,6 +332,14 @@ QString Buffer::insertImage(const QImage &p_image, const QString &p_imageFileNam
     return QString();
 }
 
+QString Buffer::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    Q_UNUSED(p_data);
+    Q_UNUSED(p_imageFileName);
+    Q_ASSERT_X(false, "insertImage", "image insert is not supported");
+    return QString();
+}
+
 void Buffer::removeImage(const QString &p_imagePath)
 {
     Q_UNUSED(p_imagePath);
@@ -319,10 +364,8 @@ void Buffer::autoSave()
         return;
 
     case EditorConfig::AutoSavePolicy::AutoSave:
-        if (save(false) != OperationCode::Success) {
+        if (saveInBackground() != OperationCode::Success) {
             qWarning() << "AutoSave failed to save buffer, retry later";
-        } else {
-            emit autoSaved();
         }
         break;
 
@@ -336,9 +379,85 @@ void Buffer::autoSave()
     }
 }
 
+Buffer::OperationCode Buffer::saveInBackground()
+{
+    const auto filePath = m_provider->getDirectWritePath();
+    if (!m_saveQueue || filePath.isEmpty()) {
+        auto code = save(false);
+        if (code == OperationCode::Success) {
+            emit autoSaved();
+        }
+        return code;
+    }
+
+    if (!m_modified) {
+        return OperationCode::Success;
+    }
+
+    syncContent();
+    if (m_savingRevision == m_revision) {
+        // Already queued.
+        return OperationCode::Success;
+    }
+
+    if (!checkFileExistsOnDisk()) {
+        qWarning() << "failed to save buffer due to file missing on disk" << getPath();
+        return OperationCode::FileMissingOnDisk;
+    }
+
+    if (checkFileChangedOutside()) {
+        qWarning() << "failed to save buffer due to file changed from outside" << getPath();
+        return OperationCode::FileChangedOutside;
+    }
+
+    m_savingRevision = m_revision;
+    m_saveQueue->enqueue(m_id, m_revision, filePath, m_content);
+    return OperationCode::Success;
+}
+
+void Buffer::cancelBackgroundSave()
+{
+    if (m_savingRevision == 0) {
+        return;
+    }
+
+    Q_ASSERT(m_saveQueue);
+    m_savingRevision = 0;
+    m_saveQueue->cancel(m_provider->getDirectWritePath());
+}
+
+void Buffer::handleSaveFinished(ID p_bufferId, int p_revision, bool p_succeeded, const QString &p_errorMessage)
+{
+    if (p_bufferId != m_id) {
+        return;
+    }
+
+    const auto result = BufferSaveQueue::checkFinishedSave(p_revision, m_savingRevision, m_revision);
+    if (result == BufferSaveQueue::FinishedSave::Superseded) {
+        return;
+    }
+
+    m_savingRevision = 0;
+
+    if (!p_succeeded) {
+        qWarning() << "failed to save buffer in background, retry later" << getPath() << p_errorMessage;
+        m_autoSaveTimer->start();
+        return;
+    }
+
+    m_provider->handleDirectWritten();
+
+    if (result == BufferSaveQueue::FinishedSave::UpToDate && !m_viewWindowToSync) {
+        // No change since the snapshot.
+        setModified(false);
+        updateState(m_state & ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside));
+        emit autoSaved();
+    }
+}
+
 void Buffer::writeBackupFile()
 {
-    if (m_backupFilePath.isEmpty()) {
+    if (!m_backupJournal) {
         const auto &config = ConfigMgr::getInst().getEditorConfig();
         QString backupDirPath(QDir(getResourcePath()).filePath(config.getBackupFileDirectory()));
         backupDirPath = QDir::cleanPath(backupDirPath);
@@ -347,13 +466,14 @@ void Buffer::writeBackupFile()
                                                                       config.getBackupFileExtension());
         QDir backupDir(backupDirPath);
         backupDir.mkpath(backupDirPath);
-        m_backupFilePath = backupDir.filePath(backupFileName);
+        m_backupJournal.reset(new BackupJournal(backupDir.filePath(backupFileName), generateBackupFileHead()));
     }
 
     Q_ASSERT(m_backupFilePathOfPreviousSession.isEmpty());
 
     // Just use FileUtils instead of notebook backend.
-    FileUtils::writeFile(m_backupFilePath, generateBackupFileHead() + getContent());
+    // Only the changes since last backup are appended in most cases.
+    m_backupJournal->record(m_revision, getContent());
 }
 
 QString Buffer::generateBackupFileHead() const
@@ -419,8 +539,7 @@ const QString &Buffer::getBackupFileOfPreviousSession() const
 
 QString Buffer::readBackupFile(const QString &p_filePath)
 {
-    auto content = FileUtils::readTextFile(p_filePath);
-    return content.mid(content.indexOf(QLatin1Char('|')) + 1);
+    return BackupJournal::replay(FileUtils::readFile(p_filePath));
 }
 
 void Buffer::discardBackupFileOfPreviousSession()
@@ -547,21 +666,26 @@ Node *Buffer::getNode() const
 bool Buffer::checkFileExistsOnDisk()
 {
     if (m_provider->checkFileExistsOnDisk()) {
-        m_state &= ~StateFlag::FileMissingOnDisk;
+        updateState(m_state & ~StateFlag::FileMissingOnDisk);
         return true;
     } else {
-        m_state |= StateFlag::FileMissingOnDisk;
+        updateState(m_state | StateFlag::FileMissingOnDisk);
         return false;
     }
 }
 
 bool Buffer::checkFileChangedOutside()
 {
+    if (m_savingRevision != 0) {
+        // The file is being replaced by ourselves.
+        return m_state.testFlag(StateFlag::FileChangedOutside);
+    }
+
     if (m_provider->checkFileChangedOutside()) {
-        m_state |= StateFlag::FileChangedOutside;
+        updateState(m_state | StateFlag::FileChangedOutside);
         return true;
     } else {
-        m_state &= ~StateFlag::FileChangedOutside;
+        updateState(m_state & ~StateFlag::FileChangedOutside);
         return false;
     }
 }
@@ -571,6 +695,16 @@ Buffer::StateFlags Buffer::state() const
     return m_state;
 }
 
+void Buffer::updateState(StateFlags p_state)
+{
+    if (m_state == p_state) {
+        return;
+    }
+
+    m_state = p_state;
+    emit stateChanged();
+}
+
 QSharedPointer<File> Buffer::getFile() const
 {
     return m_provider->getFile();
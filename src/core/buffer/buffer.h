@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QSharedPointer>
+#include <QScopedPointer>
 
 #include <functional>
 
@@ -18,11 +19,20 @@ namespace vnotex
     class ViewWindow;
     struct FileOpenParameters;
     class BufferProvider;
+    class BufferSaveQueue;
+    class BackupJournal;
     class File;
 
     struct BufferParameters
     {
         QSharedPointer<BufferProvider> m_provider;
+
+        // Used to save content in background. Save synchronously if null.
+        BufferSaveQueue *m_saveQueue = nullptr;
+
+        // Large file mode: content is not loaded into the buffer but accessed on demand
+        // by the view window, and the buffer is read-only.
+        bool m_largeFile = false;
     };
 
     class Buffer : public QObject
@@ -114,6 +124,10 @@ namespace vnotex
 
         bool isReadOnly() const;
 
+        // Whether this buffer is opened in large file mode.
+        // getContent() is always empty in this mode.
+        bool isLargeFile() const;
+
         // Save buffer content to file.
         OperationCode save(bool p_force);
 
@@ -132,6 +146,9 @@ namespace vnotex
 
         virtual QString insertImage(const QImage &p_image, const QString &p_imageFileName);
 
+        // Insert image from raw data @p_data.
+        virtual QString insertImage(const QByteArray &p_data, const QString &p_imageFileName);
+
         virtual void removeImage(const QString &p_imagePath);
 
         const QString &getBackupFileOfPreviousSession() const;
@@ -191,6 +208,9 @@ namespace vnotex
         // This buffer is AutoSavePolicy::AutoSave.
         void autoSaved();
 
+        // Emit when state() is changed, such as the file is changed outside.
+        void stateChanged();
+
     protected:
         virtual ViewWindow *createViewWindowInternal(const QSharedPointer<FileOpenParameters> &p_paras, QWidget *p_parent) = 0;
 
@@ -199,11 +219,19 @@ namespace vnotex
     private slots:
         void autoSave();
 
+        void handleSaveFinished(ID p_bufferId, int p_revision, bool p_succeeded, const QString &p_errorMessage);
+
     private:
         void syncContent();
 
         void readContent();
 
+        // Save content via m_saveQueue. Fall back to save() if not supported.
+        OperationCode saveInBackground();
+
+        // Drop the pending background save if there is one.
+        void cancelBackgroundSave();
+
         // Get the path of the image folder.
         QString getImageFolderPath() const;
 
@@ -216,6 +244,8 @@ namespace vnotex
 
         bool isBackupFileOfBuffer(const QString &p_file) const;
 
+        void updateState(StateFlags p_state);
+
         // Will be assigned uniquely once created.
         const ID m_id = 0;
 
@@ -228,6 +258,8 @@ namespace vnotex
 
         bool m_readOnly = false;
 
+        const bool m_largeFile = false;
+
         bool m_modified = false;
 
         int m_attachedViewWindowCount = 0;
@@ -237,7 +269,13 @@ namespace vnotex
         // Managed by QObject.
         QTimer *m_autoSaveTimer = nullptr;
 
-        QString m_backupFilePath;
+        BufferSaveQueue *m_saveQueue = nullptr;
+
+        // Revision being saved in background. 0 if there is none.
+        int m_savingRevision = 0;
+
+        // Journal as the backup file of this session.
+        QScopedPointer<BackupJournal> m_backupJournal;
 
         QString m_backupFilePathOfPreviousSession;
 
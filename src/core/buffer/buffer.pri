@@ -1,7 +1,11 @@
 SOURCES += \
+    $$PWD/backupjournal.cpp \
     $$PWD/buffer.cpp \
     $$PWD/bufferprovider.cpp \
+    $$PWD/buffersavequeue.cpp \
+    $$PWD/bufferwatcher.cpp \
     $$PWD/filebufferprovider.cpp \
+    $$PWD/mappedtextfile.cpp \
     $$PWD/markdownbuffer.cpp \
     $$PWD/markdownbufferfactory.cpp \
     $$PWD/filetypehelper.cpp \
@@ -11,9 +15,13 @@ SOURCES += \
 
 HEADERS += \
     $$PWD/bufferprovider.h \
+    $$PWD/backupjournal.h \
     $$PWD/buffer.h \
+    $$PWD/buffersavequeue.h \
+    $$PWD/bufferwatcher.h \
     $$PWD/filebufferprovider.h \
     $$PWD/ibufferfactory.h \
+    $$PWD/mappedtextfile.h \
     $$PWD/markdownbuffer.h \
     $$PWD/markdownbufferfactory.h \
     $$PWD/filetypehelper.h \
@@ -14,6 +14,11 @@ QDateTime BufferProvider::getLastModifiedFromFile() const
     return QFileInfo(getContentPath()).lastModified();
 }
 
+void BufferProvider::markAsRead()
+{
+    m_lastModified = getLastModifiedFromFile();
+}
+
 bool BufferProvider::checkFileChangedOutside() const
 {
     QFileInfo info(getContentPath());
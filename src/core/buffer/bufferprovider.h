@@ -38,8 +38,19 @@ namespace vnotex
 
         virtual void write(const QString &p_content) = 0;
 
+        // Local file path to write content directly in background.
+        // Return empty if content could only be written by write().
+        virtual QString getDirectWritePath() const = 0;
+
+        // Called in main thread after content is written to getDirectWritePath().
+        virtual void handleDirectWritten() = 0;
+
         virtual QString read() const = 0;
 
+        // Mark current file on disk as the one read without reading the content.
+        // Used when the content is accessed directly from getContentPath().
+        void markAsRead();
+
         virtual QString fetchImageFolderPath() = 0;
 
         virtual bool isChildOf(const Node *p_node) const = 0;
@@ -64,6 +75,9 @@ namespace vnotex
 
         virtual QString insertImage(const QImage &p_image, const QString &p_imageFileName) = 0;
 
+        // Insert image from raw data @p_data.
+        virtual QString insertImage(const QByteArray &p_data, const QString &p_imageFileName) = 0;
+
         virtual void removeImage(const QString &p_imagePath) = 0;
 
         virtual bool isAttachmentSupported() const = 0;
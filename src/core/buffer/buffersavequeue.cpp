@@ -0,0 +1,124 @@
+#include "buffersavequeue.h"
+
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <utils/fileutils.h>
+#include <utils/pathutils.h>
+#include <core/exception.h>
+
+using namespace vnotex;
+
+BufferSaveQueue::BufferSaveQueue(QObject *p_parent)
+    : QThread(p_parent)
+{
+    qRegisterMetaType<ID>("ID");
+}
+
+BufferSaveQueue::~BufferSaveQueue()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stopped = true;
+        m_jobAvailable.wakeAll();
+    }
+
+    wait();
+}
+
+void BufferSaveQueue::enqueue(ID p_bufferId, int p_revision, const QString &p_filePath, const QString &p_content)
+{
+    Job job;
+    job.m_bufferId = p_bufferId;
+    job.m_revision = p_revision;
+    job.m_filePath = p_filePath;
+    job.m_content = p_content;
+
+    {
+        QMutexLocker lock(&m_mutex);
+        Q_ASSERT(!m_stopped);
+        int idx = findPendingJob(p_filePath);
+        if (idx > -1) {
+            // Coalesce with the pending one which is not written yet.
+            m_pendingJobs[idx] = job;
+        } else {
+            m_pendingJobs.append(job);
+        }
+        m_jobAvailable.wakeOne();
+    }
+
+    if (!isRunning()) {
+        start(QThread::LowPriority);
+    }
+}
+
+void BufferSaveQueue::cancel(const QString &p_filePath)
+{
+    QMutexLocker lock(&m_mutex);
+    int idx = findPendingJob(p_filePath);
+    if (idx > -1) {
+        m_pendingJobs.removeAt(idx);
+    }
+
+    while (!m_runningFilePath.isEmpty() && PathUtils::areSamePaths(m_runningFilePath, p_filePath)) {
+        m_jobDone.wait(&m_mutex);
+    }
+}
+
+BufferSaveQueue::FinishedSave BufferSaveQueue::checkFinishedSave(int p_savedRevision,
+                                                                 int p_savingRevision,
+                                                                 int p_currentRevision)
+{
+    if (p_savingRevision == 0 || p_savedRevision != p_savingRevision) {
+        return FinishedSave::Superseded;
+    }
+
+    return p_savedRevision == p_currentRevision ? FinishedSave::UpToDate : FinishedSave::Outdated;
+}
+
+int BufferSaveQueue::findPendingJob(const QString &p_filePath) const
+{
+    for (int i = 0; i < m_pendingJobs.size(); ++i) {
+        if (PathUtils::areSamePaths(m_pendingJobs[i].m_filePath, p_filePath)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void BufferSaveQueue::run()
+{
+    while (true) {
+        Job job;
+        {
+            QMutexLocker lock(&m_mutex);
+            while (m_pendingJobs.isEmpty()) {
+                if (m_stopped) {
+                    return;
+                }
+                m_jobAvailable.wait(&m_mutex);
+            }
+
+            job = m_pendingJobs.takeFirst();
+            m_runningFilePath = job.m_filePath;
+        }
+
+        bool succeeded = true;
+        QString errorMessage;
+        try {
+            FileUtils::writeFile(job.m_filePath, job.m_content);
+        } catch (Exception &p_e) {
+            succeeded = false;
+            errorMessage = p_e.what();
+        }
+
+        {
+            QMutexLocker lock(&m_mutex);
+            m_runningFilePath.clear();
+            m_jobDone.wakeAll();
+        }
+
+        emit saveFinished(job.m_bufferId, job.m_revision, succeeded, errorMessage);
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef BUFFERSAVEQUEUE_H
+#define BUFFERSAVEQUEUE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+
+#include <global.h>
+
+namespace vnotex
+{
+    // Write buffer contents to local files in a background thread.
+    // Each file is written via FileUtils::writeFile(), which replaces the target atomically.
+    // A pending save is replaced by a newer one of the same file.
+    class BufferSaveQueue : public QThread
+    {
+        Q_OBJECT
+    public:
+        enum class FinishedSave
+        {
+            // Not the latest save requested by the buffer.
+            Superseded,
+
+            // Written but the buffer has been changed since the snapshot.
+            Outdated,
+
+            // Written and the buffer has not been changed since the snapshot.
+            UpToDate
+        };
+
+        explicit BufferSaveQueue(QObject *p_parent = nullptr);
+
+        // Finish all the pending saves before return.
+        ~BufferSaveQueue();
+
+        // @p_content is shared implicitly, so later changes of the buffer will not affect it.
+        void enqueue(ID p_bufferId, int p_revision, const QString &p_filePath, const QString &p_content);
+
+        // Drop the pending save of @p_filePath and wait for the one being written.
+        void cancel(const QString &p_filePath);
+
+        // Check a finished save of @p_savedRevision against the buffer which requested
+        // @p_savingRevision last and is at @p_currentRevision now.
+        static FinishedSave checkFinishedSave(int p_savedRevision, int p_savingRevision, int p_currentRevision);
+
+    signals:
+        // Emitted in the background thread.
+        void saveFinished(ID p_bufferId, int p_revision, bool p_succeeded, const QString &p_errorMessage);
+
+    protected:
+        void run() Q_DECL_OVERRIDE;
+
+    private:
+        struct Job
+        {
+            ID m_bufferId = 0;
+
+            int m_revision = 0;
+
+            QString m_filePath;
+
+            QString m_content;
+        };
+
+        int findPendingJob(const QString &p_filePath) const;
+
+        QMutex m_mutex;
+
+        QWaitCondition m_jobAvailable;
+
+        QWaitCondition m_jobDone;
+
+        QList<Job> m_pendingJobs;
+
+        // File path of the job being written.
+        QString m_runningFilePath;
+
+        bool m_stopped = false;
+    };
+} // ns vnotex
+
+#endif // BUFFERSAVEQUEUE_H
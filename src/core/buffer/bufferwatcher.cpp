@@ -0,0 +1,158 @@
+#include "bufferwatcher.h"
+
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QTimer>
+#include <QDebug>
+
+#include "buffer.h"
+
+using namespace vnotex;
+
+BufferWatcher::BufferWatcher(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &BufferWatcher::handleFileChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &BufferWatcher::handleDirectoryChanged);
+
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(300);
+    connect(m_timer, &QTimer::timeout,
+            this, &BufferWatcher::processPendingChanges);
+
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(2000);
+    connect(m_pollTimer, &QTimer::timeout,
+            this, &BufferWatcher::pollUnwatchedFiles);
+}
+
+void BufferWatcher::addBuffer(Buffer *p_buffer)
+{
+    const auto path = p_buffer->getContentPath();
+    Q_ASSERT(!m_buffers.contains(path));
+    m_buffers.insert(path, p_buffer);
+    watchFile(path);
+}
+
+void BufferWatcher::removeBuffer(Buffer *p_buffer)
+{
+    const auto path = p_buffer->getContentPath();
+    if (m_buffers.value(path) != p_buffer) {
+        return;
+    }
+
+    m_buffers.remove(path);
+    m_pendingFiles.remove(path);
+
+    if (m_unwatchedFiles.remove(path) && m_unwatchedFiles.isEmpty()) {
+        m_pollTimer->stop();
+    }
+
+    if (m_watcher->files().contains(path)) {
+        m_watcher->removePath(path);
+    }
+
+    updateWatchedDirectories();
+}
+
+void BufferWatcher::watchFile(const QString &p_path)
+{
+    if (m_watcher->files().contains(p_path) || !QFileInfo::exists(p_path)) {
+        // A missing file will be caught by watching its folder.
+        return;
+    }
+
+    if (m_watcher->addPath(p_path)) {
+        if (m_unwatchedFiles.remove(p_path) && m_unwatchedFiles.isEmpty()) {
+            m_pollTimer->stop();
+        }
+        return;
+    }
+
+    if (!m_unwatchedFiles.contains(p_path)) {
+        qWarning() << "failed to watch file, poll it instead (the inotify watch limit may be reached)" << p_path;
+        m_unwatchedFiles.insert(p_path);
+    }
+
+    if (!m_pollTimer->isActive()) {
+        m_pollTimer->start();
+    }
+}
+
+void BufferWatcher::handleFileChanged(const QString &p_path)
+{
+    m_pendingFiles.insert(p_path);
+    m_timer->start();
+}
+
+void BufferWatcher::handleDirectoryChanged(const QString &p_path)
+{
+    // Only folders of missing files are watched.
+    for (auto it = m_buffers.constBegin(); it != m_buffers.constEnd(); ++it) {
+        if (QFileInfo(it.key()).absolutePath() == p_path) {
+            m_pendingFiles.insert(it.key());
+        }
+    }
+
+    m_timer->start();
+}
+
+void BufferWatcher::processPendingChanges()
+{
+    const auto files = m_pendingFiles;
+    m_pendingFiles.clear();
+
+    for (const auto &file : files) {
+        auto buffer = m_buffers.value(file);
+        if (!buffer) {
+            continue;
+        }
+
+        if (buffer->checkFileExistsOnDisk()) {
+            buffer->checkFileChangedOutside();
+
+            // Watch is dropped once the file is replaced or re-created.
+            watchFile(file);
+        }
+    }
+
+    updateWatchedDirectories();
+}
+
+void BufferWatcher::pollUnwatchedFiles()
+{
+    if (m_unwatchedFiles.isEmpty()) {
+        m_pollTimer->stop();
+        return;
+    }
+
+    m_pendingFiles.unite(m_unwatchedFiles);
+    processPendingChanges();
+}
+
+void BufferWatcher::updateWatchedDirectories()
+{
+    QSet<QString> dirs;
+    for (auto it = m_buffers.constBegin(); it != m_buffers.constEnd(); ++it) {
+        if (it.value()->state() & Buffer::StateFlag::FileMissingOnDisk) {
+            dirs.insert(QFileInfo(it.key()).absolutePath());
+        }
+    }
+
+    const auto watchedDirs = m_watcher->directories();
+    for (const auto &dir : watchedDirs) {
+        if (!dirs.contains(dir)) {
+            m_watcher->removePath(dir);
+        }
+    }
+
+    for (const auto &dir : dirs) {
+        if (!watchedDirs.contains(dir) && QFileInfo::exists(dir)) {
+            m_watcher->addPath(dir);
+        }
+    }
+}
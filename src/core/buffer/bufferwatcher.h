@@ -0,0 +1,65 @@
+#ifndef BUFFERWATCHER_H
+#define BUFFERWATCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace vnotex
+{
+    class Buffer;
+
+    // Watch the content files of all open buffers and update their state
+    // (FileChangedOutside/FileMissingOnDisk) once changed on disk.
+    // Use inotify on Linux via QFileSystemWatcher. Bursts of events are coalesced.
+    // The folder of a missing file is watched to catch its re-creation.
+    // Files failed to watch (the inotify watch limit may be reached) are polled instead.
+    class BufferWatcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit BufferWatcher(QObject *p_parent = nullptr);
+
+        void addBuffer(Buffer *p_buffer);
+
+        void removeBuffer(Buffer *p_buffer);
+
+    private:
+        void handleFileChanged(const QString &p_path);
+
+        void handleDirectoryChanged(const QString &p_path);
+
+        // Update the state of buffers with pending changes.
+        void processPendingChanges();
+
+        void pollUnwatchedFiles();
+
+        void watchFile(const QString &p_path);
+
+        void updateWatchedDirectories();
+
+        // Managed by QObject.
+        QFileSystemWatcher *m_watcher = nullptr;
+
+        // Coalesce bursts of events.
+        // Managed by QObject.
+        QTimer *m_timer = nullptr;
+
+        // Managed by QObject.
+        QTimer *m_pollTimer = nullptr;
+
+        // Content file path -> buffer.
+        QHash<QString, Buffer *> m_buffers;
+
+        // Content file paths with pending changes.
+        QSet<QString> m_pendingFiles;
+
+        // Existing content files failed to watch.
+        QSet<QString> m_unwatchedFiles;
+    };
+} // ns vnotex
+
+#endif // BUFFERWATCHER_H
@@ -63,6 +63,17 @@ void FileBufferProvider::write(const QString &p_content)
     m_lastModified = getLastModifiedFromFile();
 }
 
+QString FileBufferProvider::getDirectWritePath() const
+{
+    return m_file->getDirectWritePath();
+}
+
+void FileBufferProvider::handleDirectWritten()
+{
+    m_file->handleDirectWritten();
+    m_lastModified = getLastModifiedFromFile();
+}
+
 QString FileBufferProvider::read() const
 {
     const_cast<FileBufferProvider *>(this)->m_lastModified = getLastModifiedFromFile();
@@ -157,6 +168,16 @@ QString FileBufferProvider::insertImage(const QImage &p_image, const QString &p_
     }
 }
 
+QString FileBufferProvider::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    auto file = m_file->getImageInterface();
+    if (file) {
+        return file->insertImage(p_data, p_imageFileName);
+    } else {
+        return QString();
+    }
+}
+
 void FileBufferProvider::removeImage(const QString &p_imagePath)
 {
     auto file = m_file->getImageInterface();
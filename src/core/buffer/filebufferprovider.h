@@ -33,6 +33,10 @@ namespace vnotex
 
         void write(const QString &p_content) Q_DECL_OVERRIDE;
 
+        QString getDirectWritePath() const Q_DECL_OVERRIDE;
+
+        void handleDirectWritten() Q_DECL_OVERRIDE;
+
         QString read() const Q_DECL_OVERRIDE;
 
         QString fetchImageFolderPath() Q_DECL_OVERRIDE;
@@ -59,6 +63,8 @@ namespace vnotex
 
         QString insertImage(const QImage &p_image, const QString &p_imageFileName) Q_DECL_OVERRIDE;
 
+        QString insertImage(const QByteArray &p_data, const QString &p_imageFileName) Q_DECL_OVERRIDE;
+
         void removeImage(const QString &p_imagePath) Q_DECL_OVERRIDE;
 
         bool isAttachmentSupported() const Q_DECL_OVERRIDE;
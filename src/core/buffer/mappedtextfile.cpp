@@ -0,0 +1,192 @@
+#include "mappedtextfile.h"
+
+#include <QDebug>
+#include <QFileInfo>
+
+#include <climits>
+#include <cstring>
+
+using namespace vnotex;
+
+const int MappedTextFile::c_checkpointInterval = 256;
+
+const qint64 MappedTextFile::c_checkInterval = 4 * 1024 * 1024;
+
+MappedTextFile::MappedTextFile(const QString &p_filePath)
+    : m_file(p_filePath)
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "failed to open file for mapping" << p_filePath << m_file.errorString();
+        return;
+    }
+
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_data = reinterpret_cast<const char *>(m_file.map(0, m_size));
+        if (!m_data) {
+            qWarning() << "failed to map file" << p_filePath << m_file.errorString();
+            m_size = 0;
+            m_file.close();
+            return;
+        }
+    }
+
+    m_modifiedTime = QFileInfo(m_file).lastModified();
+    m_valid = true;
+
+    if (m_size >= 3 && std::memcmp(m_data, "\xEF\xBB\xBF", 3) == 0) {
+        m_dataOffset = 3;
+    }
+
+    m_checkpoints.append(m_dataOffset);
+    m_lastIndexedOffset = m_dataOffset;
+    m_fullyIndexed = m_dataOffset == m_size;
+}
+
+MappedTextFile::~MappedTextFile()
+{
+    if (m_data) {
+        m_file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_data)));
+        m_data = nullptr;
+    }
+}
+
+bool MappedTextFile::isValid() const
+{
+    return m_valid;
+}
+
+bool MappedTextFile::isChanged() const
+{
+    // Check by path since QFile is not thread-safe.
+    const QFileInfo info(m_file.fileName());
+    return !info.exists() || info.size() != m_size || info.lastModified() != m_modifiedTime;
+}
+
+bool MappedTextFile::checkFile()
+{
+    if (m_valid && isChanged()) {
+        qWarning() << "mapped file is changed outside" << m_file.fileName();
+        // Keep the mapping since it may still be accessed by others until they check it.
+        m_valid = false;
+    }
+
+    return m_valid;
+}
+
+QString MappedTextFile::getFilePath() const
+{
+    return m_file.fileName();
+}
+
+const char *MappedTextFile::data() const
+{
+    return m_data;
+}
+
+qint64 MappedTextFile::size() const
+{
+    return m_size;
+}
+
+qint64 MappedTextFile::dataOffset() const
+{
+    return m_dataOffset;
+}
+
+bool MappedTextFile::ensureLineIndexed(int p_lineNumber)
+{
+    qint64 nextCheckOffset = m_lastIndexedOffset;
+    while (!m_fullyIndexed && m_indexedLineCount <= p_lineNumber) {
+        if (m_lastIndexedOffset >= nextCheckOffset) {
+            if (!checkFile()) {
+                return false;
+            }
+            nextCheckOffset = m_lastIndexedOffset + c_checkInterval;
+        }
+
+        const auto *pos = m_data + m_lastIndexedOffset;
+        const auto *nl = static_cast<const char *>(std::memchr(pos, '\n', m_size - m_lastIndexedOffset));
+        if (!nl) {
+            m_fullyIndexed = true;
+            break;
+        }
+
+        m_lastIndexedOffset = nl - m_data + 1;
+        if (m_indexedLineCount % c_checkpointInterval == 0) {
+            m_checkpoints.append(m_lastIndexedOffset);
+        }
+        ++m_indexedLineCount;
+    }
+
+    return p_lineNumber < m_indexedLineCount;
+}
+
+void MappedTextFile::indexAll()
+{
+    ensureLineIndexed(INT_MAX - 1);
+}
+
+bool MappedTextFile::isFullyIndexed() const
+{
+    return m_fullyIndexed;
+}
+
+int MappedTextFile::indexedLineCount() const
+{
+    return m_indexedLineCount;
+}
+
+qint64 MappedTextFile::lineOffset(int p_lineNumber)
+{
+    if (p_lineNumber < 0 || !ensureLineIndexed(p_lineNumber) || !checkFile()) {
+        return -1;
+    }
+
+    // Skip lines from the nearest checkpoint.
+    qint64 offset = m_checkpoints[p_lineNumber / c_checkpointInterval];
+    for (int i = p_lineNumber % c_checkpointInterval; i > 0; --i) {
+        const auto *nl = static_cast<const char *>(std::memchr(m_data + offset, '\n', m_size - offset));
+        Q_ASSERT(nl);
+        offset = nl - m_data + 1;
+    }
+
+    return offset;
+}
+
+QString MappedTextFile::readLines(int p_firstLine, int p_count)
+{
+    const auto begin = lineOffset(p_firstLine);
+    if (begin == -1 || p_count <= 0) {
+        return QString();
+    }
+
+    auto end = lineOffset(p_firstLine + p_count);
+    if (!m_valid) {
+        return QString();
+    }
+
+    if (end == -1) {
+        end = m_size;
+    } else {
+        // Exclude the line ending of the last line.
+        --end;
+    }
+
+    if (end > begin && m_data[end - 1] == '\r') {
+        --end;
+    }
+
+    auto text = QString::fromUtf8(m_data + begin, end - begin);
+    text.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
+    return text;
+}
+
+QString MappedTextFile::decodeLine(const char *p_begin, const char *p_end)
+{
+    if (p_end > p_begin && *(p_end - 1) == '\r') {
+        --p_end;
+    }
+
+    return QString::fromUtf8(p_begin, p_end - p_begin);
+}
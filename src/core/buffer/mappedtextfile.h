@@ -0,0 +1,99 @@
+#ifndef MAPPEDTEXTFILE_H
+#define MAPPEDTEXTFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QVector>
+#include <QDateTime>
+
+#include "../noncopyable.h"
+
+namespace vnotex
+{
+    // Read-only memory-mapped UTF-8 text file for large file mode.
+    // Lines are indexed on demand with one checkpoint every c_checkpointInterval lines,
+    // so only the part of the file before the requested line is scanned.
+    // data() and size() could be accessed from other threads while the object is alive.
+    // Accessing the mapping after another program truncates the file raises SIGBUS, so the file
+    // is checked before each access and invalidated once changed. It should be reloaded then.
+    class MappedTextFile : private Noncopyable
+    {
+    public:
+        explicit MappedTextFile(const QString &p_filePath);
+
+        ~MappedTextFile();
+
+        // Whether the file is mapped successfully and not changed since then.
+        bool isValid() const;
+
+        // Whether the file on disk differs in size or modification time from the mapping.
+        // Callers accessing data() should check it before each bounded chunk. Thread-safe.
+        bool isChanged() const;
+
+        QString getFilePath() const;
+
+        const char *data() const;
+
+        qint64 size() const;
+
+        // Offset of the first byte of text, skipping the UTF-8 BOM.
+        qint64 dataOffset() const;
+
+        // Index lines until line @p_lineNumber (0-based).
+        // Return false if the file has no such line or is invalidated.
+        bool ensureLineIndexed(int p_lineNumber);
+
+        // Index the whole file.
+        void indexAll();
+
+        bool isFullyIndexed() const;
+
+        // Number of lines indexed so far. It is the total line count once fully indexed.
+        int indexedLineCount() const;
+
+        // Byte offset of the start of line @p_lineNumber. Return -1 if there is no such line.
+        qint64 lineOffset(int p_lineNumber);
+
+        // Read @p_count lines from line @p_firstLine.
+        // Line endings are normalized to '\n' and there is no trailing line ending.
+        QString readLines(int p_firstLine, int p_count);
+
+        // Decode the text of [@p_begin, @p_end) without the trailing '\r'.
+        static QString decodeLine(const char *p_begin, const char *p_end);
+
+        // Bytes to access between two checks of the file.
+        static const qint64 c_checkInterval;
+
+    private:
+        // Invalidate the file if it is changed. Return false if invalid.
+        bool checkFile();
+
+        QFile m_file;
+
+        // Null if the file is empty or failed to map.
+        const char *m_data = nullptr;
+
+        qint64 m_size = 0;
+
+        QDateTime m_modifiedTime;
+
+        bool m_valid = false;
+
+        qint64 m_dataOffset = 0;
+
+        // [i] is the byte offset of line (i * c_checkpointInterval).
+        QVector<qint64> m_checkpoints;
+
+        // Number of lines whose start offset is known.
+        int m_indexedLineCount = 1;
+
+        // Byte offset of the start of the last indexed line.
+        qint64 m_lastIndexedOffset = 0;
+
+        bool m_fullyIndexed = false;
+
+        static const int c_checkpointInterval;
+    };
+} // ns vnotex
+
+#endif // MAPPEDTEXTFILE_H
@@ -32,6 +32,11 @@ QString MarkdownBuffer::insertImage(const QImage &p_image, const QString &p_imag
     return m_provider->insertImage(p_image, p_imageFileName);
 }
 
+QString MarkdownBuffer::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    return m_provider->insertImage(p_data, p_imageFileName);
+}
+
 void MarkdownBuffer::fetchInitialImages()
 {
     Q_ASSERT(m_initialImages.isEmpty());
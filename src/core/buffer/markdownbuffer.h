@@ -21,6 +21,8 @@ namespace vnotex
 
         QString insertImage(const QImage &p_image, const QString &p_imageFileName) Q_DECL_OVERRIDE;
 
+        QString insertImage(const QByteArray &p_data, const QString &p_imageFileName) Q_DECL_OVERRIDE;
+
         void removeImage(const QString &p_imagePath) Q_DECL_OVERRIDE;
 
         void addInsertedImage(const QString &p_imagePath, const QString &p_urlInLink);
@@ -60,6 +60,17 @@ void NodeBufferProvider::write(const QString &p_content)
     m_lastModified = getLastModifiedFromFile();
 }
 
+QString NodeBufferProvider::getDirectWritePath() const
+{
+    return m_nodeFile->getDirectWritePath();
+}
+
+void NodeBufferProvider::handleDirectWritten()
+{
+    m_nodeFile->handleDirectWritten();
+    m_lastModified = getLastModifiedFromFile();
+}
+
 QString NodeBufferProvider::read() const
 {
     const_cast<NodeBufferProvider *>(this)->m_lastModified = getLastModifiedFromFile();
@@ -137,6 +148,16 @@ QString NodeBufferProvider::insertImage(const QImage &p_image, const QString &p_
     }
 }
 
+QString NodeBufferProvider::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    auto file = m_nodeFile->getImageInterface();
+    if (file) {
+        return file->insertImage(p_data, p_imageFileName);
+    } else {
+        return QString();
+    }
+}
+
 void NodeBufferProvider::removeImage(const QString &p_imagePath)
 {
     auto file = m_nodeFile->getImageInterface();
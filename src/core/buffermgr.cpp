@@ -1,19 +1,25 @@
 #include "buffermgr.h"
 
 #include <QUrl>
+#include <QFileInfo>
 #include <QDebug>
 
 #include <notebook/node.h>
+#include <notebookbackend/backendiostats.h>
 #include <buffer/filetypehelper.h>
 #include <buffer/markdownbufferfactory.h>
 #include <buffer/textbufferfactory.h>
 #include <buffer/buffer.h>
 #include <buffer/nodebufferprovider.h>
 #include <buffer/filebufferprovider.h>
+#include <buffer/buffersavequeue.h>
+#include <buffer/bufferwatcher.h>
 #include <utils/widgetutils.h>
 #include "notebookmgr.h"
 #include "vnotex.h"
 #include "externalfile.h"
+#include "configmgr.h"
+#include "editorconfig.h"
 
 #include "fileopenparameters.h"
 
@@ -32,6 +38,10 @@ BufferMgr::~BufferMgr()
 void BufferMgr::init()
 {
     initBufferServer();
+
+    m_saveQueue = new BufferSaveQueue(this);
+
+    m_bufferWatcher = new BufferWatcher(this);
 }
 
 void BufferMgr::initBufferServer()
@@ -59,6 +69,8 @@ void BufferMgr::open(Node *p_node, const QSharedPointer<FileOpenParameters> &p_p
         return;
     }
 
+    BackendIoStats::OperationScope ioScope("open_note");
+
     if (!p_node->checkExists()) {
         auto msg = QString("Failed to open node that does not exist (%1)").arg(p_node->fetchAbsolutePath());
         qWarning() << msg;
@@ -82,6 +94,8 @@ void BufferMgr::open(Node *p_node, const QSharedPointer<FileOpenParameters> &p_p
 
         BufferParameters paras;
         paras.m_provider.reset(new NodeBufferProvider(p_node->sharedFromThis(), nodeFile));
+        paras.m_saveQueue = m_saveQueue;
+        paras.m_largeFile = isLargeFile(paras.m_provider->getContentPath());
         buffer = factory->createBuffer(paras, this);
         addBuffer(buffer);
     }
@@ -140,6 +154,8 @@ void BufferMgr::open(const QString &p_filePath, const QSharedPointer<FileOpenPar
         paras.m_provider.reset(new FileBufferProvider(externalFile,
                                                       p_paras->m_nodeAttachedTo,
                                                       p_paras->m_readOnly));
+        paras.m_saveQueue = m_saveQueue;
+        paras.m_largeFile = isLargeFile(paras.m_provider->getContentPath());
         buffer = factory->createBuffer(paras, this);
         addBuffer(buffer);
     }
@@ -179,12 +195,30 @@ Buffer *BufferMgr::findBuffer(const QString &p_filePath) const
 void BufferMgr::addBuffer(Buffer *p_buffer)
 {
     m_buffers.push_back(p_buffer);
+    m_bufferWatcher->addBuffer(p_buffer);
     connect(p_buffer, &Buffer::attachedViewWindowEmpty,
             this, [this, p_buffer]() {
                 qDebug() << "delete buffer without attached view window"
                          << p_buffer->getName();
                 m_buffers.removeAll(p_buffer);
+                m_bufferWatcher->removeBuffer(p_buffer);
                 p_buffer->close();
                 p_buffer->deleteLater();
             });
 }
+
+bool BufferMgr::isLargeFile(const QString &p_filePath)
+{
+    const auto threshold = ConfigMgr::getInst().getEditorConfig().getLargeFileSize();
+    if (threshold <= 0) {
+        return false;
+    }
+
+    const QFileInfo finfo(p_filePath);
+    if (finfo.size() < threshold) {
+        return false;
+    }
+
+    qInfo() << "open file in large file mode" << p_filePath << finfo.size();
+    return true;
+}
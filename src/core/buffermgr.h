@@ -13,6 +13,8 @@ namespace vnotex
     class IBufferFactory;
     class Node;
     class Buffer;
+    class BufferSaveQueue;
+    class BufferWatcher;
     struct FileOpenParameters;
 
     class BufferMgr : public QObject
@@ -42,10 +44,20 @@ namespace vnotex
 
         void addBuffer(Buffer *p_buffer);
 
+        // Whether @p_filePath should be opened in large file mode.
+        static bool isLargeFile(const QString &p_filePath);
+
         QSharedPointer<NameBasedServer<IBufferFactory>> m_bufferServer;
 
         // Managed by QObject.
         QVector<Buffer *> m_buffers;
+
+        // Managed by QObject.
+        BufferSaveQueue *m_saveQueue = nullptr;
+
+        // Shared watcher of the content files of all buffers.
+        // Managed by QObject.
+        BufferWatcher *m_bufferWatcher = nullptr;
     };
 } // ns vnotex
 
@@ -461,6 +461,13 @@ QString ConfigMgr::getUserSnippetFolder() const
     return folderPath;
 }
 
+QString ConfigMgr::getUserCacheFolder() const
+{
+    auto folderPath = PathUtils::concatenateFilePath(m_userConfigFolderPath, QStringLiteral("cache"));
+    QDir().mkpath(folderPath);
+    return folderPath;
+}
+
 QString ConfigMgr::getUserMarkdownUserStyleFile() const
 {
     auto folderPath = PathUtils::concatenateFilePath(m_userConfigFolderPath, QStringLiteral("web/css"));
@@ -97,6 +97,9 @@ namespace vnotex
 
         QString getUserSnippetFolder() const;
 
+        // Folder for persistent caches which could be deleted safely.
+        QString getUserCacheFolder() const;
+
         // web/css/user.css.
         QString getUserMarkdownUserStyleFile() const;
 
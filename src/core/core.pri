@@ -34,6 +34,8 @@ SOURCES += \
     $$PWD/taskmgr.cpp \
     $$PWD/taskvariablemgr.cpp \
     $$PWD/shellexecution.cpp \
+    $$PWD/networkfetcher.cpp \
+    $$PWD/diskcache.cpp \
     $$PWD/notebookmgr.cpp \
     $$PWD/theme.cpp \
     $$PWD/sessionconfig.cpp \
@@ -70,6 +72,8 @@ HEADERS += \
     $$PWD/taskmgr.h \
     $$PWD/taskvariablemgr.h \
     $$PWD/shellexecution.h \
+    $$PWD/networkfetcher.h \
+    $$PWD/diskcache.h \
     $$PWD/global.h \
     $$PWD/namebasedserver.h \
     $$PWD/exception.h \
@@ -134,6 +134,13 @@ void CoreConfig::loadNoteManagement(const QJsonObject &p_app, const QJsonObject
 
         m_externalNodeExcludePatterns = READSTRLIST(QStringLiteral("exclude_patterns"));
     }
+
+    {
+        const auto &appObj = topAppObj;
+        const auto &userObj = topUserObj;
+
+        m_watchExternalChangesEnabled = READBOOL(QStringLiteral("watch_external_changes"));
+    }
 }
 
 QJsonObject CoreConfig::saveShortcuts() const
@@ -182,6 +189,11 @@ const QStringList &CoreConfig::getExternalNodeExcludePatterns() const
     return m_externalNodeExcludePatterns;
 }
 
+bool CoreConfig::isWatchExternalChangesEnabled() const
+{
+    return m_watchExternalChangesEnabled;
+}
+
 bool CoreConfig::isRecoverLastSessionOnStartEnabled() const
 {
     return m_recoverLastSessionOnStartEnabled;
@@ -95,6 +95,8 @@ namespace vnotex
 
         const QStringList &getExternalNodeExcludePatterns() const;
 
+        bool isWatchExternalChangesEnabled() const;
+
         static const QStringList &getAvailableLocales();
 
         bool isRecoverLastSessionOnStartEnabled() const;
@@ -134,6 +136,9 @@ namespace vnotex
 
         QStringList m_externalNodeExcludePatterns;
 
+        // Whether watch notebook folders and apply external changes incrementally.
+        bool m_watchExternalChangesEnabled = true;
+
         // Whether recover last session on start.
         bool m_recoverLastSessionOnStartEnabled = true;
 
@@ -0,0 +1,191 @@
+#include "diskcache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QVector>
+#include <QDebug>
+
+#include <algorithm>
+
+using namespace vnotex;
+
+// Suffix of entry files.
+static const QString c_entrySuffix = QStringLiteral(".cache");
+
+DiskCache::DiskCache(const QString &p_folderPath, qint64 p_maxSize)
+    : m_folderPath(p_folderPath),
+      m_maxSize(p_maxSize)
+{
+}
+
+const QString &DiskCache::getFolderPath() const
+{
+    return m_folderPath;
+}
+
+void DiskCache::setMaxSize(qint64 p_maxSize)
+{
+    m_maxSize = p_maxSize;
+    if (m_loaded && m_totalSize > m_maxSize) {
+        evict(m_maxSize);
+    }
+}
+
+void DiskCache::load()
+{
+    if (m_loaded) {
+        return;
+    }
+
+    m_loaded = true;
+
+    QDir dir(m_folderPath);
+    if (!dir.exists()) {
+        dir.mkpath(m_folderPath);
+        return;
+    }
+
+    const auto infos = dir.entryInfoList(QStringList() << ("*" + c_entrySuffix), QDir::Files);
+    m_entries.reserve(infos.size());
+    for (const auto &info : infos) {
+        Entry entry;
+        entry.m_size = info.size();
+        entry.m_lastAccess = info.lastModified().toMSecsSinceEpoch();
+        m_entries.insert(info.completeBaseName().toLatin1(), entry);
+        m_totalSize += entry.m_size;
+    }
+
+    if (m_totalSize > m_maxSize) {
+        evict(m_maxSize);
+    }
+}
+
+QByteArray DiskCache::get(const QByteArray &p_key)
+{
+    load();
+
+    const auto name = entryName(p_key);
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        return QByteArray();
+    }
+
+    QFile file(entryPath(name));
+    if (!file.open(QIODevice::ReadWrite)) {
+        // Removed outside.
+        m_totalSize -= it->m_size;
+        m_entries.erase(it);
+        return QByteArray();
+    }
+
+    auto data = file.readAll();
+
+    // Keep the access time across sessions via the modification time.
+    const auto now = QDateTime::currentDateTimeUtc();
+    file.setFileTime(now, QFileDevice::FileModificationTime);
+    it->m_lastAccess = now.toMSecsSinceEpoch();
+
+    return data;
+}
+
+void DiskCache::set(const QByteArray &p_key, const QByteArray &p_data)
+{
+    load();
+
+    if (p_data.size() > m_maxSize) {
+        return;
+    }
+
+    const auto name = entryName(p_key);
+    QSaveFile file(entryPath(name));
+    if (!file.open(QIODevice::WriteOnly) || file.write(p_data) != p_data.size() || !file.commit()) {
+        qWarning() << "failed to write disk cache entry" << file.fileName() << file.errorString();
+        return;
+    }
+
+    auto &entry = m_entries[name];
+    m_totalSize += p_data.size() - entry.m_size;
+    entry.m_size = p_data.size();
+    entry.m_lastAccess = QDateTime::currentMSecsSinceEpoch();
+
+    if (m_totalSize > m_maxSize) {
+        // Leave some room to avoid evicting on every insertion.
+        evict(m_maxSize * 9 / 10);
+    }
+}
+
+void DiskCache::remove(const QByteArray &p_key)
+{
+    load();
+
+    const auto name = entryName(p_key);
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    QFile::remove(entryPath(name));
+    m_totalSize -= it->m_size;
+    m_entries.erase(it);
+}
+
+void DiskCache::clear()
+{
+    load();
+
+    for (auto it = m_entries.keyBegin(); it != m_entries.keyEnd(); ++it) {
+        QFile::remove(entryPath(*it));
+    }
+
+    m_entries.clear();
+    m_totalSize = 0;
+}
+
+int DiskCache::getCount()
+{
+    load();
+    return m_entries.size();
+}
+
+qint64 DiskCache::getTotalSize()
+{
+    load();
+    return m_totalSize;
+}
+
+void DiskCache::evict(qint64 p_targetSize)
+{
+    QVector<QPair<qint64, QByteArray>> entries;
+    entries.reserve(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        entries.push_back(qMakePair(it->m_lastAccess, it.key()));
+    }
+
+    // Oldest first.
+    std::sort(entries.begin(), entries.end());
+
+    for (const auto &entry : entries) {
+        if (m_totalSize <= p_targetSize) {
+            break;
+        }
+
+        QFile::remove(entryPath(entry.second));
+        m_totalSize -= m_entries.take(entry.second).m_size;
+    }
+
+    qDebug() << "evicted disk cache" << m_folderPath << "to" << m_totalSize << "bytes";
+}
+
+QString DiskCache::entryPath(const QByteArray &p_name) const
+{
+    return QDir(m_folderPath).filePath(QString::fromLatin1(p_name) + c_entrySuffix);
+}
+
+QByteArray DiskCache::entryName(const QByteArray &p_key)
+{
+    return QCryptographicHash::hash(p_key, QCryptographicHash::Sha1).toHex();
+}
@@ -0,0 +1,71 @@
+#ifndef DISKCACHE_H
+#define DISKCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QByteArray>
+
+#include "noncopyable.h"
+
+namespace vnotex
+{
+    // Persistent key-value cache with one file per entry in a folder.
+    // Least recently used entries are evicted once the total size exceeds the limit.
+    // Not thread-safe. Only one instance should work on one folder.
+    class DiskCache : private Noncopyable
+    {
+    public:
+        // @p_maxSize: max total size in bytes of all entries.
+        DiskCache(const QString &p_folderPath, qint64 p_maxSize);
+
+        const QString &getFolderPath() const;
+
+        void setMaxSize(qint64 p_maxSize);
+
+        // Return null if not found.
+        QByteArray get(const QByteArray &p_key);
+
+        void set(const QByteArray &p_key, const QByteArray &p_data);
+
+        void remove(const QByteArray &p_key);
+
+        // Remove all entries from disk.
+        void clear();
+
+        int getCount();
+
+        qint64 getTotalSize();
+
+    private:
+        struct Entry
+        {
+            qint64 m_size = 0;
+
+            // Msecs since epoch.
+            qint64 m_lastAccess = 0;
+        };
+
+        // Scan the folder lazily.
+        void load();
+
+        // Evict entries until under @p_targetSize.
+        void evict(qint64 p_targetSize);
+
+        QString entryPath(const QByteArray &p_name) const;
+
+        static QByteArray entryName(const QByteArray &p_key);
+
+        QString m_folderPath;
+
+        qint64 m_maxSize = 0;
+
+        bool m_loaded = false;
+
+        // Entry name -> Entry.
+        QHash<QByteArray, Entry> m_entries;
+
+        qint64 m_totalSize = 0;
+    };
+}
+
+#endif // DISKCACHE_H
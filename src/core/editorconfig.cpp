@@ -88,6 +88,11 @@ void EditorConfig::loadCore(const QJsonObject &p_app, const QJsonObject &p_user)
 
     m_backupFileExtension = READSTR(QStringLiteral("backup_file_extension"));
 
+    m_largeFileSize = READINT(QStringLiteral("large_file_size"));
+    if (m_largeFileSize < 0) {
+        m_largeFileSize = 0;
+    }
+
     loadShortcuts(appObj, userObj);
 
     m_spellCheckAutoDetectLanguageEnabled = READBOOL(QStringLiteral("spell_check_auto_detect_language"));
@@ -109,6 +114,7 @@ QJsonObject EditorConfig::saveCore() const
     obj[QStringLiteral("auto_save_policy")] = autoSavePolicyToString(m_autoSavePolicy);
     obj[QStringLiteral("backup_file_directory")] = m_backupFileDirectory;
     obj[QStringLiteral("backup_file_extension")] = m_backupFileExtension;
+    obj[QStringLiteral("large_file_size")] = m_largeFileSize;
     obj[QStringLiteral("shortcuts")] = saveShortcuts();
     obj[QStringLiteral("spell_check_auto_detect_language")] = m_spellCheckAutoDetectLanguageEnabled;
     obj[QStringLiteral("spell_check_default_dictionary")] = m_spellCheckDefaultDictionary;
@@ -285,6 +291,11 @@ const QString &EditorConfig::getBackupFileExtension() const
     return m_backupFileExtension;
 }
 
+qint64 EditorConfig::getLargeFileSize() const
+{
+    return static_cast<qint64>(m_largeFileSize) * 1024 * 1024;
+}
+
 bool EditorConfig::isSpellCheckAutoDetectLanguageEnabled() const
 {
     return m_spellCheckAutoDetectLanguageEnabled;
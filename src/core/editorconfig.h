@@ -114,6 +114,9 @@ namespace vnotex
 
         const QString &getBackupFileExtension() const;
 
+        // In bytes. 0 if large file mode is disabled.
+        qint64 getLargeFileSize() const;
+
         const QString &getShortcut(Shortcut p_shortcut) const;
 
         bool isSpellCheckAutoDetectLanguageEnabled() const;
@@ -169,6 +172,10 @@ namespace vnotex
         // Backup file extension.
         QString m_backupFileExtension;
 
+        // Files larger than this size in MiB will be opened in large file mode.
+        // 0 to disable.
+        int m_largeFileSize = 64;
+
         // Will be shared with MarkdownEditorConfig.
         QSharedPointer<TextEditorConfig> m_textEditorConfig;
 
@@ -21,6 +21,11 @@ void ExternalFile::write(const QString &p_content)
     FileUtils::writeFile(getContentPath(), p_content);
 }
 
+QString ExternalFile::getDirectWritePath() const
+{
+    return getContentPath();
+}
+
 QString ExternalFile::getName() const
 {
     return PathUtils::fileName(c_filePath);
@@ -74,6 +79,14 @@ QString ExternalFile::insertImage(const QImage &p_image, const QString &p_imageF
     return destFilePath;
 }
 
+QString ExternalFile::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    const auto imageFolderPath = fetchImageFolderPath();
+    auto destFilePath = FileUtils::renameIfExistsCaseInsensitive(PathUtils::concatenateFilePath(imageFolderPath, p_imageFileName));
+    FileUtils::writeFile(destFilePath, p_data);
+    return destFilePath;
+}
+
 void ExternalFile::removeImage(const QString &p_imagePath)
 {
     FileUtils::removeFile(p_imagePath);
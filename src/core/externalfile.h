@@ -14,6 +14,8 @@ namespace vnotex
 
         void write(const QString &p_content) Q_DECL_OVERRIDE;
 
+        QString getDirectWritePath() const Q_DECL_OVERRIDE;
+
         QString getName() const Q_DECL_OVERRIDE;
 
         QString getFilePath() const Q_DECL_OVERRIDE;
@@ -38,6 +40,8 @@ namespace vnotex
 
         QString insertImage(const QImage &p_image, const QString &p_imageFileName) Q_DECL_OVERRIDE;
 
+        QString insertImage(const QByteArray &p_data, const QString &p_imageFileName) Q_DECL_OVERRIDE;
+
         void removeImage(const QString &p_imagePath) Q_DECL_OVERRIDE;
 
     private:
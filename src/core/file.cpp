@@ -11,3 +11,12 @@ void File::setContentType(int p_type)
 {
     m_contentType = p_type;
 }
+
+QString File::getDirectWritePath() const
+{
+    return QString();
+}
+
+void File::handleDirectWritten()
+{
+}
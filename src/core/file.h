@@ -26,6 +26,9 @@ namespace vnotex
 
         virtual QString insertImage(const QImage &p_image, const QString &p_imageFileName) = 0;
 
+        // Insert image from raw data @p_data.
+        virtual QString insertImage(const QByteArray &p_data, const QString &p_imageFileName) = 0;
+
         virtual void removeImage(const QString &p_imagePath) = 0;
     };
 
@@ -41,6 +44,14 @@ namespace vnotex
 
         virtual void write(const QString &p_content) = 0;
 
+        // Local file the content could be written to directly instead of write(),
+        // which allows writing it in background.
+        // Return empty if content could only be written by write().
+        virtual QString getDirectWritePath() const;
+
+        // Called after content is written to getDirectWritePath() directly.
+        virtual void handleDirectWritten();
+
         virtual QString getName() const = 0;
 
         virtual QString getFilePath() const = 0;
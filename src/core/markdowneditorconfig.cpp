@@ -39,6 +39,10 @@ void MarkdownEditorConfig::init(const QJsonObject &p_app, const QJsonObject &p_u
 
     m_graphvizExe = READSTR(QStringLiteral("graphviz_exe"));
 
+    m_graphRendererProcesses = READINT(QStringLiteral("graph_renderer_processes"));
+    m_graphDiskCacheSize = READINT(QStringLiteral("graph_disk_cache_size"));
+    m_inplacePreviewCacheSize = READINT(QStringLiteral("inplace_preview_cache_size"));
+
     m_prependDotInRelativeLink = READBOOL(QStringLiteral("prepend_dot_in_relative_link"));
     m_confirmBeforeClearObsoleteImages = READBOOL(QStringLiteral("confirm_before_clear_obsolete_images"));
     m_insertFileNameAsTitle = READBOOL(QStringLiteral("insert_file_name_as_title"));
@@ -87,6 +91,9 @@ QJsonObject MarkdownEditorConfig::toJson() const
     obj[QStringLiteral("plantuml_command")] = m_plantUmlCommand;
     obj[QStringLiteral("web_graphviz")] = m_webGraphviz;
     obj[QStringLiteral("graphviz_exe")] = m_graphvizExe;
+    obj[QStringLiteral("graph_renderer_processes")] = m_graphRendererProcesses;
+    obj[QStringLiteral("graph_disk_cache_size")] = m_graphDiskCacheSize;
+    obj[QStringLiteral("inplace_preview_cache_size")] = m_inplacePreviewCacheSize;
     obj[QStringLiteral("prepend_dot_in_relative_link")] = m_prependDotInRelativeLink;
     obj[QStringLiteral("confirm_before_clear_obsolete_images")] = m_confirmBeforeClearObsoleteImages;
     obj[QStringLiteral("insert_file_name_as_title")] = m_insertFileNameAsTitle;
@@ -249,6 +256,21 @@ void MarkdownEditorConfig::setGraphvizExe(const QString &p_exe)
     updateConfig(m_graphvizExe, p_exe, this);
 }
 
+int MarkdownEditorConfig::getGraphRendererProcesses() const
+{
+    return m_graphRendererProcesses;
+}
+
+int MarkdownEditorConfig::getGraphDiskCacheSize() const
+{
+    return m_graphDiskCacheSize;
+}
+
+int MarkdownEditorConfig::getInplacePreviewCacheSize() const
+{
+    return m_inplacePreviewCacheSize;
+}
+
 bool MarkdownEditorConfig::getPrependDotInRelativeLink() const
 {
     return m_prependDotInRelativeLink;
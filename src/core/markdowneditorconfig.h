@@ -76,6 +76,12 @@ namespace vnotex
         const QString &getGraphvizExe() const;
         void setGraphvizExe(const QString &p_exe);
 
+        int getGraphRendererProcesses() const;
+
+        int getGraphDiskCacheSize() const;
+
+        int getInplacePreviewCacheSize() const;
+
         bool getPrependDotInRelativeLink() const;
 
         bool getConfirmBeforeClearObsoleteImages() const;
@@ -181,6 +187,16 @@ namespace vnotex
         // Graphviz executable file.
         QString m_graphvizExe;
 
+        // Max number of concurrent processes to render PlantUml and Graphviz locally.
+        // 0 to decide by the number of CPU cores.
+        int m_graphRendererProcesses = 0;
+
+        // Max size in MiB of the on-disk cache of local rendering results.
+        int m_graphDiskCacheSize = 64;
+
+        // Max size in MiB of the in-memory cache of in-place preview images of all editors.
+        int m_inplacePreviewCacheSize = 128;
+
         // Whether prepend a dot in front of the relative link, like images.
         bool m_prependDotInRelativeLink = false;
 
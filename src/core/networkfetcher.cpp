@@ -0,0 +1,186 @@
+#include "networkfetcher.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QDebug>
+
+using namespace vnotex;
+
+static const char *c_timedOutProperty = "NetworkFetcherTimedOut";
+
+NetworkFetcher::NetworkFetcher(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_netMgr = new QNetworkAccessManager(this);
+}
+
+NetworkFetcher::~NetworkFetcher()
+{
+    // Do not let replies call back during destruction.
+    for (auto it = m_runningRequests.keyBegin(); it != m_runningRequests.keyEnd(); ++it) {
+        (*it)->disconnect(this);
+        (*it)->abort();
+    }
+}
+
+void NetworkFetcher::setMaxConnections(int p_max)
+{
+    m_maxConnections = qMax(1, p_max);
+}
+
+void NetworkFetcher::setMaxConnectionsPerHost(int p_max)
+{
+    m_maxConnectionsPerHost = qMax(1, p_max);
+}
+
+void NetworkFetcher::setTimeout(int p_timeout)
+{
+    m_timeout = p_timeout;
+}
+
+int NetworkFetcher::addUrl(const QUrl &p_url)
+{
+    Q_ASSERT(!m_started);
+    Result res;
+    res.m_url = p_url;
+    m_results.push_back(res);
+    m_pendingRequests.push_back(m_results.size() - 1);
+    return m_results.size() - 1;
+}
+
+void NetworkFetcher::start()
+{
+    Q_ASSERT(!m_started);
+    m_started = true;
+    schedule();
+    checkFinished();
+}
+
+void NetworkFetcher::abort()
+{
+    if (!m_started || m_finished) {
+        return;
+    }
+
+    for (int idx : m_pendingRequests) {
+        m_results[idx].m_errorString = tr("Aborted");
+        ++m_finishedCount;
+    }
+    m_pendingRequests.clear();
+
+    for (auto it = m_runningRequests.constBegin(); it != m_runningRequests.constEnd(); ++it) {
+        auto reply = it.key();
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+
+        m_results[it.value()].m_errorString = tr("Aborted");
+        ++m_finishedCount;
+    }
+    m_runningRequests.clear();
+    m_hostConnections.clear();
+
+    checkFinished();
+}
+
+bool NetworkFetcher::isFinished() const
+{
+    return m_finished;
+}
+
+int NetworkFetcher::getFinishedCount() const
+{
+    return m_finishedCount;
+}
+
+const QVector<NetworkFetcher::Result> &NetworkFetcher::getResults() const
+{
+    return m_results;
+}
+
+QString NetworkFetcher::hostKey(const QUrl &p_url)
+{
+    return p_url.host().toLower() + QLatin1Char(':') + QString::number(p_url.port(-1));
+}
+
+void NetworkFetcher::schedule()
+{
+    for (int i = 0; i < m_pendingRequests.size() && m_runningRequests.size() < m_maxConnections;) {
+        const int idx = m_pendingRequests[i];
+        if (m_hostConnections.value(hostKey(m_results[idx].m_url), 0) >= m_maxConnectionsPerHost) {
+            // Leave it to the next schedule.
+            ++i;
+            continue;
+        }
+
+        m_pendingRequests.remove(i);
+        startRequest(idx);
+    }
+}
+
+void NetworkFetcher::startRequest(int p_idx)
+{
+    const auto &url = m_results[p_idx].m_url;
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+
+    auto reply = m_netMgr->get(request);
+    m_runningRequests.insert(reply, p_idx);
+    ++m_hostConnections[hostKey(url)];
+
+    connect(reply, &QNetworkReply::finished,
+            this, [this, reply, p_idx]() {
+                handleReplyFinished(reply, p_idx);
+            });
+
+    if (m_timeout > 0) {
+        // The timer is gone with the reply.
+        QTimer::singleShot(m_timeout, reply, [reply]() {
+            reply->setProperty(c_timedOutProperty, true);
+            reply->abort();
+        });
+    }
+}
+
+void NetworkFetcher::handleReplyFinished(QNetworkReply *p_reply, int p_idx)
+{
+    m_runningRequests.remove(p_reply);
+
+    auto &res = m_results[p_idx];
+    auto &conns = m_hostConnections[hostKey(res.m_url)];
+    if (--conns <= 0) {
+        m_hostConnections.remove(hostKey(res.m_url));
+    }
+
+    if (p_reply->error() == QNetworkReply::NoError) {
+        res.m_data = p_reply->readAll();
+    } else if (p_reply->property(c_timedOutProperty).toBool()) {
+        res.m_errorString = tr("Timed out after %1 ms").arg(m_timeout);
+    } else {
+        res.m_errorString = p_reply->errorString();
+    }
+
+    if (!res.m_errorString.isEmpty()) {
+        qWarning() << "failed to fetch" << res.m_url << res.m_errorString;
+    }
+
+    p_reply->deleteLater();
+
+    ++m_finishedCount;
+    emit fetched(p_idx);
+
+    schedule();
+    checkFinished();
+}
+
+void NetworkFetcher::checkFinished()
+{
+    if (m_finished || !m_pendingRequests.isEmpty() || !m_runningRequests.isEmpty()) {
+        return;
+    }
+
+    m_finished = true;
+    emit finished();
+}
@@ -0,0 +1,99 @@
+#ifndef NETWORKFETCHER_H
+#define NETWORKFETCHER_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace vnotex
+{
+    // Fetch a batch of URLs asynchronously with bounded concurrency.
+    // Requests are started in the order added, limited by total and per-host connections.
+    class NetworkFetcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        struct Result
+        {
+            QUrl m_url;
+
+            QByteArray m_data;
+
+            // Empty if succeeded.
+            QString m_errorString;
+        };
+
+        explicit NetworkFetcher(QObject *p_parent = nullptr);
+
+        ~NetworkFetcher();
+
+        void setMaxConnections(int p_max);
+
+        void setMaxConnectionsPerHost(int p_max);
+
+        // Timeout in milliseconds of each request, counted from the start of it.
+        void setTimeout(int p_timeout);
+
+        // Return the index of the request.
+        int addUrl(const QUrl &p_url);
+
+        void start();
+
+        // Abort all pending and running requests. finished() will be emitted before return.
+        void abort();
+
+        bool isFinished() const;
+
+        int getFinishedCount() const;
+
+        const QVector<Result> &getResults() const;
+
+    signals:
+        // Request @p_idx finished, succeeded or not.
+        void fetched(int p_idx);
+
+        void finished();
+
+    private:
+        void schedule();
+
+        void startRequest(int p_idx);
+
+        void handleReplyFinished(QNetworkReply *p_reply, int p_idx);
+
+        void checkFinished();
+
+        static QString hostKey(const QUrl &p_url);
+
+        // Managed by QObject.
+        QNetworkAccessManager *m_netMgr = nullptr;
+
+        int m_maxConnections = 8;
+
+        int m_maxConnectionsPerHost = 4;
+
+        int m_timeout = 30 * 1000;
+
+        QVector<Result> m_results;
+
+        // Indices of requests not started yet.
+        QVector<int> m_pendingRequests;
+
+        QHash<QNetworkReply *, int> m_runningRequests;
+
+        // Host -> number of running requests.
+        QHash<QString, int> m_hostConnections;
+
+        int m_finishedCount = 0;
+
+        bool m_started = false;
+
+        bool m_finished = false;
+    };
+}
+
+#endif // NETWORKFETCHER_H
@@ -8,10 +8,13 @@
 #include <utils/fileutils.h>
 #include <core/historymgr.h>
 #include <core/exception.h>
+#include <core/configmgr.h>
+#include <core/coreconfig.h>
 #include <notebookbackend/inotebookbackend.h>
 
 #include "notebookdatabaseaccess.h"
 #include "notebooktagmgr.h"
+#include "notebookwatcher.h"
 
 using namespace vnotex;
 
@@ -50,6 +53,11 @@ void BundleNotebook::initializeInternal()
     if (m_configVersion != getConfigMgr()->getCodeVersion()) {
         updateNotebookConfig();
     }
+
+    if (ConfigMgr::getInst().getCoreConfig().isWatchExternalChangesEnabled()) {
+        m_watcher = new NotebookWatcher(this, this);
+        m_watcher->start();
+    }
 }
 
 void BundleNotebook::initDatabase()
@@ -11,6 +11,7 @@ namespace vnotex
     class NotebookConfig;
     class NotebookDatabaseAccess;
     class NotebookTagMgr;
+    class NotebookWatcher;
 
     class BundleNotebook : public Notebook,
                            public HistoryI
@@ -84,6 +85,9 @@ namespace vnotex
 
         // Managed by QObject.
         NotebookTagMgr *m_tagMgr = nullptr;
+
+        // Managed by QObject.
+        NotebookWatcher *m_watcher = nullptr;
     };
 } // ns vnotex
 
@@ -1,6 +1,7 @@
 #include "node.h"
 
 #include <QDir>
+#include <QHash>
 
 #include <notebookconfigmgr/inotebookconfigmgr.h>
 #include <notebookbackend/inotebookbackend.h>
@@ -11,6 +12,8 @@
 
 using namespace vnotex;
 
+bool Node::s_tagInterningEnabled = true;
+
 Node::Node(Flags p_flags,
            const QString &p_name,
            const NodeParameters &p_paras,
@@ -24,12 +27,13 @@ Node::Node(Flags p_flags,
       m_name(p_name),
       m_createdTimeUtc(p_paras.m_createdTimeUtc),
       m_modifiedTimeUtc(p_paras.m_modifiedTimeUtc),
-      m_tags(p_paras.m_tags),
       m_attachmentFolder(p_paras.m_attachmentFolder),
       m_parent(p_parent)
 {
     Q_ASSERT(m_notebook);
 
+    assignTags(p_paras.m_tags);
+
     checkSignature();
 }
 
@@ -47,6 +51,9 @@ Node::Node(Flags p_flags,
 
 Node::~Node()
 {
+    if (m_tagsInterned) {
+        releaseTags(m_tags);
+    }
 }
 
 bool Node::isLoaded() const
@@ -201,6 +208,11 @@ void Node::setModifiedTimeUtc()
     m_modifiedTimeUtc = QDateTime::currentDateTimeUtc();
 }
 
+void Node::setModifiedTimeUtc(const QDateTime &p_time)
+{
+    m_modifiedTimeUtc = p_time;
+}
+
 const QVector<QSharedPointer<Node>> &Node::getChildrenRef() const
 {
     return m_children;
@@ -263,13 +275,18 @@ const QStringList &Node::getTags() const
     return m_tags;
 }
 
+void Node::setTags(const QStringList &p_tags)
+{
+    assignTags(p_tags);
+}
+
 void Node::updateTags(const QStringList &p_tags)
 {
     if (p_tags == m_tags) {
         return;
     }
 
-    m_tags = p_tags;
+    assignTags(p_tags);
     save();
     emit m_notebook->nodeUpdated(this);
 }
@@ -323,6 +340,9 @@ void Node::load()
     }
 
     getConfigMgr()->loadNode(this);
+    if (isLoaded()) {
+        emit m_notebook->nodeLoaded(this);
+    }
 }
 
 void Node::save()
@@ -492,3 +512,65 @@ void Node::checkSignature()
         m_signature = generateSignature();
     }
 }
+
+// Interned tag -> number of references from nodes.
+// Nodes are accessed in main thread only.
+static QHash<QString, int> &tagPool()
+{
+    static QHash<QString, int> pool;
+    return pool;
+}
+
+QStringList Node::internTags(const QStringList &p_tags)
+{
+    auto &pool = tagPool();
+
+    QStringList tags;
+    tags.reserve(p_tags.size());
+    for (const auto &tag : p_tags) {
+        auto it = pool.find(tag);
+        if (it == pool.end()) {
+            it = pool.insert(tag, 0);
+        }
+        ++it.value();
+        tags << it.key();
+    }
+
+    return tags;
+}
+
+void Node::releaseTags(const QStringList &p_tags)
+{
+    auto &pool = tagPool();
+    for (const auto &tag : p_tags) {
+        auto it = pool.find(tag);
+        Q_ASSERT(it != pool.end() && it.value() > 0);
+        if (it != pool.end() && --it.value() == 0) {
+            pool.erase(it);
+        }
+    }
+}
+
+void Node::assignTags(const QStringList &p_tags)
+{
+    // Intern before releasing so that unchanged tags stay in the pool.
+    const bool interned = s_tagInterningEnabled && !p_tags.isEmpty();
+    const auto tags = interned ? internTags(p_tags) : p_tags;
+
+    if (m_tagsInterned) {
+        releaseTags(m_tags);
+    }
+
+    m_tags = tags;
+    m_tagsInterned = interned;
+}
+
+int Node::getInternedTagCount()
+{
+    return tagPool().size();
+}
+
+void Node::setTagInterningEnabled(bool p_enabled)
+{
+    s_tagInterningEnabled = p_enabled;
+}
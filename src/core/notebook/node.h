@@ -97,6 +97,7 @@ namespace vnotex
 
         const QDateTime &getModifiedTimeUtc() const;
         void setModifiedTimeUtc();
+        void setModifiedTimeUtc(const QDateTime &p_time);
 
         const QVector<QSharedPointer<Node>> &getChildrenRef() const;
         QVector<QSharedPointer<Node>> getChildren() const;
@@ -133,6 +134,7 @@ namespace vnotex
         virtual void save();
 
         const QStringList &getTags() const;
+        void setTags(const QStringList &p_tags);
         void updateTags(const QStringList &p_tags);
 
         const QString &getAttachmentFolder() const;
@@ -176,6 +178,13 @@ namespace vnotex
 
         static ID generateSignature();
 
+        // Whether share the same string data among identical tags of all nodes.
+        // Used for UT and benchmark.
+        static void setTagInterningEnabled(bool p_enabled);
+
+        // Number of distinct tags referred by nodes. Used for UT.
+        static int getInternedTagCount();
+
     protected:
         Notebook *m_notebook = nullptr;
 
@@ -184,10 +193,24 @@ namespace vnotex
     private:
         void checkSignature();
 
+        // Return tags sharing the string data of the tag pool and add references to them.
+        static QStringList internTags(const QStringList &p_tags);
+
+        // Drop references to interned @p_tags. Tags without references are removed from the pool.
+        static void releaseTags(const QStringList &p_tags);
+
+        // Set m_tags and update the references in the tag pool.
+        void assignTags(const QStringList &p_tags);
+
+        static bool s_tagInterningEnabled;
+
         Flags m_flags = Flag::None;
 
         Use m_use = Use::Normal;
 
+        // Whether m_tags holds references in the tag pool.
+        bool m_tagsInterned = false;
+
         ID m_id = InvalidId;
 
         // A long random number created when the node is created.
@@ -200,6 +223,7 @@ namespace vnotex
 
         QDateTime m_modifiedTimeUtc;
 
+        // Interned if m_tagsInterned.
         QStringList m_tags;
 
         QString m_attachmentFolder;
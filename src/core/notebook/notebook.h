@@ -160,8 +160,29 @@ namespace vnotex
 
         void nodeUpdated(const Node *p_node);
 
+        // Children of @p_node are changed outside (such as external edits on disk).
+        void nodeChildrenUpdated(Node *p_node);
+
+        // @p_node is loaded lazily from config.
+        void nodeLoaded(Node *p_node);
+
+        // Folder @p_node and its subtree are renamed or moved from @p_oldPath in place.
+        void nodePathChanged(Node *p_node, const QString &p_oldPath);
+
+        // The whole tag graph is reloaded.
         void tagsUpdated();
 
+        void tagAdded(const QString &p_name, const QString &p_parentName);
+
+        void tagRenamed(const QString &p_name, const QString &p_newName);
+
+        void tagMoved(const QString &p_name, const QString &p_newParentName);
+
+        // @p_name and all its descendants are removed.
+        void tagRemoved(const QString &p_name);
+
+        void nodeTagsUpdated(const Node *p_node);
+
     protected:
         virtual void initializeInternal() = 0;
 
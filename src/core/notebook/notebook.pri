@@ -8,6 +8,7 @@ SOURCES += \
     $$PWD/bundlenotebook.cpp \
     $$PWD/node.cpp \
     $$PWD/notebooktagmgr.cpp \
+    $$PWD/notebookwatcher.cpp \
     $$PWD/tag.cpp \
     $$PWD/vxnode.cpp \
     $$PWD/vxnodefile.cpp
@@ -24,6 +25,7 @@ HEADERS += \
     $$PWD/bundlenotebook.h \
     $$PWD/node.h \
     $$PWD/notebooktagmgr.h \
+    $$PWD/notebookwatcher.h \
     $$PWD/tag.h \
     $$PWD/tagi.h \
     $$PWD/vxnode.h \
@@ -104,6 +104,19 @@ void NotebookDatabaseAccess::setupTables(QSqlDatabase &p_db, int p_configVersion
             return;
         }
     }
+
+    // Indices for tag queries. Also added to existing databases.
+    {
+        bool ret = query.exec(QString("CREATE INDEX IF NOT EXISTS %1_tag_name_index ON %1 (tag_name, node_id)").arg(c_nodeTagTableName));
+        if (!ret) {
+            qWarning() << QString("failed to create database index (%1) (%2)").arg(c_nodeTagTableName, query.lastError().text());
+        }
+
+        ret = query.exec(QString("CREATE INDEX IF NOT EXISTS %1_parent_name_index ON %1 (parent_name)").arg(c_tagTableName));
+        if (!ret) {
+            qWarning() << QString("failed to create database index (%1) (%2)").arg(c_tagTableName, query.lastError().text());
+        }
+    }
 }
 
 void NotebookDatabaseAccess::initialize(int p_configVersion)
@@ -730,19 +743,46 @@ QStringList NotebookDatabaseAccess::getNodesOfTags(const QStringList &p_tags)
         return ret;
     }
 
-    QList<ID> nodeIds;
+    const auto tags = QSet<QString>::fromList(p_tags).toList();
 
-    if (p_tags.size() == 1) {
-        nodeIds = queryTagNodesRecursive(p_tags.first());
-    } else {
-        QSet<ID> allIds;
-        for (const auto &tag : p_tags) {
-            auto ids = queryTagNodesRecursive(tag);
-            for (const auto &id : ids) {
-                allIds.insert(id);
-            }
-        }
-        nodeIds = allIds.toList();
+    QStringList placeholders;
+    for (int i = 0; i < tags.size(); ++i) {
+        placeholders << QStringLiteral("?");
+    }
+
+    // Expand each queried tag to itself and its descendants, keeping the queried one as root,
+    // then keep the nodes hit by all the roots.
+    auto db = getDatabase();
+    QSqlQuery query(db);
+    query.prepare(QString("WITH RECURSIVE cte_tags(root, name) AS (\n"
+                          "    SELECT tag.name, tag.name\n"
+                          "    FROM %1 tag\n"
+                          "    WHERE tag.name IN (%3)\n"
+                          "    UNION\n"
+                          "    SELECT cte.root, tag.name\n"
+                          "    FROM %1 tag\n"
+                          "    JOIN cte_tags cte ON tag.parent_name = cte.name\n"
+                          "    LIMIT 50000)\n"
+                          "SELECT tn.node_id\n"
+                          "FROM %2 tn\n"
+                          "JOIN cte_tags cte ON tn.tag_name = cte.name\n"
+                          "GROUP BY tn.node_id\n"
+                          "HAVING COUNT(DISTINCT cte.root) = ?").arg(c_tagTableName,
+                                                                     c_nodeTagTableName,
+                                                                     placeholders.join(QStringLiteral(", "))));
+    for (const auto &tag : tags) {
+        query.addBindValue(tag);
+    }
+    query.addBindValue(tags.size());
+
+    if (!query.exec()) {
+        qWarning() << "failed to query nodes of tags" << query.executedQuery() << query.lastError().text();
+        return ret;
+    }
+
+    QList<ID> nodeIds;
+    while (query.next()) {
+        nodeIds.append(query.value(0).toULongLong());
     }
 
     for (const auto &id : nodeIds) {
@@ -80,7 +80,8 @@ namespace vnotex
     public:
         bool updateNodeTags(Node *p_node);
 
-        // Return the relative path of nodes of tags @p_tags.
+        // Return the relative path of nodes having all the tags @p_tags.
+        // A node has a tag if it has the tag or any of its descendants.
         QStringList getNodesOfTags(const QStringList &p_tags);
 
     private:
@@ -1,7 +1,7 @@
 #include "notebooktagmgr.h"
 
 #include <QDebug>
-#include <QHash>
+#include <QSet>
 
 #include "bundlenotebook.h"
 #include "tag.h"
@@ -71,8 +71,7 @@ void NotebookTagMgr::update()
 void NotebookTagMgr::update(const QList<NotebookDatabaseAccess::TagRecord> &p_allTags)
 {
     m_topLevelTags.clear();
-
-    QHash<QString, Tag *> nameToTag;
+    m_tags.clear();
 
     QVector<int> todoIdx;
     todoIdx.reserve(p_allTags.size());
@@ -86,15 +85,15 @@ void NotebookTagMgr::update(const QList<NotebookDatabaseAccess::TagRecord> &p_al
 
         for (int i = 0; i < todoIdx.size(); ++i) {
             const auto &rec = p_allTags[todoIdx[i]];
-            Q_ASSERT(!nameToTag.contains(rec.m_name));
+            Q_ASSERT(!m_tags.contains(rec.m_name));
             QSharedPointer<Tag> newTag;
             if (rec.m_parentName.isEmpty()) {
                 // Top level.
                 newTag = QSharedPointer<Tag>::create(rec.m_name);
                 m_topLevelTags.push_back(newTag);
             } else {
-                auto parentIt = nameToTag.find(rec.m_parentName);
-                if (parentIt == nameToTag.end()) {
+                auto parentIt = m_tags.find(rec.m_parentName);
+                if (parentIt == m_tags.end()) {
                     // Need to process its parent first.
                     pendingIdx.push_back(todoIdx[i]);
                     continue;
@@ -104,7 +103,7 @@ void NotebookTagMgr::update(const QList<NotebookDatabaseAccess::TagRecord> &p_al
                 }
             }
 
-            nameToTag.insert(newTag->name(), newTag.data());
+            m_tags.insert(newTag->name(), newTag);
         }
 
         if (todoIdx.size() == pendingIdx.size()) {
@@ -124,16 +123,7 @@ QStringList NotebookTagMgr::findNodesOfTag(const QString &p_name)
 
 QSharedPointer<Tag> NotebookTagMgr::findTag(const QString &p_name)
 {
-    QSharedPointer<Tag> tag;
-    forEachTag([&tag, p_name](const QSharedPointer<Tag> &p_tag) {
-                if (p_tag->name() == p_name) {
-                    tag = p_tag;
-                    return false;
-                }
-                return true;
-            });
-
-    return tag;
+    return m_tags.value(p_name);
 }
 
 void NotebookTagMgr::forEachTag(const TagFinder &p_func) const
@@ -160,21 +150,70 @@ bool NotebookTagMgr::forEachTag(const QSharedPointer<Tag> &p_tag, const TagFinde
     return true;
 }
 
+void NotebookTagMgr::attachTag(const QSharedPointer<Tag> &p_tag, Tag *p_parent)
+{
+    Q_ASSERT(!p_tag->getParent());
+    if (p_parent) {
+        p_parent->addChild(p_tag);
+    } else {
+        Tag::insertSorted(m_topLevelTags, p_tag);
+    }
+}
+
+void NotebookTagMgr::detachTag(const QSharedPointer<Tag> &p_tag)
+{
+    if (auto parent = p_tag->getParent()) {
+        parent->removeChild(p_tag.data());
+    } else {
+        Tag::remove(m_topLevelTags, p_tag.data());
+    }
+}
+
+bool NotebookTagMgr::isAncestorOrSelf(const Tag *p_tag, const Tag *p_other)
+{
+    for (auto tag = p_other; tag; tag = tag->getParent()) {
+        if (tag == p_tag) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool NotebookTagMgr::newTag(const QString &p_name, const QString &p_parentName)
 {
     if (p_name.isEmpty()) {
         return false;
     }
 
+    auto tag = findTag(p_name);
+    if (tag) {
+        // Same as DB, adding an existing tag means moving it.
+        const auto parentName = tag->getParent() ? tag->getParent()->name() : QString();
+        if (parentName == p_parentName) {
+            return true;
+        }
+
+        return moveTag(p_name, p_parentName);
+    }
+
+    auto parentTag = findTag(p_parentName);
+    if (!p_parentName.isEmpty() && !parentTag) {
+        qWarning() << "failed to new tag with non-existing parent" << p_name << p_parentName;
+        return false;
+    }
+
     auto db = m_notebook->getDatabaseAccess();
     bool ret = db->addTag(p_name, p_parentName);
     if (ret) {
-        const auto allTags = db->getAllTags();
-        update(allTags);
-        if (!p_parentName.isEmpty()) {
-            updateNotebookTagGraph(allTags);
+        tag = QSharedPointer<Tag>::create(p_name);
+        m_tags.insert(p_name, tag);
+        attachTag(tag, parentTag.data());
+
+        if (parentTag) {
+            updateNotebookTagGraph();
         }
-        emit m_notebook->tagsUpdated();
+        emit m_notebook->tagAdded(p_name, p_parentName);
         return true;
     } else {
         qWarning() << "failed to new tag" << p_name << p_parentName;
@@ -193,8 +232,19 @@ bool NotebookTagMgr::updateNodeTags(Node *p_node)
     }
 
     if (db->updateNodeTags(p_node)) {
-        update();
-        emit m_notebook->tagsUpdated();
+        // DB adds missing tags as top level ones.
+        for (const auto &name : p_node->getTags()) {
+            if (m_tags.contains(name)) {
+                continue;
+            }
+
+            auto tag = QSharedPointer<Tag>::create(name);
+            m_tags.insert(name, tag);
+            attachTag(tag, nullptr);
+            emit m_notebook->tagAdded(name, QString());
+        }
+
+        emit m_notebook->nodeTagsUpdated(p_node);
         return true;
     }
 
@@ -209,6 +259,16 @@ bool NotebookTagMgr::updateNodeTags(Node *p_node, const QStringList &p_newTags)
 
 bool NotebookTagMgr::renameTag(const QString &p_name, const QString &p_newName)
 {
+    if (p_name == p_newName) {
+        return true;
+    }
+
+    auto tag = findTag(p_name);
+    if (!tag || m_tags.contains(p_newName)) {
+        qWarning() << "failed to rename tag" << p_name << p_newName;
+        return false;
+    }
+
     const auto nodePaths = findNodesOfTag(p_name);
 
     auto db = m_notebook->getDatabaseAccess();
@@ -216,10 +276,17 @@ bool NotebookTagMgr::renameTag(const QString &p_name, const QString &p_newName)
         return false;
     }
 
-    const auto allTags = db->getAllTags();
-    update(allTags);
+    // Re-insert to keep siblings sorted.
+    auto parent = tag->getParent();
+    detachTag(tag);
+    m_tags.remove(p_name);
+    tag->setName(p_newName);
+    m_tags.insert(p_newName, tag);
+    attachTag(tag, parent);
 
-    updateNotebookTagGraph(allTags);
+    if (parent || !tag->getChildren().isEmpty()) {
+        updateNotebookTagGraph();
+    }
 
     // Update node tag.
     for (const auto &pa : nodePaths) {
@@ -230,57 +297,66 @@ bool NotebookTagMgr::renameTag(const QString &p_name, const QString &p_newName)
         }
 
         auto tags = node->getTags();
-        for (auto &tag : tags) {
-            if (tag == p_name) {
-                tag = p_newName;
+        for (auto &nodeTag : tags) {
+            if (nodeTag == p_name) {
+                nodeTag = p_newName;
                 break;
             }
         }
         node->updateTags(tags);
     }
 
-    emit m_notebook->tagsUpdated();
+    emit m_notebook->tagRenamed(p_name, p_newName);
     return true;
 }
 
-void NotebookTagMgr::updateNotebookTagGraph(const QList<NotebookDatabaseAccess::TagRecord> &p_allTags)
+void NotebookTagMgr::updateNotebookTagGraph()
 {
     QVector<TagGraphPair> graph;
-    graph.reserve(p_allTags.size());
-    for (const auto &tag : p_allTags) {
-        if (tag.m_parentName.isEmpty()) {
-            continue;
-        }
-        TagGraphPair pa;
-        pa.m_parent = tag.m_parentName;
-        pa.m_child = tag.m_name;
-        graph.push_back(pa);
-    }
+    graph.reserve(m_tags.size());
+    forEachTag([&graph](const QSharedPointer<Tag> &p_tag) {
+                if (p_tag->getParent()) {
+                    TagGraphPair pa;
+                    pa.m_parent = p_tag->getParent()->name();
+                    pa.m_child = p_tag->name();
+                    graph.push_back(pa);
+                }
+                return true;
+            });
     m_notebook->updateTagGraph(tagGraphToString(graph));
 }
 
 bool NotebookTagMgr::removeTag(const QString &p_name)
 {
+    auto tag = findTag(p_name);
+    if (!tag) {
+        qWarning() << "failed to remove non-existing tag" << p_name;
+        return false;
+    }
+
     const auto nodePaths = findNodesOfTag(p_name);
 
     auto db = m_notebook->getDatabaseAccess();
-    QStringList tagsAndChildren;
-    if (!nodePaths.isEmpty()) {
-        tagsAndChildren = db->queryTagAndChildren(p_name);
-        if (tagsAndChildren.isEmpty()) {
-            qWarning() << "failed to query tag and its children" << p_name;
-            return false;
-        }
-    }
+    QSet<QString> tagsAndChildren;
+    forEachTag(tag, [&tagsAndChildren](const QSharedPointer<Tag> &p_tag) {
+                tagsAndChildren.insert(p_tag->name());
+                return true;
+            });
 
     if (!db->removeTag(p_name)) {
         return false;
     }
 
-    const auto allTags = db->getAllTags();
-    update(allTags);
+    // Children are removed by DB cascade.
+    const bool hasGraph = tag->getParent() || !tag->getChildren().isEmpty();
+    detachTag(tag);
+    for (const auto &name : tagsAndChildren) {
+        m_tags.remove(name);
+    }
 
-    updateNotebookTagGraph(allTags);
+    if (hasGraph) {
+        updateNotebookTagGraph();
+    }
 
     // Update node tag.
     for (const auto &pa : nodePaths) {
@@ -292,31 +368,47 @@ bool NotebookTagMgr::removeTag(const QString &p_name)
 
         const auto &tags = node->getTags();
         QStringList newTags;
-        for (const auto &tag : tags) {
-            if (tagsAndChildren.contains(tag)) {
+        for (const auto &nodeTag : tags) {
+            if (tagsAndChildren.contains(nodeTag)) {
                 continue;
             }
-            newTags.append(tag);
+            newTags.append(nodeTag);
         }
         node->updateTags(newTags);
     }
 
-    emit m_notebook->tagsUpdated();
+    emit m_notebook->tagRemoved(p_name);
     return true;
 }
 
 bool NotebookTagMgr::moveTag(const QString &p_name, const QString &p_newParentName)
 {
+    auto tag = findTag(p_name);
+    auto newParent = findTag(p_newParentName);
+    if (!tag || (!p_newParentName.isEmpty() && !newParent)) {
+        qWarning() << "failed to move tag" << p_name << p_newParentName;
+        return false;
+    }
+
+    if (newParent && isAncestorOrSelf(tag.data(), newParent.data())) {
+        qWarning() << "failed to move tag under itself or its descendant" << p_name << p_newParentName;
+        return false;
+    }
+
+    if (tag->getParent() == newParent.data()) {
+        return true;
+    }
+
     auto db = m_notebook->getDatabaseAccess();
     if (!db->addTag(p_name, p_newParentName)) {
         return false;
     }
 
-    const auto allTags = db->getAllTags();
-    update(allTags);
+    detachTag(tag);
+    attachTag(tag, newParent.data());
 
-    updateNotebookTagGraph(allTags);
+    updateNotebookTagGraph();
 
-    emit m_notebook->tagsUpdated();
+    emit m_notebook->tagMoved(p_name, p_newParentName);
     return true;
 }
@@ -8,6 +8,7 @@
 #include <functional>
 
 #include <QVector>
+#include <QHash>
 #include <QSharedPointer>
 
 #include "notebookdatabaseaccess.h"
@@ -30,6 +31,7 @@ namespace vnotex
 
         explicit NotebookTagMgr(BundleNotebook *p_notebook);
 
+        // Reload the whole tag graph from DB.
         void update();
 
         static QVector<TagGraphPair> stringToTagGraph(const QString &p_text);
@@ -67,11 +69,23 @@ namespace vnotex
 
         void update(const QList<NotebookDatabaseAccess::TagRecord> &p_allTags);
 
-        void updateNotebookTagGraph(const QList<NotebookDatabaseAccess::TagRecord> &p_allTags);
+        // Write the in-memory tag graph to notebook config.
+        void updateNotebookTagGraph();
+
+        // Insert @p_tag under @p_parent or as a top level tag if @p_parent is null.
+        void attachTag(const QSharedPointer<Tag> &p_tag, Tag *p_parent);
+
+        void detachTag(const QSharedPointer<Tag> &p_tag);
+
+        // Whether @p_tag is @p_other or one of its ancestors.
+        static bool isAncestorOrSelf(const Tag *p_tag, const Tag *p_other);
 
         BundleNotebook *m_notebook = nullptr;
 
         QVector<QSharedPointer<Tag>> m_topLevelTags;
+
+        // Tag name -> tag.
+        QHash<QString, QSharedPointer<Tag>> m_tags;
     };
 }
 
@@ -0,0 +1,213 @@
+#include "notebookwatcher.h"
+
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QDebug>
+
+#include <notebookbackend/inotebookbackend.h>
+#include <notebookbackend/backendiostats.h>
+#include <notebookconfigmgr/inotebookconfigmgr.h>
+#include <utils/pathutils.h>
+#include <utils/fileutils.h>
+#include <core/exception.h>
+
+#include "notebook.h"
+#include "node.h"
+
+using namespace vnotex;
+
+NotebookWatcher::NotebookWatcher(Notebook *p_notebook, QObject *p_parent)
+    : QObject(p_parent),
+      m_notebook(p_notebook)
+{
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &NotebookWatcher::handleDirectoryChanged);
+
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(500);
+    connect(m_timer, &QTimer::timeout,
+            this, &NotebookWatcher::processPendingChanges);
+}
+
+void NotebookWatcher::start()
+{
+    if (m_active) {
+        return;
+    }
+
+    m_active = true;
+
+    connect(m_notebook, &Notebook::nodeLoaded,
+            this, &NotebookWatcher::watchNode);
+    connect(m_notebook, &Notebook::nodePathChanged,
+            this, &NotebookWatcher::handleNodePathChanged);
+
+    watchNode(m_notebook->getRootNode().data());
+}
+
+void NotebookWatcher::stop()
+{
+    if (!m_active) {
+        return;
+    }
+
+    m_active = false;
+
+    disconnect(m_notebook, &Notebook::nodeLoaded,
+               this, &NotebookWatcher::watchNode);
+    disconnect(m_notebook, &Notebook::nodePathChanged,
+               this, &NotebookWatcher::handleNodePathChanged);
+
+    m_timer->stop();
+    m_pendingFolders.clear();
+
+    const auto dirs = m_watcher->directories();
+    if (!dirs.isEmpty()) {
+        m_watcher->removePaths(dirs);
+    }
+    m_watchedFolders.clear();
+}
+
+bool NotebookWatcher::isActive() const
+{
+    return m_active;
+}
+
+void NotebookWatcher::watchNode(const Node *p_node)
+{
+    if (!m_active || !p_node->isContainer() || !p_node->isLoaded() || !p_node->exists()) {
+        return;
+    }
+
+    const auto relativePath = p_node->fetchPath();
+    if (!m_watchedFolders.contains(relativePath)) {
+        if (m_watcher->addPath(p_node->fetchAbsolutePath())) {
+            m_watchedFolders.insert(relativePath);
+        } else {
+            qWarning() << "failed to watch notebook folder (the inotify watch limit may be reached)"
+                       << p_node->fetchAbsolutePath();
+        }
+    }
+
+    for (const auto &child : p_node->getChildrenRef()) {
+        if (child->isContainer()) {
+            watchNode(child.data());
+        }
+    }
+}
+
+void NotebookWatcher::handleDirectoryChanged(const QString &p_path)
+{
+    QString relativePath;
+    try {
+        relativePath = m_notebook->getBackend()->getRelativePath(p_path);
+    } catch (Exception &p_e) {
+        Q_UNUSED(p_e);
+        return;
+    }
+
+    if (relativePath == QStringLiteral(".")) {
+        relativePath.clear();
+    }
+
+    m_pendingFolders.insert(relativePath);
+    m_timer->start();
+}
+
+void NotebookWatcher::processPendingChanges()
+{
+    BackendIoStats::OperationScope ioScope("rescan_external");
+
+    const auto folders = m_pendingFolders;
+    m_pendingFolders.clear();
+
+    auto configMgr = m_notebook->getConfigMgr();
+    for (const auto &folder : folders) {
+        auto node = findLoadedNode(folder);
+        if (!node) {
+            // Removed or not loaded.
+            unwatchPath(folder);
+            continue;
+        }
+
+        bool changed = false;
+        try {
+            changed = configMgr->reloadNode(node);
+        } catch (Exception &p_e) {
+            qWarning() << "failed to reload node changed outside" << folder << p_e.what();
+            continue;
+        }
+
+        if (!node->exists()) {
+            unwatchPath(folder);
+        } else {
+            // Watch newly-added folders.
+            watchNode(node);
+        }
+
+        if (changed) {
+            emit m_notebook->nodeChildrenUpdated(node);
+        }
+    }
+}
+
+void NotebookWatcher::handleNodePathChanged(Node *p_node, const QString &p_oldPath)
+{
+    // QFileSystemWatcher keeps reporting a renamed folder by its old path.
+    const auto prefix = p_oldPath + QLatin1Char('/');
+    auto isUnder = [&p_oldPath, &prefix](const QString &p_path) {
+        return p_path == p_oldPath || p_path.startsWith(prefix);
+    };
+
+    const auto folders = m_watchedFolders;
+    for (const auto &folder : folders) {
+        if (isUnder(folder)) {
+            unwatchPath(folder);
+        }
+    }
+
+    for (auto it = m_pendingFolders.begin(); it != m_pendingFolders.end();) {
+        if (isUnder(*it)) {
+            it = m_pendingFolders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    watchNode(p_node);
+}
+
+Node *NotebookWatcher::findLoadedNode(const QString &p_relativePath) const
+{
+    auto node = m_notebook->getRootNode().data();
+    const auto paths = PathUtils::cleanPath(p_relativePath).split('/', QString::SkipEmptyParts);
+    for (const auto &pa : paths) {
+        if (!node->isLoaded()) {
+            return nullptr;
+        }
+
+        auto child = node->findChild(pa, FileUtils::isPlatformNameCaseSensitive());
+        if (!child || !child->isContainer()) {
+            return nullptr;
+        }
+
+        node = child.data();
+    }
+
+    return node->isLoaded() ? node : nullptr;
+}
+
+void NotebookWatcher::unwatchPath(const QString &p_relativePath)
+{
+    if (!m_watchedFolders.remove(p_relativePath)) {
+        return;
+    }
+
+    // QFileSystemWatcher drops removed folders itself.
+    const auto absolutePath = m_notebook->getBackend()->getFullPath(p_relativePath);
+    if (m_watcher->directories().contains(absolutePath)) {
+        m_watcher->removePath(absolutePath);
+    }
+}
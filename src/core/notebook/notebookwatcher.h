@@ -0,0 +1,67 @@
+#ifndef NOTEBOOKWATCHER_H
+#define NOTEBOOKWATCHER_H
+
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace vnotex
+{
+    class Notebook;
+    class Node;
+
+    // Watch the folders of loaded container nodes of a notebook and apply external
+    // changes (git pull, sync tools, scripts) to the affected nodes only.
+    // Use inotify on Linux via QFileSystemWatcher. Unloaded folders are not watched
+    // since they will read the latest config on load.
+    class NotebookWatcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        NotebookWatcher(Notebook *p_notebook, QObject *p_parent = nullptr);
+
+        // Start watching the root node and all loaded container nodes.
+        void start();
+
+        void stop();
+
+        bool isActive() const;
+
+        // Watch @p_node and its loaded container descendants.
+        void watchNode(const Node *p_node);
+
+    private:
+        void handleDirectoryChanged(const QString &p_path);
+
+        // Re-key the watched folders of a renamed or moved subtree.
+        void handleNodePathChanged(Node *p_node, const QString &p_oldPath);
+
+        // Apply all pending changes.
+        void processPendingChanges();
+
+        // Find a loaded node by @p_relativePath without loading any node.
+        Node *findLoadedNode(const QString &p_relativePath) const;
+
+        void unwatchPath(const QString &p_relativePath);
+
+        Notebook *m_notebook = nullptr;
+
+        QFileSystemWatcher *m_watcher = nullptr;
+
+        // Coalesce bursts of events.
+        QTimer *m_timer = nullptr;
+
+        // Relative paths of folders with pending changes.
+        QSet<QString> m_pendingFolders;
+
+        // Relative paths of watched folders.
+        QSet<QString> m_watchedFolders;
+
+        bool m_active = false;
+    };
+} // ns vnotex
+
+#endif // NOTEBOOKWATCHER_H
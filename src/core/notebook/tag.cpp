@@ -2,6 +2,8 @@
 
 #include <QRegularExpression>
 
+#include <algorithm>
+
 #include <utils/pathutils.h>
 
 using namespace vnotex;
@@ -19,7 +21,14 @@ const QVector<QSharedPointer<Tag>> &Tag::getChildren() const
 void Tag::addChild(const QSharedPointer<Tag> &p_tag)
 {
     p_tag->m_parent = this;
-    m_children.push_back(p_tag);
+    insertSorted(m_children, p_tag);
+}
+
+void Tag::removeChild(const Tag *p_tag)
+{
+    if (remove(m_children, p_tag)) {
+        const_cast<Tag *>(p_tag)->m_parent = nullptr;
+    }
 }
 
 const QString &Tag::name() const
@@ -27,6 +36,11 @@ const QString &Tag::name() const
     return m_name;
 }
 
+void Tag::setName(const QString &p_name)
+{
+    m_name = p_name;
+}
+
 Tag *Tag::getParent() const
 {
     return m_parent;
@@ -45,3 +59,24 @@ bool Tag::isValidName(const QString &p_name)
 {
     return !p_name.isEmpty() && !p_name.contains(QRegularExpression("[>/]"));
 }
+
+void Tag::insertSorted(QVector<QSharedPointer<Tag>> &p_tags, const QSharedPointer<Tag> &p_tag)
+{
+    auto it = std::upper_bound(p_tags.begin(), p_tags.end(), p_tag->name(),
+                               [](const QString &p_name, const QSharedPointer<Tag> &p_other) {
+                                   return p_name < p_other->name();
+                               });
+    p_tags.insert(it, p_tag);
+}
+
+bool Tag::remove(QVector<QSharedPointer<Tag>> &p_tags, const Tag *p_tag)
+{
+    for (int i = 0; i < p_tags.size(); ++i) {
+        if (p_tags[i].data() == p_tag) {
+            p_tags.remove(i);
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -17,14 +17,25 @@ namespace vnotex
 
         const QString &name() const;
 
+        void setName(const QString &p_name);
+
         Tag *getParent() const;
 
+        // Children are kept sorted by name.
         void addChild(const QSharedPointer<Tag> &p_tag);
 
+        void removeChild(const Tag *p_tag);
+
         QString fetchPath() const;
 
         static bool isValidName(const QString &p_name);
 
+        // Insert @p_tag into @p_tags sorted by name.
+        static void insertSorted(QVector<QSharedPointer<Tag>> &p_tags, const QSharedPointer<Tag> &p_tag);
+
+        // Remove @p_tag from @p_tags. Return false if not found.
+        static bool remove(QVector<QSharedPointer<Tag>> &p_tags, const Tag *p_tag);
+
     private:
         Tag *m_parent = nullptr;
 
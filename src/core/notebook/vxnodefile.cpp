@@ -31,6 +31,21 @@ void VXNodeFile::write(const QString &p_content)
     m_node->save();
 }
 
+QString VXNodeFile::getDirectWritePath() const
+{
+    if (m_node->getBackend()->isLocalFileSystem()) {
+        return getContentPath();
+    }
+
+    return QString();
+}
+
+void VXNodeFile::handleDirectWritten()
+{
+    m_node->setModifiedTimeUtc();
+    m_node->save();
+}
+
 QString VXNodeFile::getName() const
 {
     return m_node->getName();
@@ -86,6 +101,16 @@ QString VXNodeFile::insertImage(const QImage &p_image, const QString &p_imageFil
     return destFilePath;
 }
 
+QString VXNodeFile::insertImage(const QByteArray &p_data, const QString &p_imageFileName)
+{
+    auto backend = m_node->getBackend();
+    const auto imageFolderPath = fetchImageFolderPath();
+    auto destFilePath = backend->renameIfExistsCaseInsensitive(PathUtils::concatenateFilePath(imageFolderPath, p_imageFileName));
+    backend->writeFile(destFilePath, p_data);
+    backend->addFile(destFilePath);
+    return destFilePath;
+}
+
 void VXNodeFile::removeImage(const QString &p_imagePath)
 {
     // Just move it to recycle bin but not added as a child node of recycle bin.
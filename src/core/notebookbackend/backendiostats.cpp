@@ -0,0 +1,192 @@
+#include "backendiostats.h"
+
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <utils/fileutils.h>
+#include "exception.h"
+
+using namespace vnotex;
+
+const QVector<qint64> BackendIoStats::c_bucketBoundsUs = {10, 100, 1000, 10000, 100000, 1000000};
+
+// Name of the innermost operation of current thread.
+static thread_local const char *t_operationName = nullptr;
+
+BackendIoStats::OperationScope::OperationScope(const char *p_name)
+    : m_prevName(t_operationName)
+{
+    t_operationName = p_name;
+}
+
+BackendIoStats::OperationScope::~OperationScope()
+{
+    t_operationName = m_prevName;
+}
+
+BackendIoStats &BackendIoStats::getInst()
+{
+    static BackendIoStats inst;
+    return inst;
+}
+
+bool BackendIoStats::isEnabled() const
+{
+    return m_enabled.load() == 1;
+}
+
+void BackendIoStats::setEnabled(bool p_enabled)
+{
+    m_enabled.store(p_enabled ? 1 : 0);
+}
+
+void BackendIoStats::record(Method p_method, qint64 p_bytes, qint64 p_nsecs)
+{
+    Q_ASSERT(p_method < MaxMethod);
+    const auto operation = t_operationName ? QString::fromLatin1(t_operationName)
+                                           : QStringLiteral("unattributed");
+
+    const qint64 us = p_nsecs / 1000;
+    int bucket = 0;
+    while (bucket < c_bucketBoundsUs.size() && us > c_bucketBoundsUs[bucket]) {
+        ++bucket;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    auto &methods = m_stats[operation];
+    if (methods.isEmpty()) {
+        methods.resize(MaxMethod);
+    }
+
+    auto &stats = methods[p_method];
+    if (stats.m_histogram.isEmpty()) {
+        stats.m_histogram.resize(c_bucketBoundsUs.size() + 1);
+    }
+
+    ++stats.m_count;
+    stats.m_bytes += p_bytes;
+    stats.m_totalNsecs += p_nsecs;
+    stats.m_maxNsecs = qMax(stats.m_maxNsecs, p_nsecs);
+    ++stats.m_histogram[bucket];
+}
+
+void BackendIoStats::reset()
+{
+    QMutexLocker lock(&m_mutex);
+    m_stats.clear();
+}
+
+QJsonObject BackendIoStats::toJson() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    QJsonObject operationsObj;
+    for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+        QJsonObject methodsObj;
+        for (int i = 0; i < it.value().size(); ++i) {
+            const auto &stats = it.value()[i];
+            if (stats.m_count == 0) {
+                continue;
+            }
+
+            QJsonObject histObj;
+            for (int j = 0; j < stats.m_histogram.size(); ++j) {
+                const auto bound = j < c_bucketBoundsUs.size() ? QString::number(c_bucketBoundsUs[j])
+                                                               : QStringLiteral("inf");
+                histObj[bound] = stats.m_histogram[j];
+            }
+
+            QJsonObject statsObj;
+            statsObj[QStringLiteral("count")] = stats.m_count;
+            statsObj[QStringLiteral("bytes")] = stats.m_bytes;
+            statsObj[QStringLiteral("total_us")] = stats.m_totalNsecs / 1000;
+            statsObj[QStringLiteral("max_us")] = stats.m_maxNsecs / 1000;
+            statsObj[QStringLiteral("histogram_us")] = histObj;
+            methodsObj[methodName(static_cast<Method>(i))] = statsObj;
+        }
+
+        operationsObj[it.key()] = methodsObj;
+    }
+
+    QJsonObject obj;
+    obj[QStringLiteral("enabled")] = isEnabled();
+    obj[QStringLiteral("operations")] = operationsObj;
+    return obj;
+}
+
+bool BackendIoStats::dumpToFile(const QString &p_filePath) const
+{
+    try {
+        FileUtils::writeFile(p_filePath, QJsonDocument(toJson()).toJson());
+    } catch (Exception &p_e) {
+        qWarning() << "failed to dump backend I/O stats" << p_filePath << p_e.what();
+        return false;
+    }
+
+    return true;
+}
+
+QString BackendIoStats::methodName(Method p_method)
+{
+    switch (p_method) {
+    case IsEmptyDir:
+        return QStringLiteral("isEmptyDir");
+
+    case MakePath:
+        return QStringLiteral("makePath");
+
+    case WriteFile:
+        return QStringLiteral("writeFile");
+
+    case ReadFile:
+        return QStringLiteral("readFile");
+
+    case Exists:
+        return QStringLiteral("exists");
+
+    case ExistsFile:
+        return QStringLiteral("existsFile");
+
+    case ExistsDir:
+        return QStringLiteral("existsDir");
+
+    case ChildExistsCaseInsensitive:
+        return QStringLiteral("childExistsCaseInsensitive");
+
+    case IsFile:
+        return QStringLiteral("isFile");
+
+    case RenameFile:
+        return QStringLiteral("renameFile");
+
+    case RenameDir:
+        return QStringLiteral("renameDir");
+
+    case CopyFile:
+        return QStringLiteral("copyFile");
+
+    case CopyDir:
+        return QStringLiteral("copyDir");
+
+    case RemoveFile:
+        return QStringLiteral("removeFile");
+
+    case RemoveDirIfEmpty:
+        return QStringLiteral("removeDirIfEmpty");
+
+    case RemoveDir:
+        return QStringLiteral("removeDir");
+
+    case RenameIfExistsCaseInsensitive:
+        return QStringLiteral("renameIfExistsCaseInsensitive");
+
+    case RemoveEmptyDir:
+        return QStringLiteral("removeEmptyDir");
+
+    default:
+        Q_ASSERT(false);
+        return QString();
+    }
+}
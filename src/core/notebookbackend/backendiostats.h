@@ -0,0 +1,107 @@
+#ifndef BACKENDIOSTATS_H
+#define BACKENDIOSTATS_H
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "../noncopyable.h"
+
+class QJsonObject;
+
+namespace vnotex
+{
+    // Process-wide statistics of notebook backend I/O, recorded by InstrumentedNotebookBackend.
+    // Calls are attributed to the innermost OperationScope of the calling thread.
+    class BackendIoStats : private Noncopyable
+    {
+    public:
+        enum Method
+        {
+            IsEmptyDir,
+            MakePath,
+            WriteFile,
+            ReadFile,
+            Exists,
+            ExistsFile,
+            ExistsDir,
+            ChildExistsCaseInsensitive,
+            IsFile,
+            RenameFile,
+            RenameDir,
+            CopyFile,
+            CopyDir,
+            RemoveFile,
+            RemoveDirIfEmpty,
+            RemoveDir,
+            RenameIfExistsCaseInsensitive,
+            RemoveEmptyDir,
+            MaxMethod
+        };
+
+        // RAII helper to attribute backend calls within its lifetime to operation @p_name.
+        class OperationScope
+        {
+        public:
+            explicit OperationScope(const char *p_name);
+
+            ~OperationScope();
+
+            OperationScope(const OperationScope &) = delete;
+            OperationScope &operator=(const OperationScope &) = delete;
+
+        private:
+            const char *m_prevName = nullptr;
+        };
+
+        static BackendIoStats &getInst();
+
+        bool isEnabled() const;
+
+        // Could be switched at runtime, such as via --io-stats at startup or the main menu.
+        // Takes effect on the next backend call. Recorded data is kept on disable.
+        void setEnabled(bool p_enabled);
+
+        void record(Method p_method, qint64 p_bytes, qint64 p_nsecs);
+
+        void reset();
+
+        QJsonObject toJson() const;
+
+        // Dump as JSON to @p_filePath.
+        bool dumpToFile(const QString &p_filePath) const;
+
+    private:
+        struct MethodStats
+        {
+            qint64 m_count = 0;
+
+            qint64 m_bytes = 0;
+
+            qint64 m_totalNsecs = 0;
+
+            qint64 m_maxNsecs = 0;
+
+            // Count of calls within each latency bucket.
+            QVector<qint64> m_histogram;
+        };
+
+        BackendIoStats() = default;
+
+        static QString methodName(Method p_method);
+
+        QAtomicInt m_enabled = 0;
+
+        mutable QMutex m_mutex;
+
+        // Operation name -> stats of all methods.
+        QHash<QString, QVector<MethodStats>> m_stats;
+
+        // Upper bounds in microseconds of latency buckets. The last bucket is unbounded.
+        static const QVector<qint64> c_bucketBoundsUs;
+    };
+} // ns vnotex
+
+#endif // BACKENDIOSTATS_H
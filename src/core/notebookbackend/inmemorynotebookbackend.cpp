@@ -0,0 +1,531 @@
+#include "inmemorynotebookbackend.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QThread>
+#include <QSet>
+
+#include <utils/pathutils.h>
+#include "exception.h"
+#include <utils/fileutils.h>
+
+using namespace vnotex;
+
+InMemoryNotebookBackend::InMemoryNotebookBackend(const QString &p_name,
+                                                 const QString &p_displayName,
+                                                 const QString &p_description,
+                                                 const QString &p_rootPath,
+                                                 QObject *p_parent)
+    : INotebookBackend(p_rootPath, p_parent),
+      m_info(p_name, p_displayName, p_description)
+{
+    makePathByKey(QString());
+}
+
+QString InMemoryNotebookBackend::getName() const
+{
+    return m_info.m_name;
+}
+
+QString InMemoryNotebookBackend::getDisplayName() const
+{
+    return m_info.m_displayName;
+}
+
+QString InMemoryNotebookBackend::getDescription() const
+{
+    return m_info.m_description;
+}
+
+bool InMemoryNotebookBackend::isReadOnly() const
+{
+    return false;
+}
+
+bool InMemoryNotebookBackend::isLocalFileSystem() const
+{
+    return false;
+}
+
+bool InMemoryNotebookBackend::isEmptyDir(const QString &p_dirPath) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    const auto key = toKey(p_dirPath);
+    auto entry = findEntry(key);
+    return entry && entry->m_isDir && !hasChildren(key);
+}
+
+void InMemoryNotebookBackend::makePath(const QString &p_dirPath)
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    makePathByKey(toKey(p_dirPath));
+}
+
+void InMemoryNotebookBackend::writeFile(const QString &p_filePath, const QByteArray &p_data)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    writeFileByKey(toKey(p_filePath), p_data);
+}
+
+void InMemoryNotebookBackend::writeFile(const QString &p_filePath, const QString &p_text)
+{
+    writeFile(p_filePath, p_text.toUtf8());
+}
+
+void InMemoryNotebookBackend::writeFile(const QString &p_filePath, const QJsonObject &p_jobj)
+{
+    writeFile(p_filePath, QJsonDocument(p_jobj).toJson());
+}
+
+QString InMemoryNotebookBackend::readTextFile(const QString &p_filePath)
+{
+    return QString::fromUtf8(readFile(p_filePath));
+}
+
+QByteArray InMemoryNotebookBackend::readFile(const QString &p_filePath)
+{
+    simulateLatency(m_latency.m_readUs);
+
+    auto entry = findEntry(toKey(p_filePath));
+    if (!entry || entry->m_isDir) {
+        Exception::throwOne(Exception::Type::FailToReadFile,
+                            QString("failed to read file: %1").arg(p_filePath));
+    }
+
+    return entry->m_data;
+}
+
+bool InMemoryNotebookBackend::exists(const QString &p_path) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    return findEntry(toKey(p_path));
+}
+
+bool InMemoryNotebookBackend::existsFile(const QString &p_path) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    auto entry = findEntry(toKey(p_path));
+    return entry && !entry->m_isDir;
+}
+
+bool InMemoryNotebookBackend::existsDir(const QString &p_path) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    auto entry = findEntry(toKey(p_path));
+    return entry && entry->m_isDir;
+}
+
+bool InMemoryNotebookBackend::childExistsCaseInsensitive(const QString &p_dirPath, const QString &p_name) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    const auto name = p_name.toLower();
+    const auto children = childrenNames(toKey(p_dirPath));
+    for (const auto &child : children) {
+        if (child.toLower() == name) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool InMemoryNotebookBackend::isFile(const QString &p_path) const
+{
+    return existsFile(p_path);
+}
+
+void InMemoryNotebookBackend::renameFile(const QString &p_filePath, const QString &p_name)
+{
+    Q_ASSERT(PathUtils::isLegalFileName(p_name));
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto key = toKey(p_filePath);
+    const auto newKey = PathUtils::concatenateFilePath(parentKey(key), p_name);
+    auto entry = findEntry(key);
+    if (!entry || entry->m_isDir || (newKey != key && findEntry(newKey))) {
+        Exception::throwOne(Exception::Type::FailToRenameFile,
+                            QString("failed to rename file: %1").arg(p_filePath));
+    }
+
+    m_entries.insert(newKey, m_entries.take(key));
+}
+
+void InMemoryNotebookBackend::renameDir(const QString &p_dirPath, const QString &p_name)
+{
+    Q_ASSERT(PathUtils::isLegalFileName(p_name));
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto key = toKey(p_dirPath);
+    const auto newKey = PathUtils::concatenateFilePath(parentKey(key), p_name);
+    auto entry = findEntry(key);
+    if (key.isEmpty() || !entry || !entry->m_isDir || (newKey != key && findEntry(newKey))) {
+        Exception::throwOne(Exception::Type::FailToRenameFile,
+                            QString("failed to rename directory: %1").arg(p_dirPath));
+    }
+
+    if (newKey == key) {
+        return;
+    }
+
+    QMap<QString, Entry> moved;
+    moved.insert(newKey, m_entries.take(key));
+
+    const auto prefix = descendantPrefix(key);
+    const auto newPrefix = descendantPrefix(newKey);
+    auto it = m_entries.lowerBound(prefix);
+    while (it != m_entries.end() && it.key().startsWith(prefix)) {
+        moved.insert(newPrefix + it.key().mid(prefix.size()), it.value());
+        it = m_entries.erase(it);
+    }
+
+    for (auto mit = moved.constBegin(); mit != moved.constEnd(); ++mit) {
+        m_entries.insert(mit.key(), mit.value());
+    }
+}
+
+void InMemoryNotebookBackend::removeFile(const QString &p_filePath)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto key = toKey(p_filePath);
+    auto entry = findEntry(key);
+    if (!entry || entry->m_isDir) {
+        Exception::throwOne(Exception::Type::FailToRemoveFile,
+                            QString("failed to remove file: %1").arg(p_filePath));
+    }
+
+    m_entries.remove(key);
+}
+
+bool InMemoryNotebookBackend::removeDirIfEmpty(const QString &p_dirPath)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto key = toKey(p_dirPath);
+    auto entry = findEntry(key);
+    Q_ASSERT(!entry || entry->m_isDir);
+    if (!entry || hasChildren(key)) {
+        return false;
+    }
+
+    m_entries.remove(key);
+    return true;
+}
+
+void InMemoryNotebookBackend::removeDir(const QString &p_dirPath)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto key = toKey(p_dirPath);
+    auto entry = findEntry(key);
+    if (entry && !entry->m_isDir) {
+        Exception::throwOne(Exception::Type::FailToRemoveFile,
+                            QString("failed to remove directory recursively: %1").arg(p_dirPath));
+    }
+
+    removeDescendants(key);
+    m_entries.remove(key);
+}
+
+void InMemoryNotebookBackend::copyFile(const QString &p_filePath, const QString &p_destPath, bool p_move)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto destKey = toKey(p_destPath);
+    const bool external = isExternalPath(p_filePath);
+
+    QString srcKey;
+    QByteArray data;
+    if (external) {
+        data = FileUtils::readFile(p_filePath);
+    } else {
+        srcKey = toKey(p_filePath);
+        if (srcKey == destKey) {
+            return;
+        }
+
+        auto entry = findEntry(srcKey);
+        if (!entry || entry->m_isDir) {
+            Exception::throwOne(Exception::Type::FailToCopyFile,
+                                QString("failed to copy file: %1 %2").arg(p_filePath, p_destPath));
+        }
+
+        data = entry->m_data;
+    }
+
+    if (findEntry(destKey)) {
+        Exception::throwOne(Exception::Type::FailToCopyFile,
+                            QString("failed to copy file: %1 %2").arg(p_filePath, p_destPath));
+    }
+
+    makePathByKey(parentKey(destKey));
+    writeFileByKey(destKey, data);
+
+    if (p_move) {
+        if (external) {
+            FileUtils::removeFile(p_filePath);
+        } else {
+            m_entries.remove(srcKey);
+        }
+    }
+}
+
+void InMemoryNotebookBackend::copyDir(const QString &p_dirPath, const QString &p_destPath, bool p_move)
+{
+    simulateLatency(m_latency.m_writeUs);
+
+    const auto destKey = toKey(p_destPath);
+    if (isExternalPath(p_dirPath)) {
+        if (findEntry(destKey)) {
+            Exception::throwOne(Exception::Type::FailToCopyDir,
+                                QString("target directory %1 already exists").arg(p_destPath));
+        }
+
+        makePathByKey(destKey);
+
+        QDir srcDir(p_dirPath);
+        QDirIterator it(p_dirPath,
+                        QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoSymLinks | QDir::NoDotAndDotDot,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const auto path = it.next();
+            const auto key = PathUtils::concatenateFilePath(destKey, srcDir.relativeFilePath(path));
+            if (it.fileInfo().isDir()) {
+                makePathByKey(key);
+            } else {
+                makePathByKey(parentKey(key));
+                writeFileByKey(key, FileUtils::readFile(path));
+            }
+        }
+
+        if (p_move) {
+            FileUtils::removeDir(p_dirPath);
+        }
+        return;
+    }
+
+    const auto srcKey = toKey(p_dirPath);
+    if (srcKey == destKey) {
+        return;
+    }
+
+    auto entry = findEntry(srcKey);
+    if (!entry || !entry->m_isDir || destKey.startsWith(descendantPrefix(srcKey))) {
+        Exception::throwOne(Exception::Type::FailToCopyDir,
+                            QString("failed to copy directory: %1 %2").arg(p_dirPath, p_destPath));
+    }
+
+    if (findEntry(destKey)) {
+        Exception::throwOne(Exception::Type::FailToCopyDir,
+                            QString("target directory %1 already exists").arg(p_destPath));
+    }
+
+    // Collect first since inserting may invalidate the iteration.
+    QMap<QString, Entry> copied;
+    copied.insert(destKey, *entry);
+
+    const auto prefix = descendantPrefix(srcKey);
+    const auto destPrefix = descendantPrefix(destKey);
+    for (auto it = m_entries.lowerBound(prefix); it != m_entries.end() && it.key().startsWith(prefix); ++it) {
+        copied.insert(destPrefix + it.key().mid(prefix.size()), it.value());
+    }
+
+    makePathByKey(parentKey(destKey));
+    for (auto it = copied.constBegin(); it != copied.constEnd(); ++it) {
+        m_entries.insert(it.key(), it.value());
+    }
+
+    if (p_move) {
+        removeDescendants(srcKey);
+        m_entries.remove(srcKey);
+    }
+}
+
+QString InMemoryNotebookBackend::renameIfExistsCaseInsensitive(const QString &p_path) const
+{
+    simulateLatency(m_latency.m_metadataUs);
+
+    const auto key = toKey(p_path);
+    const auto dirKey = parentKey(key);
+
+    QSet<QString> children;
+    for (const auto &child : childrenNames(dirKey)) {
+        children.insert(child.toLower());
+    }
+
+    QFileInfo fi(PathUtils::fileName(key));
+    const auto baseName = fi.completeBaseName();
+    const auto suffix = fi.suffix();
+    auto name = fi.fileName();
+    int idx = 1;
+    while (children.contains(name.toLower())) {
+        name = QString("%1_%2").arg(baseName, QString::number(idx));
+        if (!suffix.isEmpty()) {
+            name += QStringLiteral(".") + suffix;
+        }
+
+        ++idx;
+    }
+
+    return getFullPath(PathUtils::concatenateFilePath(dirKey, name));
+}
+
+void InMemoryNotebookBackend::addFile(const QString &p_path)
+{
+    Q_UNUSED(p_path);
+    // Do nothing for now.
+}
+
+void InMemoryNotebookBackend::removeEmptyDir(const QString &p_dirPath)
+{
+    const auto key = toKey(p_dirPath);
+    const auto children = childrenNames(key);
+    for (const auto &child : children) {
+        const auto childKey = PathUtils::concatenateFilePath(key, child);
+        if (findEntry(childKey)->m_isDir) {
+            removeEmptyDir(childKey);
+            removeDirIfEmpty(childKey);
+        }
+    }
+}
+
+const InMemoryNotebookBackend::Latency &InMemoryNotebookBackend::getLatency() const
+{
+    return m_latency;
+}
+
+void InMemoryNotebookBackend::setLatency(const Latency &p_latency)
+{
+    m_latency = p_latency;
+}
+
+qint64 InMemoryNotebookBackend::getTotalSize() const
+{
+    qint64 size = 0;
+    for (const auto &entry : m_entries) {
+        size += entry.m_data.size();
+    }
+    return size;
+}
+
+QString InMemoryNotebookBackend::toKey(const QString &p_path) const
+{
+    auto key = getRelativePath(p_path);
+    if (key == QStringLiteral(".")) {
+        key.clear();
+    }
+    return key;
+}
+
+QString InMemoryNotebookBackend::descendantPrefix(const QString &p_key)
+{
+    return p_key.isEmpty() ? p_key : p_key + QLatin1Char('/');
+}
+
+QString InMemoryNotebookBackend::parentKey(const QString &p_key)
+{
+    const int idx = p_key.lastIndexOf(QLatin1Char('/'));
+    return idx == -1 ? QString() : p_key.left(idx);
+}
+
+const InMemoryNotebookBackend::Entry *InMemoryNotebookBackend::findEntry(const QString &p_key) const
+{
+    auto it = m_entries.constFind(p_key);
+    return it == m_entries.constEnd() ? nullptr : &it.value();
+}
+
+QStringList InMemoryNotebookBackend::childrenNames(const QString &p_key) const
+{
+    QStringList names;
+    const auto prefix = descendantPrefix(p_key);
+    for (auto it = m_entries.lowerBound(prefix); it != m_entries.end() && it.key().startsWith(prefix); ++it) {
+        const auto name = it.key().mid(prefix.size());
+        if (!name.isEmpty() && !name.contains(QLatin1Char('/'))) {
+            names << name;
+        }
+    }
+    return names;
+}
+
+bool InMemoryNotebookBackend::hasChildren(const QString &p_key) const
+{
+    const auto prefix = descendantPrefix(p_key);
+    auto it = m_entries.lowerBound(prefix);
+    if (it != m_entries.end() && it.key() == p_key) {
+        // Root.
+        ++it;
+    }
+    return it != m_entries.end() && it.key().startsWith(prefix);
+}
+
+void InMemoryNotebookBackend::removeDescendants(const QString &p_key)
+{
+    const auto prefix = descendantPrefix(p_key);
+    auto it = m_entries.lowerBound(prefix);
+    while (it != m_entries.end() && it.key().startsWith(prefix)) {
+        if (it.key() == p_key) {
+            // Root.
+            ++it;
+            continue;
+        }
+        it = m_entries.erase(it);
+    }
+}
+
+void InMemoryNotebookBackend::makePathByKey(const QString &p_key)
+{
+    Entry dirEntry;
+    dirEntry.m_isDir = true;
+
+    QString key;
+    const auto parts = p_key.split(QLatin1Char('/'), QString::SkipEmptyParts);
+    for (int i = -1; i < parts.size(); ++i) {
+        if (i >= 0) {
+            key = PathUtils::concatenateFilePath(key, parts[i]);
+        }
+
+        auto entry = findEntry(key);
+        if (!entry) {
+            m_entries.insert(key, dirEntry);
+        } else if (!entry->m_isDir) {
+            Exception::throwOne(Exception::Type::FailToCreateDir,
+                                QString("fail to create directory: %1").arg(p_key));
+        }
+    }
+}
+
+void InMemoryNotebookBackend::writeFileByKey(const QString &p_key, const QByteArray &p_data)
+{
+    auto parent = findEntry(parentKey(p_key));
+    auto entry = findEntry(p_key);
+    if (p_key.isEmpty() || !parent || !parent->m_isDir || (entry && entry->m_isDir)) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_key));
+    }
+
+    Entry fileEntry;
+    fileEntry.m_data = p_data;
+    m_entries.insert(p_key, fileEntry);
+}
+
+bool InMemoryNotebookBackend::isExternalPath(const QString &p_path) const
+{
+    return QFileInfo(p_path).isAbsolute() && !PathUtils::pathContains(getRootPath(), p_path);
+}
+
+void InMemoryNotebookBackend::simulateLatency(int p_us) const
+{
+    if (p_us > 0) {
+        QThread::usleep(p_us);
+    }
+}
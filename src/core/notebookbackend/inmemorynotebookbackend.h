@@ -0,0 +1,158 @@
+#ifndef INMEMORYNOTEBOOKBACKEND_H
+#define INMEMORYNOTEBOOKBACKEND_H
+
+#include "inotebookbackend.h"
+
+#include <QMap>
+#include <QByteArray>
+
+#include "../global.h"
+
+namespace vnotex
+{
+    // Backend to keep all the files and directories of a notebook in memory.
+    // Root path is only used to resolve absolute paths and no file on disk will be touched
+    // except the source of copyFile()/copyDir() beyond the notebook.
+    // Used by tests and benchmarks to isolate CPU cost from I/O cost.
+    // Registered to NotebookMgr for benchmarks but not offered to create notebooks.
+    class InMemoryNotebookBackend : public INotebookBackend
+    {
+        Q_OBJECT
+    public:
+        // Simulated latency in microseconds of each call.
+        struct Latency
+        {
+            // Queries and directory operations.
+            int m_metadataUs = 0;
+
+            // Reads of file content.
+            int m_readUs = 0;
+
+            // Writes, copies and removals.
+            int m_writeUs = 0;
+        };
+
+        explicit InMemoryNotebookBackend(const QString &p_name,
+                                         const QString &p_displayName,
+                                         const QString &p_description,
+                                         const QString &p_rootPath,
+                                         QObject *p_parent = nullptr);
+
+        QString getName() const Q_DECL_OVERRIDE;
+
+        QString getDisplayName() const Q_DECL_OVERRIDE;
+
+        QString getDescription() const Q_DECL_OVERRIDE;
+
+        bool isReadOnly() const Q_DECL_OVERRIDE;
+
+        bool isLocalFileSystem() const Q_DECL_OVERRIDE;
+
+        // Whether @p_dirPath is an empty directory.
+        bool isEmptyDir(const QString &p_dirPath) const Q_DECL_OVERRIDE;
+
+        // Create the directory path @p_dirPath. Create all parent directories if necessary.
+        void makePath(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        // Write @p_data to @p_filePath.
+        void writeFile(const QString &p_filePath, const QByteArray &p_data) Q_DECL_OVERRIDE;
+
+        // Write @p_text to @p_filePath.
+        void writeFile(const QString &p_filePath, const QString &p_text) Q_DECL_OVERRIDE;
+
+        // Write @p_jobj to @p_filePath.
+        void writeFile(const QString &p_filePath, const QJsonObject &p_jobj) Q_DECL_OVERRIDE;
+
+        // Read content from @p_filePath.
+        QString readTextFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        // Read file @p_filePath.
+        QByteArray readFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        bool exists(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool existsFile(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool existsDir(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool childExistsCaseInsensitive(const QString &p_dirPath, const QString &p_name) const Q_DECL_OVERRIDE;
+
+        bool isFile(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        void renameFile(const QString &p_filePath, const QString &p_name) Q_DECL_OVERRIDE;
+
+        void renameDir(const QString &p_dirPath, const QString &p_name) Q_DECL_OVERRIDE;
+
+        // Delete @p_filePath.
+        void removeFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        // Delete @p_dirPath if it is empty.
+        bool removeDirIfEmpty(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        void removeDir(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        // Copy @p_filePath to @p_destPath.
+        // @p_filePath may beyond this notebook backend, which will be read from disk.
+        void copyFile(const QString &p_filePath, const QString &p_destPath, bool p_move = false) Q_DECL_OVERRIDE;
+
+        // Copy @p_dirPath to as @p_destPath.
+        // @p_dirPath may beyond this notebook backend, which will be read from disk.
+        void copyDir(const QString &p_dirPath, const QString &p_destPath, bool p_move = false) Q_DECL_OVERRIDE;
+
+        QString renameIfExistsCaseInsensitive(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        void addFile(const QString &p_path) Q_DECL_OVERRIDE;
+
+        void removeEmptyDir(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        const Latency &getLatency() const;
+
+        void setLatency(const Latency &p_latency);
+
+        // Total bytes of all the files.
+        qint64 getTotalSize() const;
+
+    private:
+        struct Entry
+        {
+            bool m_isDir = false;
+
+            QByteArray m_data;
+        };
+
+        // Get the key of @p_path, which is the cleaned relative path and empty for root.
+        QString toKey(const QString &p_path) const;
+
+        // Prefix of the keys of all the descendants of @p_key.
+        static QString descendantPrefix(const QString &p_key);
+
+        static QString parentKey(const QString &p_key);
+
+        const Entry *findEntry(const QString &p_key) const;
+
+        // Names of direct children of @p_key.
+        QStringList childrenNames(const QString &p_key) const;
+
+        bool hasChildren(const QString &p_key) const;
+
+        void removeDescendants(const QString &p_key);
+
+        void makePathByKey(const QString &p_key);
+
+        void writeFileByKey(const QString &p_key, const QByteArray &p_data);
+
+        // Whether @p_path locates beyond the root folder.
+        bool isExternalPath(const QString &p_path) const;
+
+        void simulateLatency(int p_us) const;
+
+        Info m_info;
+
+        Latency m_latency;
+
+        // Sorted so that descendants of one directory are adjacent.
+        QMap<QString, Entry> m_entries;
+    };
+} // ns vnotex
+
+#endif // INMEMORYNOTEBOOKBACKEND_H
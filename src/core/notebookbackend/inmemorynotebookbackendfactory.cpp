@@ -0,0 +1,44 @@
+#include "inmemorynotebookbackendfactory.h"
+
+#include <QObject>
+
+using namespace vnotex;
+
+InMemoryNotebookBackendFactory::InMemoryNotebookBackendFactory()
+{
+}
+
+QString InMemoryNotebookBackendFactory::getName() const
+{
+    return QStringLiteral("inmemory.vnotex");
+}
+
+QString InMemoryNotebookBackendFactory::getDisplayName() const
+{
+    return QObject::tr("In-Memory Notebook Backend");
+}
+
+QString InMemoryNotebookBackendFactory::getDescription() const
+{
+    return QObject::tr("Volatile in-memory file system for tests and benchmarks");
+}
+
+QSharedPointer<INotebookBackend> InMemoryNotebookBackendFactory::createNotebookBackend(const QString &p_rootPath)
+{
+    auto backend = QSharedPointer<InMemoryNotebookBackend>::create(getName(),
+                                                                   getDisplayName(),
+                                                                   getDescription(),
+                                                                   p_rootPath);
+    backend->setLatency(m_latency);
+    return backend;
+}
+
+bool InMemoryNotebookBackendFactory::isCreatable() const
+{
+    return false;
+}
+
+void InMemoryNotebookBackendFactory::setLatency(const InMemoryNotebookBackend::Latency &p_latency)
+{
+    m_latency = p_latency;
+}
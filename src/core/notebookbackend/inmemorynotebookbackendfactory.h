@@ -0,0 +1,34 @@
+#ifndef INMEMORYNOTEBOOKBACKENDFACTORY_H
+#define INMEMORYNOTEBOOKBACKENDFACTORY_H
+
+#include "inotebookbackendfactory.h"
+
+#include "inmemorynotebookbackend.h"
+
+namespace vnotex
+{
+    class InMemoryNotebookBackendFactory : public INotebookBackendFactory
+    {
+    public:
+        InMemoryNotebookBackendFactory();
+
+        QString getName() const Q_DECL_OVERRIDE;
+
+        QString getDisplayName() const Q_DECL_OVERRIDE;
+
+        QString getDescription()const Q_DECL_OVERRIDE;
+
+        QSharedPointer<INotebookBackend> createNotebookBackend(const QString &p_rootPath) Q_DECL_OVERRIDE;
+
+        // Content is lost on exit, so it is not offered to users.
+        bool isCreatable() const Q_DECL_OVERRIDE;
+
+        // Latency of backends created afterwards.
+        void setLatency(const InMemoryNotebookBackend::Latency &p_latency);
+
+    private:
+        InMemoryNotebookBackend::Latency m_latency;
+    };
+} // ns vnotex
+
+#endif // INMEMORYNOTEBOOKBACKENDFACTORY_H
@@ -42,6 +42,13 @@ namespace vnotex
             m_rootPath = p_rootPath;
         }
 
+        // Whether the notebook could not be modified via this backend.
+        virtual bool isReadOnly() const = 0;
+
+        // Whether all the files are plain files under the root folder, which could be
+        // accessed directly via their full paths.
+        virtual bool isLocalFileSystem() const = 0;
+
         // Whether @p_dirPath is an empty directory.
         virtual bool isEmptyDir(const QString &p_dirPath) const = 0;
 
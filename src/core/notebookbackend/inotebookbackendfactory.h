@@ -25,6 +25,12 @@ namespace vnotex
         virtual QString getDescription() const = 0;
 
         virtual QSharedPointer<INotebookBackend> createNotebookBackend(const QString &p_rootPath) = 0;
+
+        // Whether it could be chosen to create a new notebook.
+        virtual bool isCreatable() const
+        {
+            return true;
+        }
     };
 } // ns vnotex
 
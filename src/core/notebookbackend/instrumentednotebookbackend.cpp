@@ -0,0 +1,230 @@
+#include "instrumentednotebookbackend.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include "backendiostats.h"
+
+using namespace vnotex;
+
+namespace
+{
+    // Record one call into BackendIoStats on destruction, including the ones throwing.
+    class Sample
+    {
+    public:
+        explicit Sample(BackendIoStats::Method p_method)
+            : m_method(p_method),
+              m_enabled(BackendIoStats::getInst().isEnabled())
+        {
+            if (m_enabled) {
+                m_timer.start();
+            }
+        }
+
+        ~Sample()
+        {
+            if (m_enabled) {
+                BackendIoStats::getInst().record(m_method, m_bytes, m_timer.nsecsElapsed());
+            }
+        }
+
+        bool isEnabled() const
+        {
+            return m_enabled;
+        }
+
+        void addBytes(qint64 p_bytes)
+        {
+            m_bytes += p_bytes;
+        }
+
+    private:
+        BackendIoStats::Method m_method;
+
+        bool m_enabled = false;
+
+        qint64 m_bytes = 0;
+
+        QElapsedTimer m_timer;
+    };
+}
+
+InstrumentedNotebookBackend::InstrumentedNotebookBackend(const QSharedPointer<INotebookBackend> &p_backend,
+                                                         QObject *p_parent)
+    : INotebookBackend(p_backend->getRootPath(), p_parent),
+      m_backend(p_backend)
+{
+}
+
+QString InstrumentedNotebookBackend::getName() const
+{
+    return m_backend->getName();
+}
+
+QString InstrumentedNotebookBackend::getDisplayName() const
+{
+    return m_backend->getDisplayName();
+}
+
+QString InstrumentedNotebookBackend::getDescription() const
+{
+    return m_backend->getDescription();
+}
+
+bool InstrumentedNotebookBackend::isReadOnly() const
+{
+    return m_backend->isReadOnly();
+}
+
+bool InstrumentedNotebookBackend::isLocalFileSystem() const
+{
+    return m_backend->isLocalFileSystem();
+}
+
+bool InstrumentedNotebookBackend::isEmptyDir(const QString &p_dirPath) const
+{
+    Sample sample(BackendIoStats::IsEmptyDir);
+    return m_backend->isEmptyDir(p_dirPath);
+}
+
+void InstrumentedNotebookBackend::makePath(const QString &p_dirPath)
+{
+    Sample sample(BackendIoStats::MakePath);
+    m_backend->makePath(p_dirPath);
+}
+
+void InstrumentedNotebookBackend::writeFile(const QString &p_filePath, const QByteArray &p_data)
+{
+    Sample sample(BackendIoStats::WriteFile);
+    sample.addBytes(p_data.size());
+    m_backend->writeFile(p_filePath, p_data);
+}
+
+void InstrumentedNotebookBackend::writeFile(const QString &p_filePath, const QString &p_text)
+{
+    Sample sample(BackendIoStats::WriteFile);
+    if (sample.isEnabled()) {
+        sample.addBytes(p_text.toUtf8().size());
+    }
+    m_backend->writeFile(p_filePath, p_text);
+}
+
+void InstrumentedNotebookBackend::writeFile(const QString &p_filePath, const QJsonObject &p_jobj)
+{
+    // Serialize here to count the bytes, the same as the decorated backends do.
+    writeFile(p_filePath, QJsonDocument(p_jobj).toJson());
+}
+
+QString InstrumentedNotebookBackend::readTextFile(const QString &p_filePath)
+{
+    Sample sample(BackendIoStats::ReadFile);
+    auto text = m_backend->readTextFile(p_filePath);
+    if (sample.isEnabled()) {
+        sample.addBytes(text.toUtf8().size());
+    }
+    return text;
+}
+
+QByteArray InstrumentedNotebookBackend::readFile(const QString &p_filePath)
+{
+    Sample sample(BackendIoStats::ReadFile);
+    auto data = m_backend->readFile(p_filePath);
+    sample.addBytes(data.size());
+    return data;
+}
+
+bool InstrumentedNotebookBackend::exists(const QString &p_path) const
+{
+    Sample sample(BackendIoStats::Exists);
+    return m_backend->exists(p_path);
+}
+
+bool InstrumentedNotebookBackend::existsFile(const QString &p_path) const
+{
+    Sample sample(BackendIoStats::ExistsFile);
+    return m_backend->existsFile(p_path);
+}
+
+bool InstrumentedNotebookBackend::existsDir(const QString &p_path) const
+{
+    Sample sample(BackendIoStats::ExistsDir);
+    return m_backend->existsDir(p_path);
+}
+
+bool InstrumentedNotebookBackend::childExistsCaseInsensitive(const QString &p_dirPath, const QString &p_name) const
+{
+    Sample sample(BackendIoStats::ChildExistsCaseInsensitive);
+    return m_backend->childExistsCaseInsensitive(p_dirPath, p_name);
+}
+
+bool InstrumentedNotebookBackend::isFile(const QString &p_path) const
+{
+    Sample sample(BackendIoStats::IsFile);
+    return m_backend->isFile(p_path);
+}
+
+void InstrumentedNotebookBackend::renameFile(const QString &p_filePath, const QString &p_name)
+{
+    Sample sample(BackendIoStats::RenameFile);
+    m_backend->renameFile(p_filePath, p_name);
+}
+
+void InstrumentedNotebookBackend::renameDir(const QString &p_dirPath, const QString &p_name)
+{
+    Sample sample(BackendIoStats::RenameDir);
+    m_backend->renameDir(p_dirPath, p_name);
+}
+
+void InstrumentedNotebookBackend::removeFile(const QString &p_filePath)
+{
+    Sample sample(BackendIoStats::RemoveFile);
+    m_backend->removeFile(p_filePath);
+}
+
+bool InstrumentedNotebookBackend::removeDirIfEmpty(const QString &p_dirPath)
+{
+    Sample sample(BackendIoStats::RemoveDirIfEmpty);
+    return m_backend->removeDirIfEmpty(p_dirPath);
+}
+
+void InstrumentedNotebookBackend::removeDir(const QString &p_dirPath)
+{
+    Sample sample(BackendIoStats::RemoveDir);
+    m_backend->removeDir(p_dirPath);
+}
+
+void InstrumentedNotebookBackend::copyFile(const QString &p_filePath, const QString &p_destPath, bool p_move)
+{
+    Sample sample(BackendIoStats::CopyFile);
+    m_backend->copyFile(p_filePath, p_destPath, p_move);
+}
+
+void InstrumentedNotebookBackend::copyDir(const QString &p_dirPath, const QString &p_destPath, bool p_move)
+{
+    Sample sample(BackendIoStats::CopyDir);
+    m_backend->copyDir(p_dirPath, p_destPath, p_move);
+}
+
+QString InstrumentedNotebookBackend::renameIfExistsCaseInsensitive(const QString &p_path) const
+{
+    Sample sample(BackendIoStats::RenameIfExistsCaseInsensitive);
+    return m_backend->renameIfExistsCaseInsensitive(p_path);
+}
+
+void InstrumentedNotebookBackend::addFile(const QString &p_path)
+{
+    m_backend->addFile(p_path);
+}
+
+void InstrumentedNotebookBackend::removeEmptyDir(const QString &p_dirPath)
+{
+    Sample sample(BackendIoStats::RemoveEmptyDir);
+    m_backend->removeEmptyDir(p_dirPath);
+}
+
+const QSharedPointer<INotebookBackend> &InstrumentedNotebookBackend::getBackend() const
+{
+    return m_backend;
+}
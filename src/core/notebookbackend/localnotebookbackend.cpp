@@ -37,6 +37,16 @@ QString LocalNotebookBackend::getDescription() const
     return m_info.m_description;
 }
 
+bool LocalNotebookBackend::isReadOnly() const
+{
+    return false;
+}
+
+bool LocalNotebookBackend::isLocalFileSystem() const
+{
+    return true;
+}
+
 bool LocalNotebookBackend::isEmptyDir(const QString &p_dirPath) const
 {
     return PathUtils::isEmptyDir(getFullPath(p_dirPath));
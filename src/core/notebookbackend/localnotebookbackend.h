@@ -24,6 +24,10 @@ namespace vnotex
 
         QString getDescription() const Q_DECL_OVERRIDE;
 
+        bool isReadOnly() const Q_DECL_OVERRIDE;
+
+        bool isLocalFileSystem() const Q_DECL_OVERRIDE;
+
         // Whether @p_dirPath is an empty directory.
         bool isEmptyDir(const QString &p_dirPath) const Q_DECL_OVERRIDE;
 
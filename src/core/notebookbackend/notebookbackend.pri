@@ -1,10 +1,22 @@
 SOURCES += \
     $$PWD/localnotebookbackend.cpp \
     $$PWD/localnotebookbackendfactory.cpp \
+    $$PWD/inmemorynotebookbackend.cpp \
+    $$PWD/inmemorynotebookbackendfactory.cpp \
+    $$PWD/packednotebookbackend.cpp \
+    $$PWD/packednotebookbackendfactory.cpp \
+    $$PWD/instrumentednotebookbackend.cpp \
+    $$PWD/backendiostats.cpp \
     $$PWD/inotebookbackend.cpp
 
 HEADERS += \
     $$PWD/inotebookbackend.h \
     $$PWD/localnotebookbackend.h \
     $$PWD/inotebookbackendfactory.h \
-    $$PWD/localnotebookbackendfactory.h
+    $$PWD/localnotebookbackendfactory.h \
+    $$PWD/inmemorynotebookbackend.h \
+    $$PWD/inmemorynotebookbackendfactory.h \
+    $$PWD/packednotebookbackend.h \
+    $$PWD/packednotebookbackendfactory.h \
+    $$PWD/instrumentednotebookbackend.h \
+    $$PWD/backendiostats.h
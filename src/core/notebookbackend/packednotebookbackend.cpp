@@ -0,0 +1,678 @@
+#include "packednotebookbackend.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QSet>
+#include <QVector>
+#include <QDebug>
+
+#include <utils/pathutils.h>
+#include "exception.h"
+#include <utils/fileutils.h>
+
+using namespace vnotex;
+
+// Layout of the archive:
+// - header: magic (quint32), version (quint32), index offset (quint64), entry count (quint32);
+// - data of all files;
+// - index: for each entry, path (QString), is dir (quint8), offset (quint64), size (quint64).
+static const quint32 c_archiveMagic = 0x56585041;
+
+static const quint32 c_archiveVersion = 1;
+
+static const int c_headerSize = 20;
+
+const QString PackedNotebookBackend::c_archivePath = "vx_notebook/notebook.vxpack";
+
+static QString parentKey(const QString &p_key)
+{
+    const int idx = p_key.lastIndexOf(QLatin1Char('/'));
+    return idx == -1 ? QString() : p_key.left(idx);
+}
+
+// Prefix of the keys of all the descendants of @p_key.
+static QString descendantPrefix(const QString &p_key)
+{
+    return p_key.isEmpty() ? p_key : p_key + QLatin1Char('/');
+}
+
+PackedNotebookBackend::PackedNotebookBackend(const QString &p_name,
+                                             const QString &p_displayName,
+                                             const QString &p_description,
+                                             const QString &p_rootPath,
+                                             QObject *p_parent)
+    : INotebookBackend(p_rootPath, p_parent),
+      m_info(p_name, p_displayName, p_description)
+{
+    openArchive();
+    scanOverlay(QString());
+}
+
+PackedNotebookBackend::~PackedNotebookBackend()
+{
+    closeArchive();
+}
+
+QString PackedNotebookBackend::getName() const
+{
+    return m_info.m_name;
+}
+
+QString PackedNotebookBackend::getDisplayName() const
+{
+    return m_info.m_displayName;
+}
+
+QString PackedNotebookBackend::getDescription() const
+{
+    return m_info.m_description;
+}
+
+bool PackedNotebookBackend::isReadOnly() const
+{
+    return m_mappedData != nullptr;
+}
+
+bool PackedNotebookBackend::isLocalFileSystem() const
+{
+    return m_mappedData == nullptr;
+}
+
+void PackedNotebookBackend::openArchive()
+{
+    m_archiveFile.setFileName(getFullPath(c_archivePath));
+    if (!m_archiveFile.exists()) {
+        return;
+    }
+
+    if (!m_archiveFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "failed to open notebook archive" << m_archiveFile.fileName();
+        return;
+    }
+
+    m_mappedSize = m_archiveFile.size();
+    if (m_mappedSize >= c_headerSize) {
+        m_mappedData = m_archiveFile.map(0, m_mappedSize);
+    }
+
+    if (!m_mappedData) {
+        qWarning() << "failed to map notebook archive" << m_archiveFile.fileName();
+        closeArchive();
+        return;
+    }
+
+    const auto header = QByteArray::fromRawData(reinterpret_cast<const char *>(m_mappedData), c_headerSize);
+    QDataStream headerIn(header);
+    headerIn.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint64 indexOffset = 0;
+    quint32 cnt = 0;
+    headerIn >> magic >> version >> indexOffset >> cnt;
+    if (magic != c_archiveMagic
+        || version != c_archiveVersion
+        || indexOffset < static_cast<quint64>(c_headerSize)
+        || indexOffset > static_cast<quint64>(m_mappedSize)) {
+        qWarning() << "invalid notebook archive" << m_archiveFile.fileName();
+        closeArchive();
+        return;
+    }
+
+    const auto index = QByteArray::fromRawData(reinterpret_cast<const char *>(m_mappedData + indexOffset),
+                                               static_cast<int>(m_mappedSize - indexOffset));
+    QDataStream in(index);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    // Root.
+    ArchiveEntry rootEntry;
+    rootEntry.m_isDir = true;
+    m_entries.insert(QString(), rootEntry);
+
+    for (quint32 i = 0; i < cnt; ++i) {
+        QString path;
+        quint8 isDir = 0;
+        quint64 offset = 0;
+        quint64 size = 0;
+        in >> path >> isDir >> offset >> size;
+        if (in.status() != QDataStream::Ok || offset + size > indexOffset) {
+            qWarning() << "corrupted index of notebook archive" << m_archiveFile.fileName();
+            closeArchive();
+            return;
+        }
+
+        ArchiveEntry entry;
+        entry.m_isDir = isDir;
+        entry.m_offset = static_cast<qint64>(offset);
+        entry.m_size = static_cast<qint64>(size);
+        m_entries.insert(path, entry);
+    }
+}
+
+void PackedNotebookBackend::closeArchive()
+{
+    if (m_mappedData) {
+        m_archiveFile.unmap(m_mappedData);
+        m_mappedData = nullptr;
+    }
+
+    m_mappedSize = 0;
+    m_entries.clear();
+    m_archiveFile.close();
+}
+
+bool PackedNotebookBackend::isEmptyDir(const QString &p_dirPath) const
+{
+    const auto key = toKey(p_dirPath);
+    if (typeOf(key) != EntryType::Dir) {
+        return false;
+    }
+
+    if (!archiveChildrenNames(key).isEmpty()) {
+        return false;
+    }
+
+    const auto dirPath = getFullPath(key);
+    return !QFileInfo::exists(dirPath) || PathUtils::isEmptyDir(dirPath);
+}
+
+void PackedNotebookBackend::makePath(const QString &p_dirPath)
+{
+    const auto key = toKey(p_dirPath);
+    if (typeOf(key) == EntryType::File) {
+        Exception::throwOne(Exception::Type::FailToCreateDir,
+                            QString("fail to create directory: %1").arg(p_dirPath));
+    }
+
+    makeOverlayPath(key);
+}
+
+void PackedNotebookBackend::writeFile(const QString &p_filePath, const QByteArray &p_data)
+{
+    const auto key = toKey(p_filePath);
+    if (typeOf(key) == EntryType::Dir) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_filePath));
+    }
+
+    // Redirect to the overlay.
+    makeOverlayPath(parentKey(key));
+    FileUtils::writeFile(getFullPath(key), p_data);
+    m_overlayEntries.insert(key, false);
+}
+
+void PackedNotebookBackend::writeFile(const QString &p_filePath, const QString &p_text)
+{
+    writeFile(p_filePath, p_text.toUtf8());
+}
+
+void PackedNotebookBackend::writeFile(const QString &p_filePath, const QJsonObject &p_jobj)
+{
+    writeFile(p_filePath, QJsonDocument(p_jobj).toJson());
+}
+
+QString PackedNotebookBackend::readTextFile(const QString &p_filePath)
+{
+    return QString::fromUtf8(readFile(p_filePath));
+}
+
+QByteArray PackedNotebookBackend::readFile(const QString &p_filePath)
+{
+    const auto key = toKey(p_filePath);
+    auto entry = findArchiveEntry(key);
+    if (entry) {
+        if (entry->m_isDir) {
+            Exception::throwOne(Exception::Type::FailToReadFile,
+                                QString("failed to read file: %1").arg(p_filePath));
+        }
+
+        return readArchiveFile(*entry);
+    }
+
+    return FileUtils::readFile(getFullPath(key));
+}
+
+bool PackedNotebookBackend::exists(const QString &p_path) const
+{
+    return typeOf(toKey(p_path)) != EntryType::None;
+}
+
+bool PackedNotebookBackend::existsFile(const QString &p_path) const
+{
+    return typeOf(toKey(p_path)) == EntryType::File;
+}
+
+bool PackedNotebookBackend::existsDir(const QString &p_path) const
+{
+    return typeOf(toKey(p_path)) == EntryType::Dir;
+}
+
+bool PackedNotebookBackend::childExistsCaseInsensitive(const QString &p_dirPath, const QString &p_name) const
+{
+    const auto key = toKey(p_dirPath);
+    const auto name = p_name.toLower();
+    const auto children = archiveChildrenNames(key);
+    for (const auto &child : children) {
+        if (child.toLower() == name) {
+            return true;
+        }
+    }
+
+    return FileUtils::childExistsCaseInsensitive(getFullPath(key), p_name);
+}
+
+bool PackedNotebookBackend::isFile(const QString &p_path) const
+{
+    return existsFile(p_path);
+}
+
+void PackedNotebookBackend::renameFile(const QString &p_filePath, const QString &p_name)
+{
+    Q_ASSERT(isFile(p_filePath));
+    const auto key = toKey(p_filePath);
+    if (isInArchive(key)) {
+        Exception::throwOne(Exception::Type::FailToRenameFile,
+                            QString("failed to rename file within read-only archive: %1").arg(p_filePath));
+    }
+
+    FileUtils::renameFile(getFullPath(key), p_name);
+    pruneOverlay(key);
+    scanOverlay(PathUtils::concatenateFilePath(parentKey(key), p_name));
+}
+
+void PackedNotebookBackend::renameDir(const QString &p_dirPath, const QString &p_name)
+{
+    Q_ASSERT(!isFile(p_dirPath));
+    const auto key = toKey(p_dirPath);
+    if (isInArchive(key)) {
+        Exception::throwOne(Exception::Type::FailToRenameFile,
+                            QString("failed to rename directory within read-only archive: %1").arg(p_dirPath));
+    }
+
+    FileUtils::renameFile(getFullPath(key), p_name);
+    pruneOverlay(key);
+    scanOverlay(PathUtils::concatenateFilePath(parentKey(key), p_name));
+}
+
+void PackedNotebookBackend::removeFile(const QString &p_filePath)
+{
+    Q_ASSERT(isFile(p_filePath));
+    const auto key = toKey(p_filePath);
+    if (isInArchive(key)) {
+        Exception::throwOne(Exception::Type::FailToRemoveFile,
+                            QString("failed to remove file within read-only archive: %1").arg(p_filePath));
+    }
+
+    FileUtils::removeFile(getFullPath(key));
+    pruneOverlay(key);
+}
+
+bool PackedNotebookBackend::removeDirIfEmpty(const QString &p_dirPath)
+{
+    Q_ASSERT(!isFile(p_dirPath));
+    const auto key = toKey(p_dirPath);
+    if (isInArchive(key)) {
+        return false;
+    }
+
+    bool ret = FileUtils::removeDirIfEmpty(getFullPath(key));
+    pruneOverlay(key);
+    return ret;
+}
+
+void PackedNotebookBackend::removeDir(const QString &p_dirPath)
+{
+    Q_ASSERT(!isFile(p_dirPath));
+    const auto key = toKey(p_dirPath);
+    if (isInArchive(key)) {
+        Exception::throwOne(Exception::Type::FailToRemoveFile,
+                            QString("failed to remove directory within read-only archive: %1").arg(p_dirPath));
+    }
+
+    FileUtils::removeDir(getFullPath(key));
+    pruneOverlay(key);
+}
+
+void PackedNotebookBackend::copyFile(const QString &p_filePath, const QString &p_destPath, bool p_move)
+{
+    auto filePath = p_filePath;
+    if (QFileInfo(filePath).isRelative()) {
+        filePath = getFullPath(filePath);
+    }
+
+    const auto destKey = toKey(p_destPath);
+    const bool inNotebook = PathUtils::pathContains(getRootPath(), filePath);
+    const ArchiveEntry *entry = inNotebook ? findArchiveEntry(toKey(filePath)) : nullptr;
+    if (!entry) {
+        // On disk.
+        makeOverlayPath(parentKey(destKey));
+        FileUtils::copyFile(filePath, getFullPath(destKey), p_move);
+        if (p_move && inNotebook) {
+            pruneOverlay(toKey(filePath));
+        }
+        m_overlayEntries.insert(destKey, false);
+        return;
+    }
+
+    if (p_move || entry->m_isDir || typeOf(destKey) != EntryType::None) {
+        Exception::throwOne(Exception::Type::FailToCopyFile,
+                            QString("failed to copy file: %1 %2").arg(p_filePath, p_destPath));
+    }
+
+    writeFile(destKey, readArchiveFile(*entry));
+}
+
+void PackedNotebookBackend::copyDir(const QString &p_dirPath, const QString &p_destPath, bool p_move)
+{
+    auto dirPath = p_dirPath;
+    if (QFileInfo(dirPath).isRelative()) {
+        dirPath = getFullPath(dirPath);
+    }
+
+    const auto destKey = toKey(p_destPath);
+    if (typeOf(destKey) != EntryType::None) {
+        Exception::throwOne(Exception::Type::FailToCopyDir,
+                            QString("target directory %1 already exists").arg(p_destPath));
+    }
+
+    const bool inNotebook = PathUtils::pathContains(getRootPath(), dirPath);
+    const auto srcKey = inNotebook ? toKey(dirPath) : QString();
+    if (inNotebook && isInArchive(srcKey)) {
+        if (p_move) {
+            Exception::throwOne(Exception::Type::FailToCopyDir,
+                                QString("failed to move directory within read-only archive: %1").arg(p_dirPath));
+        }
+
+        // Overlay first and then the archive.
+        const auto destPath = getFullPath(destKey);
+        if (QFileInfo::exists(dirPath)) {
+            FileUtils::copyDir(dirPath, destPath);
+        }
+        makeOverlayPath(destKey);
+        extractArchiveDir(srcKey, destPath);
+    } else {
+        makeOverlayPath(parentKey(destKey));
+        FileUtils::copyDir(dirPath, getFullPath(destKey), p_move);
+        if (p_move && inNotebook) {
+            pruneOverlay(srcKey);
+        }
+    }
+
+    scanOverlay(destKey);
+}
+
+QString PackedNotebookBackend::renameIfExistsCaseInsensitive(const QString &p_path) const
+{
+    const auto key = toKey(p_path);
+    const auto dirKey = parentKey(key);
+
+    QSet<QString> children;
+    for (const auto &child : archiveChildrenNames(dirKey)) {
+        children.insert(child.toLower());
+    }
+
+    QDir dir(getFullPath(dirKey));
+    for (const auto &child : dir.entryList(QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot)) {
+        children.insert(child.toLower());
+    }
+
+    QFileInfo fi(PathUtils::fileName(key));
+    const auto baseName = fi.completeBaseName();
+    const auto suffix = fi.suffix();
+    auto name = fi.fileName();
+    int idx = 1;
+    while (children.contains(name.toLower())) {
+        name = QString("%1_%2").arg(baseName, QString::number(idx));
+        if (!suffix.isEmpty()) {
+            name += QStringLiteral(".") + suffix;
+        }
+
+        ++idx;
+    }
+
+    return getFullPath(PathUtils::concatenateFilePath(dirKey, name));
+}
+
+void PackedNotebookBackend::addFile(const QString &p_path)
+{
+    Q_UNUSED(p_path);
+    // Do nothing for now.
+}
+
+void PackedNotebookBackend::removeEmptyDir(const QString &p_dirPath)
+{
+    const auto key = toKey(p_dirPath);
+    const auto dirPath = getFullPath(key);
+    if (QFileInfo::exists(dirPath)) {
+        FileUtils::removeEmptyDir(dirPath);
+        pruneOverlay(key);
+    }
+}
+
+const QString &PackedNotebookBackend::getArchivePath()
+{
+    return c_archivePath;
+}
+
+void PackedNotebookBackend::createArchive(const QString &p_folderPath,
+                                          const QString &p_archivePath,
+                                          const QStringList &p_excludedPaths)
+{
+    QFile file(p_archivePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_archivePath));
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    // Placeholder of header.
+    out << c_archiveMagic << c_archiveVersion << quint64(0) << quint32(0);
+
+    struct IndexEntry
+    {
+        QString m_path;
+
+        ArchiveEntry m_entry;
+    };
+    QVector<IndexEntry> index;
+
+    QDir dir(p_folderPath);
+    QDirIterator it(p_folderPath,
+                    QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoSymLinks | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const auto path = it.next();
+        if (PathUtils::areSamePaths(path, p_archivePath)) {
+            continue;
+        }
+
+        IndexEntry ie;
+        ie.m_path = PathUtils::cleanPath(dir.relativeFilePath(path));
+        if (p_excludedPaths.contains(ie.m_path)) {
+            continue;
+        }
+
+        if (it.fileInfo().isDir()) {
+            ie.m_entry.m_isDir = true;
+        } else {
+            const auto data = FileUtils::readFile(path);
+            ie.m_entry.m_offset = file.pos();
+            ie.m_entry.m_size = data.size();
+            out.writeRawData(data.constData(), data.size());
+        }
+        index.push_back(ie);
+    }
+
+    const quint64 indexOffset = file.pos();
+    for (const auto &ie : index) {
+        out << ie.m_path
+            << quint8(ie.m_entry.m_isDir ? 1 : 0)
+            << quint64(ie.m_entry.m_offset)
+            << quint64(ie.m_entry.m_size);
+    }
+
+    file.seek(0);
+    out << c_archiveMagic << c_archiveVersion << indexOffset << quint32(index.size());
+
+    if (out.status() != QDataStream::Ok) {
+        file.close();
+        file.remove();
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_archivePath));
+    }
+}
+
+QString PackedNotebookBackend::toKey(const QString &p_path) const
+{
+    auto key = getRelativePath(p_path);
+    if (key == QStringLiteral(".")) {
+        key.clear();
+    }
+    return key;
+}
+
+PackedNotebookBackend::EntryType PackedNotebookBackend::typeOf(const QString &p_key) const
+{
+    auto overlayIt = m_overlayEntries.constFind(p_key);
+    if (overlayIt != m_overlayEntries.constEnd()) {
+        return overlayIt.value() ? EntryType::Dir : EntryType::File;
+    }
+
+    auto archiveIt = m_entries.constFind(p_key);
+    if (archiveIt != m_entries.constEnd()) {
+        return archiveIt.value().m_isDir ? EntryType::Dir : EntryType::File;
+    }
+
+    // Files created on disk directly, such as the database.
+    QFileInfo fi(getFullPath(p_key));
+    if (!fi.exists()) {
+        return EntryType::None;
+    }
+    return fi.isDir() ? EntryType::Dir : EntryType::File;
+}
+
+const PackedNotebookBackend::ArchiveEntry *PackedNotebookBackend::findArchiveEntry(const QString &p_key) const
+{
+    auto it = m_entries.constFind(p_key);
+    if (it == m_entries.constEnd()) {
+        return nullptr;
+    }
+
+    if (!it.value().m_isDir && m_overlayEntries.contains(p_key)) {
+        return nullptr;
+    }
+
+    return &it.value();
+}
+
+bool PackedNotebookBackend::isInArchive(const QString &p_key) const
+{
+    if (m_entries.contains(p_key)) {
+        return true;
+    }
+
+    // Descendants.
+    const auto prefix = descendantPrefix(p_key);
+    auto it = m_entries.lowerBound(prefix);
+    return it != m_entries.constEnd() && it.key().startsWith(prefix);
+}
+
+QStringList PackedNotebookBackend::archiveChildrenNames(const QString &p_key) const
+{
+    QStringList names;
+    const auto prefix = descendantPrefix(p_key);
+    for (auto it = m_entries.lowerBound(prefix); it != m_entries.constEnd() && it.key().startsWith(prefix); ++it) {
+        const auto name = it.key().mid(prefix.size());
+        if (!name.isEmpty() && !name.contains(QLatin1Char('/'))) {
+            names << name;
+        }
+    }
+    return names;
+}
+
+QByteArray PackedNotebookBackend::readArchiveFile(const ArchiveEntry &p_entry) const
+{
+    Q_ASSERT(m_mappedData && p_entry.m_offset + p_entry.m_size <= m_mappedSize);
+    return QByteArray(reinterpret_cast<const char *>(m_mappedData + p_entry.m_offset),
+                      static_cast<int>(p_entry.m_size));
+}
+
+void PackedNotebookBackend::extractArchiveDir(const QString &p_key, const QString &p_destPath) const
+{
+    QDir destDir(p_destPath);
+    const auto prefix = descendantPrefix(p_key);
+    for (auto it = m_entries.lowerBound(prefix); it != m_entries.constEnd() && it.key().startsWith(prefix); ++it) {
+        const auto destPath = destDir.filePath(it.key().mid(prefix.size()));
+        if (it.value().m_isDir) {
+            if (!destDir.mkpath(destPath)) {
+                Exception::throwOne(Exception::Type::FailToCreateDir,
+                                    QString("fail to create directory: %1").arg(destPath));
+            }
+        } else if (!QFileInfo::exists(destPath)) {
+            FileUtils::writeFile(destPath, readArchiveFile(it.value()));
+        }
+    }
+}
+
+void PackedNotebookBackend::makeOverlayPath(const QString &p_key)
+{
+    QDir dir(getRootPath());
+    if (!dir.mkpath(p_key.isEmpty() ? QStringLiteral(".") : p_key)) {
+        Exception::throwOne(Exception::Type::FailToCreateDir,
+                            QString("fail to create directory: %1").arg(p_key));
+    }
+
+    QString key;
+    const auto parts = p_key.split(QLatin1Char('/'), QString::SkipEmptyParts);
+    for (const auto &part : parts) {
+        key = PathUtils::concatenateFilePath(key, part);
+        m_overlayEntries.insert(key, true);
+    }
+}
+
+void PackedNotebookBackend::scanOverlay(const QString &p_key)
+{
+    const auto path = getFullPath(p_key);
+    QFileInfo fi(path);
+    if (!fi.exists()) {
+        return;
+    }
+
+    if (!p_key.isEmpty()) {
+        m_overlayEntries.insert(p_key, fi.isDir());
+    }
+
+    if (!fi.isDir()) {
+        return;
+    }
+
+    QDir rootDir(getRootPath());
+    QDirIterator it(path,
+                    QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoSymLinks | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const auto key = PathUtils::cleanPath(rootDir.relativeFilePath(it.next()));
+        if (key == c_archivePath) {
+            continue;
+        }
+        m_overlayEntries.insert(key, it.fileInfo().isDir());
+    }
+}
+
+void PackedNotebookBackend::pruneOverlay(const QString &p_key)
+{
+    const auto prefix = descendantPrefix(p_key);
+    for (auto it = m_overlayEntries.begin(); it != m_overlayEntries.end();) {
+        if ((it.key() == p_key || it.key().startsWith(prefix))
+            && !QFileInfo::exists(getFullPath(it.key()))) {
+            it = m_overlayEntries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
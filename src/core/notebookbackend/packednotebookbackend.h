@@ -0,0 +1,175 @@
+#ifndef PACKEDNOTEBOOKBACKEND_H
+#define PACKEDNOTEBOOKBACKEND_H
+
+#include "inotebookbackend.h"
+
+#include <QMap>
+#include <QHash>
+#include <QFile>
+
+#include "../global.h"
+
+namespace vnotex
+{
+    // Backend to serve a notebook from one packed archive file via memory mapping.
+    // The archive is located at getArchivePath() under the root folder. Everything else under
+    // the root folder forms a writable overlay: writes go to the overlay and shadow the archive,
+    // while renaming or removing entries of the archive is rejected.
+    // It falls back to a plain local backend if there is no archive.
+    class PackedNotebookBackend : public INotebookBackend
+    {
+        Q_OBJECT
+    public:
+        explicit PackedNotebookBackend(const QString &p_name,
+                                       const QString &p_displayName,
+                                       const QString &p_description,
+                                       const QString &p_rootPath,
+                                       QObject *p_parent = nullptr);
+
+        ~PackedNotebookBackend();
+
+        QString getName() const Q_DECL_OVERRIDE;
+
+        QString getDisplayName() const Q_DECL_OVERRIDE;
+
+        QString getDescription() const Q_DECL_OVERRIDE;
+
+        bool isReadOnly() const Q_DECL_OVERRIDE;
+
+        bool isLocalFileSystem() const Q_DECL_OVERRIDE;
+
+        // Whether @p_dirPath is an empty directory.
+        bool isEmptyDir(const QString &p_dirPath) const Q_DECL_OVERRIDE;
+
+        // Create the directory path @p_dirPath. Create all parent directories if necessary.
+        void makePath(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        // Write @p_data to @p_filePath.
+        void writeFile(const QString &p_filePath, const QByteArray &p_data) Q_DECL_OVERRIDE;
+
+        // Write @p_text to @p_filePath.
+        void writeFile(const QString &p_filePath, const QString &p_text) Q_DECL_OVERRIDE;
+
+        // Write @p_jobj to @p_filePath.
+        void writeFile(const QString &p_filePath, const QJsonObject &p_jobj) Q_DECL_OVERRIDE;
+
+        // Read content from @p_filePath.
+        QString readTextFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        // Read file @p_filePath.
+        QByteArray readFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        bool exists(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool existsFile(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool existsDir(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        bool childExistsCaseInsensitive(const QString &p_dirPath, const QString &p_name) const Q_DECL_OVERRIDE;
+
+        bool isFile(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        void renameFile(const QString &p_filePath, const QString &p_name) Q_DECL_OVERRIDE;
+
+        void renameDir(const QString &p_dirPath, const QString &p_name) Q_DECL_OVERRIDE;
+
+        // Delete @p_filePath from the overlay.
+        void removeFile(const QString &p_filePath) Q_DECL_OVERRIDE;
+
+        // Delete @p_dirPath from the overlay if it is empty.
+        bool removeDirIfEmpty(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        void removeDir(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        // Copy @p_filePath to @p_destPath.
+        // @p_filePath may beyond this notebook backend.
+        void copyFile(const QString &p_filePath, const QString &p_destPath, bool p_move = false) Q_DECL_OVERRIDE;
+
+        // Copy @p_dirPath to as @p_destPath.
+        void copyDir(const QString &p_dirPath, const QString &p_destPath, bool p_move = false) Q_DECL_OVERRIDE;
+
+        QString renameIfExistsCaseInsensitive(const QString &p_path) const Q_DECL_OVERRIDE;
+
+        void addFile(const QString &p_path) Q_DECL_OVERRIDE;
+
+        void removeEmptyDir(const QString &p_dirPath) Q_DECL_OVERRIDE;
+
+        // Relative path of the archive file within the root folder.
+        static const QString &getArchivePath();
+
+        // Pack all the files and directories of @p_folderPath into archive @p_archivePath.
+        // @p_excludedPaths: paths relative to @p_folderPath to skip.
+        static void createArchive(const QString &p_folderPath,
+                                  const QString &p_archivePath,
+                                  const QStringList &p_excludedPaths = QStringList());
+
+    private:
+        struct ArchiveEntry
+        {
+            bool m_isDir = false;
+
+            qint64 m_offset = 0;
+
+            qint64 m_size = 0;
+        };
+
+        enum class EntryType
+        {
+            None,
+            File,
+            Dir
+        };
+
+        void openArchive();
+
+        void closeArchive();
+
+        // Get the key of @p_path, which is the cleaned relative path and empty for root.
+        QString toKey(const QString &p_path) const;
+
+        // Look up the overlay first, then the archive and the disk at last.
+        EntryType typeOf(const QString &p_key) const;
+
+        // Return the archive entry of @p_key if it is not shadowed by the overlay.
+        const ArchiveEntry *findArchiveEntry(const QString &p_key) const;
+
+        // Whether @p_key or any of its descendants comes from the archive.
+        bool isInArchive(const QString &p_key) const;
+
+        // Names of direct children of @p_key within the archive.
+        QStringList archiveChildrenNames(const QString &p_key) const;
+
+        QByteArray readArchiveFile(const ArchiveEntry &p_entry) const;
+
+        // Write archive directory @p_key to @p_destPath on disk without overwriting existing files.
+        void extractArchiveDir(const QString &p_key, const QString &p_destPath) const;
+
+        // Make sure directories of the overlay exist for @p_key.
+        void makeOverlayPath(const QString &p_key);
+
+        // Record @p_key and all its descendants on disk into the overlay.
+        void scanOverlay(const QString &p_key);
+
+        // Drop @p_key and all its descendants from the overlay if they no longer exist on disk.
+        void pruneOverlay(const QString &p_key);
+
+        Info m_info;
+
+        QFile m_archiveFile;
+
+        uchar *m_mappedData = nullptr;
+
+        qint64 m_mappedSize = 0;
+
+        // Sorted so that descendants of one directory are adjacent.
+        QMap<QString, ArchiveEntry> m_entries;
+
+        // Entries of the overlay on disk, mapping key to whether it is a directory.
+        // Overlay takes precedence over the archive.
+        QHash<QString, bool> m_overlayEntries;
+
+        static const QString c_archivePath;
+    };
+} // ns vnotex
+
+#endif // PACKEDNOTEBOOKBACKEND_H
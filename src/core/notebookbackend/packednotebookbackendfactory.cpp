@@ -0,0 +1,39 @@
+#include "packednotebookbackendfactory.h"
+
+#include <QObject>
+
+#include "packednotebookbackend.h"
+
+using namespace vnotex;
+
+PackedNotebookBackendFactory::PackedNotebookBackendFactory()
+{
+}
+
+QString PackedNotebookBackendFactory::getName() const
+{
+    return QStringLiteral("packed.vnotex");
+}
+
+QString PackedNotebookBackendFactory::getDisplayName() const
+{
+    return QObject::tr("Packed Notebook Backend");
+}
+
+QString PackedNotebookBackendFactory::getDescription() const
+{
+    return QObject::tr("Read-only packed archive with a local overlay");
+}
+
+bool PackedNotebookBackendFactory::isCreatable() const
+{
+    return false;
+}
+
+QSharedPointer<INotebookBackend> PackedNotebookBackendFactory::createNotebookBackend(const QString &p_rootPath)
+{
+    return QSharedPointer<PackedNotebookBackend>::create(getName(),
+                                                         getDisplayName(),
+                                                         getDescription(),
+                                                         p_rootPath);
+}
@@ -0,0 +1,26 @@
+#ifndef PACKEDNOTEBOOKBACKENDFACTORY_H
+#define PACKEDNOTEBOOKBACKENDFACTORY_H
+
+#include "inotebookbackendfactory.h"
+
+namespace vnotex
+{
+    class PackedNotebookBackendFactory : public INotebookBackendFactory
+    {
+    public:
+        PackedNotebookBackendFactory();
+
+        QString getName() const Q_DECL_OVERRIDE;
+
+        QString getDisplayName() const Q_DECL_OVERRIDE;
+
+        QString getDescription()const Q_DECL_OVERRIDE;
+
+        QSharedPointer<INotebookBackend> createNotebookBackend(const QString &p_rootPath) Q_DECL_OVERRIDE;
+
+        // Archives are produced by PackedNotebookBackend::createArchive(), not by creating a notebook.
+        bool isCreatable() const Q_DECL_OVERRIDE;
+    };
+} // ns vnotex
+
+#endif // PACKEDNOTEBOOKBACKENDFACTORY_H
@@ -41,6 +41,13 @@ namespace vnotex
         virtual void loadNode(Node *p_node) = 0;
         virtual void saveNode(const Node *p_node) = 0;
 
+        // Re-read the config of loaded container node @p_node from disk and merge it into
+        // the existing children instead of rebuilding the subtree.
+        // Children are kept in the order of the config.
+        // Config written by ourselves is not parsed again, so changes caused by our own writes are cheap.
+        // Return true if anything of @p_node or its direct children changes.
+        virtual bool reloadNode(Node *p_node) = 0;
+
         virtual void renameNode(Node *p_node, const QString &p_name) = 0;
 
         virtual QSharedPointer<Node> newNode(Node *p_parent,
@@ -4,6 +4,8 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QDebug>
+#include <QSet>
+#include <QCryptographicHash>
 
 #include <notebookbackend/inotebookbackend.h>
 #include <notebook/notebookparameters.h>
@@ -11,6 +13,7 @@
 #include <notebook/externalnode.h>
 #include <notebook/bundlenotebook.h>
 #include <notebook/notebookdatabaseaccess.h>
+#include <notebook/tagi.h>
 #include <utils/utils.h>
 #include <utils/fileutils.h>
 #include <utils/pathutils.h>
@@ -91,6 +94,10 @@ QSharedPointer<Node> VXNotebookConfigMgr::loadRootNode()
     root->setExists(true);
     Q_ASSERT(root->isLoaded());
 
+    if (getBackend()->isReadOnly()) {
+        markNodeReadOnly(root.data());
+    }
+
     if (static_cast<BundleNotebook *>(getNotebook())->getConfigVersion() < 3) {
         removeLegacyRecycleBinNode(root);
     }
@@ -133,15 +140,29 @@ QSharedPointer<NodeConfig> VXNotebookConfigMgr::readNodeConfig(const QString &p_
                             QString("node (%1) is a file node without config").arg(p_path));
     } else {
         auto configPath = PathUtils::concatenateFilePath(p_path, c_nodeConfigName);
-        auto data = backend->readFile(configPath);
-        auto nodeConfig = QSharedPointer<NodeConfig>::create();
-        nodeConfig->fromJson(QJsonDocument::fromJson(data).object());
-        return nodeConfig;
+        return parseNodeConfig(configPath, backend->readFile(configPath));
     }
 
     return nullptr;
 }
 
+QSharedPointer<NodeConfig> VXNotebookConfigMgr::parseNodeConfig(const QString &p_configPath,
+                                                                const QByteArray &p_data) const
+{
+    m_nodeConfigDigests.insert(p_configPath, QCryptographicHash::hash(p_data, QCryptographicHash::Sha1));
+
+    auto nodeConfig = QSharedPointer<NodeConfig>::create();
+    nodeConfig->fromJson(QJsonDocument::fromJson(p_data).object());
+    return nodeConfig;
+}
+
+bool VXNotebookConfigMgr::isKnownNodeConfig(const QString &p_configPath, const QByteArray &p_data) const
+{
+    auto it = m_nodeConfigDigests.constFind(p_configPath);
+    return it != m_nodeConfigDigests.constEnd()
+           && it.value() == QCryptographicHash::hash(p_data, QCryptographicHash::Sha1);
+}
+
 QString VXNotebookConfigMgr::getNodeConfigFilePath(const Node *p_node) const
 {
     Q_ASSERT(p_node->isContainer());
@@ -150,7 +171,9 @@ QString VXNotebookConfigMgr::getNodeConfigFilePath(const Node *p_node) const
 
 void VXNotebookConfigMgr::writeNodeConfig(const QString &p_path, const NodeConfig &p_config) const
 {
-    getBackend()->writeFile(p_path, p_config.toJson());
+    const auto data = QJsonDocument(p_config.toJson()).toJson();
+    getBackend()->writeFile(p_path, data);
+    m_nodeConfigDigests.insert(p_path, QCryptographicHash::hash(data, QCryptographicHash::Sha1));
 }
 
 void VXNotebookConfigMgr::writeNodeConfig(const Node *p_node)
@@ -406,19 +429,186 @@ void VXNotebookConfigMgr::saveNode(const Node *p_node)
     }
 }
 
+bool VXNotebookConfigMgr::reloadNode(Node *p_node)
+{
+    Q_ASSERT(p_node->isContainer());
+    if (!p_node->isLoaded()) {
+        // Will read the latest config on load.
+        return false;
+    }
+
+    const auto nodePath = p_node->fetchPath();
+    const bool exists = getBackend()->existsDir(nodePath);
+    bool changed = exists != p_node->exists();
+    p_node->setExists(exists);
+    if (!exists) {
+        return changed;
+    }
+
+    const auto configPath = getNodeConfigFilePath(p_node);
+    QSharedPointer<NodeConfig> config;
+    try {
+        const auto data = getBackend()->readFile(configPath);
+        if (isKnownNodeConfig(configPath, data)) {
+            // Config is not changed outside, such as our own writes of the config or notes.
+            // Only files or folders removed or restored outside matter.
+            return updateChildrenExistence(p_node) || changed;
+        }
+
+        config = parseNodeConfig(configPath, data);
+    } catch (Exception &p_e) {
+        qWarning() << "failed to reload node config" << nodePath << p_e.what();
+        return changed;
+    }
+
+    ensureNodeInDatabase(p_node);
+
+    // Go through TagI to keep the in-memory tag graph in sync.
+    auto tagI = getNotebook()->tag();
+
+    // Children in the order of config. Folders go before files.
+    QVector<QSharedPointer<Node>> orderedChildren;
+    QVector<QSharedPointer<Node>> newChildren;
+    QSet<const Node *> keptChildren;
+
+    for (const auto &folder : config->m_folders) {
+        if (folder.m_name.isEmpty()) {
+            continue;
+        }
+
+        auto child = p_node->findChild(folder.m_name, true);
+        if (child && child->isContainer()) {
+            if (keptChildren.contains(child.data())) {
+                // Duplicated in config.
+                continue;
+            }
+            keptChildren.insert(child.data());
+        } else {
+            child = QSharedPointer<VXNode>::create(folder.m_name, getNotebook(), p_node);
+            newChildren.push_back(child);
+        }
+        orderedChildren.push_back(child);
+
+        const bool childExists = getBackend()->existsDir(PathUtils::concatenateFilePath(nodePath, folder.m_name));
+        if (child->exists() != childExists) {
+            child->setExists(childExists);
+            changed = true;
+        }
+    }
+
+    for (const auto &file : config->m_files) {
+        if (file.m_name.isEmpty()) {
+            continue;
+        }
+
+        auto child = p_node->findChild(file.m_name, true);
+        if (child && !child->isContainer()) {
+            if (keptChildren.contains(child.data())) {
+                continue;
+            }
+            keptChildren.insert(child.data());
+            if (child->getModifiedTimeUtc() != file.m_modifiedTimeUtc) {
+                child->setModifiedTimeUtc(file.m_modifiedTimeUtc);
+                changed = true;
+            }
+            if (child->getAttachmentFolder() != file.m_attachmentFolder) {
+                child->setAttachmentFolder(file.m_attachmentFolder);
+                changed = true;
+            }
+            if (child->getTags() != file.m_tags) {
+                child->setTags(file.m_tags);
+                if (tagI) {
+                    tagI->updateNodeTags(child.data());
+                }
+                changed = true;
+            }
+        } else {
+            child = QSharedPointer<VXNode>::create(file.m_name,
+                                                   file.toNodeParameters(),
+                                                   getNotebook(),
+                                                   p_node);
+            newChildren.push_back(child);
+        }
+        orderedChildren.push_back(child);
+
+        const bool childExists = getBackend()->existsFile(PathUtils::concatenateFilePath(nodePath, file.m_name));
+        if (child->exists() != childExists) {
+            child->setExists(childExists);
+            changed = true;
+        }
+    }
+
+    // Children removed from config.
+    const auto oldChildren = p_node->getChildren();
+    for (const auto &child : oldChildren) {
+        if (keptChildren.contains(child.data())) {
+            continue;
+        }
+
+        removeNodeFromDatabase(child.data());
+        p_node->removeChild(child);
+        changed = true;
+    }
+
+    // Place new children and the reordered ones at their index in config.
+    for (int i = 0; i < orderedChildren.size(); ++i) {
+        const auto &child = orderedChildren[i];
+        const auto &children = p_node->getChildrenRef();
+        if (i < children.size() && children[i] == child) {
+            continue;
+        }
+
+        p_node->removeChild(child);
+        p_node->insertChild(i, child);
+        changed = true;
+    }
+
+    for (const auto &child : newChildren) {
+        addNodeToDatabase(child.data());
+        if (tagI && !child->getTags().isEmpty()) {
+            tagI->updateNodeTags(child.data());
+        }
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool VXNotebookConfigMgr::updateChildrenExistence(Node *p_node)
+{
+    bool changed = false;
+    const auto nodePath = p_node->fetchPath();
+    for (const auto &child : p_node->getChildrenRef()) {
+        const auto childPath = PathUtils::concatenateFilePath(nodePath, child->getName());
+        const bool childExists = child->isContainer() ? getBackend()->existsDir(childPath)
+                                                      : getBackend()->existsFile(childPath);
+        if (child->exists() != childExists) {
+            child->setExists(childExists);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
 void VXNotebookConfigMgr::renameNode(Node *p_node, const QString &p_name)
 {
     Q_ASSERT(!p_node->isRoot());
 
+    const auto oldPath = p_node->fetchPath();
     if (p_node->isContainer()) {
-        getBackend()->renameDir(p_node->fetchPath(), p_name);
+        getBackend()->renameDir(oldPath, p_name);
     } else {
-        getBackend()->renameFile(p_node->fetchPath(), p_name);
+        getBackend()->renameFile(oldPath, p_name);
     }
 
     p_node->setName(p_name);
     writeNodeConfig(p_node->getParent());
 
+    if (p_node->isContainer()) {
+        emit getNotebook()->nodePathChanged(p_node, oldPath);
+    }
+
     ensureNodeInDatabase(p_node);
     updateNodeInDatabase(p_node);
 }
@@ -504,14 +694,17 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFileNodeAsChildOf(const QSharedPoi
                                                                 bool p_move,
                                                                 bool p_updateDatabase)
 {
+    auto notebook = getNotebook();
+    const bool sameNotebook = p_src->getNotebook() == notebook;
+
+    // Attachments could be moved directly within the same notebook.
+    const bool moveAttachment = p_move && sameNotebook;
+
     QString destFilePath;
     QString attachmentFolder;
-    copyFilesOfFileNode(p_src, p_dest->fetchPath(), destFilePath, attachmentFolder);
+    copyFilesOfFileNode(p_src, p_dest->fetchPath(), moveAttachment, destFilePath, attachmentFolder);
 
     // Create a file node.
-    auto notebook = getNotebook();
-    const bool sameNotebook = p_src->getNotebook() == notebook;
-
     if (p_updateDatabase) {
         ensureNodeInDatabase(p_dest);
         if (sameNotebook) {
@@ -535,7 +728,25 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFileNodeAsChildOf(const QSharedPoi
     destNode->setExists(true);
 
     addChildNode(p_dest, destNode);
-    writeNodeConfig(p_dest);
+    try {
+        writeNodeConfig(p_dest);
+    } catch (Exception &p_e) {
+        // Roll back to keep the source node intact.
+        qWarning() << "failed to add copied node" << destFilePath << p_e.what();
+        if (moveAttachment && !attachmentFolder.isEmpty()) {
+            getBackend()->copyDir(destNode->fetchAttachmentFolderPath(),
+                                  p_src->fetchAttachmentFolderPath(),
+                                  true);
+        }
+        p_dest->removeChild(destNode);
+        getBackend()->removeFile(destFilePath);
+        throw;
+    }
+
+    if (moveAttachment) {
+        // Already moved. Do not remove it with the source node.
+        p_src->setAttachmentFolder(QString());
+    }
 
     if (p_updateDatabase) {
         if (p_move && sameNotebook) {
@@ -565,6 +776,13 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFolderNodeAsChildOf(const QSharedP
                                                                   bool p_move,
                                                                   bool p_updateDatabase)
 {
+    auto notebook = getNotebook();
+    const bool sameNotebook = p_src->getNotebook() == notebook;
+
+    if (p_move && sameNotebook) {
+        return moveFolderNodeAsChildOf(p_src, p_dest, p_updateDatabase);
+    }
+
     auto destFolderPath = PathUtils::concatenateFilePath(p_dest->fetchPath(), p_src->getName());
     destFolderPath = getBackend()->renameIfExistsCaseInsensitive(destFolderPath);
 
@@ -572,9 +790,6 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFolderNodeAsChildOf(const QSharedP
     getBackend()->makePath(destFolderPath);
 
     // Create a folder node.
-    auto notebook = getNotebook();
-    const bool sameNotebook = p_src->getNotebook() == notebook;
-
     if (p_updateDatabase) {
         ensureNodeInDatabase(p_dest);
         if (sameNotebook) {
@@ -628,6 +843,57 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFolderNodeAsChildOf(const QSharedP
     return destNode;
 }
 
+QSharedPointer<Node> VXNotebookConfigMgr::moveFolderNodeAsChildOf(const QSharedPointer<Node> &p_src,
+                                                                  Node *p_dest,
+                                                                  bool p_updateDatabase)
+{
+    Q_ASSERT(sameNotebook(p_src.data()));
+
+    if (p_updateDatabase) {
+        ensureNodeInDatabase(p_dest);
+        ensureNodeInDatabase(p_src.data());
+    }
+
+    auto destFolderPath = PathUtils::concatenateFilePath(p_dest->fetchPath(), p_src->getName());
+    destFolderPath = getBackend()->renameIfExistsCaseInsensitive(destFolderPath);
+
+    // Move the whole folder including node configs, images and attachments.
+    // It is one single rename if they locate on the same device.
+    const auto oldPath = p_src->fetchPath();
+    const auto oldName = p_src->getName();
+    getBackend()->copyDir(oldPath, destFolderPath, true);
+
+    // Reuse the node and its loaded children.
+    auto srcParent = p_src->getParent();
+    const int srcIdx = srcParent->getChildrenRef().indexOf(p_src);
+    srcParent->removeChild(p_src);
+    p_src->setName(PathUtils::fileName(destFolderPath));
+    addChildNode(p_dest, p_src);
+    try {
+        writeNodeConfig(srcParent);
+        writeNodeConfig(p_dest);
+    } catch (Exception &p_e) {
+        // Undo the rename and restore both configs.
+        qWarning() << "failed to move folder node" << oldPath << p_e.what();
+        p_dest->removeChild(p_src);
+        p_src->setName(oldName);
+        srcParent->insertChild(srcIdx, p_src);
+        getBackend()->copyDir(destFolderPath, oldPath, true);
+        writeNodeConfig(srcParent);
+        writeNodeConfig(p_dest);
+        throw;
+    }
+
+    if (p_updateDatabase) {
+        // Children are linked to it by ID.
+        updateNodeInDatabase(p_src.data());
+    }
+
+    emit getNotebook()->nodePathChanged(p_src.data(), oldPath);
+
+    return p_src;
+}
+
 void VXNotebookConfigMgr::removeNode(const QSharedPointer<Node> &p_node, bool p_force, bool p_configOnly)
 {
     removeNode(p_node, p_force, p_configOnly, true);
@@ -734,13 +1000,15 @@ void VXNotebookConfigMgr::removeFileNodeToFolder(const QSharedPointer<Node> &p_n
 
     QString destFilePath;
     QString attachmentFolder;
-    copyFilesOfFileNode(p_node, destFolderPath, destFilePath, attachmentFolder);
+    copyFilesOfFileNode(p_node, destFolderPath, true, destFilePath, attachmentFolder);
+    p_node->setAttachmentFolder(QString());
 
     removeNode(p_node, false, false);
 }
 
 void VXNotebookConfigMgr::copyFilesOfFileNode(const QSharedPointer<Node> &p_node,
                                               const QString &p_destFolder,
+                                              bool p_moveAttachment,
                                               QString &p_destFilePath,
                                               QString &p_attachmentFolder)
 {
@@ -751,13 +1019,29 @@ void VXNotebookConfigMgr::copyFilesOfFileNode(const QSharedPointer<Node> &p_node
     getBackend()->copyFile(nodeFilePath, p_destFilePath);
 
     // Copy media files fetched from content.
-    ContentMediaUtils::copyMediaFiles(p_node.data(), getBackend().data(), p_destFilePath);
+    try {
+        ContentMediaUtils::copyMediaFiles(p_node.data(), getBackend().data(), p_destFilePath);
+    } catch (Exception &p_e) {
+        qWarning() << "failed to copy media files of node" << p_node->fetchPath() << p_e.what();
+        getBackend()->removeFile(p_destFilePath);
+        throw;
+    }
 
-    // Copy attachment folder. Rename attachment folder if conflicts.
+    // Copy attachment folder as the last step, so a moved attachment never needs to be
+    // rolled back here. Rename attachment folder if conflicts.
     p_attachmentFolder = p_node->getAttachmentFolder();
     if (!p_attachmentFolder.isEmpty()) {
         auto destAttachmentFolderPath = fetchNodeAttachmentFolder(p_destFilePath, p_attachmentFolder);
-        ContentMediaUtils::copyAttachment(p_node.data(), getBackend().data(), p_destFilePath, destAttachmentFolderPath);
+        if (!ContentMediaUtils::copyAttachment(p_node.data(),
+                                               getBackend().data(),
+                                               p_destFilePath,
+                                               destAttachmentFolderPath,
+                                               p_moveAttachment)) {
+            getBackend()->removeFile(p_destFilePath);
+            Exception::throwOne(Exception::Type::FailToCopyDir,
+                                QString("failed to copy attachment folder of node (%1) to (%2)")
+                                       .arg(p_node->fetchPath(), destAttachmentFolderPath));
+        }
     }
 }
 
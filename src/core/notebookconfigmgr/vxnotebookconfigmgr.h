@@ -6,6 +6,7 @@
 #include <QDateTime>
 #include <QVector>
 #include <QRegExp>
+#include <QHash>
 
 #include <core/global.h>
 
@@ -42,6 +43,8 @@ namespace vnotex
         void loadNode(Node *p_node) Q_DECL_OVERRIDE;
         void saveNode(const Node *p_node) Q_DECL_OVERRIDE;
 
+        bool reloadNode(Node *p_node) Q_DECL_OVERRIDE;
+
         void renameNode(Node *p_node, const QString &p_name) Q_DECL_OVERRIDE;
 
         QSharedPointer<Node> newNode(Node *p_parent,
@@ -89,6 +92,15 @@ namespace vnotex
         QSharedPointer<vx_node_config::NodeConfig> readNodeConfig(const QString &p_path) const;
         void writeNodeConfig(const QString &p_path, const vx_node_config::NodeConfig &p_config) const;
 
+        QSharedPointer<vx_node_config::NodeConfig> parseNodeConfig(const QString &p_configPath,
+                                                                   const QByteArray &p_data) const;
+
+        // Whether @p_data of @p_configPath is the same as the one we read or wrote last time.
+        bool isKnownNodeConfig(const QString &p_configPath, const QByteArray &p_data) const;
+
+        // Update existence of children of @p_node. Return true if changed.
+        bool updateChildrenExistence(Node *p_node);
+
         void writeNodeConfig(const Node *p_node);
 
         QSharedPointer<Node> nodeConfigToNode(const vx_node_config::NodeConfig &p_config,
@@ -129,6 +141,11 @@ namespace vnotex
                                                      bool p_move,
                                                      bool p_updateDatabase);
 
+        // Move folder node @p_src within the same notebook by reusing the node.
+        QSharedPointer<Node> moveFolderNodeAsChildOf(const QSharedPointer<Node> &p_src,
+                                                     Node *p_dest,
+                                                     bool p_updateDatabase);
+
         QSharedPointer<Node> copyFileAsChildOf(const QString &p_srcPath, Node *p_dest);
 
         QSharedPointer<Node> copyFolderAsChildOf(const QString &p_srcPath, Node *p_dest);
@@ -173,11 +190,16 @@ namespace vnotex
 
         void copyFilesOfFileNode(const QSharedPointer<Node> &p_node,
                                  const QString &p_destFolder,
+                                 bool p_moveAttachment,
                                  QString &p_destFilePath,
                                  QString &p_attachmentFolder);
 
         static bool isLikelyImageFolder(const QString &p_dirPath);
 
+        // Config file path -> digest of the content we read or wrote last time.
+        // Used to tell our own writes from external changes.
+        mutable QHash<QString, QByteArray> m_nodeConfigDigests;
+
         static bool s_initialized;
 
         static QVector<QRegExp> s_externalNodeExcludePatterns;
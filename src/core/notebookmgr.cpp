@@ -5,6 +5,10 @@
 #include <notebookconfigmgr/vxnotebookconfigmgrfactory.h>
 #include <notebookconfigmgr/inotebookconfigmgr.h>
 #include <notebookbackend/localnotebookbackendfactory.h>
+#include <notebookbackend/inmemorynotebookbackendfactory.h>
+#include <notebookbackend/packednotebookbackendfactory.h>
+#include <notebookbackend/instrumentednotebookbackend.h>
+#include <notebookbackend/backendiostats.h>
 #include <notebookbackend/inotebookbackend.h>
 #include <notebook/bundlenotebookfactory.h>
 #include <notebook/notebook.h>
@@ -64,6 +68,14 @@ void NotebookMgr::initBackendServer()
     // Local Notebook Backend.
     auto localFactory = QSharedPointer<LocalNotebookBackendFactory>::create();
     m_backendServer->registerItem(localFactory->getName(), localFactory);
+
+    // In-Memory Notebook Backend.
+    auto inMemoryFactory = QSharedPointer<InMemoryNotebookBackendFactory>::create();
+    m_backendServer->registerItem(inMemoryFactory->getName(), inMemoryFactory);
+
+    // Packed Notebook Backend.
+    auto packedFactory = QSharedPointer<PackedNotebookBackendFactory>::create();
+    m_backendServer->registerItem(packedFactory->getName(), packedFactory);
 }
 
 void NotebookMgr::initNotebookServer()
@@ -105,7 +117,10 @@ QSharedPointer<INotebookBackend> NotebookMgr::createNotebookBackend(const QStrin
 {
     auto factory = m_backendServer->getItem(p_backendName);
     if (factory) {
-        return factory->createNotebookBackend(p_rootFolderPath);
+        // Always instrumented so that I/O stats could be switched at runtime.
+        // It costs one atomic load per call while disabled.
+        auto backend = factory->createNotebookBackend(p_rootFolderPath);
+        return QSharedPointer<InstrumentedNotebookBackend>::create(backend);
     } else {
         Exception::throwOne(Exception::Type::InvalidArgument,
                             QString("failed to find notebook backend factory %1").arg(p_backendName));
@@ -143,6 +158,8 @@ QSharedPointer<INotebookConfigMgr> NotebookMgr::createNotebookConfigMgr(const QS
 
 void NotebookMgr::loadNotebooks()
 {
+    BackendIoStats::OperationScope ioScope("load_notebooks");
+
     readNotebooksFromConfig();
 
     loadCurrentNotebookId();
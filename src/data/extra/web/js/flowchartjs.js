@@ -8,6 +8,8 @@ class FlowchartJs extends GraphRenderer {
         this.graphDivClass = 'vx-flowchartjs-graph';
 
         this.langs = ['flow', 'flowchart'];
+
+        this.useCache = true;
     }
 
     // Render @p_node as Flowchart.js graph.
@@ -34,21 +36,23 @@ class FlowchartJs extends GraphRenderer {
 
         Utils.checkSourceLine(p_node, graphDiv);
 
-        let childNode = p_node;
-        let parentNode = p_node.parentNode;
-        if (parentNode.tagName.toLowerCase() == 'pre') {
-            childNode = parentNode;
-            parentNode = parentNode.parentNode;
-        }
-        parentNode.replaceChild(graphDiv, childNode);
+        let childNode = FlowchartJs.replaceCodeNode(p_node, graphDiv);
+        let parentNode = graphDiv.parentNode;
 
         // Draw on it after adding div to page.
         try {
             graph.drawSVG(graphDiv.id);
+
+            // Cache a stand-alone copy before it is set up for view.
+            let standAloneGraph = graphDiv.firstElementChild.cloneNode(true);
+            this.fixStandAloneGraph(standAloneGraph);
+            this.cacheGraph(p_node.textContent, 'svg', standAloneGraph.outerHTML);
+
             window.vxImageViewer.setupSVGToView(graphDiv.children[0], true);
         } catch (p_err) {
             console.error('failed to draw Flowchart.js SVG', p_err);
             parentNode.replaceChild(childNode, graphDiv);
+            Utils.transferBlockNode(graphDiv, childNode);
             this.finishRenderingOne();
             return false;
         }
@@ -57,10 +61,71 @@ class FlowchartJs extends GraphRenderer {
         return true;
     }
 
+    renderCachedOne(p_node, p_idx, p_format, p_data) {
+        if (p_format !== 'svg') {
+            return false;
+        }
+
+        let graphDiv = document.createElement('div');
+        graphDiv.id = 'vx-flowchartjs-graph-' + p_idx;
+        graphDiv.classList.add(this.graphDivClass);
+        try {
+            graphDiv.innerHTML = p_data;
+        } catch (p_err) {
+            console.error('incorrect graph SVG definition', p_err);
+            return false;
+        }
+
+        Utils.checkSourceLine(p_node, graphDiv);
+
+        FlowchartJs.replaceCodeNode(p_node, graphDiv);
+
+        window.vxImageViewer.setupSVGToView(graphDiv.children[0], true);
+        return true;
+    }
+
+    // Replace code node @p_node, or its parent <pre>, with @p_graphDiv.
+    // Return the replaced node.
+    static replaceCodeNode(p_node, p_graphDiv) {
+        let childNode = p_node;
+        let parentNode = p_node.parentNode;
+        if (parentNode.tagName.toLowerCase() == 'pre') {
+            childNode = parentNode;
+            parentNode = parentNode.parentNode;
+        }
+        parentNode.replaceChild(p_graphDiv, childNode);
+        Utils.transferBlockNode(childNode, p_graphDiv);
+        return childNode;
+    }
+
     // Render a graph from @p_text.
     // Will append a div to @p_container and return the div.
     // p_callback(graphDiv).
     renderText(p_container, p_text, p_idx, p_callback) {
+        this.vnotex.fetchCachedGraph(this.getCacheLang(), p_text, (p_format, p_data) => {
+            if (p_format === 'svg' && p_data) {
+                let graphDiv = document.createElement('div');
+                graphDiv.id = 'vx-flowchartjs-graph-stand-alone-' + p_idx;
+                let ok = true;
+                try {
+                    graphDiv.innerHTML = p_data;
+                } catch (p_err) {
+                    console.error('incorrect graph SVG definition', p_err);
+                    ok = false;
+                }
+
+                if (ok) {
+                    p_container.appendChild(graphDiv);
+                    p_callback(graphDiv);
+                    return;
+                }
+            }
+
+            this.renderTextInternal(p_container, p_text, p_idx, p_callback);
+        });
+    }
+
+    renderTextInternal(p_container, p_text, p_idx, p_callback) {
         let graph = null;
 
         try {
@@ -87,11 +152,14 @@ class FlowchartJs extends GraphRenderer {
         } catch (p_err) {
             console.error('failed to draw Flowchart.js SVG', p_err);
             p_container.removeChild(graphDiv);
-            return null;
+            p_callback(null);
+            return;
         }
 
         this.fixStandAloneGraph(graphDiv.firstElementChild);
 
+        this.cacheGraph(p_text, 'svg', graphDiv.firstElementChild.outerHTML);
+
         p_callback(graphDiv);
     }
 
@@ -100,7 +168,8 @@ class FlowchartJs extends GraphRenderer {
     // @p_graph: the <svg> node.
     fixStandAloneGraph(p_graph) {
         let markerBlock = document.getElementById('raphael-marker-block');
-        if (!p_graph.contains(markerBlock)) {
+        // @p_graph may be a detached copy.
+        if (markerBlock && !p_graph.querySelector('#raphael-marker-block')) {
             let clonedMarkerBlock = markerBlock.cloneNode(true);
             let defs = p_graph.getElementsByTagName('defs');
             if (defs.length > 0) {
@@ -88,16 +88,45 @@ class GraphPreviewer {
     }
 
     // Interface 2.
-    previewMath(p_id, p_timeStamp, p_text) {
-        if (p_text.length == 0) {
-            this.setMathPreviewData(p_id, p_timeStamp);
+    // @p_maths: [{ id, text }].
+    // Typeset all the maths in one pass and set back all the results in one call.
+    previewMath(p_timeStamp, p_maths) {
+        if (p_maths.length == 0) {
+            this.vnotex.setMathPreviewData(p_timeStamp, []);
             return;
         }
 
         this.initOnFirstPreview();
 
+        let results = [];
+        let pendingCount = p_maths.length;
+        let dataSetter = (p_id, p_timeStamp, p_format = '', p_data = '', p_base64 = false, p_needScale = false) => {
+            if (p_format) {
+                results.push({
+                    id: p_id,
+                    format: p_format,
+                    data: p_data,
+                    base64: p_base64,
+                    needScale: p_needScale
+                });
+            }
+
+            if (--pendingCount == 0) {
+                this.vnotex.setMathPreviewData(p_timeStamp, results);
+            }
+        };
+
         // Do we need to go through TexMath plugin? I don't think so.
-        this.renderMath(p_id, p_timeStamp, p_text, this.setMathPreviewData.bind(this));
+        let texts = p_maths.map((p_math) => p_math.text);
+        this.vnotex.getWorker('mathjax').renderTexts(this.container,
+                                                     texts,
+                                                     (p_svgNodes) => {
+            p_svgNodes.forEach((p_svgNode, p_idx) => {
+                this.fixSvgCurrentColor(p_svgNode);
+                this.fixSvgRelativeWidth(p_svgNode);
+                this.processSvgAsPng(p_maths[p_idx].id, p_timeStamp, p_svgNode, dataSetter);
+            });
+        });
     }
 
     initOnFirstPreview() {
@@ -239,16 +268,4 @@ class GraphPreviewer {
         };
         this.vnotex.setGraphPreviewData(previewData);
     }
-
-    setMathPreviewData(p_id, p_timeStamp, p_format = '', p_data = '', p_base64 = false, p_needScale = false) {
-        let previewData = {
-            id: p_id,
-            timeStamp: p_timeStamp,
-            format: p_format,
-            data: p_data,
-            base64: p_base64,
-            needScale: p_needScale
-        };
-        this.vnotex.setMathPreviewData(previewData);
-    }
 }
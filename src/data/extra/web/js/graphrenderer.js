@@ -19,12 +19,23 @@ class GraphRenderer extends VxWorker {
 
         // Langs for this graph render to render.
         this.langs = [];
+
+        // Whether to look up and store graphs in the persistent graph cache.
+        // Subclass should implement renderCachedOne() if enabled.
+        this.useCache = false;
+
+        // Used to drop the cache results of obsolete rounds.
+        this.renderRound = 0;
     }
 
     reset() {
-        this.graphIdx = 0;
+        // Graphs kept from last round still hold their indexes.
+        if (!this.vnotex.getWorker('markdownit').isIncremental()) {
+            this.graphIdx = 0;
+        }
         this.nodesToRender = [];
         this.numOfRenderedNodes = 0;
+        ++this.renderRound;
     }
 
     registerInternal() {
@@ -98,8 +109,28 @@ class GraphRenderer extends VxWorker {
     }
 
     renderNodes() {
+        let round = ++this.renderRound;
         this.nodesToRender.forEach((p_nodeToRender) => {
-            this.renderOne(p_nodeToRender, this.graphIdx++);
+            let idx = this.graphIdx++;
+            if (!this.useCache) {
+                this.renderOne(p_nodeToRender, idx);
+                return;
+            }
+
+            this.vnotex.fetchCachedGraph(this.getCacheLang(),
+                                         p_nodeToRender.textContent,
+                                         (p_format, p_data) => {
+                if (round != this.renderRound) {
+                    return;
+                }
+
+                if (p_data && this.renderCachedOne(p_nodeToRender, idx, p_format, p_data)) {
+                    this.finishRenderingOne();
+                    return;
+                }
+
+                this.renderOne(p_nodeToRender, idx);
+            });
         });
     }
 
@@ -109,6 +140,23 @@ class GraphRenderer extends VxWorker {
         return false;
     }
 
+    // Render @p_node with the cached graph @p_data in @p_format.
+    // Return true on success. Should not call finishRenderingOne().
+    renderCachedOne(p_node, p_idx, p_format, p_data) {
+        return false;
+    }
+
+    // Key of the persistent graph cache, including options affecting the output.
+    getCacheLang() {
+        return this.name;
+    }
+
+    cacheGraph(p_text, p_format, p_data) {
+        if (this.useCache) {
+            this.vnotex.cacheGraph(this.getCacheLang(), p_text, p_format, p_data);
+        }
+    }
+
     // Called when finishing rendering one node.
     finishRenderingOne() {
         if (++this.numOfRenderedNodes == this.nodesToRender.length) {
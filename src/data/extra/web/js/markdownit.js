@@ -109,8 +109,12 @@ class MarkdownIt extends VxWorker {
 
         this.lastContainerNode = null;
 
-        // Pre nodes collection.
-        this.preNodes = null;
+        // Top-level blocks of lastContainerNode, each as { html, key, line, nodes }.
+        // Null if the content could not be tracked by blocks.
+        this.blocks = null;
+
+        // Blocks rendered in last round. Null if the whole container is rendered.
+        this.renderedBlocks = null;
 
         this.codeNodesStore = new CodeNodeStoreByLang();
 
@@ -244,6 +248,12 @@ class MarkdownIt extends VxWorker {
     }
 
     registerInternal() {
+        this.vnotex.on('baseUrlUpdated', () => {
+            // Rendered nodes were resolved against the old base, so do not patch them.
+            this.blocks = null;
+            this.renderedBlocks = null;
+        });
+
         this.vnotex.on('markdownTextUpdated', (p_text) => {
             this.render(this.vnotex.contentContainer,
                         p_text,
@@ -263,30 +273,268 @@ class MarkdownIt extends VxWorker {
 
         if (p_node != this.lastContainerNode) {
             this.lastContainerNode = p_node;
-            this.preNodes = null;
+            this.blocks = null;
         }
 
         if (!p_text) {
             p_node.innerHTML = '';
+            this.blocks = [];
+            this.renderedBlocks = null;
             this.finishWork();
             this.markdownRenderFinished();
             return;
         }
 
-        let html = this.mdit.render(p_text);
-        p_node.innerHTML = html + this.loadedGuard(p_finishCbStr);
+        let blocks = this.renderBlocks(p_text);
 
-        if (this.preNodes == null) {
-            this.preNodes = p_node.getElementsByTagName('pre');
-        }
+        // Only patch the changed blocks if possible, so that the untouched part
+        // keeps its rendered graphs and highlights.
+        if (this.frontMatterNode || !this.patchBlocks(p_node, blocks)) {
+            this.blocks = null;
+            this.renderedBlocks = null;
+
+            let fragment = this.frontMatterNode ? null : this.createBlockNodes(blocks);
+            if (fragment) {
+                p_node.innerHTML = '';
+                p_node.appendChild(fragment);
+                this.blocks = blocks;
+            } else {
+                p_node.innerHTML = blocks.map((p_block) => p_block.html).join('');
+            }
 
-        if (this.frontMatterNode) {
-            p_node.insertAdjacentElement('afterbegin', this.frontMatterNode);
+            if (this.frontMatterNode) {
+                p_node.insertAdjacentElement('afterbegin', this.frontMatterNode);
+            }
         }
 
+        p_node.insertAdjacentHTML('beforeend', this.loadedGuard(p_finishCbStr));
+
         this.finishWork();
     }
 
+    // Parse @p_text and render each top-level block separately.
+    renderBlocks(p_text) {
+        let env = {};
+        let tokens = this.mdit.parse(p_text, env);
+
+        let blocks = [];
+        let start = 0;
+        let depth = 0;
+        for (let i = 0; i < tokens.length; ++i) {
+            depth += tokens[i].nesting;
+            if (depth > 0) {
+                continue;
+            }
+
+            let blockTokens = tokens.slice(start, i + 1);
+            start = i + 1;
+
+            let line = blockTokens[0].map ? blockTokens[0].map[0] : -1;
+            let html = this.mdit.renderer.render(blockTokens, this.mdit.options, env);
+            blocks.push({
+                html: html,
+                key: MarkdownIt.blockKey(html, line),
+                line: line,
+                nodes: []
+            });
+        }
+
+        return blocks;
+    }
+
+    // Make source lines relative to the block so that the same block in other lines gets the same key.
+    static blockKey(p_html, p_line) {
+        if (p_line < 0) {
+            return p_html;
+        }
+
+        return p_html.replace(/data-source-line="(\d+)"/g, (p_match, p_lineNumber) => {
+            return 'data-source-line="' + (parseInt(p_lineNumber) - p_line) + '"';
+        });
+    }
+
+    // Create nodes of @p_blocks within a fragment.
+    // Return null if nodes could not be separated by blocks, such as unclosed raw HTML.
+    createBlockNodes(p_blocks) {
+        let template = document.createElement('template');
+        template.innerHTML = p_blocks.map((p_block) => '<!--vx-block-->' + p_block.html).join('');
+
+        p_blocks.forEach((p_block) => {
+            p_block.nodes = [];
+        });
+
+        let fragment = template.content;
+        let idx = -1;
+        let node = fragment.firstChild;
+        while (node) {
+            let nextNode = node.nextSibling;
+            if (node.nodeType == Node.COMMENT_NODE && node.data == 'vx-block') {
+                ++idx;
+                fragment.removeChild(node);
+            } else if (idx < 0) {
+                return null;
+            } else {
+                // Workers replacing this node will update the block via Utils.transferBlockNode().
+                node.vxBlock = p_blocks[idx];
+                p_blocks[idx].nodes.push(node);
+            }
+            node = nextNode;
+        }
+
+        if (idx != p_blocks.length - 1) {
+            return null;
+        }
+
+        return fragment;
+    }
+
+    // Children of @p_container holding the nodes of @p_block.
+    // Return null if some nodes have been removed.
+    topLevelNodesOfBlock(p_container, p_block) {
+        let nodes = [];
+        for (let i = 0; i < p_block.nodes.length; ++i) {
+            let node = p_block.nodes[i];
+            // Workers may wrap the node, such as the code toolbar of Prism.
+            while (node && node.parentNode !== p_container) {
+                node = node.parentNode;
+            }
+
+            if (!node) {
+                return null;
+            }
+
+            if (nodes.indexOf(node) == -1) {
+                nodes.push(node);
+            }
+        }
+
+        return nodes;
+    }
+
+    // Replace the blocks changed since last rendering in @p_node with new ones from @p_blocks.
+    // Return false if it could not be done and a full rendering is needed.
+    patchBlocks(p_node, p_blocks) {
+        let oldBlocks = this.blocks;
+        if (!oldBlocks) {
+            return false;
+        }
+
+        let minLen = Math.min(oldBlocks.length, p_blocks.length);
+        let prefix = 0;
+        while (prefix < minLen && oldBlocks[prefix].key == p_blocks[prefix].key) {
+            ++prefix;
+        }
+
+        let suffix = 0;
+        while (suffix < minLen - prefix
+               && oldBlocks[oldBlocks.length - 1 - suffix].key == p_blocks[p_blocks.length - 1 - suffix].key) {
+            ++suffix;
+        }
+
+        let oldNodes = [];
+        for (let i = prefix; i < oldBlocks.length - suffix; ++i) {
+            let nodes = this.topLevelNodesOfBlock(p_node, oldBlocks[i]);
+            if (!nodes) {
+                return false;
+            }
+            oldNodes = oldNodes.concat(nodes);
+        }
+
+        let refNode = null;
+        let keptNodes = [];
+        for (let i = oldBlocks.length - suffix; i < oldBlocks.length; ++i) {
+            let nodes = this.topLevelNodesOfBlock(p_node, oldBlocks[i]);
+            if (!nodes) {
+                return false;
+            }
+            keptNodes.push(nodes);
+            if (!refNode && nodes.length > 0) {
+                refNode = nodes[0];
+            }
+        }
+
+        let newBlocks = p_blocks.slice(prefix, p_blocks.length - suffix);
+        let fragment = this.createBlockNodes(newBlocks);
+        if (!fragment) {
+            return false;
+        }
+
+        oldNodes.forEach((p_oldNode) => {
+            p_node.removeChild(p_oldNode);
+        });
+        p_node.insertBefore(fragment, refNode);
+
+        // Keep the rendered nodes of untouched blocks, only updating their source lines.
+        for (let i = 0; i < prefix; ++i) {
+            p_blocks[i] = oldBlocks[i];
+        }
+
+        for (let i = 0; i < suffix; ++i) {
+            let oldBlock = oldBlocks[oldBlocks.length - suffix + i];
+            let newIdx = p_blocks.length - suffix + i;
+            let delta = p_blocks[newIdx].line - oldBlock.line;
+            if (delta != 0) {
+                keptNodes[i].forEach((p_keptNode) => {
+                    MarkdownIt.shiftSourceLines(p_keptNode, delta);
+                });
+                oldBlock.line = p_blocks[newIdx].line;
+            }
+            p_blocks[newIdx] = oldBlock;
+        }
+
+        this.blocks = p_blocks;
+        this.renderedBlocks = newBlocks;
+        return true;
+    }
+
+    static shiftSourceLines(p_node, p_delta) {
+        if (p_node.nodeType != Node.ELEMENT_NODE) {
+            return;
+        }
+
+        let attr = 'data-source-line';
+        let shift = (p_ele) => {
+            p_ele.setAttribute(attr, parseInt(p_ele.getAttribute(attr)) + p_delta);
+        };
+
+        if (p_node.hasAttribute(attr)) {
+            shift(p_node);
+        }
+
+        p_node.querySelectorAll('[' + attr + ']').forEach(shift);
+    }
+
+    // Whether only part of the container is rendered in last round.
+    isIncremental() {
+        return this.renderedBlocks != null;
+    }
+
+    // Top-level element nodes rendered in last round, or the container for a full rendering.
+    getRenderedRoots() {
+        if (!this.lastContainerNode) {
+            return [];
+        }
+
+        if (!this.renderedBlocks) {
+            return [this.lastContainerNode];
+        }
+
+        let roots = [];
+        this.renderedBlocks.forEach((p_block) => {
+            let nodes = this.topLevelNodesOfBlock(this.lastContainerNode, p_block);
+            if (!nodes) {
+                return;
+            }
+
+            nodes.forEach((p_node) => {
+                if (p_node.nodeType == Node.ELEMENT_NODE) {
+                    roots.push(p_node);
+                }
+            });
+        });
+        return roots;
+    }
+
     loadedGuard(p_cbStr) {
         if (!p_cbStr) {
             return '';
@@ -306,21 +554,28 @@ class MarkdownIt extends VxWorker {
 
     // Will be called when basic markdown is rendered.
     markdownRenderFinished() {
-        window.vxImageViewer.setupForAllImages(this.lastContainerNode);
+        this.getRenderedRoots().forEach((p_root) => {
+            window.vxImageViewer.setupForAllImages(p_root);
+        });
         this.vnotex.setBasicMarkdownRendered();
     }
 
+    // Get code nodes of @p_langs rendered in last round.
     getCodeNodes(p_langs) {
-        if (!this.preNodes) {
-            return [];
-        }
-
         if (!this.codeNodesCollected) {
             // Collect code nodes.
             this.codeNodesCollected = true;
-            for (let i = 0; i < this.preNodes.length; ++i) {
-                this.codeNodesStore.addNode(this.preNodes[i].firstElementChild);
-            }
+            this.getRenderedRoots().forEach((p_root) => {
+                if (p_root.tagName.toLowerCase() == 'pre') {
+                    this.codeNodesStore.addNode(p_root.firstElementChild);
+                    return;
+                }
+
+                let preNodes = p_root.getElementsByTagName('pre');
+                for (let i = 0; i < preNodes.length; ++i) {
+                    this.codeNodesStore.addNode(preNodes[i].firstElementChild);
+                }
+            });
         }
 
         return this.codeNodesStore.getNodes(p_langs);
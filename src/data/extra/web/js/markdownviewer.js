@@ -7,8 +7,16 @@ new QWebChannel(qt.webChannelTransport,
         window.vxMarkdownAdapter = adapter;
 
         // Connect signals from CPP side.
-        adapter.textUpdated.connect(function(p_text) {
-            window.vnotex.setMarkdownText(p_text);
+        adapter.textUpdated.connect(function(p_text, p_serial) {
+            window.vnotex.updateMarkdownText(p_text, p_serial);
+        });
+
+        adapter.baseUrlUpdated.connect(function(p_baseUrl) {
+            window.vnotex.setBaseUrl(p_baseUrl);
+        });
+
+        adapter.textPatched.connect(function(p_baseSerial, p_serial, p_startLine, p_removedLines, p_text) {
+            window.vnotex.patchMarkdownText(p_baseSerial, p_serial, p_startLine, p_removedLines, p_text);
         });
 
         adapter.editLineNumberUpdated.connect(function(p_lineNumber) {
@@ -23,8 +31,8 @@ new QWebChannel(qt.webChannelTransport,
             window.vnotex.previewGraph(p_id, p_timeStamp, p_lang, p_text);
         });
 
-        adapter.mathPreviewRequested.connect(function(p_id, p_timeStamp, p_text) {
-            window.vnotex.previewMath(p_id, p_timeStamp, p_text);
+        adapter.mathPreviewRequested.connect(function(p_timeStamp, p_maths) {
+            window.vnotex.previewMath(p_timeStamp, p_maths);
         });
 
         adapter.scrollRequested.connect(function(p_up) {
@@ -51,6 +59,14 @@ new QWebChannel(qt.webChannelTransport,
             window.vnotex.graphRenderDataReady(p_id, p_index, p_format, p_data);
         });
 
+        adapter.cachedGraphDataReady.connect(function(p_id, p_format, p_data) {
+            window.vnotex.cachedGraphDataReady(p_id, p_format, p_data);
+        });
+
+        adapter.settledNotificationRequested.connect(function(p_id) {
+            window.vnotex.notifyWhenSettled(p_id);
+        });
+
         console.log('QWebChannel has been set up');
         if (window.vnotex.initialized) {
             window.vnotex.kickOffMarkdown();
@@ -74,13 +74,13 @@ class MathJaxRenderer extends VxWorker {
         this.transformExtraNodes(p_node, p_className, extraNodes);
 
         // Collect nodes to render.
-        let nodes = p_node.getElementsByClassName(p_className);
+        let nodes = this.collectNodes(p_node, p_className);
         if (nodes.length == 0) {
             this.finishWork();
             return;
         }
 
-        this.nodesToRender = Array.from(nodes);
+        this.nodesToRender = nodes;
 
         if (!this.initialize(() => {
             this.renderNodes();
@@ -91,31 +91,56 @@ class MathJaxRenderer extends VxWorker {
         this.renderNodes();
     }
 
+    // Collect nodes of @p_className in @p_node rendered in last round.
+    collectNodes(p_node, p_className) {
+        let markdownIt = this.vnotex.getWorker('markdownit');
+        if (!markdownIt.isIncremental()) {
+            return Array.from(p_node.getElementsByClassName(p_className));
+        }
+
+        let nodes = [];
+        markdownIt.getRenderedRoots().forEach((p_root) => {
+            if (p_root.classList.contains(p_className)) {
+                nodes.push(p_root);
+            }
+
+            nodes = nodes.concat(Array.from(p_root.getElementsByClassName(p_className)));
+        });
+        return nodes;
+    }
+
     // p_callback(svgNode).
     renderText(p_container, p_text, p_callback) {
-        let func = () => {
-            // Check text and remove the guards.
-            let check = this.removeTextGuard(p_text);
-            if (!check) {
-                p_callback(null);
-                return;
-            }
-            let options = null;
-            try {
-                options = MathJax.getMetricsFor(p_container, check.display);
-            } catch (err) {
-                console.error('failed to render MathJax', err);
-                p_callback(null);
-                return;
-            }
+        this.renderTexts(p_container, [p_text], (p_svgNodes) => {
+            p_callback(p_svgNodes[0]);
+        });
+    }
 
-            let mathNode = null;
-            try {
-                mathNode = MathJax.tex2svg(check.text, options);
-            } catch (err) {
-                console.error('failed to render MathJax', err);
-            }
-            p_callback(mathNode ? mathNode.firstElementChild : null);
+    // Typeset @p_texts in one pass.
+    // p_callback(svgNodes), with null for those failed.
+    renderTexts(p_container, p_texts, p_callback) {
+        let func = () => {
+            // Metrics only depend on the container and the display mode.
+            let metrics = new Map();
+            let svgNodes = p_texts.map((p_text) => {
+                // Check text and remove the guards.
+                let check = this.removeTextGuard(p_text);
+                if (!check) {
+                    return null;
+                }
+
+                let mathNode = null;
+                try {
+                    if (!metrics.has(check.display)) {
+                        metrics.set(check.display, MathJax.getMetricsFor(p_container, check.display));
+                    }
+                    mathNode = MathJax.tex2svg(check.text, metrics.get(check.display));
+                } catch (err) {
+                    console.error('failed to render MathJax', err);
+                }
+                return mathNode ? mathNode.firstElementChild : null;
+            });
+            p_callback(svgNodes);
         };
 
         if (!this.initialize(func)) {
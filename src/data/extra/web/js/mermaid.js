@@ -12,6 +12,12 @@ class Mermaid extends GraphRenderer {
         this.theme = 'default';
 
         this.langs = ['mermaid'];
+
+        this.useCache = true;
+    }
+
+    getCacheLang() {
+        return this.name + '/' + this.theme;
     }
 
     initialize(p_callback) {
@@ -51,22 +57,42 @@ class Mermaid extends GraphRenderer {
             return false;
         }
 
+        let ret = this.insertGraph(p_node, graphSvg);
+        if (ret) {
+            this.cacheGraph(p_node.textContent,
+                            'svg',
+                            Mermaid.replaceGraphId(graphSvg, 'vx-mermaid-graph-' + p_idx, Mermaid.graphIdPlaceholder));
+        }
+
+        this.finishRenderingOne();
+        return ret;
+    }
+
+    renderCachedOne(p_node, p_idx, p_format, p_data) {
+        if (p_format !== 'svg') {
+            return false;
+        }
+
+        return this.insertGraph(p_node,
+                                Mermaid.replaceGraphId(p_data, Mermaid.graphIdPlaceholder, 'vx-mermaid-graph-' + p_idx));
+    }
+
+    // Replace @p_node with a graph div of @p_graphSvg.
+    // Return true on success.
+    insertGraph(p_node, p_graphSvg) {
         let graphDiv = document.createElement('div');
         graphDiv.classList.add(this.graphDivClass);
         try {
-            graphDiv.innerHTML = graphSvg;
+            graphDiv.innerHTML = p_graphSvg;
             window.vxImageViewer.setupSVGToView(graphDiv.children[0], true);
         } catch (p_err) {
             console.error('incorrect graph SVG definition', p_err);
-            this.finishRenderingOne();
             return false;
         }
 
         Utils.checkSourceLine(p_node, graphDiv);
 
         Utils.replaceNodeWithPreCheck(p_node, graphDiv);
-
-        this.finishRenderingOne();
         return true;
     }
 
@@ -95,9 +121,47 @@ class Mermaid extends GraphRenderer {
             return null;
         }
 
+        let graphDiv = Mermaid.appendGraph(p_container, graphSvg);
+        if (graphDiv) {
+            this.cacheGraph(p_text,
+                            'svg',
+                            Mermaid.replaceGraphId(graphSvg, 'vx-mermaid-graph-stand-alone-' + p_idx, Mermaid.graphIdPlaceholder));
+        }
+
+        return graphDiv;
+    }
+
+    // p_callback(graphDiv).
+    renderText(p_container, p_text, p_idx, p_callback) {
+        this.vnotex.fetchCachedGraph(this.getCacheLang(), p_text, (p_format, p_data) => {
+            if (p_format === 'svg' && p_data) {
+                let graphDiv = Mermaid.appendGraph(p_container,
+                                                   Mermaid.replaceGraphId(p_data,
+                                                                          Mermaid.graphIdPlaceholder,
+                                                                          'vx-mermaid-graph-stand-alone-' + p_idx));
+                if (graphDiv) {
+                    p_callback(graphDiv);
+                    return;
+                }
+            }
+
+            if (!this.initialize(() => {
+                    let graphDiv = this.renderTextInternal(p_container, p_text, p_idx);
+                    p_callback(graphDiv);
+                })) {
+                return;
+            }
+
+            let graphDiv = this.renderTextInternal(p_container, p_text, p_idx);
+            p_callback(graphDiv);
+        });
+    }
+
+    // Append a div of @p_graphSvg to @p_container and return the div.
+    static appendGraph(p_container, p_graphSvg) {
         let graphDiv = document.createElement('div');
         try {
-            graphDiv.innerHTML = graphSvg;
+            graphDiv.innerHTML = p_graphSvg;
         } catch (p_err) {
             console.error('incorrect graph SVG definition', p_err);
             return null;
@@ -108,18 +172,13 @@ class Mermaid extends GraphRenderer {
         return graphDiv;
     }
 
-    // p_callback(graphDiv).
-    renderText(p_container, p_text, p_idx, p_callback) {
-        if (!this.initialize(() => {
-                let graphDiv = this.renderTextInternal(p_container, p_text, p_idx);
-                p_callback(graphDiv);
-            })) {
-            return;
-        }
-
-        let graphDiv = this.renderTextInternal(p_container, p_text, p_idx);
-        p_callback(graphDiv);
+    // The SVG refers to its id in styles, which should be replaced when reused.
+    static replaceGraphId(p_graphSvg, p_id, p_newId) {
+        return p_graphSvg.replace(new RegExp(p_id + '(?![0-9])', 'g'), p_newId);
     }
 }
 
+// Used in the cached SVG in place of its id.
+Mermaid.graphIdPlaceholder = 'vx-mermaid-graph-cached';
+
 window.vnotex.registerWorker(new Mermaid());
@@ -85,7 +85,15 @@ class PrismRenderer extends VxWorker {
 
             p_containerNode.classList.add('line-numbers');
 
-            Prism.highlightAllUnder(p_containerNode, false /* async or not */);
+            let markdownIt = this.vnotex.getWorker('markdownit');
+            if (markdownIt.isIncremental()) {
+                // Code blocks kept from last round are highlighted already.
+                markdownIt.getRenderedRoots().forEach((p_root) => {
+                    Prism.highlightAllUnder(p_root, false /* async or not */);
+                });
+            } else {
+                Prism.highlightAllUnder(p_containerNode, false /* async or not */);
+            }
 
             // Remove the toolbar.
             if (window.vxOptions.removeCodeToolBarEnabled) {
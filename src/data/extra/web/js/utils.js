@@ -78,6 +78,21 @@ class Utils {
             parentNode = parentNode.parentNode;
         }
         parentNode.replaceChild(p_newNode, childNode);
+        Utils.transferBlockNode(childNode, p_newNode);
+    }
+
+    // Let @p_newNode take the place of @p_node in the rendered block @p_node belongs to.
+    static transferBlockNode(p_node, p_newNode) {
+        let block = p_node.vxBlock;
+        if (!block) {
+            return;
+        }
+
+        let idx = block.nodes.indexOf(p_node);
+        if (idx > -1) {
+            block.nodes[idx] = p_newNode;
+            p_newNode.vxBlock = block;
+        }
     }
 
     static viewPortRect() {
@@ -7,6 +7,7 @@
         - ready()
 
     Markdown scenario:
+        - baseUrlUpdated(p_baseUrl)
         - markdownTextUpdated(p_text)
         - basicMarkdownRendered()
         - fullMarkdownRendered()
@@ -31,6 +32,12 @@ class VNoteX extends EventEmitter {
             anchor: null
         }
 
+        // Latest Markdown text from CPP side, split into lines to apply patches.
+        this.markdownLines = null;
+
+        // Serial of @markdownLines given by CPP side.
+        this.markdownSerial = -1;
+
         this.numOfMuteScroll = 0;
 
         this.os = VNoteX.detectOS();
@@ -42,6 +49,10 @@ class VNoteX extends EventEmitter {
         // Dict mapping from {id, index} to callback for renderGraph().
         this.renderGraphCallbacks = {}
 
+        // Dict mapping from request id to callback for fetchCachedGraph().
+        this.cachedGraphCallbacks = {}
+        this.cachedGraphRequestId = 0;
+
         window.addEventListener('load', () => {
             console.log('window load finished');
 
@@ -138,6 +149,42 @@ class VNoteX extends EventEmitter {
         window.vxMarkdownAdapter.setReady(true);
     }
 
+    // Resolve relative resources against @p_baseUrl, such as when the page is reused
+    // for another file.
+    setBaseUrl(p_baseUrl) {
+        let baseNode = document.head.querySelector('base');
+        if (!baseNode) {
+            baseNode = document.createElement('base');
+            document.head.insertAdjacentElement('afterbegin', baseNode);
+        }
+        baseNode.href = p_baseUrl;
+
+        this.emit('baseUrlUpdated', p_baseUrl);
+    }
+
+    // Whole Markdown text is updated from CPP side.
+    updateMarkdownText(p_text, p_serial) {
+        this.markdownLines = p_text.split('\n');
+        this.markdownSerial = p_serial;
+        this.setMarkdownText(p_text);
+    }
+
+    // Replace @p_removedLines lines from @p_startLine with lines of @p_text.
+    patchMarkdownText(p_baseSerial, p_serial, p_startLine, p_removedLines, p_text) {
+        if (!this.markdownLines || this.markdownSerial != p_baseSerial) {
+            console.warn('failed to patch Markdown text, request the whole text', this.markdownSerial, p_baseSerial);
+            this.markdownLines = null;
+            window.vxMarkdownAdapter.requestText();
+            return;
+        }
+
+        this.markdownLines = this.markdownLines.slice(0, p_startLine).concat(
+            p_text.split('\n'),
+            this.markdownLines.slice(p_startLine + p_removedLines));
+        this.markdownSerial = p_serial;
+        this.setMarkdownText(this.markdownLines.join('\n'));
+    }
+
     setMarkdownText(p_text) {
         if (this.numOfOngoingWorkers > 0) {
             this.pendingData.text = p_text;
@@ -210,9 +257,9 @@ class VNoteX extends EventEmitter {
         }
     }
 
-    previewMath(p_id, p_timeStamp, p_text) {
+    previewMath(p_timeStamp, p_maths) {
         if (this.graphPreviewer) {
-            this.graphPreviewer.previewMath(p_id, p_timeStamp, p_text);
+            this.graphPreviewer.previewMath(p_timeStamp, p_maths);
         }
     }
 
@@ -225,13 +272,9 @@ class VNoteX extends EventEmitter {
                                                      p_data.needScale);
     }
 
-    setMathPreviewData(p_data) {
-        window.vxMarkdownAdapter.setMathPreviewData(p_data.id,
-                                                    p_data.timeStamp,
-                                                    p_data.format,
-                                                    p_data.data,
-                                                    p_data.base64,
-                                                    p_data.needScale);
+    // @p_data: [{ id, format, data, base64, needScale }].
+    setMathPreviewData(p_timeStamp, p_data) {
+        window.vxMarkdownAdapter.setMathPreviewData(p_timeStamp, p_data);
     }
 
     setHeadings(p_headings) {
@@ -302,6 +345,52 @@ class VNoteX extends EventEmitter {
                                                  document.body.classList.value);
     }
 
+    // Call setSettled(@p_id) of CPP side once the content is ready to be captured, i.e. no
+    // rendering in progress, images loaded or failed and web fonts loaded.
+    notifyWhenSettled(p_id) {
+        if (!this.initialized) {
+            this.once('initialized', () => { this.notifyWhenSettled(p_id); });
+            return;
+        }
+
+        if (this.numOfOngoingWorkers > 0 || this.pendingData.text) {
+            // Pending text is kicked off right after this event, so check again later.
+            this.once('fullMarkdownRendered', () => {
+                setTimeout(() => { this.notifyWhenSettled(p_id); }, 0);
+            });
+            return;
+        }
+
+        let waits = [];
+        let images = this.contentContainer.getElementsByTagName('img');
+        for (let i = 0; i < images.length; ++i) {
+            let img = images[i];
+            if (img.complete) {
+                continue;
+            }
+            waits.push(new Promise((p_resolve) => {
+                img.addEventListener('load', p_resolve, { once: true });
+                img.addEventListener('error', p_resolve, { once: true });
+            }));
+        }
+
+        if (document.fonts) {
+            waits.push(document.fonts.ready);
+        }
+
+        // Do not hang on resources that never settle.
+        let timeout = new Promise((p_resolve) => {
+            setTimeout(p_resolve, VNoteX.settleTimeout);
+        });
+
+        Promise.race([Promise.all(waits), timeout]).then(() => {
+            // Let pending layout run. requestAnimationFrame() may not fire in a hidden view.
+            setTimeout(() => {
+                window.vxMarkdownAdapter.setSettled(p_id);
+            }, 0);
+        });
+    }
+
     setBodySize(p_width, p_height) {
         if (p_width > 0) {
             document.body.style.width = p_width + 'px';
@@ -325,6 +414,26 @@ class VNoteX extends EventEmitter {
         }
     }
 
+    // Look up the persistent graph cache at CPP side.
+    // p_callback(p_format, p_data), with empty p_data if not found.
+    fetchCachedGraph(p_lang, p_text, p_callback) {
+        let id = this.cachedGraphRequestId++;
+        this.cachedGraphCallbacks[id] = p_callback;
+        window.vxMarkdownAdapter.fetchCachedGraph(id, p_lang, p_text);
+    }
+
+    cachedGraphDataReady(p_id, p_format, p_data) {
+        if (p_id in this.cachedGraphCallbacks) {
+            let callback = this.cachedGraphCallbacks[p_id];
+            delete this.cachedGraphCallbacks[p_id];
+            callback(p_format, p_data);
+        }
+    }
+
+    cacheGraph(p_lang, p_text, p_format, p_data) {
+        window.vxMarkdownAdapter.cacheGraph(p_lang, p_text, p_format, p_data);
+    }
+
     static detectOS() {
         let osName="Unknown OS";
         if (navigator.appVersion.indexOf("Win")!=-1) {
@@ -340,4 +449,7 @@ class VNoteX extends EventEmitter {
     }
 }
 
+// Max time in milliseconds to wait for images and fonts in notifyWhenSettled().
+VNoteX.settleTimeout = 10000;
+
 window.vnotex = new VNoteX();
@@ -133,6 +133,8 @@ QJsonObject ExportOption::toJson() const
     obj["html_option"] = m_htmlOption.toJson();
     obj["pdf_option"] = m_pdfOption.toJson();
     obj["custom_export"] = m_customExport;
+    obj["viewer_count"] = m_viewerCount;
+    obj["reuse_viewer_page"] = m_reuseViewerPage;
     return obj;
 }
 
@@ -172,6 +174,8 @@ void ExportOption::fromJson(const QJsonObject &p_obj)
     m_htmlOption.fromJson(p_obj["html_option"].toObject());
     m_pdfOption.fromJson(p_obj["pdf_option"].toObject());
     m_customExport = p_obj["custom_export"].toString();
+    m_viewerCount = p_obj["viewer_count"].toInt();
+    m_reuseViewerPage = p_obj["reuse_viewer_page"].toBool(true);
 }
 
 bool ExportOption::operator==(const ExportOption &p_other) const
@@ -180,7 +184,9 @@ bool ExportOption::operator==(const ExportOption &p_other) const
                && m_useTransparentBg == p_other.m_useTransparentBg
                && m_outputDir == p_other.m_outputDir
                && m_recursive == p_other.m_recursive
-               && m_exportAttachments == p_other.m_exportAttachments;
+               && m_exportAttachments == p_other.m_exportAttachments
+               && m_viewerCount == p_other.m_viewerCount
+               && m_reuseViewerPage == p_other.m_reuseViewerPage;
 
     if (!ret) {
         return false;
@@ -126,6 +126,14 @@ namespace vnotex
 
         QString m_customExport;
 
+        // Number of viewers to render notes concurrently when exporting a folder or notebook.
+        // 0 to decide automatically.
+        int m_viewerCount = 0;
+
+        // Whether to keep the page of a viewer loaded and push the next note into it,
+        // instead of reloading the page for each note.
+        bool m_reuseViewerPage = true;
+
         // Following fields are used in runtime only.
         ExportCustomOption *m_customOption = nullptr;
 
@@ -2,6 +2,9 @@
 
 #include <QWidget>
 #include <QTemporaryDir>
+#include <QFile>
+
+#include <algorithm>
 
 #include <notebook/notebook.h>
 #include <notebook/node.h>
@@ -149,12 +152,7 @@ QString Exporter::doExportPdfAllInOne(const ExportOption &p_option, Notebook *p_
 
     auto tmpOption(getExportOptionForIntermediateHtml(p_option, tmpDir.path()));
 
-    QStringList htmlFiles;
-    if (p_notebook) {
-        htmlFiles = doExportNotebook(tmpOption, tmpDir.path(), p_notebook);
-    } else {
-        htmlFiles = doExport(tmpOption, tmpDir.path(), p_folder);
-    }
+    QStringList htmlFiles = doExportInBatch(tmpOption, tmpDir.path(), p_notebook, p_folder);
 
     cleanUpWebViewExporter();
 
@@ -203,12 +201,7 @@ QString Exporter::doExportCustomAllInOne(const ExportOption &p_option, Notebook
 
         auto tmpOption(getExportOptionForIntermediateHtml(p_option, tmpDir.path()));
 
-        QStringList htmlFiles;
-        if (p_notebook) {
-            htmlFiles = doExportNotebook(tmpOption, tmpDir.path(), p_notebook);
-        } else {
-            htmlFiles = doExport(tmpOption, tmpDir.path(), p_folder);
-        }
+        QStringList htmlFiles = doExportInBatch(tmpOption, tmpDir.path(), p_notebook, p_folder);
 
         cleanUpWebViewExporter();
 
@@ -277,7 +270,7 @@ QStringList Exporter::doExportFolder(const ExportOption &p_option, Node *p_folde
             outputFiles << file;
         }
     } else {
-        outputFiles = doExport(p_option, p_option.m_outputDir, p_folder);
+        outputFiles = doExportInBatch(p_option, p_option.m_outputDir, nullptr, p_folder);
     }
 
     cleanUp();
@@ -333,6 +326,12 @@ QStringList Exporter::doExport(const ExportOption &p_option, const QString &p_ou
 
 QString Exporter::doExport(const ExportOption &p_option, const QString &p_outputDir, const File *p_file)
 {
+    if (m_batchMode) {
+        // Logged once finished.
+        queueWebViewExport(p_option, p_outputDir, p_file);
+        return QString();
+    }
+
     QString outputFile;
 
     switch (p_option.m_targetFormat) {
@@ -386,7 +385,7 @@ QStringList Exporter::doExport(const ExportOption &p_option, Notebook *p_noteboo
             outputFiles << file;
         }
     } else {
-        outputFiles = doExportNotebook(p_option, p_option.m_outputDir, p_notebook);
+        outputFiles = doExportInBatch(p_option, p_option.m_outputDir, p_notebook, nullptr);
     }
 
     cleanUp();
@@ -431,11 +430,114 @@ QStringList Exporter::doExportNotebook(const ExportOption &p_option, const QStri
         emit progressUpdated(i + 1, children.size());
     }
 
-    cleanUp();
+    return outputFiles;
+}
+
+QStringList Exporter::doExportInBatch(const ExportOption &p_option,
+                                      const QString &p_outputDir,
+                                      Notebook *p_notebook,
+                                      Node *p_folder)
+{
+    Q_ASSERT(!m_batchMode);
+    m_batchMode = p_option.m_targetFormat == ExportFormat::HTML || p_option.m_targetFormat == ExportFormat::PDF;
+
+    QStringList outputFiles;
+    if (p_notebook) {
+        outputFiles = doExportNotebook(p_option, p_outputDir, p_notebook);
+    } else {
+        outputFiles = doExport(p_option, p_outputDir, p_folder);
+    }
+
+    if (m_batchMode) {
+        m_batchMode = false;
+        outputFiles.append(waitForBatchJobs());
+    }
+
+    return outputFiles;
+}
+
+void Exporter::queueWebViewExport(const ExportOption &p_option, const QString &p_outputDir, const File *p_file)
+{
+    if (!p_file->getContentType().isMarkdown()) {
+        emit logRequested(tr("Format %1 is not supported to export as %2.").arg(p_file->getContentType().m_displayName,
+                                                                                exportFormatString(p_option.m_targetFormat)));
+        emit logRequested(tr("Failed to export file (%1)").arg(p_file->getFilePath()));
+        return;
+    }
+
+    QString suffix = QStringLiteral("pdf");
+    if (p_option.m_targetFormat == ExportFormat::HTML) {
+        suffix = p_option.m_htmlOption.m_useMimeHtmlFormat ? QStringLiteral("mht") : QStringLiteral("html");
+    }
+    auto fileName = FileUtils::generateFileNameWithSequence(p_outputDir,
+                                                            QFileInfo(p_file->getName()).completeBaseName(),
+                                                            suffix);
+    auto destFilePath = PathUtils::concatenateFilePath(p_outputDir, fileName);
+
+    // Occupy the name since the file will be written later.
+    QFile(destFilePath).open(QIODevice::WriteOnly);
+
+    BatchJob job;
+    job.m_node = p_file->getNode();
+    job.m_srcFilePath = p_file->getFilePath();
+    job.m_outputDir = p_outputDir;
+    job.m_destFilePath = destFilePath;
+    job.m_exportAttachments = p_option.m_exportAttachments;
+
+    auto webViewExporter = getWebViewExporter(p_option);
+    // The job may finish right away if asked to stop.
+    const int idx = webViewExporter->getJobCount();
+    m_batchJobs.insert(idx, job);
+    webViewExporter->addJob(p_file, destFilePath);
+}
+
+QStringList Exporter::waitForBatchJobs()
+{
+    QStringList outputFiles;
+    if (m_batchJobs.isEmpty()) {
+        return outputFiles;
+    }
+
+    m_webViewExporter->waitForJobs();
 
+    QList<int> indices = m_batchJobs.keys();
+    std::sort(indices.begin(), indices.end());
+    for (int idx : indices) {
+        const auto &job = m_batchJobs[idx];
+        if (job.m_succeeded) {
+            outputFiles << job.m_destFilePath;
+        }
+    }
+
+    m_batchJobs.clear();
+    m_finishedBatchJobCount = 0;
     return outputFiles;
 }
 
+void Exporter::handleWebViewJobFinished(int p_idx, bool p_succeeded)
+{
+    auto it = m_batchJobs.find(p_idx);
+    if (it == m_batchJobs.end()) {
+        return;
+    }
+
+    auto &job = it.value();
+    job.m_succeeded = p_succeeded;
+    if (p_succeeded) {
+        // Copy attachments if available.
+        if (job.m_exportAttachments) {
+            exportAttachments(job.m_node, job.m_srcFilePath, job.m_outputDir, job.m_destFilePath);
+        }
+
+        emit logRequested(tr("File (%1) exported to (%2)").arg(job.m_srcFilePath, job.m_destFilePath));
+    } else {
+        QFile::remove(job.m_destFilePath);
+        emit logRequested(tr("Failed to export file (%1)").arg(job.m_srcFilePath));
+    }
+
+    emit progressUpdated(++m_finishedBatchJobCount, m_batchJobs.size());
+}
+
 QString Exporter::doExportHtml(const ExportOption &p_option, const QString &p_outputDir, const File *p_file)
 {
     QString outputFile;
@@ -468,6 +570,8 @@ WebViewExporter *Exporter::getWebViewExporter(const ExportOption &p_option)
         m_webViewExporter = new WebViewExporter(static_cast<QWidget *>(parent()));
         connect(m_webViewExporter, &WebViewExporter::logRequested,
                 this, &Exporter::logRequested);
+        connect(m_webViewExporter, &WebViewExporter::jobFinished,
+                this, &Exporter::handleWebViewJobFinished);
         m_webViewExporter->prepare(p_option);
     }
 
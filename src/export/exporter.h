@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QStringList>
+#include <QHash>
 
 #include "exportdata.h"
 
@@ -77,6 +78,21 @@ namespace vnotex
 
         QStringList doExportNotebook(const ExportOption &p_option, const QString &p_outputDir, Notebook *p_notebook);
 
+        // Export @p_notebook or @p_folder. @p_folder will be considered only when @p_notebook is null.
+        // Notes to export via WebViewExporter are queued and rendered concurrently.
+        QStringList doExportInBatch(const ExportOption &p_option,
+                                    const QString &p_outputDir,
+                                    Notebook *p_notebook,
+                                    Node *p_folder);
+
+        // Queue @p_file to WebViewExporter in batch mode.
+        void queueWebViewExport(const ExportOption &p_option, const QString &p_outputDir, const File *p_file);
+
+        // Wait for all the queued files and return the output files in the queuing order.
+        QStringList waitForBatchJobs();
+
+        void handleWebViewJobFinished(int p_idx, bool p_succeeded);
+
         static ExportOption getExportOptionForIntermediateHtml(const ExportOption &p_option, const QString &p_outputDir);
 
         static QString evaluateCommand(const ExportOption &p_option,
@@ -88,10 +104,33 @@ namespace vnotex
 
         static void collectFiles(const QList<QSharedPointer<File>> &p_files, QStringList &p_inputFiles, QStringList &p_resourcePaths);
 
+        struct BatchJob
+        {
+            Node *m_node = nullptr;
+
+            QString m_srcFilePath;
+
+            QString m_outputDir;
+
+            QString m_destFilePath;
+
+            bool m_exportAttachments = false;
+
+            bool m_succeeded = false;
+        };
+
         // Managed by QObject.
         WebViewExporter *m_webViewExporter = nullptr;
 
         bool m_askedToStop = false;
+
+        // Whether to queue files to WebViewExporter instead of exporting them one by one.
+        bool m_batchMode = false;
+
+        // Job index of WebViewExporter -> BatchJob.
+        QHash<int, BatchJob> m_batchJobs;
+
+        int m_finishedBatchJobCount = 0;
     };
 }
 
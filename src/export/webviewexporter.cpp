@@ -5,6 +5,8 @@
 #include <QFileInfo>
 #include <QTemporaryDir>
 #include <QProcess>
+#include <QEventLoop>
+#include <QThread>
 
 #include <widgets/editors/markdownviewer.h>
 #include <widgets/editors/editormarkdownvieweradapter.h>
@@ -12,7 +14,6 @@
 #include <core/markdowneditorconfig.h>
 #include <core/configmgr.h>
 #include <core/htmltemplatehelper.h>
-#include <utils/utils.h>
 #include <utils/pathutils.h>
 #include <utils/fileutils.h>
 #include <utils/webutils.h>
@@ -38,147 +39,410 @@ void WebViewExporter::clear()
 {
     m_askedToStop = false;
 
-    delete m_viewer;
-    m_viewer = nullptr;
+    for (auto &viewer : m_viewers) {
+        delete viewer.m_viewer;
+    }
+    m_viewers.clear();
+
+    m_jobs.clear();
+    m_pendingJobs.clear();
+    m_writeQueue.clear();
+    m_unfinishedCount = 0;
 
     m_htmlTemplate.clear();
     m_exportHtmlTemplate.clear();
-
-    m_exportOngoing = false;
 }
 
 bool WebViewExporter::doExport(const ExportOption &p_option,
                                const File *p_file,
                                const QString &p_outputFile)
 {
-    bool ret = false;
+    Q_UNUSED(p_option);
+    Q_ASSERT(p_option.m_targetFormat == m_option.m_targetFormat);
     m_askedToStop = false;
 
-    Q_ASSERT(p_file->getContentType().isMarkdown());
+    const int idx = addJob(p_file, p_outputFile);
+    waitForJobs();
+    return isJobSucceeded(idx);
+}
 
-    Q_ASSERT(!m_exportOngoing);
-    m_exportOngoing = true;
+int WebViewExporter::addJob(const File *p_file, const QString &p_outputFile)
+{
+    Q_ASSERT(p_file->getContentType().isMarkdown());
 
-    m_webViewStates = WebViewState::Started;
+    Job job;
+    job.m_filePath = p_file->getFilePath();
+    job.m_baseUrl = PathUtils::pathToUrl(p_file->getContentPath());
+    job.m_text = p_file->read();
+    job.m_outputFile = p_outputFile;
+    m_jobs.push_back(job);
+
+    const int idx = m_jobs.size() - 1;
+    ++m_unfinishedCount;
+    if (m_askedToStop) {
+        finishJob(idx, false);
+        return idx;
+    }
 
-    auto baseUrl = PathUtils::pathToUrl(p_file->getContentPath());
-    m_viewer->adapter()->reset();
-    m_viewer->setHtml(m_htmlTemplate, baseUrl);
+    m_pendingJobs.enqueue(idx);
+    schedule();
+    return idx;
+}
 
-    auto textContent = p_file->read();
-    if (p_option.m_targetFormat == ExportFormat::PDF
-        && p_option.m_pdfOption.m_addTableOfContents
-        && !p_option.m_pdfOption.m_useWkhtmltopdf) {
-        // Add `[TOC]` at the beginning.
-        m_viewer->adapter()->setText("[TOC]\n\n" + textContent);
-    } else {
-        m_viewer->adapter()->setText(textContent);
+void WebViewExporter::waitForJobs()
+{
+    if (m_unfinishedCount == 0) {
+        return;
     }
 
-    while (!isWebViewReady()) {
-        Utils::sleepWait(100);
+    QEventLoop loop;
+    connect(this, &WebViewExporter::allJobsFinished,
+            &loop, &QEventLoop::quit);
+    loop.exec();
+}
 
-        if (m_askedToStop) {
-            goto exit_export;
-        }
+bool WebViewExporter::isJobSucceeded(int p_idx) const
+{
+    return m_jobs[p_idx].m_state == JobState::Succeeded;
+}
 
-        if (isWebViewFailed()) {
-            qWarning() << "WebView failed when exporting" << p_file->getFilePath();
-            goto exit_export;
+int WebViewExporter::getJobCount() const
+{
+    return m_jobs.size();
+}
+
+void WebViewExporter::stop()
+{
+    m_askedToStop = true;
+
+    while (!m_pendingJobs.isEmpty()) {
+        finishJob(m_pendingJobs.dequeue(), false);
+    }
+
+    for (int i = 0; i < m_viewers.size(); ++i) {
+        if (m_viewers[i].m_jobIdx != -1) {
+            finishRendering(i, false);
         }
     }
+}
 
-    qDebug() << "WebView is ready";
+void WebViewExporter::createViewer()
+{
+    const int viewerIdx = m_viewers.size();
 
-    // Add extra wait to make sure Web side is really ready.
-    Utils::sleepWait(200);
+    // Adapter will be managed by MarkdownViewer.
+    auto adapter = new MarkdownViewerAdapter(this);
 
-    switch (p_option.m_targetFormat) {
-    case ExportFormat::HTML:
-        // TODO: MIME HTML format is not supported yet.
-        Q_ASSERT(!p_option.m_htmlOption.m_useMimeHtmlFormat);
-        ret = doExportHtml(p_option.m_htmlOption, p_outputFile, baseUrl);
-        break;
+    Viewer viewer;
+    viewer.m_viewer = new MarkdownViewer(adapter, QColor(), 1, static_cast<QWidget *>(parent()));
+    viewer.m_viewer->hide();
+    m_viewers.push_back(viewer);
 
-    case ExportFormat::PDF:
-        if (p_option.m_pdfOption.m_useWkhtmltopdf) {
-            ret = doExportWkhtmltopdf(p_option.m_pdfOption, p_outputFile, baseUrl);
-        } else {
-            ret = doExportPdf(p_option.m_pdfOption, p_outputFile);
+    connect(viewer.m_viewer->page(), &QWebEnginePage::loadFinished,
+            this, [this, viewerIdx](bool p_ok) {
+                m_viewers[viewerIdx].m_states |= p_ok ? WebViewState::LoadFinished : WebViewState::Failed;
+                checkViewerReady(viewerIdx);
+            });
+    connect(adapter, &MarkdownViewerAdapter::workFinished,
+            this, [this, viewerIdx]() {
+                m_viewers[viewerIdx].m_states |= WebViewState::WorkFinished;
+                checkViewerReady(viewerIdx);
+            });
+    connect(adapter, &MarkdownViewerAdapter::settled,
+            this, [this, viewerIdx](quint64 p_id) {
+                const auto &viewer = m_viewers[viewerIdx];
+                // Drop answers to previous jobs.
+                if (viewer.m_outputRequested && viewer.m_jobIdx != -1 && static_cast<quint64>(viewer.m_jobIdx) == p_id) {
+                    requestOutput(viewerIdx);
+                }
+            });
+    connect(adapter, &MarkdownViewerAdapter::contentReady,
+            this, [this, viewerIdx](const QString &p_headContent,
+                                    const QString &p_styleContent,
+                                    const QString &p_content,
+                                    const QString &p_bodyClassList) {
+                handleContentReady(viewerIdx, p_headContent, p_styleContent, p_content, p_bodyClassList);
+            });
+}
+
+void WebViewExporter::schedule()
+{
+    while (!m_pendingJobs.isEmpty() && !m_askedToStop) {
+        int viewerIdx = -1;
+        for (int i = 0; i < m_viewers.size(); ++i) {
+            if (m_viewers[i].m_jobIdx == -1) {
+                viewerIdx = i;
+                break;
+            }
         }
-        break;
 
-    default:
-        break;
+        if (viewerIdx == -1) {
+            if (m_viewers.size() >= m_maxViewers) {
+                break;
+            }
+
+            createViewer();
+            viewerIdx = m_viewers.size() - 1;
+        }
+
+        startJob(viewerIdx, m_pendingJobs.dequeue());
     }
+}
 
-exit_export:
-    m_exportOngoing = false;
-    return ret;
+void WebViewExporter::startJob(int p_viewerIdx, int p_jobIdx)
+{
+    auto &viewer = m_viewers[p_viewerIdx];
+    auto &job = m_jobs[p_jobIdx];
+    Q_ASSERT(viewer.m_jobIdx == -1 && job.m_state == JobState::Pending);
+
+    viewer.m_jobIdx = p_jobIdx;
+    viewer.m_outputRequested = false;
+    job.m_state = JobState::Rendering;
+
+    if (m_option.m_reuseViewerPage && isWebViewReady(viewer)) {
+        // The page has been initialized by the last job. Just push the new file into it.
+        viewer.m_states = WebViewState::LoadFinished;
+        viewer.m_viewer->adapter()->setBaseUrl(job.m_baseUrl);
+    } else {
+        viewer.m_states = WebViewState::Started;
+        viewer.m_viewer->adapter()->reset();
+        viewer.m_viewer->setHtml(m_htmlTemplate, job.m_baseUrl);
+    }
+
+    if (m_option.m_targetFormat == ExportFormat::PDF
+        && m_option.m_pdfOption.m_addTableOfContents
+        && !m_option.m_pdfOption.m_useWkhtmltopdf) {
+        // Add `[TOC]` at the beginning.
+        viewer.m_viewer->adapter()->setText("[TOC]\n\n" + job.m_text);
+    } else {
+        viewer.m_viewer->adapter()->setText(job.m_text);
+    }
+    job.m_text.clear();
 }
 
-void WebViewExporter::stop()
+bool WebViewExporter::isWebViewReady(const Viewer &p_viewer) const
 {
-    m_askedToStop = true;
+    return p_viewer.m_states == (WebViewState::LoadFinished | WebViewState::WorkFinished);
 }
 
-bool WebViewExporter::isWebViewReady() const
+bool WebViewExporter::isWebViewFailed(const Viewer &p_viewer) const
 {
-    return m_webViewStates == (WebViewState::LoadFinished | WebViewState::WorkFinished);
+    return p_viewer.m_states & WebViewState::Failed;
 }
 
-bool WebViewExporter::isWebViewFailed() const
+void WebViewExporter::checkViewerReady(int p_viewerIdx)
 {
-    return m_webViewStates & WebViewState::Failed;
+    const auto &viewer = m_viewers[p_viewerIdx];
+    if (viewer.m_jobIdx == -1 || viewer.m_outputRequested) {
+        return;
+    }
+
+    if (isWebViewFailed(viewer)) {
+        qWarning() << "WebView failed when exporting" << m_jobs[viewer.m_jobIdx].m_filePath;
+        finishRendering(p_viewerIdx, false);
+        return;
+    }
+
+    if (!isWebViewReady(viewer)) {
+        return;
+    }
+
+    qDebug() << "WebView is ready" << m_jobs[viewer.m_jobIdx].m_filePath;
+    m_viewers[p_viewerIdx].m_outputRequested = true;
+
+    // Rendering is done, but images and fonts may still be loading. Let web side tell.
+    viewer.m_viewer->adapter()->requestSettledNotification(viewer.m_jobIdx);
 }
 
-bool WebViewExporter::doExportHtml(const ExportHtmlOption &p_htmlOption,
-                                   const QString &p_outputFile,
-                                   const QUrl &p_baseUrl)
+void WebViewExporter::requestOutput(int p_viewerIdx)
 {
-    ExportState state = ExportState::Busy;
+    auto &viewer = m_viewers[p_viewerIdx];
+    if (m_option.m_targetFormat == ExportFormat::PDF && !m_option.m_pdfOption.m_useWkhtmltopdf) {
+        const int jobIdx = viewer.m_jobIdx;
+        viewer.m_viewer->page()->printToPdf([this, p_viewerIdx, jobIdx](const QByteArray &p_result) {
+            qDebug() << "printToPdf ready";
+            if (p_viewerIdx >= m_viewers.size() || m_viewers[p_viewerIdx].m_jobIdx != jobIdx) {
+                return;
+            }
+
+            m_jobs[jobIdx].m_pdfData = p_result;
+            finishRendering(p_viewerIdx, !p_result.isEmpty());
+        }, *m_option.m_pdfOption.m_layout);
+    } else {
+        // TODO: MIME HTML format is not supported yet.
+        Q_ASSERT(m_option.m_targetFormat != ExportFormat::HTML || !m_option.m_htmlOption.m_useMimeHtmlFormat);
+
+        // Result comes via contentReady. wkhtmltopdf also takes the HTML.
+        viewer.m_viewer->adapter()->saveContent();
+    }
+}
 
-    connect(m_viewer->adapter(), &MarkdownViewerAdapter::contentReady,
-            this, [&, this](const QString &p_headContent,
-                            const QString &p_styleContent,
-                            const QString &p_content,
-                            const QString &p_bodyClassList) {
-                qDebug() << "doExportHtml contentReady";
-                // Maybe unnecessary. Just to avoid duplicated signal connections.
-                disconnect(m_viewer->adapter(), &MarkdownViewerAdapter::contentReady, this, 0);
+void WebViewExporter::handleContentReady(int p_viewerIdx,
+                                         const QString &p_headContent,
+                                         const QString &p_styleContent,
+                                         const QString &p_content,
+                                         const QString &p_bodyClassList)
+{
+    const auto &viewer = m_viewers[p_viewerIdx];
+    if (viewer.m_jobIdx == -1 || !viewer.m_outputRequested) {
+        return;
+    }
 
-                if (p_content.isEmpty() || m_askedToStop) {
-                    state = ExportState::Failed;
-                    return;
-                }
+    qDebug() << "contentReady" << m_jobs[viewer.m_jobIdx].m_filePath;
+    auto &job = m_jobs[viewer.m_jobIdx];
+    job.m_headContent = p_headContent;
+    job.m_styleContent = p_styleContent;
+    job.m_content = p_content;
+    job.m_bodyClassList = p_bodyClassList;
+    finishRendering(p_viewerIdx, !p_content.isEmpty());
+}
 
-                if (!writeHtmlFile(p_outputFile,
-                                   p_baseUrl,
-                                   p_headContent,
-                                   p_styleContent,
-                                   p_content,
-                                   p_bodyClassList,
-                                   p_htmlOption.m_embedStyles,
-                                   p_htmlOption.m_completePage,
-                                   p_htmlOption.m_embedImages)) {
-                    state = ExportState::Failed;
-                    return;
-                }
+void WebViewExporter::finishRendering(int p_viewerIdx, bool p_succeeded)
+{
+    auto &viewer = m_viewers[p_viewerIdx];
+    const int jobIdx = viewer.m_jobIdx;
+    Q_ASSERT(jobIdx != -1);
+    viewer.m_jobIdx = -1;
+    viewer.m_outputRequested = false;
+
+    if (!p_succeeded) {
+        // Do not reuse a page in unknown state.
+        viewer.m_states = WebViewState::Failed;
+    }
 
-                state = ExportState::Finished;
-            });
+    if (!p_succeeded || m_askedToStop) {
+        finishJob(jobIdx, false);
+    } else {
+        m_jobs[jobIdx].m_state = JobState::Writing;
+        m_writeQueue.enqueue(jobIdx);
+    }
+
+    // Keep viewers busy before writing.
+    schedule();
 
-    m_viewer->adapter()->saveContent();
+    processWriteQueue();
+}
 
-    while (state == ExportState::Busy) {
-        Utils::sleepWait(100);
+void WebViewExporter::processWriteQueue()
+{
+    if (m_writing) {
+        // The running writer will pick it up.
+        return;
+    }
 
+    m_writing = true;
+    while (!m_writeQueue.isEmpty()) {
+        const int jobIdx = m_writeQueue.dequeue();
         if (m_askedToStop) {
+            finishJob(jobIdx, false);
+            continue;
+        }
+
+        m_writingJobIdx = jobIdx;
+        const bool ret = writeJobOutput(m_jobs[jobIdx]);
+        m_writingJobIdx = -1;
+        finishJob(jobIdx, ret);
+    }
+    m_writing = false;
+}
+
+bool WebViewExporter::writeJobOutput(Job &p_job)
+{
+    Q_ASSERT(!p_job.m_outputFile.isEmpty());
+    bool ret = false;
+    switch (m_option.m_targetFormat) {
+    case ExportFormat::HTML:
+    {
+        const auto &htmlOption = m_option.m_htmlOption;
+        ret = writeHtmlFile(p_job.m_outputFile,
+                            p_job.m_baseUrl,
+                            p_job.m_headContent,
+                            p_job.m_styleContent,
+                            p_job.m_content,
+                            p_job.m_bodyClassList,
+                            htmlOption.m_embedStyles,
+                            htmlOption.m_completePage,
+                            htmlOption.m_embedImages);
+        break;
+    }
+
+    case ExportFormat::PDF:
+        if (!m_option.m_pdfOption.m_useWkhtmltopdf) {
+            FileUtils::writeFile(p_job.m_outputFile, p_job.m_pdfData);
+            ret = true;
             break;
         }
+
+        if (m_option.m_pdfOption.m_wkhtmltopdfExePath.isEmpty()) {
+            qWarning() << "invalid wkhtmltopdf executable path";
+            break;
+        }
+
+        {
+            // Save HTML to a temp dir.
+            QTemporaryDir tmpDir;
+            if (!tmpDir.isValid()) {
+                break;
+            }
+
+            auto tmpHtmlFile = tmpDir.filePath("vnote_export_tmp.html");
+            if (!writeHtmlFile(tmpHtmlFile,
+                               p_job.m_baseUrl,
+                               p_job.m_headContent,
+                               p_job.m_styleContent,
+                               p_job.m_content,
+                               p_job.m_bodyClassList,
+                               true,
+                               true,
+                               false)) {
+                break;
+            }
+
+            // Convert HTML to PDF via wkhtmltopdf.
+            ret = htmlToPdfViaWkhtmltopdf(m_option.m_pdfOption, QStringList() << tmpHtmlFile, p_job.m_outputFile);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    p_job.m_headContent.clear();
+    p_job.m_styleContent.clear();
+    p_job.m_content.clear();
+    p_job.m_bodyClassList.clear();
+    p_job.m_pdfData.clear();
+    return ret;
+}
+
+void WebViewExporter::finishJob(int p_jobIdx, bool p_succeeded)
+{
+    auto &job = m_jobs[p_jobIdx];
+    Q_ASSERT(job.m_state != JobState::Succeeded && job.m_state != JobState::Failed);
+    job.m_state = p_succeeded ? JobState::Succeeded : JobState::Failed;
+    job.m_text.clear();
+
+    const auto logs = job.m_logs;
+    job.m_logs.clear();
+    for (const auto &msg : logs) {
+        emit logRequested(msg);
+    }
+
+    --m_unfinishedCount;
+    emit jobFinished(p_jobIdx, p_succeeded);
+
+    if (m_unfinishedCount == 0) {
+        emit allJobsFinished();
     }
+}
 
-    return state == ExportState::Finished;
+void WebViewExporter::log(const QString &p_log)
+{
+    if (m_writingJobIdx != -1) {
+        m_jobs[m_writingJobIdx].m_logs << p_log;
+    } else {
+        emit logRequested(p_log);
+    }
 }
 
 bool WebViewExporter::writeHtmlFile(const QString &p_file,
@@ -239,31 +503,22 @@ bool WebViewExporter::writeHtmlFile(const QString &p_file,
     return true;
 }
 
-QSize WebViewExporter::pageLayoutSize(const QPageLayout &p_layout) const
+QSize WebViewExporter::pageLayoutSize(const QPageLayout &p_layout, const QWidget *p_widget) const
 {
-    Q_ASSERT(m_viewer);
     auto rect = p_layout.paintRect(QPageLayout::Inch);
-    return QSize(rect.width() * m_viewer->logicalDpiX(), rect.height() * m_viewer->logicalDpiY());
+    return QSize(rect.width() * p_widget->logicalDpiX(), rect.height() * p_widget->logicalDpiY());
 }
 
 void WebViewExporter::prepare(const ExportOption &p_option)
 {
-    Q_ASSERT(!m_viewer && !m_exportOngoing);
+    Q_ASSERT(m_viewers.isEmpty() && m_jobs.isEmpty());
     Q_ASSERT(p_option.m_targetFormat == ExportFormat::PDF || p_option.m_targetFormat == ExportFormat::HTML);
 
-    {
-        // Adapter will be managed by MarkdownViewer.
-        auto adapter = new MarkdownViewerAdapter(this);
-        m_viewer = new MarkdownViewer(adapter, QColor(), 1, static_cast<QWidget *>(parent()));
-        m_viewer->hide();
-        connect(m_viewer->page(), &QWebEnginePage::loadFinished,
-                this, [this]() {
-                    m_webViewStates |= WebViewState::LoadFinished;
-                });
-        connect(adapter, &MarkdownViewerAdapter::workFinished,
-                this, [this]() {
-                    m_webViewStates |= WebViewState::WorkFinished;
-                });
+    m_option = p_option;
+    if (p_option.m_viewerCount > 0) {
+        m_maxViewers = p_option.m_viewerCount;
+    } else {
+        m_maxViewers = qBound(1, QThread::idealThreadCount() / 2, 4);
     }
 
     bool scrollable = true;
@@ -278,7 +533,7 @@ void WebViewExporter::prepare(const ExportOption &p_option)
     QSize pageBodySize(1024, 768);
     if (p_option.m_targetFormat == ExportFormat::PDF) {
         useWkhtmltopdf = p_option.m_pdfOption.m_useWkhtmltopdf;
-        pageBodySize = pageLayoutSize(*(p_option.m_pdfOption.m_layout));
+        pageBodySize = pageLayoutSize(*(p_option.m_pdfOption.m_layout), static_cast<QWidget *>(parent()));
     }
 
     qDebug() << "export page body size" << pageBodySize;
@@ -464,100 +719,6 @@ bool WebViewExporter::fixBodyResources(const QUrl &p_baseUrl,
     return altered;
 }
 
-bool WebViewExporter::doExportPdf(const ExportPdfOption &p_pdfOption, const QString &p_outputFile)
-{
-    ExportState state = ExportState::Busy;
-
-    m_viewer->page()->printToPdf([&, this](const QByteArray &p_result) {
-        qDebug() << "doExportPdf printToPdf ready";
-        if (p_result.isEmpty() || m_askedToStop) {
-            state = ExportState::Failed;
-            return;
-        }
-
-        Q_ASSERT(!p_outputFile.isEmpty());
-
-        FileUtils::writeFile(p_outputFile, p_result);
-
-        state = ExportState::Finished;
-    }, *p_pdfOption.m_layout);
-
-    while (state == ExportState::Busy) {
-        Utils::sleepWait(100);
-
-        if (m_askedToStop) {
-            break;
-        }
-    }
-
-    return state == ExportState::Finished;
-}
-
-bool WebViewExporter::doExportWkhtmltopdf(const ExportPdfOption &p_pdfOption, const QString &p_outputFile, const QUrl &p_baseUrl)
-{
-    if (p_pdfOption.m_wkhtmltopdfExePath.isEmpty()) {
-        qWarning() << "invalid wkhtmltopdf executable path";
-        return false;
-    }
-
-    ExportState state = ExportState::Busy;
-
-    connect(m_viewer->adapter(), &MarkdownViewerAdapter::contentReady,
-            this, [&, this](const QString &p_headContent,
-                            const QString &p_styleContent,
-                            const QString &p_content,
-                            const QString &p_bodyClassList) {
-                qDebug() << "doExportWkhtmltopdf contentReady";
-                // Maybe unnecessary. Just to avoid duplicated signal connections.
-                disconnect(m_viewer->adapter(), &MarkdownViewerAdapter::contentReady, this, 0);
-
-                if (p_content.isEmpty() || m_askedToStop) {
-                    state = ExportState::Failed;
-                    return;
-                }
-
-                // Save HTML to a temp dir.
-                QTemporaryDir tmpDir;
-                if (!tmpDir.isValid()) {
-                    state = ExportState::Failed;
-                    return;
-                }
-
-                auto tmpHtmlFile = tmpDir.filePath("vnote_export_tmp.html");
-                if (!writeHtmlFile(tmpHtmlFile,
-                                   p_baseUrl,
-                                   p_headContent,
-                                   p_styleContent,
-                                   p_content,
-                                   p_bodyClassList,
-                                   true,
-                                   true,
-                                   false)) {
-                    state = ExportState::Failed;
-                    return;
-                }
-
-                // Convert HTML to PDF via wkhtmltopdf.
-                if (htmlToPdfViaWkhtmltopdf(p_pdfOption, QStringList() << tmpHtmlFile, p_outputFile)) {
-                    state = ExportState::Finished;
-                } else {
-                    state = ExportState::Failed;
-                }
-            });
-
-    m_viewer->adapter()->saveContent();
-
-    while (state == ExportState::Busy) {
-        Utils::sleepWait(100);
-
-        if (m_askedToStop) {
-            break;
-        }
-    }
-
-    return state == ExportState::Finished;
-}
-
 bool WebViewExporter::htmlToPdfViaWkhtmltopdf(const ExportPdfOption &p_pdfOption, const QStringList &p_htmlFiles, const QString &p_outputFile)
 {
     QStringList args(m_wkhtmltopdfArgs);
@@ -581,7 +742,7 @@ bool WebViewExporter::htmlToPdfViaWkhtmltopdf(const ExportPdfOption &p_pdfOption
 
     bool ret = startProcess(QDir::toNativeSeparators(p_pdfOption.m_wkhtmltopdfExePath), args);
     if (ret && QFileInfo::exists(tmpFile)) {
-        emit logRequested(tr("Copy output file (%1) to (%2).").arg(tmpFile, p_outputFile));
+        log(tr("Copy output file (%1) to (%2).").arg(tmpFile, p_outputFile));
         FileUtils::copyFile(tmpFile, p_outputFile);
     }
 
@@ -590,12 +751,12 @@ bool WebViewExporter::htmlToPdfViaWkhtmltopdf(const ExportPdfOption &p_pdfOption
 
 bool WebViewExporter::startProcess(const QString &p_program, const QStringList &p_args)
 {
-    emit logRequested(p_program + " " + ProcessUtils::combineArgString(p_args));
+    log(p_program + " " + ProcessUtils::combineArgString(p_args));
 
     auto ret = ProcessUtils::start(p_program,
                                    p_args,
                                    [this](const QString &p_log) {
-                                       emit logRequested(p_log);
+                                       log(p_log);
                                    },
                                    m_askedToStop);
     return ret == ProcessUtils::State::Succeeded;
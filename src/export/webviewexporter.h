@@ -2,6 +2,9 @@
 #define WEBVIEWEXPORTER_H
 
 #include <QObject>
+#include <QVector>
+#include <QQueue>
+#include <QUrl>
 
 #include "exportdata.h"
 
@@ -12,6 +15,9 @@ namespace vnotex
     class File;
     class MarkdownViewer;
 
+    // Export Markdown files via a pool of hidden MarkdownViewers.
+    // Queued files are rendered by different viewers concurrently, while the outputs are
+    // written one by one by a shared writer.
     class WebViewExporter : public QObject
     {
         Q_OBJECT
@@ -30,15 +36,28 @@ namespace vnotex
 
         ~WebViewExporter();
 
+        // Export @p_file and wait for it.
         bool doExport(const ExportOption &p_option,
                       const File *p_file,
                       const QString &p_outputFile);
 
+        // Queue @p_file to export to @p_outputFile. jobFinished() will be emitted once done.
+        // Return the index of the job.
+        int addJob(const File *p_file, const QString &p_outputFile);
+
+        // Wait until all the queued jobs finish.
+        void waitForJobs();
+
+        bool isJobSucceeded(int p_idx) const;
+
+        int getJobCount() const;
+
         void prepare(const ExportOption &p_option);
 
         // Release resources after one batch of export.
         void clear();
 
+        // Abort all the queued and running jobs.
         void stop();
 
         bool htmlToPdfViaWkhtmltopdf(const ExportPdfOption &p_pdfOption, const QStringList &p_htmlFiles, const QString &p_outputFile);
@@ -46,21 +65,92 @@ namespace vnotex
     signals:
         void logRequested(const QString &p_log);
 
+        // Logs of the job have been sent via logRequested() before this.
+        void jobFinished(int p_idx, bool p_succeeded);
+
+        void allJobsFinished();
+
     private:
-        enum class ExportState
+        enum class JobState
         {
-            Busy = 0,
-            Finished,
+            Pending = 0,
+            Rendering,
+            Writing,
+            Succeeded,
             Failed
         };
 
-        bool isWebViewReady() const;
+        struct Job
+        {
+            QString m_filePath;
+
+            QUrl m_baseUrl;
+
+            // Released once pushed to the viewer.
+            QString m_text;
+
+            QString m_outputFile;
+
+            JobState m_state = JobState::Pending;
+
+            // Rendered result waiting to be written.
+            QString m_headContent;
+            QString m_styleContent;
+            QString m_content;
+            QString m_bodyClassList;
+            QByteArray m_pdfData;
+
+            // Logs of this job, sent together once finished to avoid interleaving with others.
+            QStringList m_logs;
+        };
+
+        struct Viewer
+        {
+            // Managed by QObject.
+            MarkdownViewer *m_viewer = nullptr;
+
+            WebViewStates m_states = WebViewState::Started;
+
+            // Index of the job in rendering. -1 if idle.
+            int m_jobIdx = -1;
+
+            // Whether the output has been requested from the page.
+            bool m_outputRequested = false;
+        };
 
-        bool isWebViewFailed() const;
+        void createViewer();
 
-        bool doExportHtml(const ExportHtmlOption &p_htmlOption,
-                          const QString &p_outputFile,
-                          const QUrl &p_baseUrl);
+        // Feed pending jobs to idle viewers, creating new viewers within the limit.
+        void schedule();
+
+        void startJob(int p_viewerIdx, int p_jobIdx);
+
+        void checkViewerReady(int p_viewerIdx);
+
+        // Request the rendered output of the job from the page.
+        void requestOutput(int p_viewerIdx);
+
+        void handleContentReady(int p_viewerIdx,
+                                const QString &p_headContent,
+                                const QString &p_styleContent,
+                                const QString &p_content,
+                                const QString &p_bodyClassList);
+
+        // Release the viewer and queue the job for the writer.
+        void finishRendering(int p_viewerIdx, bool p_succeeded);
+
+        void processWriteQueue();
+
+        bool writeJobOutput(Job &p_job);
+
+        void finishJob(int p_jobIdx, bool p_succeeded);
+
+        // Log to current job if there is one.
+        void log(const QString &p_log);
+
+        bool isWebViewReady(const Viewer &p_viewer) const;
+
+        bool isWebViewFailed(const Viewer &p_viewer) const;
 
         bool writeHtmlFile(const QString &p_file,
                            const QUrl &p_baseUrl,
@@ -78,11 +168,7 @@ namespace vnotex
 
         bool fixBodyResources(const QUrl &p_baseUrl, const QString &p_folder, QString &p_html);
 
-        bool doExportPdf(const ExportPdfOption &p_pdfOption, const QString &p_outputFile);
-
-        bool doExportWkhtmltopdf(const ExportPdfOption &p_pdfOption, const QString &p_outputFile, const QUrl &p_baseUrl);
-
-        QSize pageLayoutSize(const QPageLayout &p_layout) const;
+        QSize pageLayoutSize(const QPageLayout &p_layout, const QWidget *p_widget) const;
 
         void prepareWkhtmltopdfArguments(const ExportPdfOption &p_pdfOption);
 
@@ -90,12 +176,28 @@ namespace vnotex
 
         bool m_askedToStop = false;
 
-        bool m_exportOngoing = false;
+        ExportOption m_option;
+
+        // Max number of viewers in the pool.
+        int m_maxViewers = 1;
+
+        QVector<Viewer> m_viewers;
+
+        QVector<Job> m_jobs;
+
+        // Indices of jobs not started yet.
+        QQueue<int> m_pendingJobs;
+
+        // Indices of jobs waiting to be written.
+        QQueue<int> m_writeQueue;
+
+        // Whether the writer is busy. Writing may process events and re-enter.
+        bool m_writing = false;
 
-        WebViewStates m_webViewStates = WebViewState::Started;
+        // Job being written, whose logs are collected.
+        int m_writingJobIdx = -1;
 
-        // Managed by QObject.
-        MarkdownViewer *m_viewer = nullptr;
+        int m_unfinishedCount = 0;
 
         QString m_htmlTemplate;
 
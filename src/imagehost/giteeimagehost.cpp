@@ -3,6 +3,7 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QByteArray>
+#include <QMutexLocker>
 
 #include <utils/utils.h>
 #include <utils/pathutils.h>
@@ -13,7 +14,8 @@ using namespace vnotex;
 const QString GiteeImageHost::c_apiUrl = "https://gitee.com/api/v5";
 
 GiteeImageHost::GiteeImageHost(QObject *p_parent)
-    : ImageHost(p_parent)
+    : ImageHost(p_parent),
+      m_apiUrl(c_apiUrl)
 {
 }
 
@@ -38,6 +40,8 @@ QJsonObject GiteeImageHost::getConfig() const
 
 void GiteeImageHost::setConfig(const QJsonObject &p_jobj)
 {
+    Q_ASSERT(!isUploading());
+
     parseConfig(p_jobj, m_personalAccessToken, m_userName, m_repoName);
 
     // Do not assume the default branch.
@@ -78,11 +82,11 @@ QString GiteeImageHost::addAccessToken(const QString &p_token, QString p_url)
     return p_url;
 }
 
-vte::NetworkReply GiteeImageHost::getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const
+ImageHost::HostReply GiteeImageHost::getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const
 {
     auto rawHeader = prepareCommonHeaders();
-    auto urlStr = QString("%1/repos/%2/%3").arg(c_apiUrl, p_userName, p_repoName);
-    auto reply = vte::NetworkAccess::request(QUrl(addAccessToken(p_token, urlStr)), rawHeader);
+    auto urlStr = QString("%1/repos/%2/%3").arg(m_apiUrl, p_userName, p_repoName);
+    auto reply = sendRequest("GET", QUrl(addAccessToken(p_token, urlStr)), rawHeader);
     return reply;
 }
 
@@ -116,10 +120,10 @@ QString GiteeImageHost::create(const QByteArray &p_data, const QString &p_path,
     }
 
     auto rawHeader = prepareCommonHeaders();
-    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(c_apiUrl, m_userName, m_repoName, p_path);
+    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(m_apiUrl, m_userName, m_repoName, p_path);
 
     // Check if @p_path already exists.
-    auto reply = vte::NetworkAccess::request(QUrl(addAccessToken(m_personalAccessToken, urlStr)), rawHeader);
+    auto reply = sendRequest("GET", QUrl(addAccessToken(m_personalAccessToken, urlStr)), rawHeader);
     if (reply.m_error == QNetworkReply::NoError) {
         if (!isEmptyResponse(reply.m_data)) {
             p_msg = tr("The resource already exists at the image host (%1).").arg(p_path);
@@ -136,7 +140,11 @@ QString GiteeImageHost::create(const QByteArray &p_data, const QString &p_path,
     requestDataObj[QStringLiteral("message")] = QString("VX_ADD: %1").arg(p_path);
     requestDataObj[QStringLiteral("content")] = QString::fromUtf8(p_data.toBase64());
     auto requestData = Utils::toJsonString(requestDataObj);
-    reply = vte::NetworkAccess::post(QUrl(urlStr), rawHeader, requestData);
+    {
+        // Commit one at a time to avoid conflicts on the branch.
+        QMutexLocker lock(&m_commitMutex);
+        reply = sendRequest("POST", QUrl(urlStr), rawHeader, requestData);
+    }
     if (reply.m_error != QNetworkReply::NoError) {
         p_msg = tr("Failed to create resource at the image host (%1) (%2) (%3).").arg(urlStr, reply.errorStr(), reply.m_data);
         return QString();
@@ -159,6 +167,11 @@ bool GiteeImageHost::ownsUrl(const QString &p_url) const
     return p_url.startsWith(m_imageUrlPrefix);
 }
 
+void GiteeImageHost::setApiUrl(const QString &p_url)
+{
+    m_apiUrl = p_url;
+}
+
 bool GiteeImageHost::remove(const QString &p_url, QString &p_msg)
 {
     Q_ASSERT(ownsUrl(p_url));
@@ -171,10 +184,10 @@ bool GiteeImageHost::remove(const QString &p_url, QString &p_msg)
     const auto resourcePath = GitHubImageHost::fetchResourcePath(m_imageUrlPrefix, p_url);
 
     auto rawHeader = prepareCommonHeaders();
-    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(c_apiUrl, m_userName, m_repoName, resourcePath);
+    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(m_apiUrl, m_userName, m_repoName, resourcePath);
 
     // Get the SHA of the resource.
-    auto reply = vte::NetworkAccess::request(QUrl(addAccessToken(m_personalAccessToken, urlStr)), rawHeader);
+    auto reply = sendRequest("GET", QUrl(addAccessToken(m_personalAccessToken, urlStr)), rawHeader);
     if (reply.m_error != QNetworkReply::NoError || isEmptyResponse(reply.m_data)) {
         p_msg = tr("Failed to fetch information about the resource (%1).").arg(resourcePath);
         return false;
@@ -194,7 +207,10 @@ bool GiteeImageHost::remove(const QString &p_url, QString &p_msg)
     requestDataObj[QStringLiteral("message")] = QString("VX_DEL: %1").arg(resourcePath);
     requestDataObj[QStringLiteral("sha")] = sha;
     auto requestData = Utils::toJsonString(requestDataObj);
-    reply = vte::NetworkAccess::deleteResource(QUrl(urlStr), rawHeader, requestData);
+    {
+        QMutexLocker lock(&m_commitMutex);
+        reply = sendRequest("DELETE", QUrl(urlStr), rawHeader, requestData);
+    }
     if (reply.m_error != QNetworkReply::NoError) {
         p_msg = tr("Failed to delete resource (%1) (%2).").arg(resourcePath, QString::fromUtf8(reply.m_data));
         return false;
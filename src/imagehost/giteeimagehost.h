@@ -29,9 +29,12 @@ namespace vnotex
 
         bool ownsUrl(const QString &p_url) const Q_DECL_OVERRIDE;
 
+        // Used for UT only.
+        void setApiUrl(const QString &p_url);
+
     private:
         // Used to test.
-        vte::NetworkReply getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const;
+        HostReply getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const;
 
         static void parseConfig(const QJsonObject &p_jobj,
                                 QString &p_token,
@@ -50,6 +53,8 @@ namespace vnotex
 
         QString m_imageUrlPrefix;
 
+        QString m_apiUrl;
+
         static const QString c_apiUrl;
     };
 }
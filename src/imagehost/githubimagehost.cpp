@@ -5,6 +5,7 @@
 #include <QByteArray>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QMutexLocker>
 
 #include <utils/utils.h>
 #include <utils/webutils.h>
@@ -14,7 +15,8 @@ using namespace vnotex;
 const QString GitHubImageHost::c_apiUrl = "https://api.github.com";
 
 GitHubImageHost::GitHubImageHost(QObject *p_parent)
-    : ImageHost(p_parent)
+    : ImageHost(p_parent),
+      m_apiUrl(c_apiUrl)
 {
 }
 
@@ -39,6 +41,8 @@ QJsonObject GitHubImageHost::getConfig() const
 
 void GitHubImageHost::setConfig(const QJsonObject &p_jobj)
 {
+    Q_ASSERT(!isUploading());
+
     parseConfig(p_jobj, m_personalAccessToken, m_userName, m_repoName);
 
     // Do not assume the default branch.
@@ -81,11 +85,11 @@ vte::NetworkAccess::RawHeaderPairs GitHubImageHost::prepareCommonHeaders(const Q
     return rawHeader;
 }
 
-vte::NetworkReply GitHubImageHost::getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const
+ImageHost::HostReply GitHubImageHost::getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const
 {
     auto rawHeader = prepareCommonHeaders(p_token);
-    const auto urlStr = QString("%1/repos/%2/%3").arg(c_apiUrl, p_userName, p_repoName);
-    auto reply = vte::NetworkAccess::request(QUrl(urlStr), rawHeader);
+    const auto urlStr = QString("%1/repos/%2/%3").arg(m_apiUrl, p_userName, p_repoName);
+    auto reply = sendRequest("GET", QUrl(urlStr), rawHeader);
     return reply;
 }
 
@@ -114,10 +118,10 @@ QString GitHubImageHost::create(const QByteArray &p_data, const QString &p_path,
     }
 
     auto rawHeader = prepareCommonHeaders(m_personalAccessToken);
-    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(c_apiUrl, m_userName, m_repoName, p_path);
+    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(m_apiUrl, m_userName, m_repoName, p_path);
 
     // Check if @p_path already exists.
-    auto reply = vte::NetworkAccess::request(QUrl(urlStr), rawHeader);
+    auto reply = sendRequest("GET", QUrl(urlStr), rawHeader);
     if (reply.m_error == QNetworkReply::NoError) {
         p_msg = tr("The resource already exists at the image host (%1).").arg(p_path);
         return QString();
@@ -131,7 +135,11 @@ QString GitHubImageHost::create(const QByteArray &p_data, const QString &p_path,
     requestDataObj[QStringLiteral("message")] = QString("VX_ADD: %1").arg(p_path);
     requestDataObj[QStringLiteral("content")] = QString::fromUtf8(p_data.toBase64());
     auto requestData = Utils::toJsonString(requestDataObj);
-    reply = vte::NetworkAccess::put(QUrl(urlStr), rawHeader, requestData);
+    {
+        // Commit one at a time to avoid conflicts on the branch.
+        QMutexLocker lock(&m_commitMutex);
+        reply = sendRequest("PUT", QUrl(urlStr), rawHeader, requestData);
+    }
     if (reply.m_error != QNetworkReply::NoError) {
         p_msg = tr("Failed to create resource at the image host (%1) (%2) (%3).").arg(urlStr, reply.errorStr(), reply.m_data);
         return QString();
@@ -153,6 +161,11 @@ bool GitHubImageHost::ownsUrl(const QString &p_url) const
     return p_url.startsWith(m_imageUrlPrefix);
 }
 
+void GitHubImageHost::setApiUrl(const QString &p_url)
+{
+    m_apiUrl = p_url;
+}
+
 QString GitHubImageHost::fetchResourcePath(const QString &p_prefix, const QString &p_url)
 {
     auto resourcePath = p_url.mid(p_prefix.size());
@@ -174,11 +187,11 @@ bool GitHubImageHost::remove(const QString &p_url, QString &p_msg)
     const auto resourcePath = fetchResourcePath(m_imageUrlPrefix, p_url);
 
     auto rawHeader = prepareCommonHeaders(m_personalAccessToken);
-    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(c_apiUrl, m_userName, m_repoName, resourcePath);
+    const auto urlStr = QString("%1/repos/%2/%3/contents/%4").arg(m_apiUrl, m_userName, m_repoName, resourcePath);
 
     // Get the SHA of the resource.
     QString sha = "";
-    auto reply = vte::NetworkAccess::request(QUrl(urlStr), rawHeader);
+    auto reply = sendRequest("GET", QUrl(urlStr), rawHeader);
     if (reply.m_error == QNetworkReply::NoError) {
         auto replyObj = Utils::fromJsonString(reply.m_data);
         Q_ASSERT(!replyObj.isEmpty());
@@ -189,7 +202,7 @@ bool GitHubImageHost::remove(const QString &p_url, QString &p_msg)
         const auto fileInfo = QFileInfo(urlStr);
         const auto urlFilePath = QUrl(fileInfo.path());
         const auto fleName = fileInfo.fileName();
-        reply = vte::NetworkAccess::request(urlFilePath, rawHeader);
+        reply = sendRequest("GET", urlFilePath, rawHeader);
 
         if (QNetworkReply::NoError == reply.m_error) {
             const auto jsonArray = QJsonDocument::fromJson(reply.m_data).array();
@@ -217,7 +230,10 @@ bool GitHubImageHost::remove(const QString &p_url, QString &p_msg)
     requestDataObj[QStringLiteral("message")] = QString("VX_DEL: %1").arg(resourcePath);
     requestDataObj[QStringLiteral("sha")] = sha;
     auto requestData = Utils::toJsonString(requestDataObj);
-    reply = vte::NetworkAccess::deleteResource(QUrl(urlStr), rawHeader, requestData);
+    {
+        QMutexLocker lock(&m_commitMutex);
+        reply = sendRequest("DELETE", QUrl(urlStr), rawHeader, requestData);
+    }
     if (reply.m_error != QNetworkReply::NoError) {
         p_msg = tr("Failed to delete resource (%1) (%2).").arg(resourcePath, QString::fromUtf8(reply.m_data));
         return false;
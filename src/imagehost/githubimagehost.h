@@ -29,6 +29,9 @@ namespace vnotex
 
         bool ownsUrl(const QString &p_url) const Q_DECL_OVERRIDE;
 
+        // Used for UT only.
+        void setApiUrl(const QString &p_url);
+
         static QString fetchResourcePath(const QString &p_prefix, const QString &p_url);
 
     protected:
@@ -42,7 +45,7 @@ namespace vnotex
 
     private:
         // Used to test.
-        vte::NetworkReply getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const;
+        HostReply getRepoInfo(const QString &p_token, const QString &p_userName, const QString &p_repoName) const;
 
         static void parseConfig(const QJsonObject &p_jobj,
                                 QString &p_token,
@@ -55,6 +58,8 @@ namespace vnotex
 
         static vte::NetworkAccess::RawHeaderPairs prepareCommonHeaders(const QString &p_token);
 
+        QString m_apiUrl;
+
         static const QString c_apiUrl;
     };
 }
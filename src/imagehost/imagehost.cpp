@@ -1,12 +1,61 @@
 #include "imagehost.h"
 
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonDocument>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QDebug>
+
+#include <core/configmgr.h>
+#include <utils/pathutils.h>
+
+#include "imageuploadcache.h"
+
 using namespace vnotex;
 
+// Timeout in milliseconds of one request.
+static const int c_requestTimeout = 60 * 1000;
+
+static const int c_maxRetries = 6;
+
+// Backoff in milliseconds of the first retry without a hint from the host. Doubled for each retry.
+static const int c_initialBackoff = 1000;
+
+static const int c_maxBackoff = 16 * 1000;
+
+// Give up if the host asks to wait longer.
+static const int c_maxRetryAfterSecs = 60;
+
+// Interval in milliseconds to check the cancel flag while waiting.
+static const int c_cancelCheckInterval = 100;
+
+static thread_local const QAtomicInt *t_canceled = nullptr;
+
+ImageHost::CancelScope::CancelScope(const QAtomicInt *p_canceled)
+    : m_prevCanceled(t_canceled)
+{
+    t_canceled = p_canceled;
+}
+
+ImageHost::CancelScope::~CancelScope()
+{
+    t_canceled = m_prevCanceled;
+}
+
 ImageHost::ImageHost(QObject *p_parent)
     : QObject(p_parent)
 {
 }
 
+ImageHost::~ImageHost()
+{
+}
+
 const QString &ImageHost::getName() const
 {
     return m_name;
@@ -31,3 +80,169 @@ QString ImageHost::typeString(ImageHost::Type p_type)
         return QString("Unknown");
     }
 }
+
+QString ImageHost::uploadCacheKey() const
+{
+    // Token does not change the destination.
+    auto configObj = getConfig();
+    configObj.remove(QStringLiteral("personal_access_token"));
+    configObj[QStringLiteral("type")] = static_cast<int>(getType());
+    const auto data = QJsonDocument(configObj).toJson(QJsonDocument::Compact);
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+
+ImageUploadCache *ImageHost::getUploadCache()
+{
+    const auto key = uploadCacheKey();
+    if (!m_uploadCache || m_uploadCacheKey != key) {
+        if (m_uploadCache) {
+            m_uploadCache->save();
+        }
+
+        const auto folderPath = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                               QStringLiteral("image_host"));
+        QDir().mkpath(folderPath);
+        m_uploadCache.reset(new ImageUploadCache(PathUtils::concatenateFilePath(folderPath, key + QStringLiteral(".json"))));
+        m_uploadCacheKey = key;
+    }
+
+    return m_uploadCache.data();
+}
+
+QString ImageHost::HostReply::errorStr() const
+{
+    return QString("%1 (HTTP %2)").arg(static_cast<int>(m_error)).arg(m_statusCode);
+}
+
+ImageHost::HostReply ImageHost::sendRequest(const QByteArray &p_verb,
+                                            const QUrl &p_url,
+                                            const vte::NetworkAccess::RawHeaderPairs &p_rawHeader,
+                                            const QByteArray &p_data)
+{
+    HostReply hostReply;
+
+    QNetworkAccessManager netMgr;
+    QNetworkRequest request(p_url);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    for (const auto &header : p_rawHeader) {
+        request.setRawHeader(header.first, header.second);
+    }
+
+    for (int i = 0; ; ++i) {
+        if (isCanceled()) {
+            hostReply.m_error = QNetworkReply::OperationCanceledError;
+            break;
+        }
+
+        QScopedPointer<QNetworkReply> reply(p_verb == "GET" ? netMgr.get(request)
+                                                            : netMgr.sendCustomRequest(request, p_verb, p_data));
+
+        QEventLoop loop;
+        QObject::connect(reply.data(), &QNetworkReply::finished,
+                         &loop, &QEventLoop::quit);
+        QTimer::singleShot(c_requestTimeout, &loop, &QEventLoop::quit);
+        if (!reply->isFinished()) {
+            execCancelable(loop);
+        }
+
+        if (!reply->isFinished()) {
+            reply->abort();
+        }
+
+        hostReply.m_error = reply->error();
+        hostReply.m_statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        hostReply.m_data = reply->readAll();
+
+        if (isCanceled()) {
+            break;
+        }
+
+        const int waitMs = retryAfter(reply.data(), i);
+        if (waitMs < 0 || i >= c_maxRetries) {
+            break;
+        }
+
+        qWarning() << "image host asks to retry after" << waitMs << "ms" << p_url;
+
+        // Wait with an event loop so it is fine in GUI thread.
+        QEventLoop waitLoop;
+        QTimer::singleShot(waitMs, &waitLoop, &QEventLoop::quit);
+        execCancelable(waitLoop);
+    }
+
+    return hostReply;
+}
+
+bool ImageHost::isCanceled()
+{
+    return t_canceled && t_canceled->loadAcquire();
+}
+
+void ImageHost::execCancelable(QEventLoop &p_loop)
+{
+    // The flag is set from another thread, so poll it.
+    QTimer cancelTimer;
+    if (t_canceled) {
+        cancelTimer.setInterval(c_cancelCheckInterval);
+        QObject::connect(&cancelTimer, &QTimer::timeout,
+                         &p_loop, [&p_loop]() {
+                             if (isCanceled()) {
+                                 p_loop.quit();
+                             }
+                         });
+        cancelTimer.start();
+    }
+
+    if (!isCanceled()) {
+        p_loop.exec();
+    }
+}
+
+int ImageHost::retryAfter(const QNetworkReply *p_reply, int p_attempt)
+{
+    const int statusCode = p_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    int secs = -1;
+    if (p_reply->hasRawHeader("Retry-After")) {
+        // Seconds or HTTP-date.
+        const auto val = p_reply->rawHeader("Retry-After").trimmed();
+        bool ok = false;
+        secs = val.toInt(&ok);
+        if (!ok) {
+            const auto date = QDateTime::fromString(QString::fromLatin1(val), Qt::RFC2822Date);
+            secs = date.isValid() ? qMax<qint64>(0, QDateTime::currentDateTimeUtc().secsTo(date)) : 1;
+        }
+    } else if ((statusCode == 403 || statusCode == 429) && p_reply->rawHeader("X-RateLimit-Remaining") == "0") {
+        // Primary rate limit of GitHub: wait until the reset time in epoch seconds.
+        const auto resetSecs = p_reply->rawHeader("X-RateLimit-Reset").toLongLong();
+        secs = static_cast<int>(qMax<qint64>(0, resetSecs - QDateTime::currentSecsSinceEpoch()));
+    } else if (statusCode == 429 || statusCode == 409) {
+        // 409: concurrent commits to the same branch may conflict, such as from other clients.
+        // Back off exponentially with jitter so that the retries do not collide again.
+        const int backoff = qMin(c_initialBackoff << qMin(p_attempt, 16), c_maxBackoff);
+        return backoff / 2 + QRandomGenerator::global()->bounded(backoff / 2 + 1);
+    } else {
+        return -1;
+    }
+
+    if (secs > c_maxRetryAfterSecs) {
+        return -1;
+    }
+
+    return qMax(secs, 1) * 1000;
+}
+
+void ImageHost::beginUploads()
+{
+    m_uploadingCount.ref();
+}
+
+void ImageHost::endUploads()
+{
+    m_uploadingCount.deref();
+    Q_ASSERT(m_uploadingCount.loadAcquire() >= 0);
+}
+
+bool ImageHost::isUploading() const
+{
+    return m_uploadingCount.loadAcquire() > 0;
+}
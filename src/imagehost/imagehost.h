@@ -3,13 +3,22 @@
 
 #include <QObject>
 #include <QJsonObject>
+#include <QNetworkReply>
+#include <QScopedPointer>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include <vtextedit/networkutils.h>
 
 #include <core/global.h>
 
 class QByteArray;
+class QEventLoop;
 
 namespace vnotex
 {
+    class ImageUploadCache;
+
     // Abstract class for image host.
     class ImageHost : public QObject
     {
@@ -22,7 +31,23 @@ namespace vnotex
             MaxHost
         };
 
-        virtual ~ImageHost() = default;
+        // RAII helper to make sendRequest() calls of current thread within its lifetime
+        // give up once @p_canceled is set from any thread, used to interrupt create().
+        class CancelScope
+        {
+        public:
+            explicit CancelScope(const QAtomicInt *p_canceled);
+
+            ~CancelScope();
+
+            CancelScope(const CancelScope &) = delete;
+            CancelScope &operator=(const CancelScope &) = delete;
+
+        private:
+            const QAtomicInt *m_prevCanceled = nullptr;
+        };
+
+        virtual ~ImageHost();
 
         const QString &getName() const;
         void setName(const QString &p_name);
@@ -33,11 +58,15 @@ namespace vnotex
         virtual bool ready() const = 0;
 
         virtual QJsonObject getConfig() const = 0;
+
+        // Should not be called while uploading.
         virtual void setConfig(const QJsonObject &p_jobj) = 0;
 
         virtual bool testConfig(const QJsonObject &p_jobj, QString &p_msg) = 0;
 
         // Upload @p_data to the host at path @p_path. Return the target Url string on success.
+        // Should be thread-safe as it may be called from worker threads concurrently.
+        // It only reads the config, which is kept unchanged between beginUploads() and endUploads().
         virtual QString create(const QByteArray &p_data, const QString &p_path, QString &p_msg) = 0;
 
         virtual bool remove(const QString &p_url, QString &p_msg) = 0;
@@ -47,11 +76,63 @@ namespace vnotex
 
         static QString typeString(Type p_type);
 
+        // Mark the period in which create() may be called from worker threads.
+        // Could be nested. Config could not be changed until the last endUploads().
+        void beginUploads();
+        void endUploads();
+
+        bool isUploading() const;
+
+        // Cache of uploaded image data of current config. Reloaded once the config changes.
+        ImageUploadCache *getUploadCache();
+
     protected:
+        struct HostReply
+        {
+            QString errorStr() const;
+
+            QNetworkReply::NetworkError m_error = QNetworkReply::NoError;
+
+            int m_statusCode = 0;
+
+            QByteArray m_data;
+        };
+
         explicit ImageHost(QObject *p_parent = nullptr);
 
+        // Blocking request with a local event loop. Could be called from any thread.
+        // Wait and retry if the host asks to via Retry-After or rate limit headers.
+        // Fail with QNetworkReply::OperationCanceledError once canceled via CancelScope.
+        static HostReply sendRequest(const QByteArray &p_verb,
+                                     const QUrl &p_url,
+                                     const vte::NetworkAccess::RawHeaderPairs &p_rawHeader,
+                                     const QByteArray &p_data = QByteArray());
+
         // Name to identify one image host. One type of image host may have multiple instances.
         QString m_name;
+
+        // Serialize commits to the repository. Concurrent commits to the same branch conflict.
+        QMutex m_commitMutex;
+
+    private:
+        // Return milliseconds to wait before retrying for the @p_attempt-th time (from 0),
+        // or -1 if it should not be retried.
+        static int retryAfter(const QNetworkReply *p_reply, int p_attempt);
+
+        // Whether the innermost CancelScope of current thread is canceled.
+        static bool isCanceled();
+
+        // Run @p_loop until it quits or current thread is canceled.
+        static void execCancelable(QEventLoop &p_loop);
+
+        // Identify the upload destination of current config.
+        QString uploadCacheKey() const;
+
+        QScopedPointer<ImageUploadCache> m_uploadCache;
+
+        QString m_uploadCacheKey;
+
+        QAtomicInt m_uploadingCount;
     };
 }
 
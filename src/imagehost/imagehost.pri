@@ -5,12 +5,16 @@ HEADERS += \
     $$PWD/githubimagehost.h \
     $$PWD/imagehost.h \
     $$PWD/imagehostmgr.h \
-    $$PWD/imagehostutils.h
+    $$PWD/imagehostutils.h \
+    $$PWD/imageuploadcache.h \
+    $$PWD/imageuploadqueue.h
 
 SOURCES += \
     $$PWD/giteeimagehost.cpp \
     $$PWD/githubimagehost.cpp \
     $$PWD/imagehost.cpp \
     $$PWD/imagehostmgr.cpp \
-    $$PWD/imagehostutils.cpp
+    $$PWD/imagehostutils.cpp \
+    $$PWD/imageuploadcache.cpp \
+    $$PWD/imageuploadqueue.cpp
 
@@ -0,0 +1,98 @@
+#include "imageuploadcache.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QDebug>
+
+#include <utils/fileutils.h>
+#include <core/exception.h>
+
+using namespace vnotex;
+
+ImageUploadCache::ImageUploadCache(const QString &p_filePath)
+    : m_filePath(p_filePath)
+{
+    load();
+}
+
+const QString &ImageUploadCache::getFilePath() const
+{
+    return m_filePath;
+}
+
+void ImageUploadCache::load()
+{
+    if (!QFileInfo::exists(m_filePath)) {
+        return;
+    }
+
+    QJsonObject obj;
+    try {
+        obj = QJsonDocument::fromJson(FileUtils::readFile(m_filePath)).object();
+    } catch (Exception &p_e) {
+        qWarning() << "failed to read image upload cache" << m_filePath << p_e.what();
+        return;
+    }
+
+    const auto urlsObj = obj[QStringLiteral("urls")].toObject();
+    m_urls.reserve(urlsObj.size());
+    for (auto it = urlsObj.constBegin(); it != urlsObj.constEnd(); ++it) {
+        m_urls.insert(it.key().toLatin1(), it.value().toString());
+    }
+}
+
+QString ImageUploadCache::find(const QByteArray &p_hash) const
+{
+    return m_urls.value(p_hash);
+}
+
+void ImageUploadCache::insert(const QByteArray &p_hash, const QString &p_url)
+{
+    Q_ASSERT(!p_url.isEmpty());
+    auto &url = m_urls[p_hash];
+    if (url != p_url) {
+        url = p_url;
+        m_dirty = true;
+    }
+}
+
+void ImageUploadCache::removeUrl(const QString &p_url)
+{
+    for (auto it = m_urls.begin(); it != m_urls.end();) {
+        if (it.value() == p_url) {
+            it = m_urls.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ImageUploadCache::save()
+{
+    if (!m_dirty) {
+        return;
+    }
+
+    QJsonObject urlsObj;
+    for (auto it = m_urls.constBegin(); it != m_urls.constEnd(); ++it) {
+        urlsObj[QString::fromLatin1(it.key())] = it.value();
+    }
+
+    QJsonObject obj;
+    obj[QStringLiteral("urls")] = urlsObj;
+
+    try {
+        FileUtils::writeFile(m_filePath, QJsonDocument(obj).toJson(QJsonDocument::Compact));
+        m_dirty = false;
+    } catch (Exception &p_e) {
+        qWarning() << "failed to write image upload cache" << m_filePath << p_e.what();
+    }
+}
+
+QByteArray ImageUploadCache::hash(const QByteArray &p_data)
+{
+    return QCryptographicHash::hash(p_data, QCryptographicHash::Sha256).toHex();
+}
@@ -0,0 +1,46 @@
+#ifndef IMAGEUPLOADCACHE_H
+#define IMAGEUPLOADCACHE_H
+
+#include <QString>
+#include <QHash>
+
+#include <core/noncopyable.h>
+
+namespace vnotex
+{
+    // Persistent map from content hash of uploaded image data to its URL at one image host.
+    class ImageUploadCache : private Noncopyable
+    {
+    public:
+        // Load from @p_filePath if exists.
+        explicit ImageUploadCache(const QString &p_filePath);
+
+        const QString &getFilePath() const;
+
+        // Return empty if not found.
+        QString find(const QByteArray &p_hash) const;
+
+        void insert(const QByteArray &p_hash, const QString &p_url);
+
+        // Drop all entries pointing to @p_url.
+        void removeUrl(const QString &p_url);
+
+        // Write to file if changed.
+        void save();
+
+        // Content hash used as the key.
+        static QByteArray hash(const QByteArray &p_data);
+
+    private:
+        void load();
+
+        QString m_filePath;
+
+        // Hex hash -> URL.
+        QHash<QByteArray, QString> m_urls;
+
+        bool m_dirty = false;
+    };
+}
+
+#endif // IMAGEUPLOADCACHE_H
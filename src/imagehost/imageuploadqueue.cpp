@@ -0,0 +1,227 @@
+#include "imageuploadqueue.h"
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QPointer>
+#include <QDebug>
+
+#include <functional>
+
+#include "imagehost.h"
+#include "imageuploadcache.h"
+
+using namespace vnotex;
+
+namespace
+{
+    class UploadTask : public QRunnable
+    {
+    public:
+        typedef std::function<void(const QString &, const QString &)> Callback;
+
+        UploadTask(ImageHost *p_host,
+                   const QAtomicInt *p_canceled,
+                   const QByteArray &p_data,
+                   const QString &p_path,
+                   const Callback &p_callback)
+            : m_host(p_host),
+              m_canceled(p_canceled),
+              m_data(p_data),
+              m_path(p_path),
+              m_callback(p_callback)
+        {
+        }
+
+        void run() Q_DECL_OVERRIDE
+        {
+            QString errMsg;
+            QString url;
+            {
+                ImageHost::CancelScope cancelScope(m_canceled);
+                url = m_host->create(m_data, m_path, errMsg);
+            }
+            m_callback(url, errMsg);
+        }
+
+    private:
+        ImageHost *m_host = nullptr;
+
+        const QAtomicInt *m_canceled = nullptr;
+
+        QByteArray m_data;
+
+        QString m_path;
+
+        Callback m_callback;
+    };
+}
+
+ImageUploadQueue::ImageUploadQueue(ImageHost *p_host,
+                                   ImageUploadCache *p_cache,
+                                   int p_maxConcurrency,
+                                   QObject *p_parent)
+    : QObject(p_parent),
+      m_host(p_host),
+      m_cache(p_cache),
+      m_maxConcurrency(qMax(1, p_maxConcurrency))
+{
+    Q_ASSERT(m_host);
+
+    m_threadPool = new QThreadPool(this);
+    m_threadPool->setMaxThreadCount(m_maxConcurrency);
+}
+
+ImageUploadQueue::~ImageUploadQueue()
+{
+    // Uploads hold raw pointers to the host and the cancel flag. Interrupt them
+    // so that it does not wait for the network.
+    m_canceled.storeRelease(1);
+    m_threadPool->clear();
+    m_threadPool->waitForDone();
+
+    if (m_started && !m_finished) {
+        m_host->endUploads();
+    }
+}
+
+int ImageUploadQueue::addJob(const QByteArray &p_data, const QString &p_path)
+{
+    Q_ASSERT(!m_started);
+    Job job;
+    job.m_data = p_data;
+    job.m_path = p_path;
+    m_jobs.push_back(job);
+
+    const int idx = m_jobs.size() - 1;
+    const auto hash = ImageUploadCache::hash(p_data);
+    auto &indices = m_jobsByHash[hash];
+    if (indices.isEmpty()) {
+        m_pendingHashes.push_back(hash);
+    }
+    indices.push_back(idx);
+    return idx;
+}
+
+void ImageUploadQueue::start()
+{
+    Q_ASSERT(!m_started);
+    m_started = true;
+    m_host->beginUploads();
+
+    if (m_cache) {
+        for (int i = m_pendingHashes.size() - 1; i >= 0; --i) {
+            const auto url = m_cache->find(m_pendingHashes[i]);
+            if (!url.isEmpty() && m_host->ownsUrl(url)) {
+                const auto hash = m_pendingHashes[i];
+                m_pendingHashes.remove(i);
+                finishJobs(hash, url, QString(), true);
+            }
+        }
+    }
+
+    schedule();
+    checkFinished();
+}
+
+void ImageUploadQueue::abort()
+{
+    if (!m_started || m_finished) {
+        return;
+    }
+
+    m_canceled.storeRelease(1);
+
+    const auto hashes = m_pendingHashes;
+    m_pendingHashes.clear();
+    for (const auto &hash : hashes) {
+        finishJobs(hash, QString(), tr("Aborted"), false);
+    }
+
+    checkFinished();
+}
+
+bool ImageUploadQueue::isFinished() const
+{
+    return m_finished;
+}
+
+int ImageUploadQueue::getFinishedCount() const
+{
+    return m_finishedCount;
+}
+
+const QVector<ImageUploadQueue::Job> &ImageUploadQueue::getJobs() const
+{
+    return m_jobs;
+}
+
+void ImageUploadQueue::schedule()
+{
+    while (!m_pendingHashes.isEmpty() && m_runningCount < m_maxConcurrency) {
+        const auto hash = m_pendingHashes.takeFirst();
+        const auto &job = m_jobs[m_jobsByHash[hash].first()];
+        ++m_runningCount;
+
+        QPointer<ImageUploadQueue> self(this);
+        auto task = new UploadTask(m_host, &m_canceled, job.m_data, job.m_path,
+                                   [self, hash](const QString &p_url, const QString &p_errorMsg) {
+                                       // Back to the thread of the queue.
+                                       QMetaObject::invokeMethod(self.data(), [self, hash, p_url, p_errorMsg]() {
+                                           if (self) {
+                                               self->handleUploadFinished(hash, p_url, p_errorMsg);
+                                           }
+                                       }, Qt::QueuedConnection);
+                                   });
+        m_threadPool->start(task);
+    }
+}
+
+void ImageUploadQueue::handleUploadFinished(const QByteArray &p_hash, const QString &p_url, const QString &p_errorMsg)
+{
+    --m_runningCount;
+
+    if (p_url.isEmpty()) {
+        qWarning() << "failed to upload image" << m_jobs[m_jobsByHash[p_hash].first()].m_path << p_errorMsg;
+    } else if (m_cache) {
+        m_cache->insert(p_hash, p_url);
+    }
+
+    QString errorMsg;
+    if (p_url.isEmpty()) {
+        errorMsg = m_canceled.loadAcquire() ? tr("Aborted") : p_errorMsg;
+    }
+    finishJobs(p_hash, p_url, errorMsg, false);
+
+    schedule();
+    checkFinished();
+}
+
+void ImageUploadQueue::finishJobs(const QByteArray &p_hash, const QString &p_url, const QString &p_errorMsg, bool p_reused)
+{
+    const auto &indices = m_jobsByHash[p_hash];
+    for (int i = 0; i < indices.size(); ++i) {
+        const int idx = indices[i];
+        auto &job = m_jobs[idx];
+        job.m_url = p_url;
+        job.m_errorMsg = p_errorMsg;
+        job.m_reused = p_reused || i > 0;
+
+        ++m_finishedCount;
+        emit jobFinished(idx);
+    }
+}
+
+void ImageUploadQueue::checkFinished()
+{
+    if (m_finished || !m_pendingHashes.isEmpty() || m_runningCount > 0) {
+        return;
+    }
+
+    if (m_cache) {
+        m_cache->save();
+    }
+
+    m_finished = true;
+    m_host->endUploads();
+    emit finished();
+}
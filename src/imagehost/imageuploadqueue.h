@@ -0,0 +1,109 @@
+#ifndef IMAGEUPLOADQUEUE_H
+#define IMAGEUPLOADQUEUE_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QAtomicInt>
+
+class QThreadPool;
+
+namespace vnotex
+{
+    class ImageHost;
+    class ImageUploadCache;
+
+    // Upload a batch of images to one image host with bounded concurrency.
+    // Identical data is uploaded only once, and data found in @p_cache is not uploaded at all.
+    // The config of the host must not change from start() till finished(), since the uploads
+    // read it from worker threads.
+    class ImageUploadQueue : public QObject
+    {
+        Q_OBJECT
+    public:
+        struct Job
+        {
+            QByteArray m_data;
+
+            // Destination path at the image host.
+            QString m_path;
+
+            // Empty if failed or aborted.
+            QString m_url;
+
+            QString m_errorMsg;
+
+            // Whether the URL is taken from the cache or another job of the same data.
+            bool m_reused = false;
+        };
+
+        // @p_cache could be null.
+        ImageUploadQueue(ImageHost *p_host,
+                         ImageUploadCache *p_cache,
+                         int p_maxConcurrency,
+                         QObject *p_parent = nullptr);
+
+        ~ImageUploadQueue();
+
+        // Return the index of the job.
+        int addJob(const QByteArray &p_data, const QString &p_path);
+
+        void start();
+
+        // Cancel jobs not started yet and interrupt running uploads.
+        // finished() will be emitted once the running ones return.
+        void abort();
+
+        bool isFinished() const;
+
+        int getFinishedCount() const;
+
+        const QVector<Job> &getJobs() const;
+
+    signals:
+        // Job @p_idx finished, succeeded or not.
+        void jobFinished(int p_idx);
+
+        void finished();
+
+    private:
+        void schedule();
+
+        void handleUploadFinished(const QByteArray &p_hash, const QString &p_url, const QString &p_errorMsg);
+
+        // Finish all jobs sharing @p_hash.
+        void finishJobs(const QByteArray &p_hash, const QString &p_url, const QString &p_errorMsg, bool p_reused);
+
+        void checkFinished();
+
+        ImageHost *m_host = nullptr;
+
+        ImageUploadCache *m_cache = nullptr;
+
+        int m_maxConcurrency = 1;
+
+        // Set to interrupt running uploads. Read from worker threads.
+        QAtomicInt m_canceled;
+
+        // Managed by QObject.
+        QThreadPool *m_threadPool = nullptr;
+
+        QVector<Job> m_jobs;
+
+        // Hash of data -> indices of jobs.
+        QHash<QByteArray, QVector<int>> m_jobsByHash;
+
+        // Hashes of data not uploaded yet, in the order added.
+        QVector<QByteArray> m_pendingHashes;
+
+        int m_runningCount = 0;
+
+        int m_finishedCount = 0;
+
+        bool m_started = false;
+
+        bool m_finished = false;
+    };
+}
+
+#endif // IMAGEUPLOADQUEUE_H
@@ -21,6 +21,7 @@
 #include <core/logger.h>
 #include <widgets/mainwindow.h>
 #include <core/exception.h>
+#include <core/notebookbackend/backendiostats.h>
 #include <utils/widgetutils.h>
 #include <widgets/messageboxhelper.h>
 #include "commandlineoptions.h"
@@ -136,6 +137,10 @@ int main(int argc, char *argv[])
     // Init logger after app info is set.
     Logger::init(cmdOptions.m_verbose);
 
+    if (!cmdOptions.m_backendIoStatsFile.isEmpty()) {
+        BackendIoStats::getInst().setEnabled(true);
+    }
+
     qInfo() << QString("%1 (v%2) started at %3 (%4)").arg(ConfigMgr::c_appName,
                                                           app.applicationVersion(),
                                                           QDateTime::currentDateTime().toString(),
@@ -180,6 +185,10 @@ int main(int argc, char *argv[])
     window.kickOffOnStart(cmdOptions.m_pathsToOpen);
 
     int ret = app.exec();
+
+    if (!cmdOptions.m_backendIoStatsFile.isEmpty()) {
+        BackendIoStats::getInst().dumpToFile(cmdOptions.m_backendIoStatsFile);
+    }
     if (ret == RESTART_EXIT_CODE) {
         // Asked to restart VNote.
         guard.exit();
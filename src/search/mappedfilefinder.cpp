@@ -0,0 +1,129 @@
+#include "mappedfilefinder.h"
+
+#include <cstring>
+
+#include <buffer/mappedtextfile.h>
+
+using namespace vnotex;
+
+MappedFileFinder::MappedFileFinder(QObject *p_parent)
+    : QThread(p_parent)
+{
+}
+
+void MappedFileFinder::setData(const QSharedPointer<MappedTextFile> &p_file,
+                               const SearchToken &p_token,
+                               int p_startLine,
+                               qint64 p_startOffset,
+                               bool p_backward)
+{
+    m_file = p_file;
+    m_token = p_token;
+    m_startLine = p_startLine;
+    m_startOffset = p_startOffset;
+    m_backward = p_backward;
+}
+
+int MappedFileFinder::getMatchedLine() const
+{
+    return m_matchedLine;
+}
+
+const QList<Segment> &MappedFileFinder::getMatchedSegments() const
+{
+    return m_matchedSegments;
+}
+
+bool MappedFileFinder::isFileChanged() const
+{
+    return m_fileChanged;
+}
+
+void MappedFileFinder::stop()
+{
+    m_askedToStop.store(1);
+}
+
+bool MappedFileFinder::isAskedToStop() const
+{
+    return m_askedToStop.load() == 1;
+}
+
+void MappedFileFinder::run()
+{
+    m_matchedLine = -1;
+    m_matchedSegments.clear();
+    m_fileChanged = false;
+
+    Q_ASSERT(m_file);
+    const auto begin = m_file->dataOffset();
+    const auto end = m_file->size();
+    Q_ASSERT(m_startOffset >= begin && m_startOffset <= end);
+
+    if (!m_backward) {
+        if (!scan(m_startOffset, end, m_startLine, false) && !m_fileChanged) {
+            scan(begin, m_startOffset, 0, false);
+        }
+    } else {
+        if (!scan(begin, m_startOffset, 0, true) && !m_fileChanged) {
+            scan(m_startOffset, end, m_startLine, true);
+        }
+    }
+}
+
+bool MappedFileFinder::scan(qint64 p_begin, qint64 p_end, int p_firstLine, bool p_keepLast)
+{
+    const char *data = m_file->data();
+    const char *pos = data + p_begin;
+    const char *end = data + p_end;
+    const char *nextCheckPos = pos;
+    int lineNum = p_firstLine;
+    bool found = false;
+    while (pos < end) {
+        if (isAskedToStop()) {
+            break;
+        }
+
+        // Search for the line end in bounded chunks and check the file before each one,
+        // since accessing a truncated mapping raises SIGBUS. A line may span many chunks.
+        const char *nl = nullptr;
+        const char *searchPos = pos;
+        while (searchPos < end) {
+            if (searchPos >= nextCheckPos) {
+                if (m_file->isChanged()) {
+                    m_fileChanged = true;
+                    return found;
+                }
+                nextCheckPos = searchPos + MappedTextFile::c_checkInterval;
+            }
+
+            const char *chunkEnd = qMin(end, nextCheckPos);
+            nl = static_cast<const char *>(std::memchr(searchPos, '\n', chunkEnd - searchPos));
+            if (nl) {
+                break;
+            }
+            searchPos = chunkEnd;
+        }
+
+        const char *lineEnd = nl ? nl : end;
+
+        QList<Segment> segments;
+        if (m_token.matched(MappedTextFile::decodeLine(pos, lineEnd), &segments)) {
+            m_matchedLine = lineNum;
+            m_matchedSegments = segments;
+            found = true;
+            if (!p_keepLast) {
+                break;
+            }
+        }
+
+        if (!nl) {
+            break;
+        }
+
+        pos = nl + 1;
+        ++lineNum;
+    }
+
+    return found;
+}
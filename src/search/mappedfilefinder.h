@@ -0,0 +1,77 @@
+#ifndef MAPPEDFILEFINDER_H
+#define MAPPEDFILEFINDER_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QList>
+
+#include "searchtoken.h"
+
+namespace vnotex
+{
+    class MappedTextFile;
+
+    // Find the next matched line of a memory-mapped file in a streaming way,
+    // decoding and matching line by line via SearchToken as the file search engine does.
+    // The search wraps around the end (or the beginning when finding backward).
+    class MappedFileFinder : public QThread
+    {
+        Q_OBJECT
+    public:
+        explicit MappedFileFinder(QObject *p_parent = nullptr);
+
+        // @p_file: only data() and size() will be accessed during the search.
+        // @p_startLine/@p_startOffset: the line number and its byte offset to start from.
+        // Finding forward will check @p_startLine first while finding backward will check
+        // the lines before @p_startLine first.
+        void setData(const QSharedPointer<MappedTextFile> &p_file,
+                     const SearchToken &p_token,
+                     int p_startLine,
+                     qint64 p_startOffset,
+                     bool p_backward);
+
+        // Valid after finished.
+        // Return -1 if no match found.
+        int getMatchedLine() const;
+
+        const QList<Segment> &getMatchedSegments() const;
+
+        // Valid after finished.
+        // Whether the search stopped since the file is changed outside.
+        bool isFileChanged() const;
+
+        bool isAskedToStop() const;
+
+    public slots:
+        void stop();
+
+    protected:
+        void run() Q_DECL_OVERRIDE;
+
+    private:
+        // Scan [@p_begin, @p_end) starting at line @p_firstLine.
+        // Stop at the first match if @p_keepLast is false. Otherwise, keep the last match.
+        bool scan(qint64 p_begin, qint64 p_end, int p_firstLine, bool p_keepLast);
+
+        QAtomicInt m_askedToStop = 0;
+
+        QSharedPointer<MappedTextFile> m_file;
+
+        SearchToken m_token;
+
+        int m_startLine = 0;
+
+        qint64 m_startOffset = 0;
+
+        bool m_backward = false;
+
+        int m_matchedLine = -1;
+
+        bool m_fileChanged = false;
+
+        QList<Segment> m_matchedSegments;
+    };
+}
+
+#endif // MAPPEDFILEFINDER_H
@@ -3,6 +3,7 @@ QT += widgets
 HEADERS += \
     $$PWD/filesearchengine.h \
     $$PWD/isearchengine.h \
+    $$PWD/mappedfilefinder.h \
     $$PWD/searchdata.h \
     $$PWD/searcher.h \
     $$PWD/searchresultitem.h \
@@ -10,6 +11,7 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/filesearchengine.cpp \
+    $$PWD/mappedfilefinder.cpp \
     $$PWD/searchdata.cpp \
     $$PWD/searcher.cpp \
     $$PWD/searchresultitem.cpp \
@@ -8,6 +8,8 @@
 #include <core/exception.h>
 #include <notebook/node.h>
 #include <notebook/notebook.h>
+#include <notebookbackend/inotebookbackend.h>
+#include <notebookbackend/backendiostats.h>
 
 #include "searchresultitem.h"
 #include "filesearchengine.h"
@@ -42,6 +44,8 @@ void Searcher::stop()
 
 SearchState Searcher::search(const QSharedPointer<SearchOption> &p_option, const QList<Buffer *> &p_buffers)
 {
+    BackendIoStats::OperationScope ioScope("search");
+
     if (!(p_option->m_targets & SearchTarget::SearchFile)) {
         // Only File target is applicable.
         return SearchState::Finished;
@@ -76,6 +80,8 @@ SearchState Searcher::search(const QSharedPointer<SearchOption> &p_option, const
 
 SearchState Searcher::search(const QSharedPointer<SearchOption> &p_option, Node *p_folder)
 {
+    BackendIoStats::OperationScope ioScope("search");
+
     Q_ASSERT(p_folder->isContainer());
     if (!(p_option->m_targets & (SearchTarget::SearchFile | SearchTarget::SearchFolder))) {
         // Only File/Folder target is applicable.
@@ -115,6 +121,8 @@ SearchState Searcher::search(const QSharedPointer<SearchOption> &p_option, Node
 
 SearchState Searcher::search(const QSharedPointer<SearchOption> &p_option, const QVector<Notebook *> &p_notebooks)
 {
+    BackendIoStats::OperationScope ioScope("search");
+
     if (!prepare(p_option)) {
         return SearchState::Failed;
     }
@@ -432,7 +440,15 @@ bool Searcher::firstPhaseSearch(Node *p_node, QVector<SearchSecondPhaseItem> &p_
     }
 
     if (testObject(SearchObject::SearchContent)) {
-        p_secondPhaseItems.push_back(SearchSecondPhaseItem(filePath, relativePath));
+        if (p_node->getBackend()->isLocalFileSystem()) {
+            p_secondPhaseItems.push_back(SearchSecondPhaseItem(filePath, relativePath));
+        } else {
+            // Not a plain file on disk. Read it via the backend.
+            auto file = p_node->getContentFile();
+            if (file && !searchContent(file.data())) {
+                return false;
+            }
+        }
     }
 
     return true;
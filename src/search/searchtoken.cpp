@@ -195,11 +195,6 @@ bool SearchToken::compile(const QString &p_keyword, FindOptions p_options, Searc
 
     createCommandLineParser();
 
-    auto caseSensitivity = p_options & FindOption::CaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-    bool isRegularExpression = p_options & FindOption::RegularExpression;
-    bool isWholeWordOnly = p_options & FindOption::WholeWordOnly;
-    bool isFuzzySearch = p_options & FindOption::FuzzySearch;
-
     auto args = ProcessUtils::parseCombinedArgString(p_keyword);
     // The parser needs the first arg to be the application name.
     args.prepend("vnotex");
@@ -209,16 +204,16 @@ bool SearchToken::compile(const QString &p_keyword, FindOptions p_options, Searc
     }
 
     if (s_parser->isSet("c")) {
-        caseSensitivity = Qt::CaseSensitive;
+        p_options |= FindOption::CaseSensitive;
     }
     if (s_parser->isSet("r")) {
-        isRegularExpression = true;
+        p_options |= FindOption::RegularExpression;
     }
     if (s_parser->isSet("w")) {
-        isWholeWordOnly = true;
+        p_options |= FindOption::WholeWordOnly;
     }
     if (s_parser->isSet("f")) {
-        isFuzzySearch = true;
+        p_options |= FindOption::FuzzySearch;
     }
 
     args = s_parser->positionalArguments();
@@ -226,17 +221,39 @@ bool SearchToken::compile(const QString &p_keyword, FindOptions p_options, Searc
         return false;
     }
 
+    appendKeywords(args, p_options, p_token);
+    p_token.m_operator = s_parser->isSet("o") ? Operator::Or : Operator::And;
+
+    return !p_token.isEmpty();
+}
+
+bool SearchToken::compile(const QStringList &p_texts, FindOptions p_options, SearchToken &p_token)
+{
+    p_token.clear();
+
+    appendKeywords(p_texts, p_options, p_token);
+    p_token.m_operator = Operator::Or;
+
+    return !p_token.isEmpty();
+}
+
+void SearchToken::appendKeywords(const QStringList &p_keywords, FindOptions p_options, SearchToken &p_token)
+{
+    const auto caseSensitivity = p_options & FindOption::CaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const bool isRegularExpression = p_options & FindOption::RegularExpression;
+    const bool isWholeWordOnly = p_options & FindOption::WholeWordOnly;
+    const bool isFuzzySearch = p_options & FindOption::FuzzySearch;
+
     p_token.m_caseSensitivity = caseSensitivity;
     if (isRegularExpression || isWholeWordOnly || isFuzzySearch) {
         p_token.m_type = Type::RegularExpression;
     } else {
         p_token.m_type = Type::PlainText;
     }
-    p_token.m_operator = s_parser->isSet("o") ? Operator::Or : Operator::And;
 
     auto patternOptions = caseSensitivity == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption
                                                                  : QRegularExpression::NoPatternOption;
-    for (const auto &ar : args) {
+    for (const auto &ar : p_keywords) {
         if (ar.isEmpty()) {
             continue;
         }
@@ -260,8 +277,6 @@ bool SearchToken::compile(const QString &p_keyword, FindOptions p_options, Searc
             p_token.append(ar);
         }
     }
-
-    return !p_token.isEmpty();
 }
 
 QString SearchToken::getHelpText()
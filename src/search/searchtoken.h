@@ -60,11 +60,16 @@ namespace vnotex
         // Support some magic switchs in the keyword which will suppress the given options.
         static bool compile(const QString &p_keyword, FindOptions p_options, SearchToken &p_token);
 
+        // Compile tokens from @p_texts of find in editor, which are taken literally and combined by Or.
+        static bool compile(const QStringList &p_texts, FindOptions p_options, SearchToken &p_token);
+
         static QString getHelpText();
 
     private:
         static void createCommandLineParser();
 
+        static void appendKeywords(const QStringList &p_keywords, FindOptions p_options, SearchToken &p_token);
+
         Type m_type = Type::PlainText;
 
         Operator m_operator = Operator::And;
@@ -172,10 +172,11 @@ void ContentMediaUtils::removeMarkdownMediaFiles(const File *p_file, INotebookBa
     }
 }
 
-void ContentMediaUtils::copyAttachment(Node *p_node,
+bool ContentMediaUtils::copyAttachment(Node *p_node,
                                        INotebookBackend *p_backend,
                                        const QString &p_destFilePath,
-                                       const QString &p_destAttachmentFolderPath)
+                                       const QString &p_destAttachmentFolderPath,
+                                       bool p_move)
 {
     Q_ASSERT(p_node->hasContent());
     Q_ASSERT(!p_node->getAttachmentFolder().isEmpty());
@@ -184,25 +185,26 @@ void ContentMediaUtils::copyAttachment(Node *p_node,
     const auto srcAttachmentFolderPath = p_node->fetchAttachmentFolderPath();
     try {
         if (p_backend) {
-            p_backend->copyDir(srcAttachmentFolderPath, p_destAttachmentFolderPath);
+            p_backend->copyDir(srcAttachmentFolderPath, p_destAttachmentFolderPath, p_move);
         } else {
-            FileUtils::copyDir(srcAttachmentFolderPath, p_destAttachmentFolderPath);
+            FileUtils::copyDir(srcAttachmentFolderPath, p_destAttachmentFolderPath, p_move);
         }
     } catch (Exception &e) {
         qWarning() << "failed to copy attachment folder" << srcAttachmentFolderPath << e.what();
-        return;
+        return false;
     }
 
     // Check if we need to modify links in content.
     // FIXME: check the whole relative path.
     if (p_node->getAttachmentFolder() == PathUtils::dirName(p_destAttachmentFolderPath)) {
-        return;
+        return true;
     }
 
     auto file = p_node->getContentFile();
     if (file->getContentType().isMarkdown()) {
         fixMarkdownLinks(srcAttachmentFolderPath, p_backend, p_destFilePath, p_destAttachmentFolderPath);
     }
+    return true;
 }
 
 void ContentMediaUtils::fixMarkdownLinks(const QString &p_srcFolderPath,
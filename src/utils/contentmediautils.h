@@ -32,10 +32,13 @@ namespace vnotex
         static void removeMediaFiles(Node *p_node);
 
         // Copy attachment folder.
-        static void copyAttachment(Node *p_node,
+        // @p_move: move the folder instead, which is one single rename on the same device.
+        // Return false if failed to copy the folder. Source is kept and nothing is left at dest then.
+        static bool copyAttachment(Node *p_node,
                                    INotebookBackend *p_backend,
                                    const QString &p_destFilePath,
-                                   const QString &p_destAttachmentFolderPath);
+                                   const QString &p_destAttachmentFolderPath,
+                                   bool p_move = false);
 
     private:
         static void copyMarkdownMediaFiles(const QString &p_content,
@@ -1,18 +1,172 @@
 #include "fileutils.h"
 
 #include <QFile>
+#include <QSaveFile>
 #include <QMimeDatabase>
 #include <QDateTime>
 #include <QTemporaryFile>
 #include <QJsonDocument>
+#include <QDirIterator>
+#include <QThread>
+#include <QAtomicInteger>
+#include <QVector>
+#include <QPair>
 
 #include <core/exception.h>
 #include <core/global.h>
 
 #include "pathutils.h"
 
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/fs.h>
+#endif
+
 using namespace vnotex;
 
+// Copy content of @p_filePath to @p_destPath within kernel if possible (reflink or copy_file_range).
+// Return false if it is not supported and caller should fall back to a user-space copy.
+static bool copyFileInKernel(const QString &p_filePath, const QString &p_destPath)
+{
+#if defined(Q_OS_LINUX)
+    const int in = ::open(QFile::encodeName(p_filePath).constData(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(in, &st) != 0) {
+        ::close(in);
+        return false;
+    }
+
+    const int out = ::open(QFile::encodeName(p_destPath).constData(),
+                           O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+                           st.st_mode & 0777);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool done = false;
+
+#if defined(FICLONE)
+    // Reflink on CoW file systems such as Btrfs and XFS.
+    done = ::ioctl(out, FICLONE, in) == 0;
+#endif
+
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 27)
+    if (!done) {
+        off_t remain = st.st_size;
+        while (remain > 0) {
+            const auto ret = ::copy_file_range(in, nullptr, out, nullptr, static_cast<size_t>(remain), 0);
+            if (ret <= 0) {
+                // Not supported (such as EXDEV on old kernels) or reached EOF unexpectedly.
+                break;
+            }
+
+            remain -= ret;
+        }
+
+        done = remain == 0;
+    }
+#endif
+#endif
+
+    ::close(in);
+    ::close(out);
+
+    if (!done) {
+        // Let the fallback copy create it.
+        ::unlink(QFile::encodeName(p_destPath).constData());
+    }
+
+    return done;
+#else
+    Q_UNUSED(p_filePath);
+    Q_UNUSED(p_destPath);
+    return false;
+#endif
+}
+
+static bool copyFileContent(const QString &p_filePath, const QString &p_destPath)
+{
+    if (copyFileInKernel(p_filePath, p_destPath)) {
+        return true;
+    }
+
+    return QFile::copy(p_filePath, p_destPath);
+}
+
+// Progress callback of the innermost CopyProgressScope of current thread.
+static thread_local const FileUtils::CopyProgressCallback *t_copyProgress = nullptr;
+
+namespace
+{
+    // Worker thread to copy a batch of files.
+    class FileCopyWorker : public QThread
+    {
+    public:
+        FileCopyWorker(const QVector<QPair<QString, QString>> &p_files,
+                       QAtomicInteger<qint64> *p_copiedBytes,
+                       QAtomicInt *p_failed)
+            : m_files(p_files),
+              m_copiedBytes(p_copiedBytes),
+              m_failed(p_failed)
+        {
+        }
+
+        const QString &getError() const
+        {
+            return m_error;
+        }
+
+    protected:
+        void run() Q_DECL_OVERRIDE
+        {
+            for (const auto &file : m_files) {
+                if (m_failed->loadAcquire()) {
+                    return;
+                }
+
+                if (!copyFileContent(file.first, file.second)) {
+                    m_error = QString("failed to copy file: %1 %2").arg(file.first, file.second);
+                    m_failed->storeRelease(1);
+                    return;
+                }
+
+                // Polled by the calling thread to report progress.
+                m_copiedBytes->fetchAndAddRelaxed(QFileInfo(file.second).size());
+            }
+        }
+
+    private:
+        QVector<QPair<QString, QString>> m_files;
+
+        QAtomicInteger<qint64> *m_copiedBytes = nullptr;
+
+        QAtomicInt *m_failed = nullptr;
+
+        QString m_error;
+    };
+}
+
+FileUtils::CopyProgressScope::CopyProgressScope(const CopyProgressCallback &p_progress)
+    : m_prevProgress(t_copyProgress),
+      m_progress(p_progress)
+{
+    t_copyProgress = &m_progress;
+}
+
+FileUtils::CopyProgressScope::~CopyProgressScope()
+{
+    t_copyProgress = m_prevProgress;
+}
+
 QByteArray FileUtils::readFile(const QString &p_filePath)
 {
     QFile file(p_filePath);
@@ -45,27 +199,40 @@ QJsonObject FileUtils::readJsonFile(const QString &p_filePath)
 
 void FileUtils::writeFile(const QString &p_filePath, const QByteArray &p_data)
 {
-    QFile file(p_filePath);
+    // QSaveFile syncs the temporary file before renaming it to the target on commit.
+    // Write in place if the temporary file could not be created, such as in a read-only folder.
+    QSaveFile file(p_filePath);
+    file.setDirectWriteFallback(true);
     if (!file.open(QIODevice::WriteOnly)) {
         Exception::throwOne(Exception::Type::FailToWriteFile,
                             QString("failed to write to file: %1").arg(p_filePath));
     }
 
     file.write(p_data);
-    file.close();
+    if (!file.commit()) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1 (%2)").arg(p_filePath, file.errorString()));
+    }
 }
 
 void FileUtils::writeFile(const QString &p_filePath, const QString &p_text)
 {
-    QFile file(p_filePath);
+    QSaveFile file(p_filePath);
+    file.setDirectWriteFallback(true);
     if (!file.open(QIODevice::WriteOnly)) {
         Exception::throwOne(Exception::Type::FailToWriteFile,
                             QString("failed to write to file: %1").arg(p_filePath));
     }
 
-    QTextStream stream(&file);
-    stream << p_text;
-    file.close();
+    {
+        QTextStream stream(&file);
+        stream << p_text;
+    }
+
+    if (!file.commit()) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1 (%2)").arg(p_filePath, file.errorString()));
+    }
 }
 
 void FileUtils::writeFile(const QString &p_filePath, const QJsonObject &p_jobj)
@@ -128,7 +295,7 @@ void FileUtils::copyFile(const QString &p_filePath,
             failed = true;
         }
     } else {
-        if (!QFile::copy(p_filePath, p_destPath)) {
+        if (!copyFileContent(p_filePath, p_destPath)) {
             failed = true;
         }
     }
@@ -141,7 +308,8 @@ void FileUtils::copyFile(const QString &p_filePath,
 
 void FileUtils::copyDir(const QString &p_dirPath,
                         const QString &p_destPath,
-                        bool p_move)
+                        bool p_move,
+                        const CopyProgressCallback &p_progress)
 {
     if (PathUtils::areSamePaths(p_dirPath, p_destPath)) {
         return;
@@ -152,34 +320,116 @@ void FileUtils::copyDir(const QString &p_dirPath,
                             QString("target directory %1 already exists").arg(p_destPath));
     }
 
-    // QDir.rename() could not move directory across dirves.
+    if (p_move) {
+        // Fast path: one single rename(2). It fails if they locate on different devices.
+        QDir dir;
+        if (dir.mkpath(PathUtils::parentDirPath(p_destPath)) && dir.rename(p_dirPath, p_destPath)) {
+            return;
+        }
+    }
 
-    // Create target directory.
-    QDir destDir(p_destPath);
-    if (!destDir.mkpath(p_destPath)) {
-        Exception::throwOne(Exception::Type::FailToCreateDir,
-            QString("failed to create directory: %1").arg(p_destPath));
-    }
-
-    // Copy directory contents recursively.
-    QDir srcDir(p_dirPath);
-    auto nodes = srcDir.entryInfoList(QDir::Dirs
-                                      | QDir::Files
-                                      | QDir::Hidden
-                                      | QDir::NoSymLinks
-                                      | QDir::NoDotAndDotDot);
-    for (const auto &node : nodes) {
-        auto name = node.fileName();
-        if (node.isDir()) {
-            copyDir(srcDir.filePath(name), destDir.filePath(name), p_move);
-        } else {
-            Q_ASSERT(node.isFile());
-            copyFile(srcDir.filePath(name), destDir.filePath(name), p_move);
+    // Collect directories and files to copy.
+    QStringList dirs;
+    QVector<QPair<QString, QString>> files;
+    qint64 totalBytes = 0;
+    {
+        QDir srcDir(p_dirPath);
+        QDir destDir(p_destPath);
+        QDirIterator it(p_dirPath,
+                        QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoSymLinks | QDir::NoDotAndDotDot,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const auto path = it.next();
+            const auto fi = it.fileInfo();
+            const auto destPath = destDir.filePath(srcDir.relativeFilePath(path));
+            if (fi.isDir()) {
+                dirs << destPath;
+            } else {
+                Q_ASSERT(fi.isFile());
+                files.push_back(qMakePair(path, destPath));
+                totalBytes += fi.size();
+            }
         }
     }
 
+    // Create target directories.
+    {
+        QDir dir;
+        if (!dir.mkpath(p_destPath)) {
+            Exception::throwOne(Exception::Type::FailToCreateDir,
+                                QString("failed to create directory: %1").arg(p_destPath));
+        }
+
+        for (const auto &destPath : dirs) {
+            if (!dir.mkpath(destPath)) {
+                removeDir(p_destPath);
+                Exception::throwOne(Exception::Type::FailToCreateDir,
+                                    QString("failed to create directory: %1").arg(destPath));
+            }
+        }
+    }
+
+    const auto &progress = p_progress ? p_progress : (t_copyProgress ? *t_copyProgress : p_progress);
+
+    // Copy files concurrently.
+    QAtomicInteger<qint64> copiedBytes = 0;
+    QAtomicInt failed = 0;
+    {
+        int numThread = qMin(QThread::idealThreadCount(), 8);
+        if (numThread < 1 || files.size() < 16) {
+            numThread = 1;
+        }
+
+        QVector<QSharedPointer<FileCopyWorker>> workers;
+        workers.reserve(numThread);
+        for (int i = 0; i < numThread; ++i) {
+            QVector<QPair<QString, QString>> batch;
+            for (int j = i; j < files.size(); j += numThread) {
+                batch.push_back(files[j]);
+            }
+
+            auto worker = QSharedPointer<FileCopyWorker>::create(batch, &copiedBytes, &failed);
+            workers.push_back(worker);
+            worker->start();
+        }
+
+        for (const auto &worker : workers) {
+            while (!worker->wait(100)) {
+                if (progress) {
+                    progress(copiedBytes.loadAcquire(), totalBytes);
+                }
+            }
+        }
+
+        if (failed.loadAcquire()) {
+            QString err;
+            for (const auto &worker : workers) {
+                if (!worker->getError().isEmpty()) {
+                    err = worker->getError();
+                    break;
+                }
+            }
+
+            // Roll back.
+            try {
+                removeDir(p_destPath);
+            } catch (Exception &p_e) {
+                qWarning() << "failed to roll back partially copied directory" << p_destPath << p_e.what();
+            }
+
+            Exception::throwOne(Exception::Type::FailToCopyDir,
+                                QString("failed to copy directory %1 to %2 (%3)").arg(p_dirPath, p_destPath, err));
+        }
+    }
+
+    if (progress) {
+        progress(totalBytes, totalBytes);
+    }
+
     if (p_move) {
-        if (!destDir.rmdir(p_dirPath)) {
+        // Copy succeeded. Remove the source now.
+        QDir dir(p_dirPath);
+        if (!dir.removeRecursively()) {
             Exception::throwOne(Exception::Type::FailToRemoveDir,
                 QString("failed to remove source directory after move: %1").arg(p_dirPath));
         }
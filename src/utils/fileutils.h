@@ -8,6 +8,8 @@
 #include <QJsonObject>
 #include <QDir>
 
+#include <functional>
+
 class QTemporaryFile;
 
 namespace vnotex
@@ -17,12 +19,35 @@ namespace vnotex
     public:
         FileUtils() = delete;
 
+        // Called with copied bytes and total bytes.
+        typedef std::function<void(qint64, qint64)> CopyProgressCallback;
+
+        // RAII helper to report progress of copyDir() calls of current thread within its lifetime
+        // to @p_progress, used when the call is deep in the backends without a callback.
+        class CopyProgressScope
+        {
+        public:
+            explicit CopyProgressScope(const CopyProgressCallback &p_progress);
+
+            ~CopyProgressScope();
+
+            CopyProgressScope(const CopyProgressScope &) = delete;
+            CopyProgressScope &operator=(const CopyProgressScope &) = delete;
+
+        private:
+            const CopyProgressCallback *m_prevProgress = nullptr;
+
+            CopyProgressCallback m_progress;
+        };
+
         static QByteArray readFile(const QString &p_filePath);
 
         static QString readTextFile(const QString &p_filePath);
 
         static QJsonObject readJsonFile(const QString &p_filePath);
 
+        // Write to a temporary file in the same folder, sync it and rename it to @p_filePath,
+        // so a failure never leaves a truncated file.
         static void writeFile(const QString &p_filePath, const QByteArray &p_data);
 
         static void writeFile(const QString &p_filePath, const QString &p_text);
@@ -40,9 +65,14 @@ namespace vnotex
                              const QString &p_destPath,
                              bool p_move = false);
 
+        // Move will be done via one single rename if source and dest are on the same device.
+        // Otherwise, files are copied concurrently and @p_destPath will be removed on failure.
+        // @p_progress: called periodically in the calling thread while files are copied by workers.
+        // The innermost CopyProgressScope of the calling thread is used if it is null.
         static void copyDir(const QString &p_dirPath,
                             const QString &p_destPath,
-                            bool p_move = false);
+                            bool p_move = false,
+                            const CopyProgressCallback &p_progress = nullptr);
 
         static void removeFile(const QString &p_filePath);
 
@@ -8,6 +8,7 @@
 #include <QComboBox>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QSpinBox>
 #include <QLineEdit>
 #include <QProgressBar>
 #include <QFileInfo>
@@ -243,6 +244,20 @@ QWidget *ExportDialog::setupGeneralAdvancedSettings(QWidget *p_parent)
         layout->addRow(m_exportAttachmentsCheckBox);
     }
 
+    {
+        m_viewerCountSpinBox = WidgetsFactory::createSpinBox(widget);
+        m_viewerCountSpinBox->setToolTip(tr("Number of notes to render concurrently when exporting a folder or notebook"));
+        m_viewerCountSpinBox->setRange(0, 16);
+        m_viewerCountSpinBox->setSpecialValueText(tr("Auto"));
+        layout->addRow(tr("Concurrent rendering:"), m_viewerCountSpinBox);
+    }
+
+    {
+        m_reuseViewerPageCheckBox = WidgetsFactory::createCheckBox(tr("Reuse rendering page across notes"), widget);
+        m_reuseViewerPageCheckBox->setToolTip(tr("Load the rendering page once and push each note into it instead of reloading the page per note"));
+        layout->addRow(m_reuseViewerPageCheckBox);
+    }
+
     return widget;
 }
 
@@ -343,6 +358,10 @@ void ExportDialog::restoreFields(const ExportOption &p_option)
     m_recursiveCheckBox->setChecked(p_option.m_recursive);
 
     m_exportAttachmentsCheckBox->setChecked(p_option.m_exportAttachments);
+
+    m_viewerCountSpinBox->setValue(p_option.m_viewerCount);
+
+    m_reuseViewerPageCheckBox->setChecked(p_option.m_reuseViewerPage);
 }
 
 void ExportDialog::saveFields(ExportOption &p_option)
@@ -355,6 +374,8 @@ void ExportDialog::saveFields(ExportOption &p_option)
     p_option.m_outputDir = getOutputDir();
     p_option.m_recursive = m_recursiveCheckBox->isChecked();
     p_option.m_exportAttachments = m_exportAttachmentsCheckBox->isChecked();
+    p_option.m_viewerCount = m_viewerCountSpinBox->value();
+    p_option.m_reuseViewerPage = m_reuseViewerPageCheckBox->isChecked();
 
     if (m_advancedSettings[AdvancedSettings::HTML]) {
         saveFields(p_option.m_htmlOption);
@@ -11,6 +11,7 @@ class QGroupBox;
 class QPushButton;
 class QComboBox;
 class QCheckBox;
+class QSpinBox;
 class QLineEdit;
 class QProgressBar;
 class QPlainTextEdit;
@@ -159,6 +160,10 @@ namespace vnotex
 
         QCheckBox *m_exportAttachmentsCheckBox = nullptr;
 
+        QSpinBox *m_viewerCountSpinBox = nullptr;
+
+        QCheckBox *m_reuseViewerPageCheckBox = nullptr;
+
         // HTML settings.
         QCheckBox *m_embedStylesCheckBox = nullptr;
 
@@ -189,9 +189,17 @@ void NotebookInfoWidget::setupBackendComboBox(QWidget *p_parent)
     m_backendComboBox = WidgetsFactory::createComboBox(p_parent);
     m_backendComboBox->setToolTip(tr("Backend of notebook"));
 
+    const bool isCreation = m_mode == Mode::Create
+                            || m_mode == Mode::CreateFromFolder
+                            || m_mode == Mode::CreateFromLegacy;
+
     QString whatsThis = tr("Specify backend of notebook.<br/>");
     auto &notebookMgr = VNoteX::getInst().getNotebookMgr();
     for (auto &factory : notebookMgr.getAllNotebookBackendFactories()) {
+        if (isCreation && !factory->isCreatable()) {
+            continue;
+        }
+
         m_backendComboBox->addItem(factory->getDisplayName(), factory->getName());
         whatsThis += tr("<b>%1</b>: %2<br/>").arg(factory->getDisplayName(),
                                                   factory->getDescription());
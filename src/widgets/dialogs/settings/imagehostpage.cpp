@@ -165,6 +165,11 @@ bool ImageHostPage::saveInternal()
         }
 
         // Configs.
+        if (host->isUploading()) {
+            setError(tr("Failed to change config of image host (%1) while uploading.").arg(host->getName()));
+            hasError = true;
+            continue;
+        }
         const auto configObj = fieldsToConfig(fields);
         host->setConfig(configObj);
     }
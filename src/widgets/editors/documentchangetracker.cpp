@@ -0,0 +1,109 @@
+#include "documentchangetracker.h"
+
+#include <QTextDocument>
+#include <QTextCursor>
+
+using namespace vnotex;
+
+DocumentChangeTracker::DocumentChangeTracker(QTextDocument *p_doc, QObject *p_parent)
+    : QObject(p_parent),
+      m_doc(p_doc)
+{
+    connect(m_doc, &QTextDocument::contentsChange,
+            this, &DocumentChangeTracker::handleContentsChange);
+}
+
+void DocumentChangeTracker::reset()
+{
+    m_valid = true;
+    m_dirty = false;
+}
+
+int DocumentChangeTracker::documentLength() const
+{
+    // Exclude the trailing paragraph separator.
+    return m_doc->characterCount() - 1;
+}
+
+void DocumentChangeTracker::handleContentsChange(int p_position, int p_charsRemoved, int p_charsAdded)
+{
+    if (!m_valid) {
+        return;
+    }
+
+    // Changes of the whole document, such as setPlainText(), count the trailing paragraph
+    // separator in both removed and added.
+    const int overflow = p_position + p_charsAdded - documentLength();
+    if (overflow > 0) {
+        p_charsAdded -= overflow;
+        p_charsRemoved -= overflow;
+    }
+
+    if (p_position < 0 || p_charsAdded < 0 || p_charsRemoved < 0) {
+        m_valid = false;
+        return;
+    }
+
+    if (!m_dirty) {
+        m_dirty = true;
+        m_start = p_position;
+        m_oldEnd = p_position + p_charsRemoved;
+        m_newEnd = p_position + p_charsAdded;
+        return;
+    }
+
+    // Merge with the changed range. Text beyond m_newEnd is identical to the copy beyond m_oldEnd.
+    const int removedEnd = p_position + p_charsRemoved;
+    if (removedEnd > m_newEnd) {
+        m_oldEnd += removedEnd - m_newEnd;
+        m_newEnd = removedEnd;
+    }
+
+    m_start = qMin(m_start, p_position);
+    m_newEnd += p_charsAdded - p_charsRemoved;
+}
+
+bool DocumentChangeTracker::apply(QString &p_text) const
+{
+    if (!m_valid) {
+        return false;
+    }
+
+    const int docLen = documentLength();
+    if (!m_dirty) {
+        return p_text.size() == docLen;
+    }
+
+    if (m_oldEnd > p_text.size()
+        || m_newEnd > docLen
+        || p_text.size() - (m_oldEnd - m_start) + (m_newEnd - m_start) != docLen) {
+        return false;
+    }
+
+    QTextCursor cursor(m_doc);
+    cursor.setPosition(m_start);
+    cursor.setPosition(m_newEnd, QTextCursor::KeepAnchor);
+    auto text = cursor.selectedText();
+
+    // The same as QTextDocument::toPlainText().
+    for (auto &ch : text) {
+        switch (ch.unicode()) {
+        case 0xfdd0:
+        case 0xfdd1:
+        case QChar::ParagraphSeparator:
+        case QChar::LineSeparator:
+            ch = QLatin1Char('\n');
+            break;
+
+        case QChar::Nbsp:
+            ch = QLatin1Char(' ');
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    p_text.replace(m_start, m_oldEnd - m_start, text);
+    return true;
+}
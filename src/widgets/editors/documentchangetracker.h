@@ -0,0 +1,51 @@
+#ifndef DOCUMENTCHANGETRACKER_H
+#define DOCUMENTCHANGETRACKER_H
+
+#include <QObject>
+
+class QTextDocument;
+
+namespace vnotex
+{
+    // Track the range of a QTextDocument changed since last reset, so that a plain text copy
+    // of the document could be brought up to date without fetching the whole text.
+    // All the changes are merged into one range [start, end), in which the copy and the
+    // document may differ.
+    class DocumentChangeTracker : public QObject
+    {
+        Q_OBJECT
+    public:
+        DocumentChangeTracker(QTextDocument *p_doc, QObject *p_parent = nullptr);
+
+        // The copy is now identical to the document.
+        void reset();
+
+        // Apply the changes since last reset to @p_text, which is identical to the document at last reset.
+        // Return false if the changes could not be applied and @p_text is left untouched.
+        bool apply(QString &p_text) const;
+
+    private:
+        void handleContentsChange(int p_position, int p_charsRemoved, int p_charsAdded);
+
+        // Length of the plain text of the document.
+        int documentLength() const;
+
+        QTextDocument *m_doc = nullptr;
+
+        // False if some changes could not be tracked.
+        bool m_valid = true;
+
+        bool m_dirty = false;
+
+        // Start of the changed range, the same in the copy and the document.
+        int m_start = 0;
+
+        // End of the changed range in the copy.
+        int m_oldEnd = 0;
+
+        // End of the changed range in the document.
+        int m_newEnd = 0;
+    };
+}
+
+#endif // DOCUMENTCHANGETRACKER_H
@@ -2,16 +2,24 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QThread>
+#include <QCryptographicHash>
 
 #include <utils/processutils.h>
+#include <utils/pathutils.h>
+#include <core/configmgr.h>
+#include <core/diskcache.h>
 
 using namespace vnotex;
 
-#define TaskIdProperty "GraphTaskId"
-#define TaskTimeStampProperty "GraphTaskTimeStamp"
+GraphHelper::GraphHelper(const QString &p_name)
+    : m_name(p_name),
+      m_cache(100, CacheItem())
+{
+    setMaxProcesses(0);
+}
 
-GraphHelper::GraphHelper()
-    : m_cache(100, CacheItem())
+GraphHelper::~GraphHelper()
 {
 }
 
@@ -55,126 +63,225 @@ void GraphHelper::process(quint64 p_id,
 
     m_tasks.enqueue(task);
 
-    processOneTask();
+    schedule();
 }
 
-void GraphHelper::processOneTask()
+void GraphHelper::setMaxProcesses(int p_max)
 {
-    if (m_taskOngoing || m_tasks.isEmpty()) {
-        return;
+    if (p_max <= 0) {
+        // Renderers like PlantUML are heavy, so leave some cores to others.
+        p_max = qBound(1, QThread::idealThreadCount() / 2, 4);
     }
 
-    m_taskOngoing = true;
+    m_maxProcesses = p_max;
 
-    const auto &task = m_tasks.head();
+    schedule();
+}
 
-    const auto &cachedData = m_cache.get(task.m_text);
-    if (!cachedData.isNull() && cachedData.m_format == task.m_format) {
-        finishOneTask(cachedData.m_data);
-        return;
+void GraphHelper::setDiskCacheSize(int p_sizeInMiB)
+{
+    m_diskCacheSize = static_cast<qint64>(qMax(0, p_sizeInMiB)) * 1024 * 1024;
+    if (m_diskCache) {
+        if (m_diskCacheSize > 0) {
+            m_diskCache->setMaxSize(m_diskCacheSize);
+        } else {
+            m_diskCache.reset();
+        }
     }
+}
+
+void GraphHelper::schedule()
+{
+    while (!m_tasks.isEmpty() && m_runningCount < m_maxProcesses) {
+        const auto task = m_tasks.dequeue();
+
+        const auto cachedData = findInCache(task);
+        if (!cachedData.isNull()) {
+            qDebug() << "Graph task" << task.m_id << task.m_timeStamp << "finished by cache" << cachedData.size();
+            callbackOneTask(task, task.m_id, task.m_timeStamp, task.m_format, cachedData);
+            continue;
+        }
+
+        if (!m_programValid) {
+            qWarning() << "program to execute for rendering is not valid" << m_program;
+            callbackOneTask(task, task.m_id, task.m_timeStamp, task.m_format, QString());
+            continue;
+        }
 
-    if (!m_programValid) {
-        qWarning() << "program to execute for rendering is not valid" << m_program;
-        finishOneTask(QString());
-        return;
+        ++m_runningCount;
+        bool ret = renderByWorker(task.m_format,
+                                  task.m_text,
+                                  [this, task](const QByteArray &p_output, bool p_clean) {
+                                      finishOneTask(task, p_output, p_clean);
+                                  });
+        if (!ret) {
+            startProcess(task);
+        }
     }
+}
+
+bool GraphHelper::renderByWorker(const QString &p_format, const QString &p_text, const RenderCallback &p_callback)
+{
+    Q_UNUSED(p_format);
+    Q_UNUSED(p_text);
+    Q_UNUSED(p_callback);
+    return false;
+}
+
+int GraphHelper::getMaxProcesses() const
+{
+    return m_maxProcesses;
+}
 
-    // Will be released in finishOneTask.
+void GraphHelper::startProcess(const Task &p_task)
+{
+    // Will be released once finished.
     QProcess *process = new QProcess();
-    process->setProperty(TaskIdProperty, task.m_id);
-    process->setProperty(TaskTimeStampProperty, task.m_timeStamp);
     QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-                     [this, process](int exitCode, QProcess::ExitStatus exitStatus) {
-                         finishOneTask(process, exitCode, exitStatus);
+                     [this, process, p_task](int exitCode, QProcess::ExitStatus exitStatus) {
+                         const quint64 id = p_task.m_id;
+                         QByteArray outBa;
+                         bool failed = true;
+                         if (exitStatus == QProcess::NormalExit) {
+                             if (exitCode < 0) {
+                                 qWarning() << "Graph task" << id << "failed:" << exitCode;
+                             } else {
+                                 failed = false;
+                                 outBa = process->readAllStandardOutput();
+                             }
+                         } else {
+                             qWarning() << "Graph task" << id << "failed to start" << exitCode << exitStatus;
+                         }
+
+                         const QByteArray errBa = process->readAllStandardError();
+                         if (!errBa.isEmpty()) {
+                             QString errStr(QString::fromLocal8Bit(errBa));
+                             if (failed) {
+                                 qWarning() << "Graph task" << id << "stderr:" << errStr;
+                             } else {
+                                 qDebug() << "Graph task" << id << "stderr:" << errStr;
+                             }
+                         }
+
+                         process->deleteLater();
+
+                         // Do not persist the output of a graph with errors.
+                         finishOneTask(p_task, outBa, exitCode == 0);
+                     });
+    QObject::connect(process, &QProcess::errorOccurred,
+                     [this, process, p_task](QProcess::ProcessError error) {
+                         // finished() will not be emitted in this case.
+                         if (error == QProcess::FailedToStart) {
+                             qWarning() << "Graph task" << p_task.m_id << "failed to start:" << process->errorString();
+                             process->deleteLater();
+                             finishOneTask(p_task, QByteArray(), false);
+                         }
                      });
 
     if (m_overriddenCommand.isEmpty()) {
         Q_ASSERT(!m_program.isEmpty());
         QStringList args(m_args);
-        args << getFormatArgs(task.m_format);
+        args << getFormatArgs(p_task.m_format);
         process->start(m_program, getArgsToUse(args));
     } else {
-        auto cmd = getCommandToUse(m_overriddenCommand, task.m_format);
+        auto cmd = getCommandToUse(m_overriddenCommand, p_task.m_format);
         process->start(cmd);
     }
 
-    if (process->write(task.m_text.toUtf8()) == -1) {
-        qWarning() << "Graph task" << task.m_id << "failed to write to process stdin:" << process->errorString();
+    if (process->write(p_task.m_text.toUtf8()) == -1) {
+        qWarning() << "Graph task" << p_task.m_id << "failed to write to process stdin:" << process->errorString();
     }
 
     process->closeWriteChannel();
 }
 
-void GraphHelper::finishOneTask(QProcess *p_process, int p_exitCode, QProcess::ExitStatus p_exitStatus)
+void GraphHelper::finishOneTask(const Task &p_task, const QByteArray &p_output, bool p_clean)
 {
-    Q_ASSERT(m_taskOngoing && !m_tasks.isEmpty());
-
-    const auto task = m_tasks.dequeue();
-
-    const quint64 id = p_process->property(TaskIdProperty).toULongLong();
-    const quint64 timeStamp = p_process->property(TaskTimeStampProperty).toULongLong();
-    Q_ASSERT(task.m_id == id && task.m_timeStamp == timeStamp);
+    Q_ASSERT(m_runningCount > 0);
+    --m_runningCount;
 
-    qDebug() << "Graph task" << id << timeStamp << "finished";
+    qDebug() << "Graph task" << p_task.m_id << p_task.m_timeStamp << "finished" << p_output.size();
 
-    bool failed = true;
-    if (p_exitStatus == QProcess::NormalExit) {
-        if (p_exitCode < 0) {
-            qWarning() << "Graph task" << id << "failed:" << p_exitCode;
+    if (p_output.isEmpty()) {
+        callbackOneTask(p_task, p_task.m_id, p_task.m_timeStamp, p_task.m_format, QString());
+    } else {
+        QString data;
+        if (p_task.m_format == QStringLiteral("svg")) {
+            data = QString::fromLocal8Bit(p_output);
         } else {
-            failed = false;
-            const auto outBa = p_process->readAllStandardOutput();
-            QString data;
-            if (task.m_format == QStringLiteral("svg")) {
-                data = QString::fromLocal8Bit(outBa);
-                callbackOneTask(task, id, timeStamp, task.m_format, data);
-            } else {
-                data = QString::fromLocal8Bit(outBa.toBase64());
-                callbackOneTask(task, id, timeStamp, task.m_format, data);
-            }
-
-            CacheItem item;
-            item.m_format = task.m_format;
-            item.m_data = data;
-            m_cache.set(task.m_text, item);
+            data = QString::fromLocal8Bit(p_output.toBase64());
         }
-    } else {
-        qWarning() << "Graph task" << id << "failed to start" << p_exitCode << p_exitStatus;
-    }
 
-    const QByteArray errBa = p_process->readAllStandardError();
-    if (!errBa.isEmpty()) {
-        QString errStr(QString::fromLocal8Bit(errBa));
-        if (failed) {
-            qWarning() << "Graph task" << id << "stderr:" << errStr;
-        } else {
-            qDebug() << "Graph task" << id << "stderr:" << errStr;
+        callbackOneTask(p_task, p_task.m_id, p_task.m_timeStamp, p_task.m_format, data);
+
+        if (p_clean) {
+            addToCache(p_task, data);
         }
     }
 
-    if (failed) {
-        callbackOneTask(task, id, task.m_timeStamp, task.m_format, QString());
+    schedule();
+}
+
+QString GraphHelper::findInCache(const Task &p_task)
+{
+    const auto &cachedData = m_cache.get(p_task.m_text);
+    if (!cachedData.isNull() && cachedData.m_format == p_task.m_format) {
+        return cachedData.m_data;
     }
 
-    p_process->deleteLater();
+    auto diskCache = getDiskCache();
+    if (diskCache) {
+        const auto ba = diskCache->get(diskCacheKey(p_task));
+        if (!ba.isNull()) {
+            CacheItem item;
+            item.m_format = p_task.m_format;
+            item.m_data = QString::fromUtf8(ba);
+            m_cache.set(p_task.m_text, item);
+            return item.m_data;
+        }
+    }
 
-    m_taskOngoing = false;
-    processOneTask();
+    return QString();
 }
 
-void GraphHelper::finishOneTask(const QString &p_data)
+void GraphHelper::addToCache(const Task &p_task, const QString &p_data)
 {
-    Q_ASSERT(m_taskOngoing && !m_tasks.isEmpty());
+    CacheItem item;
+    item.m_format = p_task.m_format;
+    item.m_data = p_data;
+    m_cache.set(p_task.m_text, item);
+
+    auto diskCache = getDiskCache();
+    if (diskCache) {
+        diskCache->set(diskCacheKey(p_task), p_data.toUtf8());
+    }
+}
 
-    const auto task = m_tasks.dequeue();
+QByteArray GraphHelper::diskCacheKey(const Task &p_task) const
+{
+    // The output is decided by the program, its arguments, the format and the text.
+    QByteArray key;
+    key += m_program.toUtf8() + '\n';
+    key += m_args.join(QLatin1Char(' ')).toUtf8() + '\n';
+    key += m_overriddenCommand.toUtf8() + '\n';
+    key += p_task.m_format.toUtf8() + '\n';
+    key += QCryptographicHash::hash(p_task.m_text.toUtf8(), QCryptographicHash::Sha256);
+    return key;
+}
 
-    qDebug() << "Graph task" << task.m_id << task.m_timeStamp << "finished by cache" << p_data.size();
+DiskCache *GraphHelper::getDiskCache()
+{
+    if (m_diskCacheSize <= 0) {
+        return nullptr;
+    }
 
-    callbackOneTask(task, task.m_id, task.m_timeStamp, task.m_format, p_data);
+    if (!m_diskCache) {
+        const auto folderPath = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                               QStringLiteral("graph/") + m_name);
+        m_diskCache.reset(new DiskCache(folderPath, m_diskCacheSize));
+    }
 
-    m_taskOngoing = false;
-    processOneTask();
+    return m_diskCache.data();
 }
 
 QString GraphHelper::getCommandToUse(const QString &p_command, const QString &p_format)
@@ -189,6 +296,11 @@ void GraphHelper::clearCache()
     m_cache.clear();
 }
 
+void GraphHelper::clearPendingTasks()
+{
+    m_tasks.clear();
+}
+
 void GraphHelper::checkValidProgram()
 {
     m_programValid = true;
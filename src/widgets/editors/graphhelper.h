@@ -6,6 +6,7 @@
 #include <QPair>
 #include <QQueue>
 #include <QPointer>
+#include <QScopedPointer>
 
 #include <core/noncopyable.h>
 #include <core/global.h>
@@ -13,12 +14,14 @@
 
 namespace vnotex
 {
+    class DiskCache;
+
     class GraphHelper : private Noncopyable
     {
     public:
         typedef std::function<void(quint64, TimeStamp, const QString &, const QString &)> ResultCallback;
 
-        GraphHelper();
+        virtual ~GraphHelper();
 
         void process(quint64 p_id,
                      TimeStamp p_timeStamp,
@@ -27,11 +30,35 @@ namespace vnotex
                      QObject *p_owner,
                      const ResultCallback &p_callback);
 
+        // Max number of concurrent rendering processes. 0 to decide by the number of CPU cores.
+        void setMaxProcesses(int p_max);
+
+        // Max size in MiB of the on-disk cache. 0 to disable it.
+        void setDiskCacheSize(int p_sizeInMiB);
+
     protected:
+        // @p_output: empty if failed.
+        // @p_clean: whether no error is reported so that the output could be persisted.
+        typedef std::function<void(const QByteArray &p_output, bool p_clean)> RenderCallback;
+
+        // @p_name: name of the folder to hold the on-disk cache.
+        explicit GraphHelper(const QString &p_name);
+
         virtual QStringList getFormatArgs(const QString &p_format) = 0;
 
+        // Render @p_text by a long-lived worker instead of a new process per task.
+        // Return false to fall back to a new process. @p_callback should be called asynchronously.
+        virtual bool renderByWorker(const QString &p_format, const QString &p_text, const RenderCallback &p_callback);
+
+        int getMaxProcesses() const;
+
+        // Clear the in-memory cache only. Entries on disk are keyed by the program and
+        // arguments so they will not be hit after config changes.
         void clearCache();
 
+        // Drop queued tasks without calling back. Running ones will still be finished.
+        void clearPendingTasks();
+
         void checkValidProgram();
 
         static QStringList getArgsToUse(const QStringList &p_args);
@@ -74,21 +101,42 @@ namespace vnotex
             QString m_data;
         };
 
-        void processOneTask();
+        // Start tasks as long as there are free process slots.
+        void schedule();
 
-        void finishOneTask(QProcess *p_process, int p_exitCode, QProcess::ExitStatus p_exitStatus);
+        void startProcess(const Task &p_task);
 
-        void finishOneTask(const QString &p_data);
+        void finishOneTask(const Task &p_task, const QByteArray &p_output, bool p_clean);
+
+        // Return null if not cached in memory or on disk.
+        QString findInCache(const Task &p_task);
+
+        void addToCache(const Task &p_task, const QString &p_data);
+
+        QByteArray diskCacheKey(const Task &p_task) const;
+
+        // Return null if disabled.
+        DiskCache *getDiskCache();
 
         void callbackOneTask(const Task &p_task, quint64 p_id, TimeStamp p_timeStamp, const QString &p_format, const QString &p_data) const;
 
+        QString m_name;
+
         QQueue<Task> m_tasks;
 
-        bool m_taskOngoing = false;
+        // Number of tasks being rendered by processes or workers.
+        int m_runningCount = 0;
+
+        int m_maxProcesses = 1;
 
         // {text} -> CacheItem.
         vte::LruCache<QString, CacheItem> m_cache;
 
+        QScopedPointer<DiskCache> m_diskCache;
+
+        // In bytes.
+        qint64 m_diskCacheSize = 0;
+
         // Whether @m_program is valid.
         bool m_programValid = false;
     };
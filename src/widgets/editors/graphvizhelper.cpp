@@ -11,6 +11,11 @@
 
 using namespace vnotex;
 
+GraphvizHelper::GraphvizHelper()
+    : GraphHelper(QStringLiteral("graphviz"))
+{
+}
+
 GraphvizHelper &GraphvizHelper::getInst()
 {
     static bool initialized = false;
@@ -19,6 +24,8 @@ GraphvizHelper &GraphvizHelper::getInst()
         initialized = true;
         const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
         inst.update(markdownEditorConfig.getGraphvizExe());
+        inst.setMaxProcesses(markdownEditorConfig.getGraphRendererProcesses());
+        inst.setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
     }
     return inst;
 }
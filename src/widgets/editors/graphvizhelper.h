@@ -15,7 +15,7 @@ namespace vnotex
         static QPair<bool, QString> testGraphviz(const QString &p_graphvizFile);
 
     private:
-        GraphvizHelper() = default;
+        GraphvizHelper();
 
         QStringList getFormatArgs(const QString &p_format) Q_DECL_OVERRIDE;
 
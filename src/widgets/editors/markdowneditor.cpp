@@ -12,11 +12,12 @@
 #include <QAction>
 #include <QShortcut>
 #include <QProgressDialog>
-#include <QTemporaryFile>
+#include <QEventLoop>
 #include <QTimer>
 #include <QBuffer>
 #include <QPainter>
 #include <QHash>
+#include <QSet>
 
 #include <vtextedit/markdowneditorconfig.h>
 #include <vtextedit/previewmgr.h>
@@ -52,9 +53,12 @@
 #include <core/editorconfig.h>
 #include <core/vnotex.h>
 #include <core/fileopenparameters.h>
+#include <core/networkfetcher.h>
 #include <imagehost/imagehostutils.h>
 #include <imagehost/imagehost.h>
 #include <imagehost/imagehostmgr.h>
+#include <imagehost/imageuploadcache.h>
+#include <imagehost/imageuploadqueue.h>
 
 #include "previewhelper.h"
 #include "../outlineprovider.h"
@@ -400,6 +404,36 @@ bool MarkdownEditor::insertImageToBufferFromLocalFile(const QString &p_title,
     return true;
 }
 
+bool MarkdownEditor::insertImageToBufferFromBytes(const QString &p_title,
+                                                  const QByteArray &p_data,
+                                                  const QString &p_suffix,
+                                                  QString *p_urlInLink)
+{
+    const auto destFileName = generateImageFileNameToInsertAs(p_title, p_suffix);
+
+    QString destFilePath;
+
+    if (m_imageHost) {
+        // Save to image host.
+        destFilePath = saveToImageHost(p_data, destFileName);
+        if (destFilePath.isEmpty()) {
+            return false;
+        }
+    } else {
+        try {
+            destFilePath = m_buffer->insertImage(p_data, destFileName);
+        } catch (Exception &e) {
+            MessageBoxHelper::notify(MessageBoxHelper::Warning,
+                                     QString("Failed to insert image from data (%1).").arg(e.what()),
+                                     this);
+            return false;
+        }
+    }
+
+    insertImageLink(p_title, QString(), destFilePath, 0, 0, false, p_urlInLink);
+    return true;
+}
+
 QString MarkdownEditor::generateImageFileNameToInsertAs(const QString &p_title, const QString &p_suffix)
 {
     return FileUtils::generateRandomFileName(p_title, p_suffix);
@@ -871,18 +905,42 @@ void MarkdownEditor::updateHeadings(const QVector<vte::peg::ElementRegion> &p_he
         }
     }
 
-    OutlineProvider::makePerfectHeadings(headings, m_headings);
+    QVector<Heading> perfectHeadings;
+    OutlineProvider::makePerfectHeadings(headings, perfectHeadings);
+
+    // Block numbers shift on each edit while the outline only cares about name and level.
+    const bool outlineChanged = !isSameOutline(m_headings, perfectHeadings);
+    m_headings = perfectHeadings;
 
     if (needUpdateSectionNumber) {
         // Use a timer to kick off the update to let user have time to undo.
         m_sectionNumberTimer->start();
     }
 
-    emit headingsChanged();
+    if (outlineChanged) {
+        emit headingsChanged();
+    }
 
     emit currentHeadingChanged();
 }
 
+bool MarkdownEditor::isSameOutline(const QVector<Heading> &p_a, const QVector<Heading> &p_b)
+{
+    if (p_a.size() != p_b.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < p_a.size(); ++i) {
+        if (p_a[i].m_level != p_b[i].m_level
+            || p_a[i].m_name != p_b[i].m_name
+            || p_a[i].m_sectionNumber != p_b[i].m_sectionNumber) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int MarkdownEditor::getHeadingIndexByBlockNumber(int p_blockNumber) const
 {
     if (m_headings.isEmpty()) {
@@ -1086,24 +1144,45 @@ void MarkdownEditor::fetchImagesToLocalAndReplace(QString &p_text)
     // Sort it in ascending order.
     std::sort(regs.begin(), regs.end());
 
-    QProgressDialog proDlg(tr("Fetching images to local..."),
-                           tr("Abort"),
-                           0,
-                           regs.size(),
-                           this);
-    proDlg.setWindowModality(Qt::WindowModal);
-    proDlg.setWindowTitle(tr("Fetch Images To Local"));
+    // One image link to replace.
+    struct ImageLink
+    {
+        int m_startPos = 0;
+
+        int m_endPos = 0;
+
+        QString m_title;
+
+        // Captured texts after the URL in the link.
+        QString m_cap3;
+
+        QString m_cap6;
+
+        // Suffix guessed from the URL.
+        QString m_suffix;
+
+        // Absolute local path of the image.
+        QString m_localPath;
+
+        // Index of the network request.
+        int m_requestIdx = -1;
+
+        // New text of the whole link. Empty to keep it as is.
+        QString m_newText;
+    };
+
+    QVector<ImageLink> links;
+    links.reserve(regs.size());
+
+    NetworkFetcher fetcher;
+    fetcher.setMaxConnections(8);
+    fetcher.setMaxConnectionsPerHost(4);
+    fetcher.setTimeout(30 * 1000);
 
     QRegExp zhihuRegExp("^https?://www\\.zhihu\\.com/equation\\?tex=(.+)$");
 
     QRegExp regExp(vte::MarkdownUtils::c_imageLinkRegExp);
-    for (int i = regs.size() - 1; i >= 0; --i) {
-        proDlg.setValue(regs.size() - 1 - i);
-        if (proDlg.wasCanceled()) {
-            break;
-        }
-
-        const auto &reg = regs[i];
+    for (const auto &reg : regs) {
         QString linkText = p_text.mid(reg.m_startPos, reg.m_endPos - reg.m_startPos);
         if (regExp.indexIn(linkText) == -1) {
             continue;
@@ -1111,16 +1190,14 @@ void MarkdownEditor::fetchImagesToLocalAndReplace(QString &p_text)
 
         qDebug() << "fetching image link" << linkText;
 
-        const QString imageTitle = purifyImageTitle(regExp.cap(1).trimmed());
+        ImageLink link;
+        link.m_startPos = reg.m_startPos;
+        link.m_endPos = reg.m_endPos;
+        link.m_title = purifyImageTitle(regExp.cap(1).trimmed());
+        link.m_cap3 = regExp.cap(3);
+        link.m_cap6 = regExp.cap(6);
         QString imageUrl = regExp.cap(2).trimmed();
 
-        const int maxUrlLength = 100;
-        QString urlToDisplay(imageUrl);
-        if (urlToDisplay.size() > maxUrlLength) {
-            urlToDisplay = urlToDisplay.left(maxUrlLength) + "...";
-        }
-        proDlg.setLabelText(tr("Fetching image (%1)").arg(urlToDisplay));
-
         // Handle equation from zhihu.com like http://www.zhihu.com/equation?tex=P.
         if (zhihuRegExp.indexIn(imageUrl) != -1) {
             QString tex = zhihuRegExp.cap(1).trimmed();
@@ -1133,76 +1210,136 @@ void MarkdownEditor::fetchImagesToLocalAndReplace(QString &p_text)
                 continue;
             }
 
-            tex = "$" + tex + "$";
-            p_text.replace(reg.m_startPos,
-                           reg.m_endPos - reg.m_startPos,
-                           tex);
+            link.m_newText = "$" + tex + "$";
+            links.push_back(link);
             continue;
         }
 
         // Only handle absolute file path or network path.
-        QString srcImagePath;
         QFileInfo info(WebUtils::purifyUrl(imageUrl));
-
-        // For network image.
-        QScopedPointer<QTemporaryFile> tmpFile;
-
+        link.m_suffix = info.suffix();
         if (info.exists()) {
-            if (info.isAbsolute()) {
-                // Absolute local path.
-                srcImagePath = info.absoluteFilePath();
+            if (!info.isAbsolute()) {
+                continue;
             }
+
+            // Absolute local path.
+            link.m_localPath = info.absoluteFilePath();
         } else {
             // Network path.
             // Prepend the protocol if missing.
             if (imageUrl.startsWith(QStringLiteral("//"))) {
                 imageUrl.prepend(QStringLiteral("https:"));
             }
-            QByteArray data = vte::NetworkAccess::request(QUrl(imageUrl)).m_data;
-            if (!data.isEmpty()) {
-                // Prefer the suffix from the real data.
-                auto suffix = ImageUtils::guessImageSuffix(data);
-                if (suffix.isEmpty()) {
-                    suffix = info.suffix();
-                } else if (info.suffix() != suffix) {
-                    qWarning() << "guess a different suffix from image data" << info.suffix() << suffix;
-                }
-                tmpFile.reset(FileUtils::createTemporaryFile(suffix));
-                if (tmpFile->open() && tmpFile->write(data) > -1) {
-                    srcImagePath = tmpFile->fileName();
-                }
+            link.m_requestIdx = fetcher.addUrl(QUrl(imageUrl));
+        }
 
-                // Need to close it explicitly to flush cache of small file.
-                tmpFile->close();
-            }
+        links.push_back(link);
+    }
+
+    const int nrRequests = fetcher.getResults().size();
+    if (nrRequests > 0) {
+        QProgressDialog proDlg(tr("Fetching images to local..."),
+                               tr("Abort"),
+                               0,
+                               nrRequests,
+                               this);
+        proDlg.setWindowModality(Qt::WindowModal);
+        proDlg.setWindowTitle(tr("Fetch Images To Local"));
+
+        connect(&fetcher, &NetworkFetcher::fetched,
+                &proDlg, [&proDlg, &fetcher](int p_idx) {
+                    const int maxUrlLength = 100;
+                    QString urlToDisplay(fetcher.getResults()[p_idx].m_url.toString());
+                    if (urlToDisplay.size() > maxUrlLength) {
+                        urlToDisplay = urlToDisplay.left(maxUrlLength) + "...";
+                    }
+                    proDlg.setLabelText(tr("Fetched image (%1)").arg(urlToDisplay));
+                    proDlg.setValue(fetcher.getFinishedCount());
+                });
+        connect(&proDlg, &QProgressDialog::canceled,
+                &fetcher, &NetworkFetcher::abort);
+
+        QEventLoop loop;
+        connect(&fetcher, &NetworkFetcher::finished,
+                &loop, &QEventLoop::quit);
+
+        proDlg.setValue(0);
+        fetcher.start();
+        if (!fetcher.isFinished()) {
+            loop.exec();
         }
 
-        if (srcImagePath.isEmpty()) {
+        proDlg.setValue(nrRequests);
+    }
+
+    // Images fetched before abort are still inserted.
+    const auto &results = fetcher.getResults();
+    for (auto &link : links) {
+        if (!link.m_newText.isEmpty()) {
             continue;
         }
 
-        // Insert image without inserting text.
         QString urlInLink;
-        bool ret = insertImageToBufferFromLocalFile(imageTitle,
-                                                    QString(),
-                                                    srcImagePath,
-                                                    0,
-                                                    0,
-                                                    false,
-                                                    &urlInLink);
-        if (!ret || urlInLink.isEmpty()) {
+        if (link.m_requestIdx > -1) {
+            const auto &data = results[link.m_requestIdx].m_data;
+            if (data.isEmpty()) {
+                continue;
+            }
+
+            // Prefer the suffix from the real data.
+            auto suffix = ImageUtils::guessImageSuffix(data);
+            if (suffix.isEmpty()) {
+                suffix = link.m_suffix;
+            } else if (link.m_suffix != suffix) {
+                qWarning() << "guess a different suffix from image data" << link.m_suffix << suffix;
+            }
+
+            if (!insertImageToBufferFromBytes(link.m_title, data, suffix, &urlInLink)) {
+                continue;
+            }
+        } else {
+            // Insert image without inserting text.
+            bool ret = insertImageToBufferFromLocalFile(link.m_title,
+                                                        QString(),
+                                                        link.m_localPath,
+                                                        0,
+                                                        0,
+                                                        false,
+                                                        &urlInLink);
+            if (!ret) {
+                continue;
+            }
+        }
+
+        if (urlInLink.isEmpty()) {
             continue;
         }
 
-        // Replace URL in link.
-        QString newLink = QString("![%1](%2%3%4)")
-                                 .arg(imageTitle, urlInLink, regExp.cap(3), regExp.cap(6));
-        p_text.replace(reg.m_startPos,
-                       reg.m_endPos - reg.m_startPos,
-                       newLink);
+        link.m_newText = QString("![%1](%2%3%4)").arg(link.m_title, urlInLink, link.m_cap3, link.m_cap6);
     }
 
-    proDlg.setValue(regs.size());
+    // Replace links in one pass.
+    QString text;
+    int lastPos = 0;
+    for (const auto &link : links) {
+        if (link.m_newText.isEmpty()) {
+            continue;
+        }
+
+        if (lastPos == 0) {
+            text.reserve(p_text.size());
+        }
+
+        text += p_text.midRef(lastPos, link.m_startPos - lastPos);
+        text += link.m_newText;
+        lastPos = link.m_endPos;
+    }
+
+    if (lastPos > 0) {
+        text += p_text.midRef(lastPos);
+        p_text = text;
+    }
 }
 
 static bool updateHeadingSectionNumber(QTextCursor &p_cursor,
@@ -1335,12 +1472,20 @@ QString MarkdownEditor::saveToImageHost(const QByteArray &p_imageData, const QSt
 {
     Q_ASSERT(m_imageHost);
 
+    // Reuse the URL of identical data uploaded before.
+    auto cache = m_imageHost->getUploadCache();
+    const auto hash = ImageUploadCache::hash(p_imageData);
+    auto targetUrl = cache->find(hash);
+    if (!targetUrl.isEmpty() && m_imageHost->ownsUrl(targetUrl)) {
+        return targetUrl;
+    }
+
     const auto destPath = generateImageHostFileName(m_buffer, p_destFileName);
 
     QString errMsg;
 
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-    auto targetUrl = m_imageHost->create(p_imageData, destPath, errMsg);
+    targetUrl = m_imageHost->create(p_imageData, destPath, errMsg);
     QApplication::restoreOverrideCursor();
 
     if (targetUrl.isEmpty()) {
@@ -1349,6 +1494,9 @@ QString MarkdownEditor::saveToImageHost(const QByteArray &p_imageData, const QSt
                                  QString(),
                                  errMsg,
                                  this);
+    } else {
+        cache->insert(hash, targetUrl);
+        cache->save();
     }
 
     return targetUrl;
@@ -1389,38 +1537,18 @@ void MarkdownEditor::uploadImagesToImageHost()
         return;
     }
 
-    QProgressDialog proDlg(tr("Uploading local images..."),
-                           tr("Abort"),
-                           0,
-                           images.size(),
-                           this);
-    proDlg.setWindowModality(Qt::WindowModal);
-    proDlg.setWindowTitle(tr("Upload Images To Image Host"));
-
-    QHash<QString, QString> uploadedImages;
-
-    int cnt = 0;
-    auto cursor = m_textEdit->textCursor();
-    cursor.beginEditBlock();
-    for (int i = 0; i < images.size(); ++i) {
-        const auto &link = images[i];
+    // Max number of concurrent uploads. Hosts serialize the commits to the branch, so it mainly
+    // overlaps the existence queries and keeps the queue busy.
+    const int maxConcurrency = 4;
+    ImageUploadQueue queue(host, host->getUploadCache(), maxConcurrency);
 
-        auto it = uploadedImages.find(link.m_path);
-        if (it != uploadedImages.end()) {
-            cursor.setPosition(link.m_urlInLinkPos);
-            cursor.setPosition(link.m_urlInLinkPos + link.m_urlInLink.size(), QTextCursor::KeepAnchor);
-            cursor.insertText(it.value());
+    // Image path -> index of the upload job.
+    QHash<QString, int> jobOfImage;
+    for (const auto &link : images) {
+        if (jobOfImage.contains(link.m_path)) {
             continue;
         }
 
-        proDlg.setValue(i + 1);
-        if (proDlg.wasCanceled()) {
-            break;
-        }
-        proDlg.setLabelText(tr("Upload image (%1)").arg(link.m_path));
-
-        Q_ASSERT(i == 0 || link.m_urlInLinkPos < images[i - 1].m_urlInLinkPos);
-
         QByteArray ba;
         try {
             ba = FileUtils::readFile(link.m_path);
@@ -1428,43 +1556,103 @@ void MarkdownEditor::uploadImagesToImageHost()
             MessageBoxHelper::notify(MessageBoxHelper::Warning,
                                      QString("Failed to read local image file (%1) (%2).").arg(link.m_path, e.what()),
                                      this);
+            jobOfImage.insert(link.m_path, -1);
             continue;
         }
 
         if (ba.isEmpty()) {
             qWarning() << "Skipped uploading empty image" << link.m_path;
+            jobOfImage.insert(link.m_path, -1);
             continue;
         }
 
         const auto destPath = generateImageHostFileName(m_buffer, PathUtils::fileName(link.m_path));
-        QString errMsg;
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-        const auto targetUrl = host->create(ba, destPath, errMsg);
-        QApplication::restoreOverrideCursor();
+        jobOfImage.insert(link.m_path, queue.addJob(ba, destPath));
+    }
 
-        if (targetUrl.isEmpty()) {
-            MessageBoxHelper::notify(MessageBoxHelper::Warning,
-                                     QString("Failed to upload image to image host (%1) as (%2).").arg(host->getName(), destPath),
-                                     QString(),
-                                     errMsg,
-                                     this);
+    const int nrJobs = queue.getJobs().size();
+    if (nrJobs == 0) {
+        return;
+    }
+
+    {
+        QProgressDialog proDlg(tr("Uploading local images..."),
+                               tr("Abort"),
+                               0,
+                               nrJobs,
+                               this);
+        proDlg.setWindowModality(Qt::WindowModal);
+        proDlg.setWindowTitle(tr("Upload Images To Image Host"));
+
+        connect(&queue, &ImageUploadQueue::jobFinished,
+                &proDlg, [&proDlg, &queue](int p_idx) {
+                    proDlg.setLabelText(tr("Uploaded image (%1)").arg(queue.getJobs()[p_idx].m_path));
+                    proDlg.setValue(queue.getFinishedCount());
+                });
+        connect(&proDlg, &QProgressDialog::canceled,
+                &queue, [&proDlg, &queue]() {
+                    // Wait for the running uploads.
+                    proDlg.setLabelText(tr("Aborting..."));
+                    queue.abort();
+                });
+
+        QEventLoop loop;
+        connect(&queue, &ImageUploadQueue::finished,
+                &loop, &QEventLoop::quit);
+
+        proDlg.setValue(0);
+        queue.start();
+        if (!queue.isFinished()) {
+            loop.exec();
+        }
+
+        proDlg.setValue(nrJobs);
+    }
+
+    // Images uploaded before abort are still updated.
+    const auto &jobs = queue.getJobs();
+    QStringList failures;
+    QSet<int> failedJobs;
+    int cnt = 0;
+    auto cursor = m_textEdit->textCursor();
+    cursor.beginEditBlock();
+    for (int i = 0; i < images.size(); ++i) {
+        const auto &link = images[i];
+        Q_ASSERT(i == 0 || link.m_urlInLinkPos < images[i - 1].m_urlInLinkPos);
+
+        const int jobIdx = jobOfImage.value(link.m_path, -1);
+        if (jobIdx == -1) {
+            continue;
+        }
+
+        const auto &job = jobs[jobIdx];
+        if (job.m_url.isEmpty()) {
+            if (!failedJobs.contains(jobIdx)) {
+                failedJobs.insert(jobIdx);
+                failures << QString("%1 (%2)").arg(job.m_path, job.m_errorMsg);
+            }
             continue;
         }
 
         // Update the link URL.
         cursor.setPosition(link.m_urlInLinkPos);
         cursor.setPosition(link.m_urlInLinkPos + link.m_urlInLink.size(), QTextCursor::KeepAnchor);
-        cursor.insertText(targetUrl);
-        uploadedImages.insert(link.m_path, targetUrl);
+        cursor.insertText(job.m_url);
         ++cnt;
     }
     cursor.endEditBlock();
 
-    proDlg.setValue(images.size());
-
     if (cnt > 0) {
         m_textEdit->setTextCursor(cursor);
     }
+
+    if (!failures.isEmpty()) {
+        MessageBoxHelper::notify(MessageBoxHelper::Warning,
+                                 QString("Failed to upload images to image host (%1).").arg(host->getName()),
+                                 QString(),
+                                 failures.join(QLatin1Char('\n')),
+                                 this);
+    }
 }
 
 void MarkdownEditor::prependContextSensitiveMenu(QMenu *p_menu, const QPoint &p_pos)
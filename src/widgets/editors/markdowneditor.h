@@ -148,6 +148,12 @@ namespace vnotex
                                          int p_scaledWidth = 0,
                                          int p_scaledHeight = 0);
 
+        // Insert raw image data @p_data of format @p_suffix without inserting text.
+        bool insertImageToBufferFromBytes(const QString &p_title,
+                                          const QByteArray &p_data,
+                                          const QString &p_suffix,
+                                          QString *p_urlInLink);
+
         void insertImageLink(const QString &p_title,
                              const QString &p_altText,
                              const QString &p_destImagePath,
@@ -177,6 +183,9 @@ namespace vnotex
 
         int getHeadingIndexByBlockNumber(int p_blockNumber) const;
 
+        // Whether @p_a and @p_b are the same ignoring block numbers.
+        static bool isSameOutline(const QVector<Heading> &p_a, const QVector<Heading> &p_b);
+
         void setupShortcuts();
 
         void fetchImagesToLocalAndReplace(QString &p_text);
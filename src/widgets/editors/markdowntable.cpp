@@ -1,6 +1,7 @@
 #include "markdowntable.h"
 
 #include <QTextEdit>
+#include <QTextLayout>
 #include <QDebug>
 
 using namespace vnotex;
@@ -57,9 +58,45 @@ enum
     DelimiterRowIndex = 1
 };
 
-MarkdownTable::MarkdownTable(QTextEdit *p_textEdit, const vte::peg::TableBlock &p_block)
-    : m_textEdit(p_textEdit)
+bool MarkdownTable::WidthCache::get(const QString &p_key, qreal &p_width) const
 {
+    auto it = m_widths.constFind(p_key);
+    if (it == m_widths.constEnd()) {
+        return false;
+    }
+
+    p_width = it.value();
+    return true;
+}
+
+void MarkdownTable::WidthCache::set(const QString &p_key, qreal p_width)
+{
+    // Drop all when it grows too large. It will be filled by the next format.
+    if (m_widths.size() >= 16384) {
+        m_widths.clear();
+    }
+
+    m_widths.insert(p_key, p_width);
+}
+
+void MarkdownTable::WidthCache::checkFont(const QFont &p_font)
+{
+    if (m_font != p_font) {
+        m_font = p_font;
+        m_widths.clear();
+    }
+}
+
+MarkdownTable::MarkdownTable(QTextEdit *p_textEdit,
+                             const vte::peg::TableBlock &p_block,
+                             WidthCache *p_widthCache)
+    : m_textEdit(p_textEdit),
+      m_widthCache(p_widthCache)
+{
+    if (m_widthCache) {
+        m_widthCache->checkFont(m_textEdit->font());
+    }
+
     parseTableBlock(p_block);
 }
 
@@ -470,9 +507,9 @@ void MarkdownTable::fetchCellInfoOfColumn(int p_idx,
         }
 
         // Calculate the core width.
-        info.m_coreWidth = calculateTextWidth(row.m_block,
-                                              cell.m_offset + info.m_coreOffset,
-                                              info.m_coreLength);
+        info.m_coreWidth = textWidth(row.m_block,
+                                     cell.m_offset + info.m_coreOffset,
+                                     cell.m_text.mid(info.m_coreOffset, info.m_coreLength));
         // Delimiter row's width should not be considered.
         if (info.m_coreWidth > p_targetWidth && !isDelimiterRow(i)) {
             p_targetWidth = info.m_coreWidth;
@@ -485,8 +522,15 @@ bool MarkdownTable::isDelimiterRow(int p_idx) const
     return p_idx == DelimiterRowIndex;
 }
 
-qreal MarkdownTable::calculateTextWidth(const QTextBlock &p_block, int p_pib, int p_length) const
+qreal MarkdownTable::calculateTextWidth(const QTextBlock &p_block,
+                                        int p_pib,
+                                        int p_length,
+                                        bool *p_crossLines) const
 {
+    if (p_crossLines) {
+        *p_crossLines = false;
+    }
+
     // The block may cross multiple lines.
     qreal textWidth = 0;
     QTextLayout *layout = p_block.layout();
@@ -499,6 +543,10 @@ qreal MarkdownTable::calculateTextWidth(const QTextBlock &p_block, int p_pib, in
             break;
         } else {
             // Cross lines.
+            if (p_crossLines) {
+                *p_crossLines = true;
+            }
+
             textWidth += line.cursorToX(lineEnd) - line.cursorToX(p_pib);
 
             // Move to next line.
@@ -511,6 +559,48 @@ qreal MarkdownTable::calculateTextWidth(const QTextBlock &p_block, int p_pib, in
     return textWidth > 0 ? textWidth : -1;
 }
 
+QString MarkdownTable::widthCacheKey(const QTextBlock &p_block, int p_pib, const QString &p_text)
+{
+    QString key(p_text);
+    const int end = p_pib + p_text.size();
+    const auto formats = p_block.layout()->formats();
+    for (const auto &fmt : formats) {
+        const int start = qMax(fmt.start, p_pib);
+        const int fmtEnd = qMin(fmt.start + fmt.length, end);
+        if (start >= fmtEnd) {
+            continue;
+        }
+
+        key += QString("\n%1,%2,%3").arg(QString::number(start - p_pib),
+                                         QString::number(fmtEnd - start),
+                                         fmt.format.font().key());
+    }
+
+    return key;
+}
+
+qreal MarkdownTable::textWidth(const QTextBlock &p_block, int p_pib, const QString &p_text) const
+{
+    qreal width = 0;
+    QString key;
+    if (m_widthCache) {
+        key = widthCacheKey(p_block, p_pib, p_text);
+        if (m_widthCache->get(key, width)) {
+            return width;
+        }
+    }
+
+    bool crossLines = false;
+    width = calculateTextWidth(p_block, p_pib, p_text.size(), &crossLines);
+
+    // Width of text crossing lines depends on where it wraps.
+    if (m_widthCache && !crossLines) {
+        m_widthCache->set(key, width);
+    }
+
+    return width;
+}
+
 Alignment MarkdownTable::getColumnAlignment(int p_idx) const
 {
     auto row = delimiter();
@@ -645,9 +735,9 @@ bool MarkdownTable::isCellWellFormatted(const Row &p_row,
     }
 
     // Calculate the width of the text without two spaces around.
-    int cellWidth = calculateTextWidth(p_row.m_block,
-                                       p_cell.m_offset + 2,
-                                       p_cell.m_length - 3);
+    int cellWidth = textWidth(p_row.m_block,
+                              p_cell.m_offset + 2,
+                              text.mid(2, p_cell.m_length - 3));
     if (!equalWidth(cellWidth, p_targetWidth, s_spaceWidth / 2)) {
         return false;
     }
@@ -714,10 +804,28 @@ void MarkdownTable::writeTable()
 
         newBlockText += c_borderChar;
 
-        // Replace the whole block.
-        cursor.setPosition(row.m_block.position());
-        cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
-        cursor.insertText(newBlockText);
+        // Replace only the changed part of the block, usually the padding of a few cells.
+        const QString oldBlockText = row.m_block.text();
+        const int minLength = qMin(oldBlockText.size(), newBlockText.size());
+        int head = 0;
+        while (head < minLength && oldBlockText[head] == newBlockText[head]) {
+            ++head;
+        }
+
+        int tail = 0;
+        while (tail < minLength - head
+               && oldBlockText[oldBlockText.size() - 1 - tail] == newBlockText[newBlockText.size() - 1 - tail]) {
+            ++tail;
+        }
+
+        if (head == oldBlockText.size() && head == newBlockText.size()) {
+            continue;
+        }
+
+        const int blockPos = row.m_block.position();
+        cursor.setPosition(blockPos + head);
+        cursor.setPosition(blockPos + oldBlockText.size() - tail, QTextCursor::KeepAnchor);
+        cursor.insertText(newBlockText.mid(head, newBlockText.size() - head - tail));
     }
 
     if (changed) {
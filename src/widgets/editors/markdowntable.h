@@ -3,6 +3,8 @@
 
 #include <QTextBlock>
 #include <QVector>
+#include <QHash>
+#include <QFont>
 
 #include <vtextedit/pegmarkdownhighlighterdata.h>
 
@@ -15,7 +17,27 @@ namespace vnotex
     class MarkdownTable
     {
     public:
-        MarkdownTable(QTextEdit *p_textEdit, const vte::peg::TableBlock &p_block);
+        // Cache of pixel widths of cell texts, keyed by the text and its highlight formats.
+        // Kept across formats so that only edited cells need to be laid out again.
+        class WidthCache
+        {
+        public:
+            bool get(const QString &p_key, qreal &p_width) const;
+
+            void set(const QString &p_key, qreal p_width);
+
+            // Clear the cache if font changes.
+            void checkFont(const QFont &p_font);
+
+        private:
+            QFont m_font;
+
+            QHash<QString, qreal> m_widths;
+        };
+
+        MarkdownTable(QTextEdit *p_textEdit,
+                      const vte::peg::TableBlock &p_block,
+                      WidthCache *p_widthCache = nullptr);
 
         MarkdownTable(QTextEdit *p_textEdit, int p_bodyRow, int p_col, Alignment p_alignment);
 
@@ -114,7 +136,18 @@ namespace vnotex
 
         bool isDelimiterRow(int p_idx) const;
 
-        qreal calculateTextWidth(const QTextBlock &p_block, int p_pib, int p_length) const;
+        // @p_crossLines: set to true if the text crosses multiple lines.
+        qreal calculateTextWidth(const QTextBlock &p_block,
+                                 int p_pib,
+                                 int p_length,
+                                 bool *p_crossLines = nullptr) const;
+
+        // Width of @p_text which locates at @p_pib of @p_block. Use m_widthCache if possible.
+        qreal textWidth(const QTextBlock &p_block, int p_pib, const QString &p_text) const;
+
+        // Key of m_widthCache for @p_text at @p_pib of @p_block. Fonts of the highlight formats
+        // are included, since the same text may be highlighted differently, such as bold.
+        static QString widthCacheKey(const QTextBlock &p_block, int p_pib, const QString &p_text);
 
         Alignment getColumnAlignment(int p_idx) const;
 
@@ -142,6 +175,9 @@ namespace vnotex
 
         QTextEdit *m_textEdit = nullptr;
 
+        // Not owned. May be null.
+        WidthCache *m_widthCache = nullptr;
+
         // Whether this table is a new table or not.
         bool m_isNew = false;
 
@@ -56,7 +56,7 @@ void MarkdownTableHelper::formatTable()
     }
 
 
-    MarkdownTable table(m_editor->getTextEdit(), m_block);
+    MarkdownTable table(m_editor->getTextEdit(), m_block, &m_widthCache);
     if (!table.isValid()) {
         return;
     }
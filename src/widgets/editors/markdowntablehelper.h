@@ -41,6 +41,8 @@ namespace vnotex
         QTimer *m_timer = nullptr;
 
         vte::peg::TableBlock m_block;
+
+        MarkdownTable::WidthCache m_widthCache;
     };
 }
 
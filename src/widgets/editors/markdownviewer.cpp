@@ -91,13 +91,20 @@ void MarkdownViewer::setPreviewHelper(PreviewHelper *p_previewHelper)
                 }
             });
     connect(p_previewHelper, &PreviewHelper::mathPreviewRequested,
-            this, [this, p_previewHelper](quint64 p_id,
-                                          TimeStamp p_timeStamp,
-                                          const QString &p_text) {
+            this, [this, p_previewHelper](TimeStamp p_timeStamp,
+                                          const QVector<quint64> &p_ids,
+                                          const QStringList &p_texts) {
                 if (m_adapter->isViewerReady()) {
-                    m_adapter->mathPreviewRequested(p_id, p_timeStamp, p_text);
+                    QJsonArray maths;
+                    for (int i = 0; i < p_ids.size(); ++i) {
+                        QJsonObject obj;
+                        obj[QStringLiteral("id")] = static_cast<qint64>(p_ids[i]);
+                        obj[QStringLiteral("text")] = p_texts[i];
+                        maths.append(obj);
+                    }
+                    m_adapter->mathPreviewRequested(p_timeStamp, maths);
                 } else {
-                    p_previewHelper->handleMathPreviewData(MarkdownViewerAdapter::PreviewData());
+                    p_previewHelper->handleMathPreviewData(p_timeStamp, QVector<MarkdownViewerAdapter::PreviewData>());
                 }
             });
     connect(m_adapter, &MarkdownViewerAdapter::graphPreviewDataReady,
@@ -6,10 +6,63 @@
 #include "../outlineprovider.h"
 #include "plantumlhelper.h"
 #include "graphvizhelper.h"
+#include "webgraphcache.h"
 #include <utils/utils.h>
 
 using namespace vnotex;
 
+namespace
+{
+    // Lines [m_startLine, m_startLine + m_removedLines) of the old text are replaced
+    // by lines of m_text, which contains at least one line.
+    struct LineDelta
+    {
+        int m_startLine = 0;
+
+        int m_removedLines = 0;
+
+        QString m_text;
+    };
+
+    LineDelta diffLines(const QString &p_old, const QString &p_new)
+    {
+        const QChar newLine('\n');
+        const int minLen = qMin(p_old.size(), p_new.size());
+
+        int prefix = 0;
+        while (prefix < minLen && p_old[prefix] == p_new[prefix]) {
+            ++prefix;
+        }
+
+        // Start of the line of the first difference.
+        const int lineStart = prefix > 0 ? p_old.lastIndexOf(newLine, prefix - 1) + 1 : 0;
+
+        // Common suffix should not overlap with the changed line.
+        const int maxSuffix = minLen - lineStart;
+        int suffix = 0;
+        while (suffix < maxSuffix
+               && p_old[p_old.size() - 1 - suffix] == p_new[p_new.size() - 1 - suffix]) {
+            ++suffix;
+        }
+
+        // Lines after the first new line within the common suffix are kept.
+        int oldEnd = p_old.indexOf(newLine, p_old.size() - suffix);
+        int newEnd = 0;
+        if (oldEnd == -1) {
+            oldEnd = p_old.size();
+            newEnd = p_new.size();
+        } else {
+            newEnd = oldEnd + p_new.size() - p_old.size();
+        }
+
+        LineDelta delta;
+        delta.m_startLine = p_old.leftRef(lineStart).count(newLine);
+        delta.m_removedLines = p_old.midRef(lineStart, oldEnd - lineStart).count(newLine) + 1;
+        delta.m_text = p_new.mid(lineStart, newEnd - lineStart);
+        return delta;
+    }
+}
+
 MarkdownViewerAdapter::Position::Position(int p_lineNumber, const QString &p_anchor)
     : m_lineNumber(p_lineNumber),
       m_anchor(p_anchor)
@@ -82,21 +135,67 @@ void MarkdownViewerAdapter::setText(int p_revision,
 
     m_revision = p_revision;
     if (m_viewerReady) {
-        emit textUpdated(p_text);
+        sendText(p_text);
         scrollToPosition(Position(p_lineNumber, ""));
     } else {
         m_pendingActions.append([this, p_text, p_lineNumber]() {
-            emit textUpdated(p_text);
+            sendText(p_text);
             scrollToPosition(Position(p_lineNumber, ""));
         });
     }
 }
 
+void MarkdownViewerAdapter::sendText(const QString &p_text)
+{
+    if (!m_textSent) {
+        m_sentText = p_text;
+        m_textSent = true;
+        emit textUpdated(p_text, ++m_textSerial);
+        return;
+    }
+
+    if (p_text == m_sentText) {
+        return;
+    }
+
+    // Only the changed lines go through the web channel. Web side will patch its copy.
+    const auto delta = diffLines(m_sentText, p_text);
+    m_sentText = p_text;
+    const int baseSerial = m_textSerial++;
+    emit textPatched(baseSerial, m_textSerial, delta.m_startLine, delta.m_removedLines, delta.m_text);
+}
+
+void MarkdownViewerAdapter::requestText()
+{
+    if (!m_textSent) {
+        return;
+    }
+
+    emit textUpdated(m_sentText, ++m_textSerial);
+}
+
 void MarkdownViewerAdapter::setText(const QString &p_text, int p_lineNumber)
 {
     setText(0, p_text, p_lineNumber);
 }
 
+void MarkdownViewerAdapter::setBaseUrl(const QUrl &p_baseUrl)
+{
+    // Text patched against the last one would leave untouched nodes resolved against the old base.
+    m_revision = 0;
+    m_sentText.clear();
+    m_textSent = false;
+
+    const auto url = p_baseUrl.toString();
+    if (m_viewerReady) {
+        emit baseUrlUpdated(url);
+    } else {
+        m_pendingActions.append([this, url]() {
+            emit baseUrlUpdated(url);
+        });
+    }
+}
+
 void MarkdownViewerAdapter::setReady(bool p_ready)
 {
     if (m_viewerReady == p_ready) {
@@ -173,18 +272,35 @@ bool MarkdownViewerAdapter::isViewerReady() const
     return m_viewerReady;
 }
 
-void MarkdownViewerAdapter::setMathPreviewData(quint64 p_id,
-                                               quint64 p_timeStamp,
-                                               const QString &p_format,
-                                               const QString &p_data,
-                                               bool p_base64,
-                                               bool p_needScale)
+void MarkdownViewerAdapter::setMathPreviewData(quint64 p_timeStamp, const QJsonArray &p_data)
 {
-    auto ba = p_data.toUtf8();
-    if (p_base64 && !ba.isEmpty()) {
-        ba = QByteArray::fromBase64(ba);
+    QVector<PreviewData> data;
+    data.reserve(p_data.size());
+    for (const auto &ele : p_data) {
+        const auto obj = ele.toObject();
+        auto ba = obj[QStringLiteral("data")].toString().toUtf8();
+        if (ba.isEmpty()) {
+            continue;
+        }
+
+        if (obj[QStringLiteral("base64")].toBool()) {
+            ba = QByteArray::fromBase64(ba);
+        }
+
+        // Sent as a JSON number, so read it back as a double instead of truncating it to int.
+        const auto idVal = obj[QStringLiteral("id")];
+        if (!idVal.isDouble() || idVal.toDouble() < 0) {
+            continue;
+        }
+
+        data.append(PreviewData(static_cast<quint64>(idVal.toDouble()),
+                                p_timeStamp,
+                                obj[QStringLiteral("format")].toString(),
+                                ba,
+                                obj[QStringLiteral("needScale")].toBool()));
     }
-    emit mathPreviewDataReady(PreviewData(p_id, p_timeStamp, p_format, ba, p_needScale));
+
+    emit mathPreviewDataReady(p_timeStamp, data);
 }
 
 void MarkdownViewerAdapter::setHeadings(const QJsonArray &p_headings)
@@ -344,11 +460,21 @@ void MarkdownViewerAdapter::setWorkFinished()
     emit workFinished();
 }
 
+void MarkdownViewerAdapter::setSettled(quint64 p_id)
+{
+    emit settled(p_id);
+}
+
 void MarkdownViewerAdapter::saveContent()
 {
     emit contentRequested();
 }
 
+void MarkdownViewerAdapter::requestSettledNotification(quint64 p_id)
+{
+    emit settledNotificationRequested(p_id);
+}
+
 void MarkdownViewerAdapter::setSavedContent(const QString &p_headContent,
                                             const QString &p_styleContent,
                                             const QString &p_content,
@@ -361,6 +487,8 @@ void MarkdownViewerAdapter::reset()
 {
     m_revision = 0;
     m_viewerReady = false;
+    m_sentText.clear();
+    m_textSent = false;
     m_pendingActions.clear();
     m_topLineNumber = -1;
     m_headings.clear();
@@ -401,3 +529,27 @@ void MarkdownViewerAdapter::renderGraph(quint64 p_id,
         Q_ASSERT(false);
     }
 }
+
+void MarkdownViewerAdapter::fetchCachedGraph(quint64 p_id, const QString &p_lang, const QString &p_text)
+{
+    QString format;
+    QString data;
+    if (p_text.isEmpty() || !WebGraphCache::getInst().get(p_lang, p_text, format, data)) {
+        emit cachedGraphDataReady(p_id, QString(), QString());
+        return;
+    }
+
+    emit cachedGraphDataReady(p_id, format, data);
+}
+
+void MarkdownViewerAdapter::cacheGraph(const QString &p_lang,
+                                       const QString &p_text,
+                                       const QString &p_format,
+                                       const QString &p_data)
+{
+    if (p_text.isEmpty()) {
+        return;
+    }
+
+    WebGraphCache::getInst().set(p_lang, p_text, p_format, p_data);
+}
@@ -6,6 +6,8 @@
 #include <QJsonObject>
 #include <QScopedPointer>
 #include <QJsonArray>
+#include <QVector>
+#include <QUrl>
 
 #include <core/global.h>
 
@@ -90,6 +92,10 @@ namespace vnotex
         // @p_lineNumber: the line number needed to sync, -1 for invalid.
         void setText(const QString &p_text, int p_lineNumber = -1);
 
+        // Resolve relative resources against @p_baseUrl without reloading the page.
+        // The next setText() will be rendered as a whole.
+        void setBaseUrl(const QUrl &p_baseUrl);
+
         void scrollToPosition(const Position &p_pos);
 
         int getTopLineNumber() const;
@@ -111,6 +117,9 @@ namespace vnotex
 
         void saveContent();
 
+        // settled(@p_id) will be emitted once web side finishes rendering and loading resources.
+        void requestSettledNotification(quint64 p_id);
+
         // Should be called before WebViewer.setHtml().
         void reset();
 
@@ -120,6 +129,8 @@ namespace vnotex
 
         void setWorkFinished();
 
+        void setSettled(quint64 p_id);
+
         // The line number at the top.
         void setTopLineNumber(int p_lineNumber);
 
@@ -131,13 +142,9 @@ namespace vnotex
                                  bool p_base64 = false,
                                  bool p_needScale = false);
 
-        // Web sets back the preview result.
-        void setMathPreviewData(quint64 p_id,
-                                quint64 p_timeStamp,
-                                const QString &p_format,
-                                const QString &p_data,
-                                bool p_base64 = false,
-                                bool p_needScale = false);
+        // Web sets back the preview results of one mathPreviewRequested() batch.
+        // @p_data: [{id, format, data, base64, needScale}]. Failed ones could be omitted.
+        void setMathPreviewData(quint64 p_timeStamp, const QJsonArray &p_data);
 
         // Set the headings.
         void setHeadings(const QJsonArray &p_headings);
@@ -167,10 +174,32 @@ namespace vnotex
                          const QString &p_lang,
                          const QString &p_text);
 
+        // Web side fails to apply a patch and asks for the whole text.
+        void requestText();
+
+        // Look up the persistent graph cache. Result will be sent back via cachedGraphDataReady().
+        // @p_lang: the renderer and its options affecting the output.
+        void fetchCachedGraph(quint64 p_id, const QString &p_lang, const QString &p_text);
+
+        // Store a graph rendered by web side to the persistent graph cache.
+        void cacheGraph(const QString &p_lang,
+                        const QString &p_text,
+                        const QString &p_format,
+                        const QString &p_data);
+
         // Signals to be connected at web side.
     signals:
         // Current Markdown text is updated.
-        void textUpdated(const QString &p_text);
+        // @p_serial: serial of the text for later textPatched().
+        void textUpdated(const QString &p_text, int p_serial);
+
+        // Current Markdown text is updated by replacing @p_removedLines lines from @p_startLine
+        // of text @p_baseSerial with lines of @p_text.
+        void textPatched(int p_baseSerial,
+                         int p_serial,
+                         int p_startLine,
+                         int p_removedLines,
+                         const QString &p_text);
 
         // Current editor line number is updated.
         void editLineNumberUpdated(int p_lineNumber);
@@ -181,10 +210,9 @@ namespace vnotex
                                    const QString &p_lang,
                                    const QString &p_text);
 
-        // Request to preview math.
-        void mathPreviewRequested(quint64 p_id,
-                                  quint64 p_timeStamp,
-                                  const QString &p_text);
+        // Request to preview a batch of maths.
+        // @p_maths: [{id, text}].
+        void mathPreviewRequested(quint64 p_timeStamp, const QJsonArray &p_maths);
 
         void anchorScrollRequested(const QString &p_anchor);
 
@@ -208,17 +236,27 @@ namespace vnotex
                                   const QString &p_format,
                                   const QString &p_data);
 
+        // Result of fetchCachedGraph(). @p_data will be empty if not found.
+        void cachedGraphDataReady(quint64 p_id, const QString &p_format, const QString &p_data);
+
+        void settledNotificationRequested(quint64 p_id);
+
+        void baseUrlUpdated(const QString &p_baseUrl);
+
     // Signals to be connected at cpp side.
     signals:
         void graphPreviewDataReady(const PreviewData &p_data);
 
-        void mathPreviewDataReady(const PreviewData &p_data);
+        void mathPreviewDataReady(quint64 p_timeStamp, const QVector<PreviewData> &p_data);
 
         void viewerReady();
 
         // All rendering work has finished.
         void workFinished();
 
+        // Content is ready to be captured. Answer to requestSettledNotification().
+        void settled(quint64 p_id);
+
         void headingsChanged();
 
         void currentHeadingChanged();
@@ -243,8 +281,19 @@ namespace vnotex
 
         void scrollToAnchor(const QString &p_anchor);
 
+        // Send @p_text to web side, as a patch against the text sent last time if possible.
+        void sendText(const QString &p_text);
+
         int m_revision = 0;
 
+        // Text sent to web side last time.
+        QString m_sentText;
+
+        bool m_textSent = false;
+
+        // Serial of the text sent to web side, used to check if a patch could be applied.
+        int m_textSerial = 0;
+
         // Whether web side viewer is ready to handle text update.
         bool m_viewerReady = false;
 
@@ -2,6 +2,9 @@
 
 #include <QDebug>
 #include <QDir>
+#include <QCoreApplication>
+
+#include "plantumlpipeworker.h"
 
 #include <utils/processutils.h>
 #include <utils/pathutils.h>
@@ -11,6 +14,16 @@
 
 using namespace vnotex;
 
+PlantUmlHelper::PlantUmlHelper()
+    : GraphHelper(QStringLiteral("plantuml"))
+{
+}
+
+PlantUmlHelper::~PlantUmlHelper()
+{
+    clearWorkers();
+}
+
 PlantUmlHelper &PlantUmlHelper::getInst()
 {
     static bool initialized = false;
@@ -21,6 +34,16 @@ PlantUmlHelper &PlantUmlHelper::getInst()
         inst.update(markdownEditorConfig.getPlantUmlJar(),
                     markdownEditorConfig.getGraphvizExe(),
                     markdownEditorConfig.getPlantUmlCommand());
+        inst.setMaxProcesses(markdownEditorConfig.getGraphRendererProcesses());
+        inst.setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
+
+        // Do not leave workers behind the application. Clear pending tasks first so that
+        // failing the busy workers will not schedule new ones.
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit,
+                         []() {
+                             inst.clearPendingTasks();
+                             inst.clearWorkers();
+                         });
     }
     return inst;
 }
@@ -40,6 +63,9 @@ void PlantUmlHelper::update(const QString &p_plantUmlJarFile,
     checkValidProgram();
 
     clearCache();
+
+    // Program and arguments may change.
+    clearWorkers();
 }
 
 void PlantUmlHelper::prepareProgramAndArgs(const QString &p_plantUmlJarFile,
@@ -109,3 +135,58 @@ QStringList PlantUmlHelper::getFormatArgs(const QString &p_format)
     args << ("-t" + p_format);
     return args;
 }
+
+bool PlantUmlHelper::renderByWorker(const QString &p_format, const QString &p_text, const RenderCallback &p_callback)
+{
+    // The overridden command may not support pipe mode.
+    if (!m_overriddenCommand.isEmpty() || !PlantUmlPipeWorker::isSupported(p_text)) {
+        return false;
+    }
+
+    auto worker = getIdleWorker(p_format);
+    worker->render(p_text, p_callback);
+    return true;
+}
+
+PlantUmlPipeWorker *PlantUmlHelper::getIdleWorker(const QString &p_format)
+{
+    for (auto worker : m_workers) {
+        if (!worker->isBusy() && worker->getFormat() == p_format) {
+            return worker;
+        }
+    }
+
+    // Busy workers are bounded by the max processes. Drop an idle one of other formats if full.
+    if (m_workers.size() >= getMaxProcesses()) {
+        for (int i = 0; i < m_workers.size(); ++i) {
+            if (!m_workers[i]->isBusy()) {
+                delete m_workers.takeAt(i);
+                break;
+            }
+        }
+    }
+
+    auto args = m_args;
+    args << PlantUmlPipeWorker::delimiterArgs() << getFormatArgs(p_format);
+#if !defined(Q_OS_WIN)
+    // Let java replace the shell so that killing the worker kills java.
+    if (!args.isEmpty() && args[0] == "-c") {
+        args.insert(1, "exec");
+    }
+#endif
+
+    auto worker = new PlantUmlPipeWorker(m_program, getArgsToUse(args), p_format);
+    m_workers.push_back(worker);
+    return worker;
+}
+
+void PlantUmlHelper::clearWorkers()
+{
+    // Pending requests of busy workers will fail and may issue new requests.
+    const auto workers = m_workers;
+    m_workers.clear();
+    for (auto worker : workers) {
+        worker->disconnect();
+        delete worker;
+    }
+}
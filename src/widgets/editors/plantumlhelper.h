@@ -1,13 +1,19 @@
 #ifndef PLANTUMLHELPER_H
 #define PLANTUMLHELPER_H
 
+#include <QVector>
+
 #include "graphhelper.h"
 
 namespace vnotex
 {
+    class PlantUmlPipeWorker;
+
     class PlantUmlHelper : public GraphHelper
     {
     public:
+        ~PlantUmlHelper();
+
         void update(const QString &p_plantUmlJarFile,
                     const QString &p_graphvizFile,
                     const QString &p_overriddenCommand);
@@ -17,14 +23,24 @@ namespace vnotex
         static QPair<bool, QString> testPlantUml(const QString &p_plantUmlJarFile);
 
     private:
-        PlantUmlHelper() = default;
+        PlantUmlHelper();
 
         QStringList getFormatArgs(const QString &p_format) Q_DECL_OVERRIDE;
 
+        bool renderByWorker(const QString &p_format, const QString &p_text, const RenderCallback &p_callback) Q_DECL_OVERRIDE;
+
+        // Return an idle worker of @p_format, creating one if needed.
+        PlantUmlPipeWorker *getIdleWorker(const QString &p_format);
+
+        void clearWorkers();
+
         static void prepareProgramAndArgs(const QString &p_plantUmlJarFile,
                                           const QString &p_graphvizFile,
                                           QString &p_program,
                                           QStringList &p_args);
+
+        // Long-lived workers in pipe mode. Owned.
+        QVector<PlantUmlPipeWorker *> m_workers;
     };
 }
 
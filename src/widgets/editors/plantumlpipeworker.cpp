@@ -0,0 +1,242 @@
+#include "plantumlpipeworker.h"
+
+#include <QTimer>
+#include <QRegularExpression>
+#include <QDebug>
+
+using namespace vnotex;
+
+// Should be safe to be passed via shell.
+static const QByteArray c_delimiter = "VNOTE_PLANTUML_PIPE_DELIMITER";
+
+// Kill the process if one diagram takes longer.
+static const int c_requestTimeout = 60 * 1000;
+
+// Quit the process if not used for a while to release the memory of JVM.
+static const int c_idleTimeout = 10 * 60 * 1000;
+
+PlantUmlPipeWorker::PlantUmlPipeWorker(const QString &p_program,
+                                       const QStringList &p_args,
+                                       const QString &p_format,
+                                       QObject *p_parent)
+    : QObject(p_parent),
+      m_program(p_program),
+      m_args(p_args),
+      m_format(p_format)
+{
+    m_requestTimer = new QTimer(this);
+    m_requestTimer->setSingleShot(true);
+    m_requestTimer->setInterval(c_requestTimeout);
+    connect(m_requestTimer, &QTimer::timeout,
+            this, [this]() {
+                qWarning() << "PlantUML pipe worker timed out";
+                // Do not retry.
+                m_retried = true;
+                m_process->kill();
+            });
+
+    m_idleTimer = new QTimer(this);
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(c_idleTimeout);
+    connect(m_idleTimer, &QTimer::timeout,
+            this, &PlantUmlPipeWorker::stopProcess);
+}
+
+PlantUmlPipeWorker::~PlantUmlPipeWorker()
+{
+    if (m_process) {
+        // Do not block on it. QProcess waits for the process in its destructor, so leave it
+        // to be deleted once finished.
+        m_process->disconnect(this);
+        m_process->setParent(nullptr);
+        connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                m_process, &QObject::deleteLater);
+        m_process->kill();
+        m_process = nullptr;
+    }
+
+    if (m_busy) {
+        finishRequest(QByteArray(), false);
+    }
+}
+
+const QString &PlantUmlPipeWorker::getFormat() const
+{
+    return m_format;
+}
+
+bool PlantUmlPipeWorker::isBusy() const
+{
+    return m_busy;
+}
+
+QStringList PlantUmlPipeWorker::delimiterArgs()
+{
+    return QStringList() << "-pipedelimitor" << QString::fromLatin1(c_delimiter);
+}
+
+bool PlantUmlPipeWorker::isSupported(const QString &p_text)
+{
+    // Multiple diagrams produce multiple outputs.
+    static const QRegularExpression startRegExp("^\\s*@start", QRegularExpression::MultilineOption);
+    return p_text.count(startRegExp) <= 1;
+}
+
+QByteArray PlantUmlPipeWorker::prepareInput(const QString &p_text)
+{
+    static const QRegularExpression startRegExp("^\\s*@start", QRegularExpression::MultilineOption);
+    static const QRegularExpression endRegExp("^\\s*@end", QRegularExpression::MultilineOption);
+
+    // Without them, PlantUML will wait for the end of input forever.
+    QString text(p_text);
+    if (!text.contains(startRegExp)) {
+        text = QStringLiteral("@startuml\n") + text + QStringLiteral("\n@enduml");
+    } else if (!text.contains(endRegExp)) {
+        text += QStringLiteral("\n@enduml");
+    }
+
+    text += QLatin1Char('\n');
+    return text.toUtf8();
+}
+
+void PlantUmlPipeWorker::render(const QString &p_text, const Callback &p_callback)
+{
+    Q_ASSERT(!m_busy);
+    m_busy = true;
+    m_callback = p_callback;
+    m_input = prepareInput(p_text);
+    m_retried = false;
+    m_hasError = false;
+
+    m_idleTimer->stop();
+
+    if (!m_process || m_process->state() == QProcess::NotRunning) {
+        startProcess();
+    }
+
+    if (m_busy) {
+        m_process->write(m_input);
+        m_requestTimer->start();
+    }
+}
+
+void PlantUmlPipeWorker::startProcess()
+{
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->deleteLater();
+    }
+
+    m_buffer.clear();
+
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::readyReadStandardOutput,
+            this, &PlantUmlPipeWorker::handleStandardOutput);
+    connect(m_process, &QProcess::readyReadStandardError,
+            this, [this]() {
+                const auto errBa = m_process->readAllStandardError();
+                if (m_busy && !errBa.trimmed().isEmpty()) {
+                    m_hasError = true;
+                    qDebug() << "PlantUML pipe worker stderr:" << QString::fromLocal8Bit(errBa);
+                }
+            });
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &PlantUmlPipeWorker::handleProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, [this](QProcess::ProcessError p_error) {
+                // finished() will not be emitted in this case.
+                if (p_error == QProcess::FailedToStart) {
+                    qWarning() << "PlantUML pipe worker failed to start:" << m_process->errorString();
+                    if (m_busy) {
+                        // Defer it to keep the callback asynchronous.
+                        QTimer::singleShot(0, this, [this]() {
+                            if (m_busy) {
+                                finishRequest(QByteArray(), false);
+                            }
+                        });
+                    }
+                }
+            });
+
+    qDebug() << "start PlantUML pipe worker" << m_program << m_args;
+    m_process->start(m_program, m_args);
+}
+
+void PlantUmlPipeWorker::stopProcess()
+{
+    if (m_busy || !m_process) {
+        return;
+    }
+
+    qDebug() << "stop idle PlantUML pipe worker";
+
+    // PlantUML quits at the end of input.
+    m_process->disconnect(this);
+    m_process->closeWriteChannel();
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            m_process, &QObject::deleteLater);
+    m_process = nullptr;
+}
+
+void PlantUmlPipeWorker::handleStandardOutput()
+{
+    m_buffer += m_process->readAllStandardOutput();
+    if (!m_busy) {
+        // Stray output.
+        m_buffer.clear();
+        return;
+    }
+
+    const int idx = m_buffer.indexOf(c_delimiter);
+    if (idx == -1) {
+        return;
+    }
+
+    // Skip the line break of the previous delimiter line.
+    int start = 0;
+    while (start < idx && (m_buffer[start] == '\r' || m_buffer[start] == '\n')) {
+        ++start;
+    }
+
+    const auto output = m_buffer.mid(start, idx - start);
+    m_buffer.remove(0, idx + c_delimiter.size());
+
+    finishRequest(output, !m_hasError);
+}
+
+void PlantUmlPipeWorker::handleProcessFinished()
+{
+    qWarning() << "PlantUML pipe worker exited" << m_process->exitCode() << m_process->exitStatus();
+
+    if (!m_busy) {
+        return;
+    }
+
+    m_requestTimer->stop();
+
+    if (!m_retried) {
+        // Restart and retry once in case it is not caused by this request.
+        m_retried = true;
+        m_hasError = false;
+        startProcess();
+        m_process->write(m_input);
+        m_requestTimer->start();
+        return;
+    }
+
+    finishRequest(QByteArray(), false);
+}
+
+void PlantUmlPipeWorker::finishRequest(const QByteArray &p_output, bool p_clean)
+{
+    Q_ASSERT(m_busy);
+    m_busy = false;
+    m_input.clear();
+    m_requestTimer->stop();
+    m_idleTimer->start();
+
+    // The callback may issue another request.
+    auto callback = m_callback;
+    m_callback = nullptr;
+    callback(p_output, p_clean);
+}
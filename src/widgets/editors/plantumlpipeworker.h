@@ -0,0 +1,95 @@
+#ifndef PLANTUMLPIPEWORKER_H
+#define PLANTUMLPIPEWORKER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QProcess>
+
+#include <functional>
+
+class QTimer;
+
+namespace vnotex
+{
+    // A long-lived PlantUML process in pipe mode rendering diagrams one by one in one format,
+    // which saves the startup of JVM for each diagram.
+    // Outputs of diagrams are separated by a delimiter line. The process is restarted on crash.
+    class PlantUmlPipeWorker : public QObject
+    {
+        Q_OBJECT
+    public:
+        // @p_output: empty if failed.
+        // @p_clean: whether no error is reported.
+        typedef std::function<void(const QByteArray &p_output, bool p_clean)> Callback;
+
+        // @p_program and @p_args: command to start PlantUML in pipe mode in @p_format,
+        // with delimiterArgs() included.
+        PlantUmlPipeWorker(const QString &p_program,
+                           const QStringList &p_args,
+                           const QString &p_format,
+                           QObject *p_parent = nullptr);
+
+        // Pending request will be called back as failed.
+        ~PlantUmlPipeWorker();
+
+        const QString &getFormat() const;
+
+        bool isBusy() const;
+
+        // Render one diagram. Should not be called when busy.
+        // @p_callback will be called asynchronously.
+        void render(const QString &p_text, const Callback &p_callback);
+
+        // Whether @p_text contains at most one diagram that could be streamed to the worker.
+        static bool isSupported(const QString &p_text);
+
+        // Arguments to make PlantUML output the delimiter after each diagram.
+        static QStringList delimiterArgs();
+
+    private:
+        void startProcess();
+
+        void stopProcess();
+
+        void handleStandardOutput();
+
+        void handleProcessFinished();
+
+        void finishRequest(const QByteArray &p_output, bool p_clean);
+
+        // Wrap @p_text with @startuml and @enduml if missing.
+        static QByteArray prepareInput(const QString &p_text);
+
+        QString m_program;
+
+        QStringList m_args;
+
+        QString m_format;
+
+        // Managed by QObject.
+        QProcess *m_process = nullptr;
+
+        QByteArray m_buffer;
+
+        bool m_busy = false;
+
+        // Input of current request.
+        QByteArray m_input;
+
+        Callback m_callback;
+
+        // Whether current request has been retried after crash.
+        bool m_retried = false;
+
+        // Whether errors are reported for current request.
+        bool m_hasError = false;
+
+        // Managed by QObject.
+        QTimer *m_requestTimer = nullptr;
+
+        // Managed by QObject.
+        QTimer *m_idleTimer = nullptr;
+    };
+}
+
+#endif // PLANTUMLPIPEWORKER_H
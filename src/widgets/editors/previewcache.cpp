@@ -0,0 +1,119 @@
+#include "previewcache.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+
+using namespace vnotex;
+
+int PreviewCache::Entry::s_imageIndex = 0;
+
+PreviewCache::Entry::Entry(const QPixmap &p_image, QRgb p_background)
+    : m_image(p_image),
+      m_name(QString::number(++s_imageIndex)),
+      m_background(p_background)
+{
+    m_size = static_cast<qint64>(m_image.width()) * m_image.height() * qMax(m_image.depth(), 8) / 8;
+}
+
+PreviewCache::PreviewCache(qint64 p_budget)
+    : m_budget(p_budget)
+{
+}
+
+PreviewCache &PreviewCache::getInst()
+{
+    static PreviewCache inst(128 * 1024 * 1024);
+    return inst;
+}
+
+void PreviewCache::setBudget(qint64 p_budget)
+{
+    m_budget = p_budget;
+    evict();
+}
+
+qint64 PreviewCache::getBudget() const
+{
+    return m_budget;
+}
+
+QSharedPointer<const PreviewCache::Entry> PreviewCache::get(const QByteArray &p_key)
+{
+    auto it = m_items.find(p_key);
+    if (it == m_items.end()) {
+        ++m_stats.m_misses;
+        return nullptr;
+    }
+
+    ++m_stats.m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, it->m_pos);
+    return it->m_entry;
+}
+
+void PreviewCache::set(const QByteArray &p_key, const QSharedPointer<const Entry> &p_entry)
+{
+    Q_ASSERT(p_entry);
+
+    auto it = m_items.find(p_key);
+    if (it != m_items.end()) {
+        m_totalSize -= it->m_entry->m_size;
+        m_lru.erase(it->m_pos);
+        m_items.erase(it);
+    }
+
+    if (p_entry->m_size > m_budget) {
+        return;
+    }
+
+    m_lru.push_front(p_key);
+    Item item;
+    item.m_entry = p_entry;
+    item.m_pos = m_lru.begin();
+    m_items.insert(p_key, item);
+    m_totalSize += p_entry->m_size;
+
+    evict();
+}
+
+void PreviewCache::clear()
+{
+    m_items.clear();
+    m_lru.clear();
+    m_totalSize = 0;
+}
+
+PreviewCache::Stats PreviewCache::getStats() const
+{
+    auto stats = m_stats;
+    stats.m_count = m_items.size();
+    stats.m_totalSize = m_totalSize;
+    return stats;
+}
+
+void PreviewCache::evict()
+{
+    if (m_totalSize <= m_budget) {
+        return;
+    }
+
+    while (m_totalSize > m_budget && !m_lru.empty()) {
+        const auto item = m_items.take(m_lru.back());
+        m_lru.pop_back();
+        m_totalSize -= item.m_entry->m_size;
+        ++m_stats.m_evictions;
+    }
+
+    qDebug() << "preview cache evicted to" << m_totalSize << "bytes" << m_items.size() << "entries"
+             << "hits" << m_stats.m_hits << "misses" << m_stats.m_misses << "evictions" << m_stats.m_evictions;
+}
+
+QByteArray PreviewCache::makeKey(const QString &p_kind,
+                                 const QString &p_text,
+                                 qreal p_scaleFactor,
+                                 QRgb p_background)
+{
+    auto key = p_kind.toUtf8() + ':';
+    key += QCryptographicHash::hash(p_text.toUtf8(), QCryptographicHash::Sha1).toHex();
+    key += ':' + QByteArray::number(p_scaleFactor, 'f', 2) + ':' + QByteArray::number(p_background, 16);
+    return key;
+}
@@ -0,0 +1,104 @@
+#ifndef PREVIEWCACHE_H
+#define PREVIEWCACHE_H
+
+#include <QPixmap>
+#include <QHash>
+#include <QSharedPointer>
+
+#include <list>
+
+#include <core/noncopyable.h>
+
+namespace vnotex
+{
+    // Process-wide cache of rendered in-place preview images, shared by all editors.
+    // Least recently used entries are evicted once the total bytes of images exceed the budget.
+    class PreviewCache : private Noncopyable
+    {
+    public:
+        struct Entry
+        {
+            Entry(const QPixmap &p_image, QRgb p_background);
+
+            QPixmap m_image;
+
+            // Name of the image for identification in resource manager.
+            // Unique for each entry so that editors could share it.
+            QString m_name;
+
+            // Background color to override.
+            // 0x0 indicates it is not specified.
+            QRgb m_background = 0x0;
+
+            // Bytes of the image.
+            qint64 m_size = 0;
+
+            // An increasing index to used as the image name.
+            static int s_imageIndex;
+        };
+
+        struct Stats
+        {
+            qint64 m_hits = 0;
+
+            qint64 m_misses = 0;
+
+            qint64 m_evictions = 0;
+
+            int m_count = 0;
+
+            qint64 m_totalSize = 0;
+        };
+
+        // @p_budget: max total bytes of images.
+        explicit PreviewCache(qint64 p_budget);
+
+        static PreviewCache &getInst();
+
+        void setBudget(qint64 p_budget);
+
+        qint64 getBudget() const;
+
+        // Return null if not found.
+        QSharedPointer<const Entry> get(const QByteArray &p_key);
+
+        void set(const QByteArray &p_key, const QSharedPointer<const Entry> &p_entry);
+
+        void clear();
+
+        Stats getStats() const;
+
+        // Key of the image rendered from @p_text at @p_scaleFactor with @p_background.
+        // @p_kind: namespace of the renderer, such as "code:<lang>" or "math", since the same
+        // text may be rendered differently by different renderers.
+        static QByteArray makeKey(const QString &p_kind,
+                                  const QString &p_text,
+                                  qreal p_scaleFactor,
+                                  QRgb p_background);
+
+    private:
+        struct Item
+        {
+            QSharedPointer<const Entry> m_entry;
+
+            // Position in @m_lru.
+            std::list<QByteArray>::iterator m_pos;
+        };
+
+        // Evict until the total size is within the budget.
+        void evict();
+
+        qint64 m_budget = 0;
+
+        qint64 m_totalSize = 0;
+
+        QHash<QByteArray, Item> m_items;
+
+        // Keys with the most recently used at front.
+        std::list<QByteArray> m_lru;
+
+        Stats m_stats;
+    };
+}
+
+#endif // PREVIEWCACHE_H
@@ -10,6 +10,9 @@
 #include <vtextedit/textutils.h>
 
 #include <utils/utils.h>
+#include <core/configmgr.h>
+#include <core/editorconfig.h>
+#include <core/markdowneditorconfig.h>
 
 #include "markdowneditor.h"
 #include "plantumlhelper.h"
@@ -76,39 +79,54 @@ void PreviewHelper::MathBlockPreviewData::updateInplacePreview(QTextDocument *p_
     }
 }
 
-int PreviewHelper::GraphPreviewData::s_imageIndex = 0;
-
-PreviewHelper::GraphPreviewData::GraphPreviewData(TimeStamp p_timeStamp,
-                                                  const QString &p_format,
-                                                  const QByteArray &p_data,
-                                                  QRgb p_background,
-                                                  qreal p_scaleFactor)
-    : m_timeStamp(p_timeStamp),
-      m_background(p_background)
+PreviewCache &PreviewHelper::previewCache()
 {
-    if (p_data.isEmpty()) {
-        return;
+    static bool initialized = false;
+    auto &cache = PreviewCache::getInst();
+    if (!initialized) {
+        initialized = true;
+        const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
+        cache.setBudget(static_cast<qint64>(markdownEditorConfig.getInplacePreviewCacheSize()) * 1024 * 1024);
     }
+    return cache;
+}
 
-    m_name = QString::number(++s_imageIndex);
-
+QSharedPointer<const PreviewCache::Entry> PreviewHelper::addPreviewToCache(const QByteArray &p_key,
+                                                                           const QString &p_format,
+                                                                           const QByteArray &p_data,
+                                                                           QRgb p_background,
+                                                                           qreal p_scaleFactor)
+{
+    QPixmap image;
     bool needScale = p_scaleFactor > 1.01;
     if (needScale) {
         if (p_format == QStringLiteral("svg")) {
-            m_image = Utils::svgToPixmap(p_data, p_background, p_scaleFactor);
+            image = Utils::svgToPixmap(p_data, p_background, p_scaleFactor);
         } else {
             QPixmap tmpImg;
             tmpImg.loadFromData(p_data, p_format.toLocal8Bit().data());
-            m_image = tmpImg.scaledToWidth(tmpImg.width() * p_scaleFactor, Qt::SmoothTransformation);
+            image = tmpImg.scaledToWidth(tmpImg.width() * p_scaleFactor, Qt::SmoothTransformation);
         }
     } else {
-        m_image.loadFromData(p_data, p_format.toLocal8Bit().data());
+        image.loadFromData(p_data, p_format.toLocal8Bit().data());
     }
+
+    QSharedPointer<const PreviewCache::Entry> entry = QSharedPointer<PreviewCache::Entry>::create(image, p_background);
+    previewCache().set(p_key, entry);
+    return entry;
+}
+
+QByteArray PreviewHelper::codeBlockCacheKey(const QString &p_text, const QString &p_lang) const
+{
+    return PreviewCache::makeKey(QStringLiteral("code:") + p_lang,
+                                 p_text,
+                                 getEditorScaleFactor(),
+                                 needForcedBackground(p_lang) ? m_editor->getPreviewBackground() : 0);
 }
 
-bool PreviewHelper::GraphPreviewData::isNull() const
+QByteArray PreviewHelper::mathBlockCacheKey(const QString &p_text) const
 {
-    return m_timeStamp == 0;
+    return PreviewCache::makeKey(QStringLiteral("math"), p_text, getEditorScaleFactor(), 0);
 }
 
 PreviewHelper::PreviewHelper(MarkdownEditor *p_editor, QObject *p_parent)
@@ -118,9 +136,7 @@ PreviewHelper::PreviewHelper(MarkdownEditor *p_editor, QObject *p_parent)
                               | SourceFlag::WaveDrom
                               | SourceFlag::PlantUml
                               | SourceFlag::Graphviz
-                              | SourceFlag::Math),
-      m_codeBlockCache(100, nullptr),
-      m_mathBlockCache(100, nullptr)
+                              | SourceFlag::Math)
 {
     setMarkdownEditor(p_editor);
 
@@ -169,10 +185,9 @@ void PreviewHelper::handleCodeBlocksUpdate()
         const int blockPreviewIdx = m_codeBlocksData.size() - 1;
 
         bool cacheHit = false;
-        auto &cachedData = m_codeBlockCache.get(cb.m_text);
+        const auto cachedData = previewCache().get(codeBlockCacheKey(cb.m_text, cb.m_lang));
         if (cachedData) {
             cacheHit = true;
-            cachedData->m_timeStamp = m_codeBlockTimeStamp;
             m_codeBlocksData[blockPreviewIdx].updateInplacePreview(m_document,
                                                                    cachedData->m_image,
                                                                    cachedData->m_name,
@@ -295,12 +310,11 @@ void PreviewHelper::handleGraphPreviewData(const MarkdownViewerAdapter::PreviewD
 
     auto &blockData = m_codeBlocksData[p_data.m_id];
     const bool forcedBackground = needForcedBackground(blockData.m_lang);
-    auto previewData = QSharedPointer<GraphPreviewData>::create(p_data.m_timeStamp,
-                                                                p_data.m_format,
-                                                                p_data.m_data,
-                                                                forcedBackground ? m_editor->getPreviewBackground() : 0,
-                                                                p_data.m_needScale ? getEditorScaleFactor() : 1);
-    m_codeBlockCache.set(blockData.m_text, previewData);
+    auto previewData = addPreviewToCache(codeBlockCacheKey(blockData.m_text, blockData.m_lang),
+                                         p_data.m_format,
+                                         p_data.m_data,
+                                         forcedBackground ? m_editor->getPreviewBackground() : 0,
+                                         p_data.m_needScale ? getEditorScaleFactor() : 1);
     blockData.m_text.clear();
 
     blockData.updateInplacePreview(m_document,
@@ -340,8 +354,6 @@ void PreviewHelper::updateEditorInplacePreviewCodeBlock()
     if (!obsoleteBlocks.isEmpty()) {
         emit potentialObsoletePreviewBlocksUpdated(obsoleteBlocks.toList());
     }
-
-    m_codeBlockCache.setCapacityHint(m_codeBlocksData.size());
 }
 
 void PreviewHelper::setMarkdownEditor(MarkdownEditor *p_editor)
@@ -370,17 +382,17 @@ void PreviewHelper::handleMathBlocksUpdate()
     m_mathBlocksData.clear();
     m_mathBlocksData.reserve(m_pendingMathBlocks.size());
 
-    bool needUpdateEditorInplacePreview = true;
+    QVector<quint64> ids;
+    QStringList texts;
 
     for (const auto &mb : m_pendingMathBlocks) {
         m_mathBlocksData.append(MathBlockPreviewData(mb));
         const int blockPreviewIdx = m_mathBlocksData.size() - 1;
 
         bool cacheHit = false;
-        auto &cachedData = m_mathBlockCache.get(mb.m_text);
+        const auto cachedData = previewCache().get(mathBlockCacheKey(mb.m_text));
         if (cachedData) {
             cacheHit = true;
-            cachedData->m_timeStamp = m_mathBlockTimeStamp;
             m_mathBlocksData[blockPreviewIdx].updateInplacePreview(m_document,
                                                                    cachedData->m_image,
                                                                    cachedData->m_name,
@@ -388,24 +400,21 @@ void PreviewHelper::handleMathBlocksUpdate()
         }
 
         if (!cacheHit) {
-            needUpdateEditorInplacePreview = false;
+            Q_ASSERT(!mb.m_text.isEmpty());
             m_mathBlocksData[blockPreviewIdx].m_text = mb.m_text;
-            inplacePreviewMathBlock(blockPreviewIdx);
+            ids.append(blockPreviewIdx);
+            texts.append(mb.m_text);
         }
     }
 
-    if (needUpdateEditorInplacePreview) {
-        updateEditorInplacePreviewMathBlock();
-    }
-
     m_pendingMathBlocks.clear();
-}
 
-void PreviewHelper::inplacePreviewMathBlock(int p_blockPreviewIdx)
-{
-    const auto &blockData = m_mathBlocksData[p_blockPreviewIdx];
-    Q_ASSERT(!blockData.m_text.isEmpty());
-    emit mathPreviewRequested(p_blockPreviewIdx, m_mathBlockTimeStamp, blockData.m_text);
+    if (ids.isEmpty()) {
+        updateEditorInplacePreviewMathBlock();
+    } else {
+        // Web side typesets them in one pass and sends them back together.
+        emit mathPreviewRequested(m_mathBlockTimeStamp, ids, texts);
+    }
 }
 
 void PreviewHelper::updateEditorInplacePreviewMathBlock()
@@ -436,34 +445,41 @@ void PreviewHelper::updateEditorInplacePreviewMathBlock()
     if (!obsoleteBlocks.isEmpty()) {
         emit potentialObsoletePreviewBlocksUpdated(obsoleteBlocks.toList());
     }
-
-    m_mathBlockCache.setCapacityHint(m_mathBlocksData.size());
 }
 
-void PreviewHelper::handleMathPreviewData(const MarkdownViewerAdapter::PreviewData &p_data)
+void PreviewHelper::handleMathPreviewData(TimeStamp p_timeStamp,
+                                          const QVector<MarkdownViewerAdapter::PreviewData> &p_data)
 {
-    if (p_data.m_timeStamp != m_mathBlockTimeStamp) {
-        return;
-    }
-    if (p_data.m_id >= static_cast<quint64>(m_mathBlocksData.size()) || p_data.m_data.isEmpty()) {
-        updateEditorInplacePreviewMathBlock();
+    if (p_timeStamp != m_mathBlockTimeStamp) {
         return;
     }
 
-    auto &blockData = m_mathBlocksData[p_data.m_id];
-    auto previewData = QSharedPointer<GraphPreviewData>::create(p_data.m_timeStamp,
-                                                                p_data.m_format,
-                                                                p_data.m_data,
-                                                                0,
-                                                                p_data.m_needScale ? getEditorScaleFactor() : 1);
-    m_mathBlockCache.set(blockData.m_text, previewData);
-    blockData.m_text.clear();
+    const qreal scaleFactor = getEditorScaleFactor();
+    for (const auto &data : p_data) {
+        if (data.m_id >= static_cast<quint64>(m_mathBlocksData.size()) || data.m_data.isEmpty()) {
+            continue;
+        }
 
-    blockData.updateInplacePreview(m_document,
-                                   previewData->m_image,
-                                   previewData->m_name,
-                                   m_tabStopWidth);
+        auto &blockData = m_mathBlocksData[data.m_id];
+        if (blockData.m_text.isEmpty()) {
+            // Already handled.
+            continue;
+        }
+
+        auto previewData = addPreviewToCache(mathBlockCacheKey(blockData.m_text),
+                                             data.m_format,
+                                             data.m_data,
+                                             0,
+                                             data.m_needScale ? scaleFactor : 1);
+        blockData.m_text.clear();
+
+        blockData.updateInplacePreview(m_document,
+                                       previewData->m_image,
+                                       previewData->m_name,
+                                       m_tabStopWidth);
+    }
 
+    // Apply all the previews in one shot.
     updateEditorInplacePreviewMathBlock();
 }
 
@@ -505,12 +521,11 @@ void PreviewHelper::handleLocalData(quint64 p_id,
     }
 
     auto &blockData = m_codeBlocksData[p_id];
-    auto previewData = QSharedPointer<GraphPreviewData>::create(p_timeStamp,
-                                                                p_format,
-                                                                p_data.toUtf8(),
-                                                                p_forcedBackground ? m_editor->getPreviewBackground() : 0,
-                                                                getEditorScaleFactor());
-    m_codeBlockCache.set(blockData.m_text, previewData);
+    auto previewData = addPreviewToCache(codeBlockCacheKey(blockData.m_text, blockData.m_lang),
+                                         p_format,
+                                         p_data.toUtf8(),
+                                         p_forcedBackground ? m_editor->getPreviewBackground() : 0,
+                                         getEditorScaleFactor());
     blockData.m_text.clear();
 
     blockData.updateInplacePreview(m_document,
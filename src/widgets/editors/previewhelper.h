@@ -3,13 +3,14 @@
 
 #include <QObject>
 #include <QPixmap>
+#include <QStringList>
 
 #include <vtextedit/global.h>
-#include <vtextedit/lrucache.h>
 #include <vtextedit/pegmarkdownhighlighterdata.h>
 
 #include <core/global.h>
 #include "markdownvieweradapter.h"
+#include "previewcache.h"
 
 class QTimer;
 class QTextDocument;
@@ -61,7 +62,9 @@ namespace vnotex
 
         void handleGraphPreviewData(const MarkdownViewerAdapter::PreviewData &p_data);
 
-        void handleMathPreviewData(const MarkdownViewerAdapter::PreviewData &p_data);
+        // Handle the results of one mathPreviewRequested() batch.
+        void handleMathPreviewData(TimeStamp p_timeStamp,
+                                   const QVector<MarkdownViewerAdapter::PreviewData> &p_data);
 
     signals:
         // Request to preview graph.
@@ -71,11 +74,12 @@ namespace vnotex
                                    const QString &p_lang,
                                    const QString &p_text);
 
-        // Request to preview math.
+        // Request to preview all the uncached maths in one batch.
+        // @p_texts[i] is the text of math @p_ids[i].
         // There must be a corresponding call to handleMathPreviewData().
-        void mathPreviewRequested(quint64 p_id,
-                                  TimeStamp p_timeStamp,
-                                  const QString &p_text);
+        void mathPreviewRequested(TimeStamp p_timeStamp,
+                                  const QVector<quint64> &p_ids,
+                                  const QStringList &p_texts);
 
         // Request to do in-place preview for @p_previewItems.
         void inplacePreviewCodeBlockUpdated(const QVector<QSharedPointer<vte::PreviewItem>> &p_previewItems);
@@ -142,34 +146,6 @@ namespace vnotex
             QSharedPointer<vte::PreviewItem> m_inplacePreview;
         };
 
-        // Data of the preview result.
-        struct GraphPreviewData
-        {
-            GraphPreviewData() = default;
-
-            GraphPreviewData(TimeStamp p_timeStamp,
-                             const QString &p_format,
-                             const QByteArray &p_data,
-                             QRgb p_background = 0x0,
-                             qreal p_scaleFactor = 1);
-
-            bool isNull() const;
-
-            TimeStamp m_timeStamp = 0;
-
-            QPixmap m_image;
-
-            // Name of the image for identification in resource manager.
-            QString m_name;
-
-            // Background color to override.
-            // 0x0 indicates it is not specified.
-            QRgb m_background = 0x0;
-
-            // An increasing index to used as the image name.
-            static int s_imageIndex;
-        };
-
         // Return <InplacePreview, FocusPreview>.
         QPair<bool, bool> isLangNeedPreview(const QString &p_lang) const;
 
@@ -180,8 +156,6 @@ namespace vnotex
         // Inplace preview code block m_codeBlocksData[@p_blockPreviewIdx].
         void inplacePreviewCodeBlock(int p_blockPreviewIdx);
 
-        void inplacePreviewMathBlock(int p_blockPreviewIdx);
-
         void updateEditorInplacePreviewCodeBlock();
 
         void updateEditorInplacePreviewMathBlock();
@@ -196,6 +170,20 @@ namespace vnotex
 
         bool needForcedBackground(const QString &p_lang) const;
 
+        QByteArray codeBlockCacheKey(const QString &p_text, const QString &p_lang) const;
+
+        QByteArray mathBlockCacheKey(const QString &p_text) const;
+
+        // Create the preview image from the rendered data and add it to the cache.
+        static QSharedPointer<const PreviewCache::Entry> addPreviewToCache(const QByteArray &p_key,
+                                                                           const QString &p_format,
+                                                                           const QByteArray &p_data,
+                                                                           QRgb p_background,
+                                                                           qreal p_scaleFactor);
+
+        // Cache shared by all editors.
+        static PreviewCache &previewCache();
+
         void handleCodeBlocksUpdate();
 
         void handleMathBlocksUpdate();
@@ -229,11 +217,6 @@ namespace vnotex
         // To record the size of previous inplace preview of math block.
         int m_previousInplacePreviewMathBlockSize = 0;
 
-        // {text} -> GraphPreviewData.
-        vte::LruCache<QString, QSharedPointer<GraphPreviewData>> m_codeBlockCache;
-
-        vte::LruCache<QString, QSharedPointer<GraphPreviewData>> m_mathBlockCache;
-
         bool m_webPlantUmlEnabled = true;
 
         bool m_webGraphvizEnabled = true;
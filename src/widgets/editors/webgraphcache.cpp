@@ -0,0 +1,94 @@
+#include "webgraphcache.h"
+
+#include <QCryptographicHash>
+
+#include <utils/pathutils.h>
+#include <core/configmgr.h>
+#include <core/diskcache.h>
+#include <core/editorconfig.h>
+#include <core/markdowneditorconfig.h>
+
+using namespace vnotex;
+
+WebGraphCache &WebGraphCache::getInst()
+{
+    static bool initialized = false;
+    static WebGraphCache inst;
+    if (!initialized) {
+        initialized = true;
+        const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
+        inst.setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
+    }
+
+    return inst;
+}
+
+WebGraphCache::~WebGraphCache()
+{
+}
+
+void WebGraphCache::setDiskCacheSize(int p_sizeInMiB)
+{
+    m_diskCacheSize = static_cast<qint64>(qMax(0, p_sizeInMiB)) * 1024 * 1024;
+    if (m_diskCache) {
+        if (m_diskCacheSize > 0) {
+            m_diskCache->setMaxSize(m_diskCacheSize);
+        } else {
+            m_diskCache.reset();
+        }
+    }
+}
+
+bool WebGraphCache::get(const QString &p_lang, const QString &p_text, QString &p_format, QString &p_data)
+{
+    auto diskCache = getDiskCache();
+    if (!diskCache) {
+        return false;
+    }
+
+    // Stored as "<format>\n<data>".
+    const auto ba = diskCache->get(cacheKey(p_lang, p_text));
+    const int idx = ba.indexOf('\n');
+    if (idx <= 0) {
+        return false;
+    }
+
+    p_format = QString::fromUtf8(ba.left(idx));
+    p_data = QString::fromUtf8(ba.mid(idx + 1));
+    return true;
+}
+
+void WebGraphCache::set(const QString &p_lang, const QString &p_text, const QString &p_format, const QString &p_data)
+{
+    if (p_format.isEmpty() || p_data.isEmpty()) {
+        return;
+    }
+
+    auto diskCache = getDiskCache();
+    if (diskCache) {
+        diskCache->set(cacheKey(p_lang, p_text), p_format.toUtf8() + '\n' + p_data.toUtf8());
+    }
+}
+
+QByteArray WebGraphCache::cacheKey(const QString &p_lang, const QString &p_text)
+{
+    QByteArray key;
+    key += p_lang.toUtf8() + '\n';
+    key += QCryptographicHash::hash(p_text.toUtf8(), QCryptographicHash::Sha256);
+    return key;
+}
+
+DiskCache *WebGraphCache::getDiskCache()
+{
+    if (m_diskCacheSize <= 0) {
+        return nullptr;
+    }
+
+    if (!m_diskCache) {
+        const auto folderPath = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                               QStringLiteral("graph/web"));
+        m_diskCache.reset(new DiskCache(folderPath, m_diskCacheSize));
+    }
+
+    return m_diskCache.data();
+}
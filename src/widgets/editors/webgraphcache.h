@@ -0,0 +1,44 @@
+#ifndef WEBGRAPHCACHE_H
+#define WEBGRAPHCACHE_H
+
+#include <QString>
+#include <QScopedPointer>
+
+#include <core/noncopyable.h>
+
+namespace vnotex
+{
+    class DiskCache;
+
+    // Persistent cache of graphs rendered by the web side, such as Mermaid and Flowchart.js.
+    // Shared by all viewers, including the ones used for in-place preview and export.
+    class WebGraphCache : private Noncopyable
+    {
+    public:
+        static WebGraphCache &getInst();
+
+        ~WebGraphCache();
+
+        // 0 to disable the cache.
+        void setDiskCacheSize(int p_sizeInMiB);
+
+        // @p_lang: the renderer and its options affecting the output, such as the theme.
+        // Return false if not found.
+        bool get(const QString &p_lang, const QString &p_text, QString &p_format, QString &p_data);
+
+        void set(const QString &p_lang, const QString &p_text, const QString &p_format, const QString &p_data);
+
+    private:
+        WebGraphCache() = default;
+
+        DiskCache *getDiskCache();
+
+        static QByteArray cacheKey(const QString &p_lang, const QString &p_text);
+
+        QScopedPointer<DiskCache> m_diskCache;
+
+        qint64 m_diskCacheSize = 0;
+    };
+}
+
+#endif // WEBGRAPHCACHE_H
@@ -0,0 +1,414 @@
+#include "largefileviewwindow.h"
+
+#include <QPlainTextEdit>
+#include <QLabel>
+#include <QToolBar>
+#include <QScrollBar>
+#include <QTextBlock>
+#include <QFontDatabase>
+#include <QInputDialog>
+
+#include <climits>
+
+#include <core/fileopenparameters.h>
+#include <buffer/mappedtextfile.h>
+#include <search/mappedfilefinder.h>
+#include <search/searchtoken.h>
+#include "toolbarhelper.h"
+#include "findandreplacewidget.h"
+#include "editors/statuswidget.h"
+
+using namespace vnotex;
+
+const int LargeFileViewWindow::c_linesPerPage = 1000;
+
+LargeFileViewWindow::LargeFileViewWindow(QWidget *p_parent)
+    : ViewWindow(p_parent)
+{
+    m_mode = ViewWindowMode::Read;
+    setupUI();
+}
+
+LargeFileViewWindow::~LargeFileViewWindow()
+{
+    stopFinder();
+}
+
+void LargeFileViewWindow::setupUI()
+{
+    // Central widget.
+    {
+        // No highlight and no wrap to keep the layout cheap.
+        m_textEdit = new QPlainTextEdit(this);
+        m_textEdit->setReadOnly(true);
+        m_textEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+        m_textEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        m_textEdit->setTextInteractionFlags(Qt::TextSelectableByMouse | Qt::TextSelectableByKeyboard);
+        setCentralWidget(m_textEdit);
+    }
+
+    // Status widget.
+    {
+        m_pageLabel = QSharedPointer<QLabel>::create();
+        auto statusWidget = QSharedPointer<StatusWidget>::create();
+        statusWidget->setEditorStatusWidget(m_pageLabel);
+        setStatusWidget(statusWidget);
+    }
+
+    setupToolBar();
+}
+
+void LargeFileViewWindow::setupToolBar()
+{
+    auto toolBar = createToolBar(this);
+    addToolBar(toolBar);
+
+    toolBar->addAction(tr("Previous Page"),
+                       this, [this]() {
+                           showPage(m_pageFirstLine - c_linesPerPage);
+                       });
+
+    toolBar->addAction(tr("Next Page"),
+                       this, [this]() {
+                           showPage(m_pageFirstLine + c_linesPerPage);
+                       });
+
+    toolBar->addAction(tr("Go To Line"),
+                       this, &LargeFileViewWindow::goToLine);
+
+    toolBar->addSeparator();
+
+    addAction(toolBar, ViewWindowToolBarHelper::Attachment);
+    addAction(toolBar, ViewWindowToolBarHelper::Tag);
+
+    ToolBarHelper::addSpacer(toolBar);
+
+    addAction(toolBar, ViewWindowToolBarHelper::FindAndReplace);
+}
+
+void LargeFileViewWindow::handleBufferChangedInternal(const QSharedPointer<FileOpenParameters> &p_paras)
+{
+    syncEditorFromBuffer();
+
+    emit statusChanged();
+    emit modeChanged();
+
+    handleFileOpenParameters(p_paras);
+}
+
+void LargeFileViewWindow::syncEditorFromBuffer()
+{
+    stopFinder();
+    m_file.reset();
+
+    auto buffer = getBuffer();
+    if (buffer) {
+        Q_ASSERT(buffer->isLargeFile());
+        m_file.reset(new MappedTextFile(buffer->getContentPath()));
+        if (!m_file->isValid()) {
+            showMessage(tr("Failed to map file (%1)").arg(buffer->getContentPath()));
+        }
+
+        // Keep current page if possible on reload.
+        m_textEdit->clear();
+        showPage(m_pageFirstLine);
+    } else {
+        m_textEdit->clear();
+        m_pageFirstLine = 0;
+        updatePageStatus();
+    }
+
+    m_bufferRevision = buffer ? buffer->getRevision() : 0;
+}
+
+void LargeFileViewWindow::syncEditorFromBufferContent()
+{
+    // The file is reloaded from disk.
+    syncEditorFromBuffer();
+}
+
+void LargeFileViewWindow::detachFromBufferInternal()
+{
+    stopFinder();
+    m_file.reset();
+}
+
+QString LargeFileViewWindow::getLatestContent() const
+{
+    // Content is never changed by this window.
+    return QString();
+}
+
+QString LargeFileViewWindow::selectedText() const
+{
+    return m_textEdit->textCursor().selectedText();
+}
+
+void LargeFileViewWindow::setMode(ViewWindowMode p_mode)
+{
+    // Large file is always read-only.
+    Q_UNUSED(p_mode);
+}
+
+void LargeFileViewWindow::setModified(bool p_modified)
+{
+    Q_UNUSED(p_modified);
+}
+
+void LargeFileViewWindow::handleEditorConfigChange()
+{
+}
+
+void LargeFileViewWindow::applySnippet(const QString &p_name)
+{
+    Q_UNUSED(p_name);
+}
+
+void LargeFileViewWindow::applySnippet()
+{
+}
+
+void LargeFileViewWindow::openTwice(const QSharedPointer<FileOpenParameters> &p_paras)
+{
+    handleFileOpenParameters(p_paras);
+}
+
+void LargeFileViewWindow::handleFileOpenParameters(const QSharedPointer<FileOpenParameters> &p_paras)
+{
+    if (!p_paras) {
+        return;
+    }
+
+    if (p_paras->m_lineNumber > -1) {
+        scrollToLine(p_paras->m_lineNumber);
+    }
+
+    if (p_paras->m_searchToken) {
+        const auto patterns = p_paras->m_searchToken->toPatterns();
+        updateLastFindInfo(patterns.first, patterns.second);
+        find(patterns.first, *p_paras->m_searchToken, qMax(p_paras->m_lineNumber, 0), false);
+    }
+}
+
+ViewWindowSession LargeFileViewWindow::saveSession() const
+{
+    auto session = ViewWindow::saveSession();
+    if (getBuffer()) {
+        session.m_lineNumber = currentLineNumber();
+    }
+    return session;
+}
+
+void LargeFileViewWindow::showPage(int p_firstLine)
+{
+    if (!m_file || !m_file->isValid()) {
+        m_textEdit->clear();
+        m_pageFirstLine = 0;
+        updatePageStatus();
+        return;
+    }
+
+    int firstLine = qMax(p_firstLine, 0);
+    if (!m_file->ensureLineIndexed(firstLine)) {
+        // Beyond the end. Show the last page.
+        firstLine = m_file->indexedLineCount() - 1;
+    }
+    firstLine = firstLine / c_linesPerPage * c_linesPerPage;
+
+    if (firstLine != m_pageFirstLine || m_textEdit->document()->isEmpty()) {
+        m_pageFirstLine = firstLine;
+        m_textEdit->setPlainText(m_file->readLines(m_pageFirstLine, c_linesPerPage));
+    }
+
+    if (!m_file->isValid()) {
+        handleFileChanged();
+        return;
+    }
+
+    updatePageStatus();
+}
+
+void LargeFileViewWindow::handleFileChanged()
+{
+    showMessage(tr("File (%1) is changed outside and should be reloaded").arg(m_file->getFilePath()));
+    m_textEdit->clear();
+    m_pageFirstLine = 0;
+    updatePageStatus();
+}
+
+void LargeFileViewWindow::scrollToLine(int p_lineNumber, int p_offset, int p_length)
+{
+    showPage(p_lineNumber);
+
+    auto block = m_textEdit->document()->findBlockByNumber(p_lineNumber - m_pageFirstLine);
+    if (!block.isValid()) {
+        block = m_textEdit->document()->lastBlock();
+    }
+
+    QTextCursor cursor(block);
+    if (p_length > 0) {
+        const int maxPos = block.position() + block.length() - 1;
+        cursor.setPosition(qMin(block.position() + p_offset, maxPos));
+        cursor.setPosition(qMin(block.position() + p_offset + p_length, maxPos), QTextCursor::KeepAnchor);
+    }
+    m_textEdit->setTextCursor(cursor);
+    m_textEdit->centerCursor();
+}
+
+int LargeFileViewWindow::currentLineNumber() const
+{
+    return m_pageFirstLine + m_textEdit->textCursor().blockNumber();
+}
+
+void LargeFileViewWindow::goToLine()
+{
+    if (!m_file || !m_file->isValid()) {
+        return;
+    }
+
+    bool ok = false;
+    const int lineNumber = QInputDialog::getInt(this,
+                                                tr("Go To Line"),
+                                                tr("Line number:"),
+                                                currentLineNumber() + 1,
+                                                1,
+                                                INT_MAX,
+                                                1,
+                                                &ok);
+    if (ok) {
+        scrollToLine(lineNumber - 1);
+    }
+}
+
+void LargeFileViewWindow::updatePageStatus()
+{
+    if (!m_file || !m_file->isValid()) {
+        m_pageLabel->clear();
+        return;
+    }
+
+    const int lastLine = qMin(m_pageFirstLine + c_linesPerPage, m_file->indexedLineCount());
+    if (m_file->isFullyIndexed()) {
+        m_pageLabel->setText(tr("Lines %1-%2 of %3").arg(m_pageFirstLine + 1)
+                                                     .arg(lastLine)
+                                                     .arg(m_file->indexedLineCount()));
+    } else {
+        m_pageLabel->setText(tr("Lines %1-%2").arg(m_pageFirstLine + 1).arg(lastLine));
+    }
+}
+
+void LargeFileViewWindow::handleFindNext(const QStringList &p_texts, FindOptions p_options)
+{
+    SearchToken token;
+    if (!SearchToken::compile(p_texts, p_options, token)) {
+        showFindResult(p_texts, 0, 0);
+        return;
+    }
+
+    const bool backward = p_options & FindOption::FindBackward;
+    const int curLine = currentLineNumber();
+    find(p_texts, token, backward ? curLine : curLine + 1, backward);
+}
+
+void LargeFileViewWindow::handleFindAndReplaceWidgetOpened()
+{
+    m_findAndReplace->setReplaceEnabled(false);
+}
+
+void LargeFileViewWindow::find(const QStringList &p_texts, const SearchToken &p_token, int p_startLine, bool p_backward)
+{
+    stopFinder();
+
+    if (!m_file || !m_file->isValid()) {
+        return;
+    }
+
+    int startLine = p_startLine;
+    auto startOffset = m_file->lineOffset(startLine);
+    if (!m_file->isValid()) {
+        handleFileChanged();
+        return;
+    }
+
+    if (startOffset == -1) {
+        // Wrap around.
+        startLine = 0;
+        startOffset = m_file->dataOffset();
+    }
+
+    m_findTexts = p_texts;
+
+    const int serial = ++m_findSerial;
+    m_finder.reset(new MappedFileFinder());
+    m_finder->setData(m_file, p_token, startLine, startOffset, p_backward);
+    connect(m_finder.data(), &QThread::finished,
+            this, [this, serial]() {
+                handleFindFinished(serial);
+            });
+    m_finder->start();
+
+    showMessage(tr("Finding %1").arg(p_texts.join(QStringLiteral("; "))));
+}
+
+void LargeFileViewWindow::handleFindFinished(int p_serial)
+{
+    if (p_serial != m_findSerial || !m_finder) {
+        return;
+    }
+
+    // finished() is emitted right before the thread ends.
+    m_finder->wait();
+    const int line = m_finder->getMatchedLine();
+    if (m_finder->isFileChanged()) {
+        m_finder.reset();
+        handleFileChanged();
+        return;
+    } else if (line < 0) {
+        showFindResult(m_findTexts, 0, 0);
+    } else {
+        const auto &segments = m_finder->getMatchedSegments();
+        if (segments.isEmpty()) {
+            scrollToLine(line);
+        } else {
+            scrollToLine(line, segments.first().m_offset, segments.first().m_length);
+        }
+        showMessage(tr("Match found at line %1").arg(line + 1));
+    }
+
+    m_finder.reset();
+}
+
+void LargeFileViewWindow::stopFinder()
+{
+    if (m_finder) {
+        ++m_findSerial;
+        m_finder->stop();
+        m_finder->wait();
+        m_finder.reset();
+    }
+}
+
+void LargeFileViewWindow::scrollUp()
+{
+    QScrollBar *vbar = m_textEdit->verticalScrollBar();
+    if (vbar && (vbar->minimum() != vbar->maximum())) {
+        vbar->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+    }
+}
+
+void LargeFileViewWindow::scrollDown()
+{
+    QScrollBar *vbar = m_textEdit->verticalScrollBar();
+    if (vbar && (vbar->minimum() != vbar->maximum())) {
+        vbar->triggerAction(QAbstractSlider::SliderSingleStepSub);
+    }
+}
+
+void LargeFileViewWindow::zoom(bool p_zoomIn)
+{
+    if (p_zoomIn) {
+        m_textEdit->zoomIn();
+    } else {
+        m_textEdit->zoomOut();
+    }
+}
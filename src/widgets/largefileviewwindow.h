@@ -0,0 +1,116 @@
+#ifndef LARGEFILEVIEWWINDOW_H
+#define LARGEFILEVIEWWINDOW_H
+
+#include "viewwindow.h"
+
+class QPlainTextEdit;
+class QLabel;
+
+namespace vnotex
+{
+    class MappedTextFile;
+    class MappedFileFinder;
+    class SearchToken;
+
+    // Read-only view of a buffer in large file mode.
+    // The file is memory-mapped and shown page by page without highlight, preview or outline.
+    class LargeFileViewWindow : public ViewWindow
+    {
+        Q_OBJECT
+    public:
+        explicit LargeFileViewWindow(QWidget *p_parent = nullptr);
+
+        ~LargeFileViewWindow();
+
+        QString getLatestContent() const Q_DECL_OVERRIDE;
+
+        QString selectedText() const Q_DECL_OVERRIDE;
+
+        void setMode(ViewWindowMode p_mode) Q_DECL_OVERRIDE;
+
+        void openTwice(const QSharedPointer<FileOpenParameters> &p_paras) Q_DECL_OVERRIDE;
+
+        ViewWindowSession saveSession() const Q_DECL_OVERRIDE;
+
+        void applySnippet(const QString &p_name) Q_DECL_OVERRIDE;
+
+        void applySnippet() Q_DECL_OVERRIDE;
+
+    public slots:
+        void handleEditorConfigChange() Q_DECL_OVERRIDE;
+
+    protected slots:
+        void setModified(bool p_modified) Q_DECL_OVERRIDE;
+
+        void handleBufferChangedInternal(const QSharedPointer<FileOpenParameters> &p_paras) Q_DECL_OVERRIDE;
+
+        void handleFindNext(const QStringList &p_texts, FindOptions p_options) Q_DECL_OVERRIDE;
+
+        void handleFindAndReplaceWidgetOpened() Q_DECL_OVERRIDE;
+
+    protected:
+        void syncEditorFromBuffer() Q_DECL_OVERRIDE;
+
+        void syncEditorFromBufferContent() Q_DECL_OVERRIDE;
+
+        void detachFromBufferInternal() Q_DECL_OVERRIDE;
+
+        void scrollUp() Q_DECL_OVERRIDE;
+
+        void scrollDown() Q_DECL_OVERRIDE;
+
+        void zoom(bool p_zoomIn) Q_DECL_OVERRIDE;
+
+    private:
+        void setupUI();
+
+        void setupToolBar();
+
+        void handleFileOpenParameters(const QSharedPointer<FileOpenParameters> &p_paras);
+
+        // Show the page containing line @p_firstLine.
+        void showPage(int p_firstLine);
+
+        // The mapped file is changed outside and could not be accessed any more.
+        void handleFileChanged();
+
+        // Show line @p_lineNumber and select [@p_offset, @p_offset + @p_length) of it.
+        void scrollToLine(int p_lineNumber, int p_offset = 0, int p_length = 0);
+
+        // 0-based line number of the cursor in the whole file.
+        int currentLineNumber() const;
+
+        void goToLine();
+
+        // Start finding @p_token in background from @p_startLine.
+        void find(const QStringList &p_texts, const SearchToken &p_token, int p_startLine, bool p_backward);
+
+        void handleFindFinished(int p_serial);
+
+        void stopFinder();
+
+        void updatePageStatus();
+
+        // Managed by QObject.
+        QPlainTextEdit *m_textEdit = nullptr;
+
+        // Shown in the status widget.
+        QSharedPointer<QLabel> m_pageLabel;
+
+        QSharedPointer<MappedTextFile> m_file;
+
+        // Line number of the first line of current page.
+        int m_pageFirstLine = 0;
+
+        QSharedPointer<MappedFileFinder> m_finder;
+
+        // Used to skip the results of outdated finds.
+        int m_findSerial = 0;
+
+        QStringList m_findTexts;
+
+        static const int c_linesPerPage;
+    };
+}
+
+#endif // LARGEFILEVIEWWINDOW_H
@@ -28,6 +28,7 @@
 #include <core/thememgr.h>
 #include <imagehost/imagehostmgr.h>
 #include <imagehost/imagehost.h>
+#include <imagehost/imageuploadcache.h>
 #include "editors/markdowneditor.h"
 #include "textviewwindowhelper.h"
 #include "editors/markdownviewer.h"
@@ -152,6 +153,10 @@ void MarkdownViewWindow::setModeInternal(ViewWindowMode p_mode, bool p_syncBuffe
             setEditViewMode(ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig().getEditViewMode());
         } else {
             setEditViewMode(m_editViewMode);
+
+            // Editor won't notify if headings are unchanged since last time in Edit mode.
+            m_outlineProvider->setOutline(headingsToOutline(m_editor->getHeadings()));
+            m_outlineProvider->setCurrentHeadingIndex(m_editor->getCurrentHeadingIndex());
         }
 
         // Avoid focus glitch.
@@ -215,6 +220,12 @@ QString MarkdownViewWindow::getLatestContent() const
     return m_editor->getText();
 }
 
+void MarkdownViewWindow::syncLatestContent(QString &p_content) const
+{
+    Q_ASSERT(m_editor);
+    TextViewWindowHelper::syncLatestContent(this, p_content);
+}
+
 void MarkdownViewWindow::syncEditorFromBuffer()
 {
     m_bufferRevision = getBuffer() ? getBuffer()->getRevision() : 0;
@@ -507,6 +518,7 @@ void MarkdownViewWindow::syncTextEditorFromBuffer(bool p_syncPositionFromReadMod
         m_editor->setReadOnly(buffer->isReadOnly());
         m_editor->setBasePath(buffer->getResourcePath());
         m_editor->setText(buffer->getContent());
+        m_contentChangeTracker->reset();
         m_editor->setModified(buffer->isModified());
 
         int lineNumber = -1;
@@ -570,6 +582,7 @@ void MarkdownViewWindow::syncTextEditorFromBufferContent(bool p_syncPosition)
     auto buffer = getBuffer();
     Q_ASSERT(buffer);
     m_editor->setText(buffer->getContent());
+    m_contentChangeTracker->reset();
     m_editor->setModified(buffer->isModified());
 
     m_textEditorBufferRevision = m_bufferRevision;
@@ -1188,7 +1201,13 @@ void MarkdownViewWindow::removeFromImageHost(const QString &p_url)
                                  QString(),
                                  errMsg,
                                  this);
+        return;
     }
+
+    // Do not hand out the deleted URL for identical images any more.
+    auto cache = host->getUploadCache();
+    cache->removeUrl(p_url);
+    cache->save();
 }
 
 bool MarkdownViewWindow::updateConfigRevision()
@@ -29,6 +29,7 @@ namespace vnotex
     class EditorConfig;
     class ImageHost;
     class SearchToken;
+    class DocumentChangeTracker;
 
     class MarkdownViewWindow : public ViewWindow
     {
@@ -42,6 +43,8 @@ namespace vnotex
 
         QString getLatestContent() const Q_DECL_OVERRIDE;
 
+        void syncLatestContent(QString &p_content) const Q_DECL_OVERRIDE;
+
         QString selectedText() const Q_DECL_OVERRIDE;
 
         void setMode(ViewWindowMode p_mode) Q_DECL_OVERRIDE;
@@ -190,6 +193,10 @@ namespace vnotex
         // Managed by QObject.
         MarkdownEditor *m_editor = nullptr;
 
+        // Track changes of editor since last sync with buffer.
+        // Managed by QObject.
+        DocumentChangeTracker *m_contentChangeTracker = nullptr;
+
         // Managed by QObject.
         MarkdownViewer *m_viewer = nullptr;
 
@@ -6,11 +6,13 @@
 #include <QAction>
 #include <QSet>
 #include <QShortcut>
+#include <QProgressDialog>
 
 #include <notebook/notebook.h>
 #include <notebook/node.h>
 #include <notebook/externalnode.h>
 #include <notebook/nodeparameters.h>
+#include <notebookbackend/backendiostats.h>
 #include <core/exception.h>
 #include "messageboxhelper.h"
 #include "vnotex.h"
@@ -27,6 +29,7 @@
 #include <utils/widgetutils.h>
 #include <utils/pathutils.h>
 #include <utils/clipboardutils.h>
+#include <utils/fileutils.h>
 #include "notebookmgr.h"
 #include "widgetsfactory.h"
 #include "navigationmodemgr.h"
@@ -304,6 +307,8 @@ void NotebookNodeExplorer::setNotebook(const QSharedPointer<Notebook> &p_noteboo
                 this, [this](const Node *p_node) {
                     updateNode(p_node->getParent());
                 });
+        connect(m_notebook.data(), &Notebook::nodeChildrenUpdated,
+                this, &NotebookNodeExplorer::updateNode);
     }
 
     generateNodeTree();
@@ -499,6 +504,8 @@ NotebookNodeExplorer::NodeData NotebookNodeExplorer::getItemNodeData(const QTree
 
 void NotebookNodeExplorer::updateNode(Node *p_node)
 {
+    BackendIoStats::OperationScope ioScope("rescan");
+
     if (p_node && p_node->getNotebook() != m_notebook) {
         return;
     }
@@ -1156,6 +1163,8 @@ static QSharedPointer<Node> getNodeFromClipboardDataItem(const NodeClipboardData
 
 void NotebookNodeExplorer::pasteNodesFromClipboard()
 {
+    BackendIoStats::OperationScope ioScope("paste");
+
     // Identify the dest node.
     auto destNode = getCurrentNode();
     if (!destNode) {
@@ -1200,10 +1209,32 @@ void NotebookNodeExplorer::pasteNodesFromClipboard()
     }
 
     bool isMove = cdata->getAction() == ClipboardData::MoveNode;
+
+    // Shown only if copying folders takes a while. Copy could not be interrupted.
+    const int stepsPerNode = 100;
+    QProgressDialog proDlg(isMove ? tr("Moving items...") : tr("Copying items..."),
+                           QString(),
+                           0,
+                           srcNodes.size() * stepsPerNode,
+                           VNoteX::getInst().getMainWindow());
+    proDlg.setWindowModality(Qt::WindowModal);
+    proDlg.setWindowTitle(isMove ? tr("Move") : tr("Paste"));
+    proDlg.setCancelButton(nullptr);
+    proDlg.setValue(0);
+
+    int nodeIdx = 0;
+    FileUtils::CopyProgressScope progressScope([&proDlg, &nodeIdx, stepsPerNode](qint64 p_copied, qint64 p_total) {
+        const int step = p_total > 0 ? static_cast<int>(p_copied * stepsPerNode / p_total) : stepsPerNode;
+        proDlg.setValue(nodeIdx * stepsPerNode + qMin(step, stepsPerNode - 1));
+    });
+
     QVector<const Node *> pastedNodes;
     QSet<Node *> nodesNeedUpdate;
     for (auto srcNode : srcNodes) {
         Q_ASSERT(srcNode->exists());
+        proDlg.setLabelText(tr("Pasting (%1)").arg(srcNode->getName()));
+        proDlg.setValue(nodeIdx * stepsPerNode);
+        ++nodeIdx;
 
         if (isMove) {
             // Notice the view area to close any opened view windows.
@@ -1233,6 +1264,8 @@ void NotebookNodeExplorer::pasteNodesFromClipboard()
         }
     }
 
+    proDlg.setValue(proDlg.maximum());
+
     for (auto node : nodesNeedUpdate) {
         updateNode(node);
 
@@ -1863,6 +1896,8 @@ void NotebookNodeExplorer::openSelectedNodesWithExternalProgram(const QString &p
 
 void NotebookNodeExplorer::loadItemChildren(QTreeWidgetItem *p_item) const
 {
+    BackendIoStats::OperationScope ioScope("browse");
+
     auto cnt = p_item->childCount();
     for (int i = 0; i < cnt; ++i) {
         auto child = p_item->child(i);
@@ -5,6 +5,7 @@
 #include <QVBoxLayout>
 #include <QShowEvent>
 #include <QTreeWidgetItem>
+#include <QTreeWidgetItemIterator>
 #include <QToolButton>
 #include <QToolTip>
 #include <QDebug>
@@ -190,25 +191,245 @@ void OutlineViewer::updateTree(bool p_force)
 
 void OutlineViewer::updateOutline(const QSharedPointer<Outline> &p_outline)
 {
+    Outline outline;
     if (!p_outline) {
         if (m_outline.isEmpty()) {
             return;
         }
-        m_outline.clear();
     } else {
         if (m_outline == *p_outline) {
             return;
         }
-        m_outline = *p_outline;
+        outline = *p_outline;
     }
 
     m_muted = true;
-    updateTreeToOutline(m_tree, m_outline);
+    if (canUpdateIncrementally(outline)) {
+        updateTreeIncrementally(outline);
+    } else {
+        m_outline = outline;
+        updateTreeToOutline(m_tree, m_outline);
+        collectItems();
 
-    expandTree(m_autoExpandedLevel);
+        expandTree(m_autoExpandedLevel);
+    }
     m_muted = false;
 }
 
+bool OutlineViewer::canUpdateIncrementally(const Outline &p_outline) const
+{
+    if (m_outline.isEmpty() || p_outline.isEmpty() || m_items.size() != m_outline.m_headings.size()) {
+        return false;
+    }
+
+    if (m_outline.m_sectionNumberBaseLevel != p_outline.m_sectionNumberBaseLevel
+        || m_outline.m_sectionNumberEndingDot != p_outline.m_sectionNumberEndingDot) {
+        return false;
+    }
+
+    // The tree structure is derived from levels assuming there is no level skipped.
+    const auto &headings = p_outline.m_headings;
+    const int baseLevel = headings[0].m_level;
+    if (baseLevel != m_outline.m_headings[0].m_level) {
+        return false;
+    }
+
+    for (int i = 1; i < headings.size(); ++i) {
+        if (headings[i].m_level < baseLevel || headings[i].m_level > headings[i - 1].m_level + 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void takeTreeItem(QTreeWidget *p_tree, QTreeWidgetItem *p_item)
+{
+    auto parentItem = p_item->parent();
+    if (parentItem) {
+        parentItem->removeChild(p_item);
+    } else {
+        p_tree->takeTopLevelItem(p_tree->indexOfTopLevelItem(p_item));
+    }
+}
+
+// Insert @p_item right after @p_prevItem under @p_parentItem, or as the first child if @p_prevItem is null.
+static void insertTreeItem(QTreeWidget *p_tree,
+                           QTreeWidgetItem *p_parentItem,
+                           QTreeWidgetItem *p_prevItem,
+                           QTreeWidgetItem *p_item)
+{
+    if (p_parentItem) {
+        int idx = p_prevItem ? p_parentItem->indexOfChild(p_prevItem) + 1 : 0;
+        p_parentItem->insertChild(idx, p_item);
+    } else {
+        int idx = p_prevItem ? p_tree->indexOfTopLevelItem(p_prevItem) + 1 : 0;
+        p_tree->insertTopLevelItem(idx, p_item);
+    }
+}
+
+void OutlineViewer::updateTreeIncrementally(const Outline &p_outline)
+{
+    const auto &oldHeadings = m_outline.m_headings;
+    const auto &newHeadings = p_outline.m_headings;
+    const int oldSize = oldHeadings.size();
+    const int newSize = newHeadings.size();
+
+    // Headings within [0, prefix) and the last @suffix ones are unchanged.
+    int prefix = 0;
+    while (prefix < oldSize && prefix < newSize && oldHeadings[prefix] == newHeadings[prefix]) {
+        ++prefix;
+    }
+
+    int suffix = 0;
+    while (suffix < oldSize - prefix
+           && suffix < newSize - prefix
+           && oldHeadings[oldSize - 1 - suffix] == newHeadings[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+
+    const int oldMidEnd = oldSize - suffix;
+    const int newMidEnd = newSize - suffix;
+    const int delta = newSize - oldSize;
+
+    auto curItem = m_tree->currentItem();
+    int curIdx = curItem ? curItem->data(Column::Name, Qt::UserRole).toInt() : -1;
+    if (curIdx >= prefix && curIdx < oldMidEnd) {
+        curItem = nullptr;
+        curIdx = -1;
+    } else if (curIdx >= oldMidEnd) {
+        curIdx += delta;
+    }
+
+    bool renameOnly = oldMidEnd - prefix == newMidEnd - prefix;
+    for (int i = prefix; renameOnly && i < oldMidEnd; ++i) {
+        renameOnly = oldHeadings[i].m_level == newHeadings[i].m_level;
+    }
+
+    QVector<QTreeWidgetItem *> items;
+    if (renameOnly) {
+        items = m_items;
+    } else {
+        // Parent and previous sibling of each new heading.
+        QVector<int> parents(newSize, -1);
+        QVector<int> prevSiblings(newSize, -1);
+        {
+            QVector<int> stack;
+            for (int i = 0; i < newSize; ++i) {
+                const int level = newHeadings[i].m_level;
+                while (!stack.isEmpty() && newHeadings[stack.last()].m_level > level) {
+                    stack.removeLast();
+                }
+                if (!stack.isEmpty() && newHeadings[stack.last()].m_level == level) {
+                    prevSiblings[i] = stack.takeLast();
+                }
+                parents[i] = stack.isEmpty() ? -1 : stack.last();
+                stack.push_back(i);
+            }
+        }
+
+        items.reserve(newSize);
+        items += m_items.mid(0, prefix);
+        items.resize(newMidEnd);
+        items += m_items.mid(oldMidEnd);
+
+        auto itemAt = [&items](int p_idx) {
+            return p_idx == -1 ? nullptr : items[p_idx];
+        };
+
+        // Items of the suffix whose parent changes. Their subtrees move along with them.
+        QVector<int> movedItems;
+        QVector<bool> expanded(suffix);
+        for (int i = newMidEnd; i < newSize; ++i) {
+            auto item = items[i];
+            expanded[i - newMidEnd] = item->isExpanded();
+            // Items of the new middle part are not created yet.
+            const int parentIdx = parents[i];
+            if ((parentIdx >= prefix && parentIdx < newMidEnd) || item->parent() != itemAt(parentIdx)) {
+                movedItems.push_back(i);
+            }
+        }
+
+        for (int i = movedItems.size() - 1; i >= 0; --i) {
+            takeTreeItem(m_tree, items[movedItems[i]]);
+        }
+
+        // Children go before their parents.
+        for (int i = oldMidEnd - 1; i >= prefix; --i) {
+            delete m_items[i];
+        }
+
+        for (int i = prefix; i < newMidEnd; ++i) {
+            auto item = new QTreeWidgetItem();
+            items[i] = item;
+            insertTreeItem(m_tree, itemAt(parents[i]), itemAt(prevSiblings[i]), item);
+            item->setExpanded(newHeadings[i].m_level < m_autoExpandedLevel);
+        }
+
+        for (int idx : movedItems) {
+            insertTreeItem(m_tree, itemAt(parents[idx]), itemAt(prevSiblings[idx]), items[idx]);
+        }
+
+        // Taking an item out of the tree loses the expansion of its subtree.
+        for (int i = newMidEnd; i < newSize; ++i) {
+            items[i]->setExpanded(expanded[i - newMidEnd]);
+        }
+    }
+
+    m_outline = p_outline;
+    m_items = items;
+
+    const auto sectionStrs = computeSectionStrings(m_outline);
+    for (int i = prefix; i < newSize; ++i) {
+        // Unchanged items need an update only if the index or section number may shift.
+        auto item = m_items[i];
+        if (i >= newMidEnd
+            && item->data(Column::Name, Qt::UserRole).toInt() == i
+            && sectionStrs[i].isEmpty()) {
+            continue;
+        }
+
+        fillTreeItem(item, newHeadings[i], i, sectionStrs[i]);
+    }
+
+    m_tree->setCurrentItem(curItem);
+    m_currentHeadingIndex = curIdx;
+}
+
+void OutlineViewer::collectItems()
+{
+    // Pre-order differs from the heading order when levels are skipped, so place items by
+    // their stored index.
+    m_items.clear();
+    m_items.resize(m_outline.m_headings.size());
+    for (QTreeWidgetItemIterator it(m_tree); *it; ++it) {
+        const int idx = (*it)->data(Column::Name, Qt::UserRole).toInt();
+        if (idx >= 0 && idx < m_items.size()) {
+            m_items[idx] = *it;
+        }
+    }
+}
+
+QVector<QString> OutlineViewer::computeSectionStrings(const Outline &p_outline)
+{
+    QVector<QString> strs(p_outline.m_headings.size());
+
+    const auto &widgetConfig = ConfigMgr::getInst().getWidgetConfig();
+    if (!widgetConfig.getOutlineSectionNumberEnabled() || p_outline.m_sectionNumberBaseLevel <= 0) {
+        return strs;
+    }
+
+    SectionNumber sectionNumber(7, 0);
+    for (int i = 0; i < p_outline.m_headings.size(); ++i) {
+        OutlineProvider::increaseSectionNumber(sectionNumber,
+                                               p_outline.m_headings[i].m_level,
+                                               p_outline.m_sectionNumberBaseLevel);
+        strs[i] = OutlineProvider::joinSectionNumber(sectionNumber, p_outline.m_sectionNumberEndingDot);
+    }
+
+    return strs;
+}
+
 void OutlineViewer::updateCurrentHeading(int p_idx)
 {
     if (m_currentHeadingIndex == p_idx) {
@@ -324,8 +545,13 @@ void OutlineViewer::highlightHeading(int p_idx)
         return;
     }
 
-    auto item = TreeWidget::findItem(m_tree, p_idx);
-    m_tree->setCurrentItem(item);
+    if (p_idx < 0 || p_idx >= m_items.size()) {
+        qWarning() << "invalid heading index to highlight" << p_idx << m_items.size();
+        m_tree->setCurrentItem(nullptr);
+        return;
+    }
+
+    m_tree->setCurrentItem(m_items[p_idx]);
 }
 
 void OutlineViewer::expandTree(int p_level)
@@ -73,6 +73,19 @@ namespace vnotex
 
         static void updateTreeToOutline(QTreeWidget *p_tree, const Outline &p_outline);
 
+        // Whether we could diff @p_outline against m_outline instead of re-rendering the tree.
+        bool canUpdateIncrementally(const Outline &p_outline) const;
+
+        // Apply inserts, removes and renames of headings to existing items, keeping their
+        // expansion and the current item.
+        void updateTreeIncrementally(const Outline &p_outline);
+
+        // Collect items of the tree by their heading index.
+        void collectItems();
+
+        // Section number string of each heading. Empty strings if section number is disabled.
+        static QVector<QString> computeSectionStrings(const Outline &p_outline);
+
         bool m_muted = false;
 
         QTimer *m_expandTimer = nullptr;
@@ -83,6 +96,9 @@ namespace vnotex
 
         Outline m_outline;
 
+        // Items of m_outline.m_headings by index. Owned by m_tree.
+        QVector<QTreeWidgetItem *> m_items;
+
         int m_currentHeadingIndex = -1;
 
         int m_autoExpandedLevel = 6;
@@ -156,6 +156,16 @@ void TagExplorer::setNotebook(const QSharedPointer<Notebook> &p_notebook)
     if (m_notebook) {
         connect(m_notebook.data(), &Notebook::tagsUpdated,
                 this, &TagExplorer::updateTags);
+        connect(m_notebook.data(), &Notebook::tagAdded,
+                this, &TagExplorer::handleTagAdded);
+        connect(m_notebook.data(), &Notebook::tagRenamed,
+                this, &TagExplorer::handleTagRenamed);
+        connect(m_notebook.data(), &Notebook::tagMoved,
+                this, &TagExplorer::handleTagReparented);
+        connect(m_notebook.data(), &Notebook::tagRemoved,
+                this, &TagExplorer::handleTagRemoved);
+        connect(m_notebook.data(), &Notebook::nodeTagsUpdated,
+                this, &TagExplorer::handleNodeTagsUpdated);
     }
 
     m_lastTagName.clear();
@@ -166,6 +176,7 @@ void TagExplorer::setNotebook(const QSharedPointer<Notebook> &p_notebook)
 void TagExplorer::updateTags()
 {
     m_tagTree->clear();
+    m_tagItems.clear();
 
     auto tagI = m_notebook ? m_notebook->tag() : nullptr;
     if (!tagI) {
@@ -176,6 +187,7 @@ void TagExplorer::updateTags()
     for (const auto &tag : topLevelTags) {
         auto item = new QTreeWidgetItem(m_tagTree);
         fillTagItem(tag, item);
+        m_tagItems.insert(tag->name(), item);
         loadTagChildren(tag, item);
     }
 
@@ -189,6 +201,7 @@ void TagExplorer::loadTagChildren(const QSharedPointer<Tag> &p_tag, QTreeWidgetI
     for (const auto &child : p_tag->getChildren()) {
         auto item = new QTreeWidgetItem(p_parentItem);
         fillTagItem(child, item);
+        m_tagItems.insert(child->name(), item);
         loadTagChildren(child, item);
     }
 }
@@ -201,6 +214,122 @@ void TagExplorer::fillTagItem(const QSharedPointer<Tag> &p_tag, QTreeWidgetItem
     p_item->setData(Column::Name, Qt::UserRole, p_tag->name());
 }
 
+void TagExplorer::placeTagItem(const QSharedPointer<Tag> &p_tag, QTreeWidgetItem *p_item)
+{
+    Q_ASSERT(!p_item->parent() && m_tagTree->indexOfTopLevelItem(p_item) == -1);
+    auto parentTag = p_tag->getParent();
+    if (parentTag) {
+        auto parentItem = m_tagItems.value(parentTag->name());
+        Q_ASSERT(parentItem);
+        // Siblings in the tree are the same as in the tag graph except @p_tag itself.
+        int idx = 0;
+        for (const auto &child : parentTag->getChildren()) {
+            if (child == p_tag) {
+                break;
+            }
+            ++idx;
+        }
+        parentItem->insertChild(idx, p_item);
+        parentItem->setExpanded(true);
+    } else {
+        const auto &topLevelTags = m_notebook->tag()->getTopLevelTags();
+        m_tagTree->insertTopLevelItem(topLevelTags.indexOf(p_tag), p_item);
+    }
+
+    // Taken items lose the expanded state.
+    TreeWidget::forEachItem(p_item, [](QTreeWidgetItem *p_it) {
+        p_it->setExpanded(true);
+        return true;
+    });
+}
+
+void TagExplorer::takeTagItem(QTreeWidgetItem *p_item)
+{
+    if (auto parentItem = p_item->parent()) {
+        parentItem->removeChild(p_item);
+    } else {
+        m_tagTree->takeTopLevelItem(m_tagTree->indexOfTopLevelItem(p_item));
+    }
+}
+
+void TagExplorer::removeTagItemsFromIndex(QTreeWidgetItem *p_item)
+{
+    TreeWidget::forEachItem(p_item, [this](QTreeWidgetItem *p_it) {
+        m_tagItems.remove(itemTag(p_it));
+        return true;
+    });
+}
+
+void TagExplorer::handleTagAdded(const QString &p_name)
+{
+    auto tag = m_notebook->tag()->findTag(p_name);
+    if (!tag || m_tagItems.contains(p_name)) {
+        return;
+    }
+
+    auto item = new QTreeWidgetItem();
+    fillTagItem(tag, item);
+    m_tagItems.insert(p_name, item);
+    placeTagItem(tag, item);
+}
+
+void TagExplorer::handleTagRenamed(const QString &p_name, const QString &p_newName)
+{
+    auto item = m_tagItems.take(p_name);
+    auto tag = m_notebook->tag()->findTag(p_newName);
+    if (!item || !tag) {
+        updateTags();
+        return;
+    }
+
+    if (m_lastTagName == p_name) {
+        m_lastTagName = p_newName;
+    }
+
+    // Re-place it since siblings are sorted by name.
+    takeTagItem(item);
+    fillTagItem(tag, item);
+    m_tagItems.insert(p_newName, item);
+    placeTagItem(tag, item);
+
+    scrollToTag(m_lastTagName);
+}
+
+void TagExplorer::handleTagReparented(const QString &p_name)
+{
+    auto item = m_tagItems.value(p_name);
+    auto tag = m_notebook->tag()->findTag(p_name);
+    if (!item || !tag) {
+        updateTags();
+        return;
+    }
+
+    // The item may have been moved by drag and drop already.
+    takeTagItem(item);
+    placeTagItem(tag, item);
+
+    scrollToTag(m_lastTagName);
+}
+
+void TagExplorer::handleTagRemoved(const QString &p_name)
+{
+    auto item = m_tagItems.value(p_name);
+    if (!item) {
+        return;
+    }
+
+    removeTagItemsFromIndex(item);
+    delete item;
+}
+
+void TagExplorer::handleNodeTagsUpdated()
+{
+    // Tag references of nodes changed.
+    if (!m_lastTagName.isEmpty() && m_tagItems.contains(m_lastTagName)) {
+        updateNodeList(m_lastTagName);
+    }
+}
+
 void TagExplorer::activateTagItem()
 {
     auto items = m_tagTree->selectedItems();
@@ -398,6 +527,8 @@ void TagExplorer::handleTagMoved(QTreeWidgetItem *p_item)
     qDebug() << "re-parent tag" << tagName << oldParentName << "->" << newParentName;
     bool ret = m_notebook->tag()->moveTag(tagName, newParentName);
     if (!ret) {
+        // Restore the tree modified by drag and drop.
+        updateTags();
         MessageBoxHelper::notify(MessageBoxHelper::Type::Warning,
                                 tr("Failed to move tag (%1).").arg(tagName),
                                 VNoteX::getInst().getMainWindow());
@@ -410,7 +541,7 @@ void TagExplorer::scrollToTag(const QString &p_name)
         return;
     }
 
-    auto item = TreeWidget::findItem(m_tagTree, p_name, Column::Name);
+    auto item = m_tagItems.value(p_name);
     if (item) {
         m_tagTree->setCurrentItem(item);
         m_tagTree->scrollToItem(item);
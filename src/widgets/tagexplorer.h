@@ -4,6 +4,7 @@
 #include <QFrame>
 #include <QSharedPointer>
 #include <QScopedPointer>
+#include <QHash>
 
 #include "navigationmodewrapper.h"
 
@@ -40,6 +41,16 @@ namespace vnotex
 
         void handleTagMoved(QTreeWidgetItem *p_item);
 
+        void handleTagAdded(const QString &p_name);
+
+        void handleTagRenamed(const QString &p_name, const QString &p_newName);
+
+        void handleTagReparented(const QString &p_name);
+
+        void handleTagRemoved(const QString &p_name);
+
+        void handleNodeTagsUpdated();
+
     private:
         enum Column { Name = 0 };
 
@@ -61,6 +72,13 @@ namespace vnotex
 
         void fillTagItem(const QSharedPointer<Tag> &p_tag, QTreeWidgetItem *p_item) const;
 
+        // Insert detached @p_item of @p_tag according to the position of @p_tag in the tag graph.
+        void placeTagItem(const QSharedPointer<Tag> &p_tag, QTreeWidgetItem *p_item);
+
+        void takeTagItem(QTreeWidgetItem *p_item);
+
+        void removeTagItemsFromIndex(QTreeWidgetItem *p_item);
+
         void activateTagItem();
 
         QString itemTag(const QTreeWidgetItem *p_item) const;
@@ -84,6 +102,9 @@ namespace vnotex
         // Used to cache current selected tag after update.
         QString m_lastTagName;
 
+        // Tag name -> item.
+        QHash<QString, QTreeWidgetItem *> m_tagItems;
+
         TitleBar *m_titleBar = nullptr;
 
         QSplitter *m_splitter = nullptr;
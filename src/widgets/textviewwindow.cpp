@@ -95,6 +95,7 @@ void TextViewWindow::syncEditorFromBuffer()
         m_editor->setSyntax(QFileInfo(buffer->getPath()).suffix());
         m_editor->setReadOnly(buffer->isReadOnly());
         m_editor->setText(buffer->getContent());
+        m_contentChangeTracker->reset();
         m_editor->setModified(buffer->isModified());
     } else {
         m_editor->setSyntax("");
@@ -115,6 +116,7 @@ void TextViewWindow::syncEditorFromBufferContent()
     auto buffer = getBuffer();
     Q_ASSERT(buffer);
     m_editor->setText(buffer->getContent());
+    m_contentChangeTracker->reset();
     m_editor->setModified(buffer->isModified());
 
     m_bufferRevision = buffer->getRevision();
@@ -126,6 +128,11 @@ QString TextViewWindow::getLatestContent() const
     return m_editor->getText();
 }
 
+void TextViewWindow::syncLatestContent(QString &p_content) const
+{
+    TextViewWindowHelper::syncLatestContent(this, p_content);
+}
+
 void TextViewWindow::setModified(bool p_modified)
 {
     m_editor->setModified(p_modified);
@@ -12,6 +12,7 @@ namespace vte
 namespace vnotex
 {
     class TextEditor;
+    class DocumentChangeTracker;
     class TextEditorConfig;
     class EditorConfig;
 
@@ -25,6 +26,8 @@ namespace vnotex
 
         QString getLatestContent() const Q_DECL_OVERRIDE;
 
+        void syncLatestContent(QString &p_content) const Q_DECL_OVERRIDE;
+
         QString selectedText() const Q_DECL_OVERRIDE;
 
         void setMode(ViewWindowMode p_mode) Q_DECL_OVERRIDE;
@@ -93,6 +96,10 @@ namespace vnotex
         // Managed by QObject.
         TextEditor *m_editor = nullptr;
 
+        // Track changes of editor since last sync with buffer.
+        // Managed by QObject.
+        DocumentChangeTracker *m_contentChangeTracker = nullptr;
+
         // Whether propogate the state from editor to buffer.
         bool m_propogateEditorToBuffer = false;
 
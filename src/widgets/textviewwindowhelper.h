@@ -15,6 +15,7 @@
 #include <search/searchtoken.h>
 
 #include "quickselector.h"
+#include "editors/documentchangetracker.h"
 
 namespace vte
 {
@@ -35,6 +36,8 @@ namespace vnotex
         static void connectEditor(_ViewWindow *p_win)
         {
             auto editor = p_win->m_editor;
+            p_win->m_contentChangeTracker = new DocumentChangeTracker(editor->getTextEdit()->document(), p_win);
+
             p_win->connect(editor, &vte::VTextEditor::focusIn,
                            p_win, [p_win]() {
                                emit p_win->focused(p_win);
@@ -52,6 +55,16 @@ namespace vnotex
                            });
         }
 
+        // Apply only the changed range of editor to @p_content instead of fetching the whole text.
+        template <typename _ViewWindow>
+        static void syncLatestContent(const _ViewWindow *p_win, QString &p_content)
+        {
+            if (!p_win->m_contentChangeTracker->apply(p_content)) {
+                p_content = p_win->getLatestContent();
+            }
+            p_win->m_contentChangeTracker->reset();
+        }
+
         template <typename _ViewWindow>
         static void handleBufferChanged(_ViewWindow *p_win)
         {
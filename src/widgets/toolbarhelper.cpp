@@ -27,6 +27,7 @@
 #include <core/fileopenparameters.h>
 #include <core/htmltemplatehelper.h>
 #include <core/exception.h>
+#include <notebookbackend/backendiostats.h>
 #include "propertydefs.h"
 #include "dialogs/settings/settingsdialog.h"
 #include "dialogs/updater.h"
@@ -650,6 +651,47 @@ void ToolBarHelper::setupMenuButton(MainWindow *p_win, QToolBar *p_toolBar)
                         }
                     });
 
+    {
+        auto ioStatsMenu = menu->addMenu(MainWindow::tr("Notebook I/O Statistics"));
+
+        auto recordAct = ioStatsMenu->addAction(MainWindow::tr("Record"));
+        recordAct->setCheckable(true);
+        MainWindow::connect(ioStatsMenu, &QMenu::aboutToShow,
+                            recordAct, [recordAct]() {
+                                recordAct->setChecked(BackendIoStats::getInst().isEnabled());
+                            });
+        MainWindow::connect(recordAct, &QAction::triggered,
+                            recordAct, [](bool p_checked) {
+                                BackendIoStats::getInst().setEnabled(p_checked);
+                            });
+
+        ioStatsMenu->addAction(MainWindow::tr("Dump"),
+                               ioStatsMenu,
+                               [p_win]() {
+                                   const auto defaultFile = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                                                           QStringLiteral("io_stats.json"));
+                                   const auto file = QFileDialog::getSaveFileName(p_win,
+                                                                                  MainWindow::tr("Dump Notebook I/O Statistics"),
+                                                                                  defaultFile,
+                                                                                  QStringLiteral("JSON (*.json)"));
+                                   if (file.isEmpty()) {
+                                       return;
+                                   }
+
+                                   if (!BackendIoStats::getInst().dumpToFile(file)) {
+                                       MessageBoxHelper::notify(MessageBoxHelper::Warning,
+                                                                MainWindow::tr("Failed to dump notebook I/O statistics to (%1).").arg(file),
+                                                                p_win);
+                                   }
+                               });
+
+        ioStatsMenu->addAction(MainWindow::tr("Reset"),
+                               ioStatsMenu,
+                               []() {
+                                   BackendIoStats::getInst().reset();
+                               });
+    }
+
     {
         menu->addSeparator();
 
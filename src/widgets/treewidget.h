@@ -42,6 +42,11 @@ namespace vnotex
         // @p_func: return false to abort the iteration.
         static void forEachItem(const QTreeWidget *p_widget, const std::function<bool(QTreeWidgetItem *p_item)> &p_func);
 
+        // Iterate @p_item and its descendants.
+        // @p_func: return false to abort the iteration.
+        // Return false to abort the ieration.
+        static bool forEachItem(QTreeWidgetItem *p_item, const std::function<bool(QTreeWidgetItem *p_item)> &p_func);
+
     signals:
         // Emit when single item is selected and Drag&Drop to move internally.
         void itemMoved(QTreeWidgetItem *p_item);
@@ -62,10 +67,6 @@ namespace vnotex
 
         static QTreeWidgetItem *lastItemOfTree(QTreeWidgetItem *p_item);
 
-        // @p_func: return false to abort the iteration.
-        // Return false to abort the ieration.
-        static bool forEachItem(QTreeWidgetItem *p_item, const std::function<bool(QTreeWidgetItem *p_item)> &p_func);
-
         Flags m_flags = Flag::None;
     };
 
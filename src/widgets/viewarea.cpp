@@ -33,6 +33,8 @@
 #include <notebook/notebook.h>
 #include "editors/plantumlhelper.h"
 #include "editors/graphvizhelper.h"
+#include "editors/previewcache.h"
+#include "editors/webgraphcache.h"
 #include <core/historymgr.h>
 
 using namespace vnotex;
@@ -100,30 +102,21 @@ ViewArea::ViewArea(QWidget *p_parent)
                 });
 
                 const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
-                PlantUmlHelper::getInst().update(markdownEditorConfig.getPlantUmlJar(),
-                                                 markdownEditorConfig.getGraphvizExe(),
-                                                 markdownEditorConfig.getPlantUmlCommand());
-                GraphvizHelper::getInst().update(markdownEditorConfig.getGraphvizExe());
-            });
+                auto &plantUmlHelper = PlantUmlHelper::getInst();
+                plantUmlHelper.update(markdownEditorConfig.getPlantUmlJar(),
+                                      markdownEditorConfig.getGraphvizExe(),
+                                      markdownEditorConfig.getPlantUmlCommand());
+                plantUmlHelper.setMaxProcesses(markdownEditorConfig.getGraphRendererProcesses());
+                plantUmlHelper.setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
 
-    m_fileCheckTimer = new QTimer(this);
-    m_fileCheckTimer->setSingleShot(false);
-    m_fileCheckTimer->setInterval(2000);
-    connect(m_fileCheckTimer, &QTimer::timeout,
-            this, [this]() {
-                auto win = getCurrentViewWindow();
-                if (win) {
-                    win->checkFileMissingOrChangedOutsidePeriodically();
-                }
-            });
+                auto &graphvizHelper = GraphvizHelper::getInst();
+                graphvizHelper.update(markdownEditorConfig.getGraphvizExe());
+                graphvizHelper.setMaxProcesses(markdownEditorConfig.getGraphRendererProcesses());
+                graphvizHelper.setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
 
-    connect(qApp, &QApplication::focusChanged,
-            this, [this](QWidget *p_old, QWidget *p_now) {
-                if (!p_now) {
-                    m_fileCheckTimer->stop();
-                } else if (!p_old && m_currentSplit) {
-                    m_fileCheckTimer->start();
-                }
+                WebGraphCache::getInst().setDiskCacheSize(markdownEditorConfig.getGraphDiskCacheSize());
+
+                PreviewCache::getInst().setBudget(static_cast<qint64>(markdownEditorConfig.getInplacePreviewCacheSize()) * 1024 * 1024);
             });
 }
 
@@ -336,8 +329,6 @@ void ViewArea::postFirstViewSplit()
 
     emit viewSplitsCountChanged();
     checkCurrentViewWindowChange();
-
-    m_fileCheckTimer->start();
 }
 
 static ViewSplit *fetchFirstChildViewSplit(const QSplitter *p_splitter)
@@ -403,8 +394,6 @@ void ViewArea::removeViewSplit(ViewSplit *p_split, bool p_removeWorkspace)
         Q_ASSERT(newCurrentSplit == nullptr);
         setCurrentViewSplit(newCurrentSplit, false);
         showSceneWidget();
-
-        m_fileCheckTimer->stop();
     } else if (m_currentSplit == p_split) {
         setCurrentViewSplit(newCurrentSplit, true);
     }
@@ -253,9 +253,6 @@ namespace vnotex
 
         QVector<ViewSplit::ViewWindowNavigationModeInfo> m_navigationItems;
 
-        // Timer to check file change outside periodically.
-        QTimer *m_fileCheckTimer = nullptr;
-
         ID m_nextViewSplitId = InvalidViewSplitId + 1;
     };
 } // ns vnotex
@@ -61,6 +61,9 @@ ViewWindow::ViewWindow(QWidget *p_parent)
                     bool hadFocus = p_old && (p_old == this || isAncestorOf(p_old));
                     if (!hadFocus) {
                         emit focused(this);
+
+                        // Buffer state may change while we are not focused.
+                        QTimer::singleShot(0, this, &ViewWindow::handleBufferStateChanged);
                     }
                 }
             });
@@ -141,6 +144,11 @@ void ViewWindow::handleBufferChanged(const QSharedPointer<FileOpenParameters> &p
         connect(buffer, &Buffer::attachmentChanged,
                 this, &ViewWindow::attachmentChanged);
 
+        // Queued to avoid prompting within the buffer watcher.
+        connect(buffer, &Buffer::stateChanged,
+                this, &ViewWindow::handleBufferStateChanged,
+                Qt::QueuedConnection);
+
         connect(buffer, &Buffer::autoSaved,
                 this, [this]() {
                     executeHook(FileOpenParameters::PostSave);
@@ -201,6 +209,11 @@ QIcon ViewWindow::getIcon() const
     }
 }
 
+void ViewWindow::syncLatestContent(QString &p_content) const
+{
+    p_content = getLatestContent();
+}
+
 QString ViewWindow::getName() const
 {
     if (m_buffer) {
@@ -906,14 +919,25 @@ int ViewWindow::checkFileMissingOrChangedOutside()
     return Normal;
 }
 
-void ViewWindow::checkFileMissingOrChangedOutsidePeriodically()
+void ViewWindow::handleBufferStateChanged()
 {
-    if (m_fileChangeCheckEnabled) {
-        // Disable it first.
-        m_fileChangeCheckEnabled = false;
-        int ret = checkFileMissingOrChangedOutside();
-        m_fileChangeCheckEnabled = ret != Discarded;
+    if (!m_buffer || !m_fileChangeCheckEnabled) {
+        return;
+    }
+
+    if (!(m_buffer->state() & (Buffer::StateFlag::FileMissingOnDisk | Buffer::StateFlag::FileChangedOutside))) {
+        return;
     }
+
+    auto focusWidget = QApplication::focusWidget();
+    if (!focusWidget || (focusWidget != this && !isAncestorOf(focusWidget))) {
+        return;
+    }
+
+    // Disable it first.
+    m_fileChangeCheckEnabled = false;
+    int ret = checkFileMissingOrChangedOutside();
+    m_fileChangeCheckEnabled = ret != Discarded;
 }
 
 bool ViewWindow::save(bool p_force)
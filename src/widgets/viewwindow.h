@@ -70,6 +70,10 @@ namespace vnotex
         // Get latest content from editor instead of buffer.
         virtual QString getLatestContent() const = 0;
 
+        // Bring @p_content, which was identical to the editor at last sync, up to date with the editor.
+        // Default implementation just fetches the latest content.
+        virtual void syncLatestContent(QString &p_content) const;
+
         // Will be called before close.
         // Return true if it is OK to proceed.
         bool aboutToClose(bool p_force);
@@ -79,9 +83,6 @@ namespace vnotex
 
         virtual QSharedPointer<OutlineProvider> getOutlineProvider();
 
-        // Called by upside.
-        void checkFileMissingOrChangedOutsidePeriodically();
-
         virtual ViewWindowSession saveSession() const;
 
         WindowFlags getWindowFlags() const;
@@ -318,6 +319,10 @@ namespace vnotex
         };
         int checkFileMissingOrChangedOutside();
 
+        // Prompt to handle the file missing or changed outside if the buffer is flagged so.
+        // Only the focused ViewWindow will prompt and others will check once focused.
+        void handleBufferStateChanged();
+
         void findNextOnLastFind(bool p_forward = true);
 
         void handleBufferChanged(const QSharedPointer<FileOpenParameters> &p_paras);
@@ -41,6 +41,7 @@ SOURCES += \
     $$PWD/dialogs/viewtagsdialog.cpp \
     $$PWD/dockwidgethelper.cpp \
     $$PWD/dragdropareaindicator.cpp \
+    $$PWD/editors/documentchangetracker.cpp \
     $$PWD/editors/editormarkdownvieweradapter.cpp \
     $$PWD/editors/graphhelper.cpp \
     $$PWD/editors/graphvizhelper.cpp \
@@ -50,9 +51,12 @@ SOURCES += \
     $$PWD/editors/markdownviewer.cpp \
     $$PWD/editors/markdownvieweradapter.cpp \
     $$PWD/editors/plantumlhelper.cpp \
+    $$PWD/editors/plantumlpipeworker.cpp \
+    $$PWD/editors/previewcache.cpp \
     $$PWD/editors/previewhelper.cpp \
     $$PWD/editors/statuswidget.cpp \
     $$PWD/editors/texteditor.cpp \
+    $$PWD/editors/webgraphcache.cpp \
     $$PWD/editreaddiscardaction.cpp \
     $$PWD/filesystemviewer.cpp \
     $$PWD/dialogs/folderfilesfilterwidget.cpp \
@@ -65,6 +69,7 @@ SOURCES += \
     $$PWD/historypanel.cpp \
     $$PWD/itemproxystyle.cpp \
     $$PWD/labelwithbuttonswidget.cpp \
+    $$PWD/largefileviewwindow.cpp \
     $$PWD/lineedit.cpp \
     $$PWD/lineeditdelegate.cpp \
     $$PWD/lineeditwithsnippet.cpp \
@@ -168,6 +173,7 @@ HEADERS += \
     $$PWD/dialogs/viewtagsdialog.h \
     $$PWD/dockwidgethelper.h \
     $$PWD/dragdropareaindicator.h \
+    $$PWD/editors/documentchangetracker.h \
     $$PWD/editors/editormarkdownvieweradapter.h \
     $$PWD/editors/graphhelper.h \
     $$PWD/editors/graphvizhelper.h \
@@ -177,9 +183,12 @@ HEADERS += \
     $$PWD/editors/markdownviewer.h \
     $$PWD/editors/markdownvieweradapter.h \
     $$PWD/editors/plantumlhelper.h \
+    $$PWD/editors/plantumlpipeworker.h \
+    $$PWD/editors/previewcache.h \
     $$PWD/editors/previewhelper.h \
     $$PWD/editors/statuswidget.h \
     $$PWD/editors/texteditor.h \
+    $$PWD/editors/webgraphcache.h \
     $$PWD/editreaddiscardaction.h \
     $$PWD/filesystemviewer.h \
     $$PWD/dialogs/folderfilesfilterwidget.h \
@@ -193,6 +202,7 @@ HEADERS += \
     $$PWD/historypanel.h \
     $$PWD/itemproxystyle.h \
     $$PWD/labelwithbuttonswidget.h \
+    $$PWD/largefileviewwindow.h \
     $$PWD/lineedit.h \
     $$PWD/lineeditdelegate.h \
     $$PWD/lineeditwithsnippet.h \
@@ -0,0 +1,267 @@
+#include "test_backupjournal.h"
+
+#include <QTemporaryDir>
+
+#include <buffer/backupjournal.h>
+#include <utils/fileutils.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    const QString c_head = QStringLiteral("vnotex_backup_file /notes/test.md|");
+
+    // Count records of @p_type in journal @p_data.
+    int countRecords(const QByteArray &p_data, const QByteArray &p_type)
+    {
+        const QByteArray magic("|vnotex_journal 1\n");
+        int pos = p_data.indexOf(magic);
+        if (pos == -1) {
+            return -1;
+        }
+        pos += magic.size();
+
+        int cnt = 0;
+        while (pos < p_data.size()) {
+            const int lineEnd = p_data.indexOf('\n', pos);
+            if (lineEnd == -1) {
+                break;
+            }
+
+            const auto fields = p_data.mid(pos, lineEnd - pos).split(' ');
+            if (fields[0] == p_type) {
+                ++cnt;
+            }
+            pos = lineEnd + 1 + fields.last().toInt() + 1;
+        }
+        return cnt;
+    }
+}
+
+TestBackupJournal::TestBackupJournal(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestBackupJournal::testReplay()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    BackupJournal journal(filePath, c_head);
+
+    const QStringList contents = {
+        QStringLiteral("hello\nworld\n"),
+        // Insert in the middle.
+        QStringLiteral("hello\nbig world\n"),
+        // Remove from the beginning.
+        QStringLiteral("big world\n"),
+        // Same content records nothing.
+        QStringLiteral("big world\n"),
+        // Replace.
+        QStringLiteral("big vnote\n"),
+        // Append with a line break in the inserted text.
+        QStringLiteral("big vnote\nD 1 2 3 4\nC 1 1\n"),
+        QString(),
+        QStringLiteral("again")
+    };
+
+    int revision = 0;
+    for (const auto &content : contents) {
+        journal.record(++revision, content);
+        QCOMPARE(BackupJournal::replay(FileUtils::readFile(filePath)), content);
+    }
+
+    const auto data = FileUtils::readFile(filePath);
+    QVERIFY(data.startsWith(c_head.toUtf8()));
+    QCOMPARE(countRecords(data, "C"), 1);
+    QCOMPARE(countRecords(data, "D"), contents.size() - 2);
+}
+
+void TestBackupJournal::testCompactByCount()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    BackupJournal journal(filePath, c_head);
+
+    QString content;
+    int revision = 0;
+    journal.record(++revision, content);
+
+    // 256 small diffs are kept as diffs.
+    for (int i = 0; i < 256; ++i) {
+        content += QLatin1Char('a' + i % 26);
+        journal.record(++revision, content);
+    }
+
+    auto data = FileUtils::readFile(filePath);
+    QCOMPARE(countRecords(data, "C"), 1);
+    QCOMPARE(countRecords(data, "D"), 256);
+    QCOMPARE(BackupJournal::replay(data), content);
+
+    // The next one compacts the journal into one checkpoint.
+    content += QStringLiteral("end");
+    journal.record(++revision, content);
+
+    data = FileUtils::readFile(filePath);
+    QCOMPARE(countRecords(data, "C"), 1);
+    QCOMPARE(countRecords(data, "D"), 0);
+    QCOMPARE(BackupJournal::replay(data), content);
+
+    // Diffs go on after the compaction.
+    content += QStringLiteral("!");
+    journal.record(++revision, content);
+
+    data = FileUtils::readFile(filePath);
+    QCOMPARE(countRecords(data, "D"), 1);
+    QCOMPARE(BackupJournal::replay(data), content);
+}
+
+void TestBackupJournal::testCompactBySize()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    BackupJournal journal(filePath, c_head);
+
+    // Replace the whole 10 KiB content each time, so each diff takes about 10 KiB.
+    const int size = 10 * 1024;
+    int revision = 0;
+    journal.record(++revision, QString(size, QLatin1Char('a')));
+
+    // 7 diffs exceed 64 KiB.
+    for (int i = 1; i <= 7; ++i) {
+        journal.record(++revision, QString(size, QLatin1Char('a' + i)));
+    }
+
+    auto data = FileUtils::readFile(filePath);
+    QCOMPARE(countRecords(data, "D"), 7);
+    QVERIFY(data.size() > 64 * 1024);
+
+    const QString content(size, QLatin1Char('z'));
+    journal.record(++revision, content);
+
+    data = FileUtils::readFile(filePath);
+    QCOMPARE(countRecords(data, "C"), 1);
+    QCOMPARE(countRecords(data, "D"), 0);
+    QVERIFY(data.size() < 2 * size);
+    QCOMPARE(BackupJournal::replay(data), content);
+}
+
+void TestBackupJournal::testTruncatedTail()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    BackupJournal journal(filePath, c_head);
+    journal.record(1, QStringLiteral("line 1\n"));
+    journal.record(2, QStringLiteral("line 1\nline 2\n"));
+
+    const auto goodData = FileUtils::readFile(filePath);
+
+    journal.record(3, QStringLiteral("line 1\nline 2\nline 3 is a bit longer\n"));
+    const auto data = FileUtils::readFile(filePath);
+    QVERIFY(data.size() > goodData.size());
+
+    // Crash at any point while appending the last record.
+    for (int len = goodData.size(); len < data.size(); ++len) {
+        QCOMPARE(BackupJournal::replay(data.left(len)), QStringLiteral("line 1\nline 2\n"));
+    }
+
+    QCOMPARE(BackupJournal::replay(data), QStringLiteral("line 1\nline 2\nline 3 is a bit longer\n"));
+}
+
+void TestBackupJournal::testCorruptRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    BackupJournal journal(filePath, c_head);
+    journal.record(1, QStringLiteral("abc"));
+    journal.record(2, QStringLiteral("abcd"));
+    const auto data = FileUtils::readFile(filePath);
+
+    // Unknown record type.
+    QCOMPARE(BackupJournal::replay(data + "X 3 1\nx\nD 4 0 0 1\ny\n"), QStringLiteral("abcd"));
+
+    // Malformed numbers.
+    QCOMPARE(BackupJournal::replay(data + "D 3 a 0 1\nx\n"), QStringLiteral("abcd"));
+
+    // Wrong number of fields.
+    QCOMPARE(BackupJournal::replay(data + "D 3 1\nx\n"), QStringLiteral("abcd"));
+
+    // Diff out of range.
+    QCOMPARE(BackupJournal::replay(data + "D 3 2 10 1\nx\n"), QStringLiteral("abcd"));
+    QCOMPARE(BackupJournal::replay(data + "D 3 -1 0 1\nx\n"), QStringLiteral("abcd"));
+
+    // Negative size.
+    QCOMPARE(BackupJournal::replay(data + "D 3 0 0 -1\n"), QStringLiteral("abcd"));
+
+    // Valid diffs are still applied.
+    QCOMPARE(BackupJournal::replay(data + "D 3 4 0 1\ne\n"), QStringLiteral("abcde"));
+}
+
+void TestBackupJournal::testLegacyBackupFile()
+{
+    QCOMPARE(BackupJournal::replay((c_head + QStringLiteral("legacy content\nline 2\n")).toUtf8()),
+             QStringLiteral("legacy content\nline 2\n"));
+
+    // Content containing the separator and the journal magic.
+    QCOMPARE(BackupJournal::replay((c_head + QStringLiteral("a|b\n|vnotex_journal 1\n")).toUtf8()),
+             QStringLiteral("a|b\n|vnotex_journal 1\n"));
+
+    QCOMPARE(BackupJournal::replay(c_head.toUtf8()), QString());
+
+    // Not a backup file.
+    QCOMPARE(BackupJournal::replay(QByteArray("no head")), QString());
+}
+
+void TestBackupJournal::testSurrogatePairs()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md.vswp"));
+
+    // U+1F600 and U+1F601 share the high surrogate.
+    const auto grinning = QString::fromUcs4(U"\U0001F600");
+    const auto beaming = QString::fromUcs4(U"\U0001F601");
+    // U+10000 and U+1F400 share the low surrogate.
+    const auto linearB = QString::fromUcs4(U"\U00010000");
+    const auto rat = QString::fromUcs4(U"\U0001F400");
+    QCOMPARE(grinning[0], beaming[0]);
+    QCOMPARE(linearB[1], rat[1]);
+
+    BackupJournal journal(filePath, c_head);
+
+    const QStringList contents = {
+        QStringLiteral("a") + grinning + QStringLiteral("b"),
+        // Only the low surrogate changes.
+        QStringLiteral("a") + beaming + QStringLiteral("b"),
+        // Insert a non-BMP char before one with the same high surrogate.
+        QStringLiteral("a") + grinning + beaming + QStringLiteral("b"),
+        QStringLiteral("a") + grinning + beaming + QStringLiteral("b") + linearB,
+        // Only the high surrogate changes.
+        QStringLiteral("a") + grinning + beaming + QStringLiteral("b") + rat,
+        // Diff offsets after non-BMP chars are in UTF-16 units.
+        QStringLiteral("a") + grinning + beaming + QStringLiteral("bc") + rat + QChar(0x4E2D),
+        beaming + QStringLiteral("bc") + rat
+    };
+
+    int revision = 0;
+    for (const auto &content : contents) {
+        journal.record(++revision, content);
+        QCOMPARE(BackupJournal::replay(FileUtils::readFile(filePath)), content);
+    }
+
+    QCOMPARE(countRecords(FileUtils::readFile(filePath), "D"), contents.size() - 1);
+}
+
+QTEST_MAIN(tests::TestBackupJournal)
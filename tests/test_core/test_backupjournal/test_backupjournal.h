@@ -0,0 +1,32 @@
+#ifndef TEST_BACKUPJOURNAL_H
+#define TEST_BACKUPJOURNAL_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestBackupJournal : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestBackupJournal(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testReplay();
+
+        void testCompactByCount();
+
+        void testCompactBySize();
+
+        void testTruncatedTail();
+
+        void testCorruptRecord();
+
+        void testLegacyBackupFile();
+
+        void testSurrogatePairs();
+    };
+} // ns tests
+
+#endif // TEST_BACKUPJOURNAL_H
@@ -0,0 +1,23 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_backupjournal
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+CORE_FOLDER = $$SRC_FOLDER/core
+UTILS_FOLDER = $$SRC_FOLDER/utils
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$SRC_FOLDER/core
+
+SOURCES += \
+    test_backupjournal.cpp \
+    $$CORE_FOLDER/buffer/backupjournal.cpp \
+    $$UTILS_FOLDER/fileutils.cpp \
+    $$UTILS_FOLDER/pathutils.cpp
+
+HEADERS += \
+    test_backupjournal.h \
+    $$CORE_FOLDER/buffer/backupjournal.h \
+    $$UTILS_FOLDER/fileutils.h \
+    $$UTILS_FOLDER/pathutils.h
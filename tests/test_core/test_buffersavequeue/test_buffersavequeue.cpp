@@ -0,0 +1,126 @@
+#include "test_buffersavequeue.h"
+
+#include <QTemporaryDir>
+#include <QScopedPointer>
+
+#include <buffer/buffersavequeue.h>
+#include <utils/fileutils.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    // Big enough to keep the queue busy while other jobs are enqueued.
+    const QString c_bigContent(8 * 1024 * 1024, QLatin1Char('a'));
+
+    // Get revisions of @p_bufferId reported by @p_spy.
+    QVector<int> finishedRevisions(const QSignalSpy &p_spy, ID p_bufferId)
+    {
+        QVector<int> revisions;
+        for (const auto &args : p_spy) {
+            if (args[0].value<ID>() == p_bufferId) {
+                revisions.push_back(args[1].toInt());
+                if (!args[2].toBool()) {
+                    qWarning() << "save failed" << args[3].toString();
+                }
+            }
+        }
+        return revisions;
+    }
+}
+
+TestBufferSaveQueue::TestBufferSaveQueue(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestBufferSaveQueue::testMergeJobs()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto bigFilePath = dir.filePath(QStringLiteral("big.md"));
+    const auto filePath = dir.filePath(QStringLiteral("test.md"));
+
+    QScopedPointer<BufferSaveQueue> queue(new BufferSaveQueue());
+    QSignalSpy spy(queue.data(), &BufferSaveQueue::saveFinished);
+
+    queue->enqueue(1, 1, bigFilePath, c_bigContent);
+
+    const int cnt = 50;
+    for (int i = 1; i <= cnt; ++i) {
+        queue->enqueue(2, i, filePath, QStringLiteral("revision %1").arg(i));
+    }
+
+    // Finish all the pending saves.
+    queue.reset();
+
+    QCOMPARE(finishedRevisions(spy, 1), QVector<int>({1}));
+    QCOMPARE(FileUtils::readTextFile(bigFilePath), c_bigContent);
+
+    // Jobs of the same file queued behind the big one are merged into the latest one.
+    const auto revisions = finishedRevisions(spy, 2);
+    QCOMPARE(revisions, QVector<int>({cnt}));
+    QCOMPARE(FileUtils::readTextFile(filePath), QStringLiteral("revision %1").arg(cnt));
+
+    // The buffer requested the latest revision and has not changed since.
+    QCOMPARE(BufferSaveQueue::checkFinishedSave(revisions.last(), cnt, cnt),
+             BufferSaveQueue::FinishedSave::UpToDate);
+}
+
+void TestBufferSaveQueue::testCancel()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto filePath = dir.filePath(QStringLiteral("test.md"));
+
+    QScopedPointer<BufferSaveQueue> queue(new BufferSaveQueue());
+    QSignalSpy spy(queue.data(), &BufferSaveQueue::saveFinished);
+
+    // Nothing to cancel.
+    queue->cancel(filePath);
+
+    queue->enqueue(1, 1, filePath, c_bigContent);
+    queue->enqueue(1, 2, filePath, QStringLiteral("revision 2"));
+
+    // Either revision 1 is being written and is waited for, or it has been replaced by revision 2
+    // which is dropped.
+    queue->cancel(filePath);
+
+    const bool written = QFileInfo::exists(filePath);
+    if (written) {
+        QCOMPARE(FileUtils::readTextFile(filePath), c_bigContent);
+    }
+
+    // No temporary file is left by a write in progress.
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files).size(), written ? 1 : 0);
+
+    queue.reset();
+
+    // Nothing is written after the cancel.
+    QCOMPARE(QFileInfo::exists(filePath), written);
+    if (written) {
+        QCOMPARE(FileUtils::readTextFile(filePath), c_bigContent);
+        QCOMPARE(finishedRevisions(spy, 1), QVector<int>({1}));
+    } else {
+        QVERIFY(finishedRevisions(spy, 1).isEmpty());
+    }
+}
+
+void TestBufferSaveQueue::testCheckFinishedSave()
+{
+    // Nothing changed since the snapshot.
+    QCOMPARE(BufferSaveQueue::checkFinishedSave(3, 3, 3), BufferSaveQueue::FinishedSave::UpToDate);
+
+    // Changed while being written.
+    QCOMPARE(BufferSaveQueue::checkFinishedSave(3, 3, 5), BufferSaveQueue::FinishedSave::Outdated);
+
+    // A newer save has been requested.
+    QCOMPARE(BufferSaveQueue::checkFinishedSave(3, 4, 4), BufferSaveQueue::FinishedSave::Superseded);
+
+    // Cancelled by a foreground save or a reload.
+    QCOMPARE(BufferSaveQueue::checkFinishedSave(3, 0, 3), BufferSaveQueue::FinishedSave::Superseded);
+}
+
+QTEST_MAIN(tests::TestBufferSaveQueue)
@@ -0,0 +1,24 @@
+#ifndef TEST_BUFFERSAVEQUEUE_H
+#define TEST_BUFFERSAVEQUEUE_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestBufferSaveQueue : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestBufferSaveQueue(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testMergeJobs();
+
+        void testCancel();
+
+        void testCheckFinishedSave();
+    };
+} // ns tests
+
+#endif // TEST_BUFFERSAVEQUEUE_H
@@ -0,0 +1,23 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_buffersavequeue
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+CORE_FOLDER = $$SRC_FOLDER/core
+UTILS_FOLDER = $$SRC_FOLDER/utils
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$SRC_FOLDER/core
+
+SOURCES += \
+    test_buffersavequeue.cpp \
+    $$CORE_FOLDER/buffer/buffersavequeue.cpp \
+    $$UTILS_FOLDER/fileutils.cpp \
+    $$UTILS_FOLDER/pathutils.cpp
+
+HEADERS += \
+    test_buffersavequeue.h \
+    $$CORE_FOLDER/buffer/buffersavequeue.h \
+    $$UTILS_FOLDER/fileutils.h \
+    $$UTILS_FOLDER/pathutils.h
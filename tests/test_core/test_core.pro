@@ -2,4 +2,11 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
     test_notebook \
-    test_theme
+    test_theme \
+    test_networkfetcher \
+    test_diskcache \
+    test_previewcache \
+    test_backupjournal \
+    test_buffersavequeue \
+    test_documentchangetracker \
+    test_imagehost
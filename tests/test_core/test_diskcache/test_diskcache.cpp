@@ -0,0 +1,93 @@
+#include "test_diskcache.h"
+
+#include <QTemporaryDir>
+
+#include <diskcache.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+TestDiskCache::TestDiskCache(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestDiskCache::testSetAndGet()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    DiskCache cache(dir.filePath(QStringLiteral("cache")), 1024);
+    QVERIFY(cache.get("a").isNull());
+
+    cache.set("a", "data-a");
+    cache.set("b", "data-b");
+    QCOMPARE(cache.get("a"), QByteArray("data-a"));
+    QCOMPARE(cache.getCount(), 2);
+    QCOMPARE(cache.getTotalSize(), qint64(12));
+
+    // Overwrite.
+    cache.set("a", "new-data-a");
+    QCOMPARE(cache.get("a"), QByteArray("new-data-a"));
+    QCOMPARE(cache.getTotalSize(), qint64(16));
+
+    cache.remove("b");
+    QVERIFY(cache.get("b").isNull());
+    QCOMPARE(cache.getCount(), 1);
+
+    cache.clear();
+    QCOMPARE(cache.getCount(), 0);
+    QVERIFY(cache.get("a").isNull());
+}
+
+void TestDiskCache::testPersistence()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto folderPath = dir.filePath(QStringLiteral("cache"));
+
+    {
+        DiskCache cache(folderPath, 1024);
+        cache.set("a", "data-a");
+    }
+
+    DiskCache cache(folderPath, 1024);
+    QCOMPARE(cache.getCount(), 1);
+    QCOMPARE(cache.get("a"), QByteArray("data-a"));
+}
+
+void TestDiskCache::testEviction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    DiskCache cache(dir.filePath(QStringLiteral("cache")), 100);
+    const QByteArray data(30, 'x');
+    cache.set("a", data);
+    QTest::qWait(10);
+    cache.set("b", data);
+    QTest::qWait(10);
+    cache.set("c", data);
+    QTest::qWait(10);
+
+    // Make "a" the most recently used.
+    QVERIFY(!cache.get("a").isNull());
+    QTest::qWait(10);
+
+    cache.set("d", data);
+    QVERIFY(cache.getTotalSize() <= 90);
+    QVERIFY(cache.get("b").isNull());
+    QVERIFY(!cache.get("a").isNull());
+    QVERIFY(!cache.get("d").isNull());
+
+    // Too large to cache.
+    cache.set("e", QByteArray(101, 'x'));
+    QVERIFY(cache.get("e").isNull());
+
+    // Shrink.
+    cache.setMaxSize(30);
+    QVERIFY(cache.getTotalSize() <= 30);
+}
+
+QTEST_MAIN(tests::TestDiskCache)
@@ -0,0 +1,24 @@
+#ifndef TEST_DISKCACHE_H
+#define TEST_DISKCACHE_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestDiskCache : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestDiskCache(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testSetAndGet();
+
+        void testPersistence();
+
+        void testEviction();
+    };
+} // ns tests
+
+#endif // TEST_DISKCACHE_H
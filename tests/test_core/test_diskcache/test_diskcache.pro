@@ -0,0 +1,18 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_diskcache
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+CORE_FOLDER = $$SRC_FOLDER/core
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$SRC_FOLDER/core
+
+SOURCES += \
+    test_diskcache.cpp \
+    $$CORE_FOLDER/diskcache.cpp
+
+HEADERS += \
+    test_diskcache.h \
+    $$CORE_FOLDER/diskcache.h
@@ -0,0 +1,165 @@
+#include "test_documentchangetracker.h"
+
+#include <QTextDocument>
+#include <QTextCursor>
+
+#include <documentchangetracker.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    const QString c_text = QStringLiteral("line 1\nline 2\nline 3\nline 4\n");
+
+    // Replace [@p_start, @p_end) of @p_doc with @p_text.
+    void replace(QTextDocument &p_doc, int p_start, int p_end, const QString &p_text)
+    {
+        QTextCursor cursor(&p_doc);
+        cursor.setPosition(p_start);
+        cursor.setPosition(p_end, QTextCursor::KeepAnchor);
+        cursor.insertText(p_text);
+    }
+
+    // Apply the tracked changes to @p_copy and check it against @p_doc.
+    void checkApply(const DocumentChangeTracker &p_tracker, const QTextDocument &p_doc, QString &p_copy)
+    {
+        QVERIFY(p_tracker.apply(p_copy));
+        QCOMPARE(p_copy, p_doc.toPlainText());
+    }
+}
+
+TestDocumentChangeTracker::TestDocumentChangeTracker(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestDocumentChangeTracker::testNoChange()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+    auto copy = doc.toPlainText();
+
+    checkApply(tracker, doc, copy);
+}
+
+void TestDocumentChangeTracker::testOverlappingEdits()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+    auto copy = doc.toPlainText();
+
+    // Changed range [7, 14).
+    replace(doc, 7, 13, QStringLiteral("second line"));
+
+    // Overlap the start of the changed range.
+    replace(doc, 3, 10, QStringLiteral("E"));
+
+    // Overlap the end of the changed range.
+    replace(doc, 8, 20, QStringLiteral("-x-"));
+
+    // Cover the whole changed range.
+    replace(doc, 1, 10, QString());
+
+    checkApply(tracker, doc, copy);
+
+    tracker.reset();
+
+    // Inside the changed range.
+    replace(doc, 2, 6, QStringLiteral("abcdef"));
+    replace(doc, 4, 6, QStringLiteral("XYZ"));
+
+    checkApply(tracker, doc, copy);
+}
+
+void TestDocumentChangeTracker::testAdjacentEdits()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+    auto copy = doc.toPlainText();
+
+    // Typing.
+    const QString typed("hello");
+    for (int i = 0; i < typed.size(); ++i) {
+        replace(doc, 7 + i, 7 + i, typed.mid(i, 1));
+    }
+    checkApply(tracker, doc, copy);
+
+    tracker.reset();
+
+    // Backspacing, right before the changed range each time.
+    for (int i = 0; i < 3; ++i) {
+        replace(doc, 11 - i, 12 - i, QString());
+    }
+
+    // Right after the changed range.
+    replace(doc, 9, 11, QStringLiteral("12"));
+    checkApply(tracker, doc, copy);
+}
+
+void TestDocumentChangeTracker::testDisjointEdits()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+    auto copy = doc.toPlainText();
+
+    replace(doc, 14, 20, QStringLiteral("third"));
+
+    // Before the changed range.
+    replace(doc, 0, 4, QStringLiteral("first"));
+
+    // After the changed range.
+    replace(doc, doc.characterCount() - 3, doc.characterCount() - 1, QStringLiteral("four\nline 5"));
+
+    checkApply(tracker, doc, copy);
+}
+
+void TestDocumentChangeTracker::testResetAfterSetText()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+    auto copy = doc.toPlainText();
+
+    // The whole document is changed.
+    doc.setPlainText(QStringLiteral("new text\nwith two lines"));
+    checkApply(tracker, doc, copy);
+
+    tracker.reset();
+    replace(doc, 4, 8, QStringLiteral("content"));
+    checkApply(tracker, doc, copy);
+
+    // Reset right after setting text, like the copy is taken from the new text.
+    doc.setPlainText(c_text);
+    copy = doc.toPlainText();
+    tracker.reset();
+    checkApply(tracker, doc, copy);
+
+    replace(doc, 0, 0, QStringLiteral(">"));
+    checkApply(tracker, doc, copy);
+}
+
+void TestDocumentChangeTracker::testLengthMismatch()
+{
+    QTextDocument doc(c_text);
+    DocumentChangeTracker tracker(&doc);
+
+    // Not identical to the document at last reset, so the caller has to fetch the whole text.
+    QString copy("stale");
+    QVERIFY(!tracker.apply(copy));
+    QCOMPARE(copy, QStringLiteral("stale"));
+
+    replace(doc, 0, 4, QStringLiteral("LINE"));
+    QVERIFY(!tracker.apply(copy));
+    QCOMPARE(copy, QStringLiteral("stale"));
+
+    // Full resync.
+    copy = doc.toPlainText();
+    tracker.reset();
+    checkApply(tracker, doc, copy);
+
+    replace(doc, 5, 6, QStringLiteral("one"));
+    checkApply(tracker, doc, copy);
+}
+
+QTEST_MAIN(tests::TestDocumentChangeTracker)
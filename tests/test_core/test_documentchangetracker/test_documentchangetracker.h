@@ -0,0 +1,30 @@
+#ifndef TEST_DOCUMENTCHANGETRACKER_H
+#define TEST_DOCUMENTCHANGETRACKER_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestDocumentChangeTracker : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestDocumentChangeTracker(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testNoChange();
+
+        void testOverlappingEdits();
+
+        void testAdjacentEdits();
+
+        void testDisjointEdits();
+
+        void testResetAfterSetText();
+
+        void testLengthMismatch();
+    };
+} // ns tests
+
+#endif // TEST_DOCUMENTCHANGETRACKER_H
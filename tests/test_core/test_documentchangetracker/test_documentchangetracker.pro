@@ -0,0 +1,18 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_documentchangetracker
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+EDITORS_FOLDER = $$SRC_FOLDER/widgets/editors
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$EDITORS_FOLDER
+
+SOURCES += \
+    test_documentchangetracker.cpp \
+    $$EDITORS_FOLDER/documentchangetracker.cpp
+
+HEADERS += \
+    test_documentchangetracker.h \
+    $$EDITORS_FOLDER/documentchangetracker.h
@@ -0,0 +1,283 @@
+#include "test_imagehost.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+#include <imagehost/githubimagehost.h>
+#include <imagehost/imageuploadcache.h>
+#include <imagehost/imageuploadqueue.h>
+#include <utils/utils.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    // GET of contents replies 404. The first PUT is rate limited with Retry-After, the second
+    // one conflicts and the others create the resource.
+    // PUT is never replied if hanging.
+    class GitHubStandIn
+    {
+    public:
+        GitHubStandIn()
+        {
+            QObject::connect(&m_server, &QTcpServer::newConnection,
+                             [this]() {
+                                 while (m_server.hasPendingConnections()) {
+                                     auto socket = m_server.nextPendingConnection();
+                                     QObject::connect(socket, &QTcpSocket::readyRead,
+                                                      [this, socket]() {
+                                                          handleRead(socket);
+                                                      });
+                                 }
+                             });
+            m_server.listen(QHostAddress::LocalHost);
+        }
+
+        QString apiUrl() const
+        {
+            return QString("http://127.0.0.1:%1").arg(m_server.serverPort());
+        }
+
+        int getUploadCount() const
+        {
+            return m_uploadCount;
+        }
+
+        int getRateLimitedCount() const
+        {
+            return m_rateLimitedCount;
+        }
+
+        int getConflictCount() const
+        {
+            return m_conflictCount;
+        }
+
+        void setHanging(bool p_hanging)
+        {
+            m_hanging = p_hanging;
+        }
+
+        int getHangingCount() const
+        {
+            return m_hangingCount;
+        }
+
+    private:
+        void handleRead(QTcpSocket *p_socket)
+        {
+            auto &buf = m_buffers[p_socket];
+            buf += p_socket->readAll();
+
+            int end = -1;
+            while ((end = buf.indexOf("\r\n\r\n")) != -1) {
+                const auto header = buf.left(end);
+                int contentLength = 0;
+                for (const auto &line : header.split('\n')) {
+                    if (line.toLower().startsWith("content-length:")) {
+                        contentLength = line.mid(line.indexOf(':') + 1).trimmed().toInt();
+                    }
+                }
+
+                if (buf.size() < end + 4 + contentLength) {
+                    // Wait for the body.
+                    return;
+                }
+
+                buf.remove(0, end + 4 + contentLength);
+
+                const auto parts = header.left(header.indexOf("\r\n")).split(' ');
+                const auto verb = parts.value(0);
+                const auto path = QString::fromUtf8(parts.value(1));
+                handleRequest(p_socket, verb, path);
+            }
+        }
+
+        void handleRequest(QTcpSocket *p_socket, const QByteArray &p_verb, const QString &p_path)
+        {
+            if (p_verb == "GET") {
+                reply(p_socket, "404 Not Found", QByteArray(), "{\"message\":\"Not Found\"}");
+                return;
+            }
+
+            Q_ASSERT(p_verb == "PUT");
+            if (m_hanging) {
+                ++m_hangingCount;
+                return;
+            }
+
+            if (m_rateLimitedCount == 0) {
+                ++m_rateLimitedCount;
+                reply(p_socket, "429 Too Many Requests", "Retry-After: 1\r\n", "{}");
+                return;
+            }
+
+            if (m_conflictCount == 0) {
+                ++m_conflictCount;
+                reply(p_socket, "409 Conflict", QByteArray(), "{\"message\":\"is at a but expected b\"}");
+                return;
+            }
+
+            ++m_uploadCount;
+            const auto resPath = p_path.mid(p_path.indexOf(QStringLiteral("/contents/")) + 10);
+            QJsonObject contentObj;
+            contentObj[QStringLiteral("download_url")] = QString("https://raw.githubusercontent.com/user/repo/main/%1").arg(resPath);
+            QJsonObject obj;
+            obj[QStringLiteral("content")] = contentObj;
+            reply(p_socket, "201 Created", QByteArray(), Utils::toJsonString(obj));
+        }
+
+        static void reply(QTcpSocket *p_socket, const QByteArray &p_status, const QByteArray &p_headers, const QByteArray &p_body)
+        {
+            QByteArray resp("HTTP/1.1 " + p_status + "\r\nContent-Type: application/json\r\n");
+            resp += p_headers;
+            resp += "Content-Length: " + QByteArray::number(p_body.size()) + "\r\n\r\n";
+            resp += p_body;
+            p_socket->write(resp);
+        }
+
+        QTcpServer m_server;
+
+        QHash<QTcpSocket *, QByteArray> m_buffers;
+
+        int m_uploadCount = 0;
+
+        int m_rateLimitedCount = 0;
+
+        int m_conflictCount = 0;
+
+        bool m_hanging = false;
+
+        int m_hangingCount = 0;
+    };
+
+    void setupHost(GitHubImageHost &p_host, const GitHubStandIn &p_server)
+    {
+        QJsonObject config;
+        config[QStringLiteral("personal_access_token")] = QStringLiteral("token");
+        config[QStringLiteral("user_name")] = QStringLiteral("user");
+        config[QStringLiteral("repository_name")] = QStringLiteral("repo");
+        p_host.setConfig(config);
+        p_host.setApiUrl(p_server.apiUrl());
+    }
+}
+
+TestImageHost::TestImageHost(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestImageHost::testUpload()
+{
+    GitHubStandIn server;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto cacheFile = dir.filePath(QStringLiteral("cache.json"));
+
+    GitHubImageHost host(nullptr);
+    setupHost(host, server);
+
+    {
+        ImageUploadCache cache(cacheFile);
+        ImageUploadQueue queue(&host, &cache, 2);
+        queue.addJob("image-a", QStringLiteral("a.png"));
+        queue.addJob("image-b", QStringLiteral("b.png"));
+        // Identical data under another name.
+        queue.addJob("image-a", QStringLiteral("c.png"));
+
+        QSignalSpy finishedSpy(&queue, &ImageUploadQueue::finished);
+        queue.start();
+        QVERIFY(host.isUploading());
+        QVERIFY(finishedSpy.wait(30000));
+        QVERIFY(!host.isUploading());
+
+        const auto &jobs = queue.getJobs();
+        for (const auto &job : jobs) {
+            QVERIFY2(!job.m_url.isEmpty(), qPrintable(job.m_errorMsg));
+            QVERIFY(host.ownsUrl(job.m_url));
+        }
+        QCOMPARE(jobs[2].m_url, jobs[0].m_url);
+        QVERIFY(jobs[2].m_reused);
+        QVERIFY(!jobs[1].m_reused);
+
+        // The rate limited and conflicted requests are retried instead of failed.
+        QCOMPARE(server.getRateLimitedCount(), 1);
+        QCOMPARE(server.getConflictCount(), 1);
+        QCOMPARE(server.getUploadCount(), 2);
+    }
+
+    {
+        // Persisted across sessions.
+        ImageUploadCache cache(cacheFile);
+        ImageUploadQueue queue(&host, &cache, 2);
+        queue.addJob("image-b", QStringLiteral("d.png"));
+        queue.addJob("image-a", QStringLiteral("e.png"));
+
+        queue.start();
+        QVERIFY(queue.isFinished());
+        for (const auto &job : queue.getJobs()) {
+            QVERIFY(job.m_reused);
+            QVERIFY(!job.m_url.isEmpty());
+        }
+        QCOMPARE(server.getUploadCount(), 2);
+    }
+}
+
+void TestImageHost::testAbort()
+{
+    GitHubStandIn server;
+    server.setHanging(true);
+
+    GitHubImageHost host(nullptr);
+    setupHost(host, server);
+
+    // Far less than the timeout of one request.
+    const int maxWaitMs = 10000;
+
+    {
+        ImageUploadQueue queue(&host, nullptr, 1);
+        queue.addJob("image-a", QStringLiteral("a.png"));
+        queue.addJob("image-b", QStringLiteral("b.png"));
+
+        QSignalSpy finishedSpy(&queue, &ImageUploadQueue::finished);
+        queue.start();
+        QTRY_COMPARE_WITH_TIMEOUT(server.getHangingCount(), 1, maxWaitMs);
+
+        // Interrupt the running upload and drop the pending one.
+        QElapsedTimer timer;
+        timer.start();
+        queue.abort();
+        QVERIFY(finishedSpy.count() == 1 || finishedSpy.wait(maxWaitMs));
+        QVERIFY(timer.elapsed() < maxWaitMs);
+
+        for (const auto &job : queue.getJobs()) {
+            QVERIFY(job.m_url.isEmpty());
+            QVERIFY(!job.m_errorMsg.isEmpty());
+        }
+        QVERIFY(!host.isUploading());
+    }
+
+    {
+        // Destroyed while uploading.
+        auto queue = new ImageUploadQueue(&host, nullptr, 1);
+        queue->addJob("image-c", QStringLiteral("c.png"));
+        queue->start();
+        QTRY_COMPARE_WITH_TIMEOUT(server.getHangingCount(), 2, maxWaitMs);
+
+        QElapsedTimer timer;
+        timer.start();
+        delete queue;
+        QVERIFY(timer.elapsed() < maxWaitMs);
+        QVERIFY(!host.isUploading());
+    }
+
+    QCOMPARE(server.getHangingCount(), 2);
+}
+
+QTEST_MAIN(tests::TestImageHost)
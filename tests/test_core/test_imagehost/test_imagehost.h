@@ -0,0 +1,23 @@
+#ifndef TEST_IMAGEHOST_H
+#define TEST_IMAGEHOST_H
+
+#include <QtTest>
+
+namespace tests
+{
+    // Upload queue and cache of image hosts against a local stand-in of the GitHub contents API.
+    class TestImageHost : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestImageHost(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testUpload();
+
+        void testAbort();
+    };
+} // ns tests
+
+#endif // TEST_IMAGEHOST_H
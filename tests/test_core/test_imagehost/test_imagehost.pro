@@ -0,0 +1,31 @@
+include($$PWD/../../common.pri)
+
+QT += sql
+
+TARGET = test_imagehost
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+CORE_FOLDER = $$SRC_FOLDER/core
+
+INCLUDEPATH *= $$SRC_FOLDER
+
+LIBS_FOLDER = $$PWD/../../../libs
+
+include($$LIBS_FOLDER/vtextedit/src/editor/editor_export.pri)
+
+include($$LIBS_FOLDER/vtextedit/src/libs/syntax-highlighting/syntax-highlighting_export.pri)
+
+include($$CORE_FOLDER/core.pri)
+include($$SRC_FOLDER/widgets/widgets.pri)
+include($$SRC_FOLDER/utils/utils.pri)
+include($$SRC_FOLDER/export/export.pri)
+include($$SRC_FOLDER/search/search.pri)
+include($$SRC_FOLDER/snippet/snippet.pri)
+include($$SRC_FOLDER/imagehost/imagehost.pri)
+
+SOURCES += \
+    test_imagehost.cpp
+
+HEADERS += \
+    test_imagehost.h
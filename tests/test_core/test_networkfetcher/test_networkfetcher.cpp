@@ -0,0 +1,160 @@
+#include "test_networkfetcher.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QSignalSpy>
+
+#include <networkfetcher.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    // A minimal local HTTP server standing in for image hosts.
+    // GET /<name> replies "data-<name>" after a short delay. GET /hang never replies.
+    class HttpStandIn
+    {
+    public:
+        HttpStandIn()
+        {
+            QObject::connect(&m_server, &QTcpServer::newConnection,
+                             [this]() {
+                                 while (m_server.hasPendingConnections()) {
+                                     auto socket = m_server.nextPendingConnection();
+                                     QObject::connect(socket, &QTcpSocket::readyRead,
+                                                      [this, socket]() {
+                                                          handleRead(socket);
+                                                      });
+                                 }
+                             });
+            m_server.listen(QHostAddress::LocalHost);
+        }
+
+        QUrl url(const QString &p_name) const
+        {
+            return QUrl(QString("http://127.0.0.1:%1/%2").arg(m_server.serverPort()).arg(p_name));
+        }
+
+        int getMaxInFlight() const
+        {
+            return m_maxInFlight;
+        }
+
+    private:
+        void handleRead(QTcpSocket *p_socket)
+        {
+            auto &buf = m_buffers[p_socket];
+            buf += p_socket->readAll();
+
+            int end = -1;
+            while ((end = buf.indexOf("\r\n\r\n")) != -1) {
+                const auto requestLine = buf.left(buf.indexOf("\r\n"));
+                buf.remove(0, end + 4);
+
+                const auto parts = requestLine.split(' ');
+                const auto name = parts.size() > 1 ? QString::fromUtf8(parts[1].mid(1)) : QString();
+                if (name == QStringLiteral("hang")) {
+                    continue;
+                }
+
+                m_maxInFlight = qMax(m_maxInFlight, ++m_inFlight);
+                QTimer::singleShot(50, p_socket, [this, p_socket, name]() {
+                    --m_inFlight;
+                    const auto body = QString("data-%1").arg(name).toUtf8();
+                    QByteArray resp("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n");
+                    resp += "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n";
+                    resp += body;
+                    p_socket->write(resp);
+                });
+            }
+        }
+
+        QTcpServer m_server;
+
+        QHash<QTcpSocket *, QByteArray> m_buffers;
+
+        int m_inFlight = 0;
+
+        int m_maxInFlight = 0;
+    };
+}
+
+TestNetworkFetcher::TestNetworkFetcher(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestNetworkFetcher::testFetch()
+{
+    HttpStandIn server;
+
+    NetworkFetcher fetcher;
+    fetcher.setMaxConnectionsPerHost(2);
+    const int nr = 10;
+    for (int i = 0; i < nr; ++i) {
+        QCOMPARE(fetcher.addUrl(server.url(QString::number(i))), i);
+    }
+
+    QSignalSpy fetchedSpy(&fetcher, &NetworkFetcher::fetched);
+    QSignalSpy finishedSpy(&fetcher, &NetworkFetcher::finished);
+    fetcher.start();
+    QVERIFY(finishedSpy.wait(10000));
+
+    QVERIFY(fetcher.isFinished());
+    QCOMPARE(fetchedSpy.count(), nr);
+    QCOMPARE(fetcher.getFinishedCount(), nr);
+    for (int i = 0; i < nr; ++i) {
+        const auto &res = fetcher.getResults()[i];
+        QVERIFY(res.m_errorString.isEmpty());
+        QCOMPARE(res.m_data, QString("data-%1").arg(i).toUtf8());
+    }
+
+    QVERIFY(server.getMaxInFlight() <= 2);
+    QVERIFY(server.getMaxInFlight() > 1);
+}
+
+void TestNetworkFetcher::testTimeout()
+{
+    HttpStandIn server;
+
+    NetworkFetcher fetcher;
+    fetcher.setTimeout(300);
+    fetcher.addUrl(server.url(QStringLiteral("hang")));
+    fetcher.addUrl(server.url(QStringLiteral("ok")));
+
+    QSignalSpy finishedSpy(&fetcher, &NetworkFetcher::finished);
+    fetcher.start();
+    QVERIFY(finishedSpy.wait(10000));
+
+    const auto &results = fetcher.getResults();
+    QVERIFY(!results[0].m_errorString.isEmpty());
+    QVERIFY(results[0].m_data.isEmpty());
+    QCOMPARE(results[1].m_data, QByteArray("data-ok"));
+}
+
+void TestNetworkFetcher::testAbort()
+{
+    HttpStandIn server;
+
+    NetworkFetcher fetcher;
+    fetcher.setMaxConnections(1);
+    fetcher.addUrl(server.url(QStringLiteral("hang")));
+    fetcher.addUrl(server.url(QStringLiteral("ok")));
+
+    QSignalSpy finishedSpy(&fetcher, &NetworkFetcher::finished);
+    fetcher.start();
+    QVERIFY(!fetcher.isFinished());
+
+    fetcher.abort();
+    QVERIFY(fetcher.isFinished());
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(fetcher.getFinishedCount(), 2);
+    for (const auto &res : fetcher.getResults()) {
+        QVERIFY(!res.m_errorString.isEmpty());
+    }
+}
+
+QTEST_MAIN(tests::TestNetworkFetcher)
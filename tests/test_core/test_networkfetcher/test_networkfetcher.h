@@ -0,0 +1,24 @@
+#ifndef TEST_NETWORKFETCHER_H
+#define TEST_NETWORKFETCHER_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestNetworkFetcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestNetworkFetcher(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testFetch();
+
+        void testTimeout();
+
+        void testAbort();
+    };
+} // ns tests
+
+#endif // TEST_NETWORKFETCHER_H
@@ -0,0 +1,18 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_networkfetcher
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+CORE_FOLDER = $$SRC_FOLDER/core
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$SRC_FOLDER/core
+
+SOURCES += \
+    test_networkfetcher.cpp \
+    $$CORE_FOLDER/networkfetcher.cpp
+
+HEADERS += \
+    test_networkfetcher.h \
+    $$CORE_FOLDER/networkfetcher.h
@@ -2,7 +2,10 @@
 
 #include <QDebug>
 #include <QTemporaryDir>
+#include <QDir>
 #include <QFileInfo>
+#include <QJsonObject>
+#include <QElapsedTimer>
 
 #include <versioncontroller/dummyversioncontrollerfactory.h>
 #include <versioncontroller/iversioncontroller.h>
@@ -11,12 +14,20 @@
 #include <notebookconfigmgr/bundlenotebookconfigmgr.h>
 #include <notebookbackend/localnotebookbackendfactory.h>
 #include <notebookbackend/inotebookbackend.h>
+#include <notebookbackend/inmemorynotebookbackendfactory.h>
+#include <notebookbackend/packednotebookbackendfactory.h>
+#include <notebookbackend/packednotebookbackend.h>
+#include <notebookbackend/instrumentednotebookbackend.h>
+#include <notebookbackend/backendiostats.h>
 #include <notebook/bundlenotebookfactory.h>
 #include <notebook/notebook.h>
 #include <notebook/notebookparameters.h>
 #include <utils/pathutils.h>
+#include <utils/fileutils.h>
+#include <exception.h>
 
 #include "testnotebookdatabase.h"
+#include "testnodefootprint.h"
 
 using namespace tests;
 
@@ -33,4 +44,168 @@ void TestNotebook::testNotebookDatabase()
     test.test();
 }
 
+void TestNotebook::testNodeFootprint()
+{
+    TestNodeFootprint test;
+    test.test();
+}
+
+void TestNotebook::testInMemoryNotebookBackend()
+{
+    InMemoryNotebookBackendFactory factory;
+    const auto rootPath = QDir::temp().filePath("vnotex_inmemory_backend");
+    auto backend = factory.createNotebookBackend(rootPath);
+
+    QVERIFY(backend->existsDir("."));
+    QVERIFY(backend->isEmptyDir(rootPath));
+
+    backend->makePath("a/b");
+    backend->writeFile("a/b/note.md", QString("hello"));
+    QVERIFY(backend->existsFile(PathUtils::concatenateFilePath(rootPath, "a/b/note.md")));
+    QCOMPARE(backend->readTextFile("a/b/note.md"), QString("hello"));
+    QVERIFY(backend->childExistsCaseInsensitive("a/b", "NOTE.md"));
+    QVERIFY(!QFileInfo::exists(rootPath));
+
+    QCOMPARE(backend->renameIfExistsCaseInsensitive("a/b/Note.md"),
+             PathUtils::concatenateFilePath(rootPath, "a/b/Note_1.md"));
+
+    backend->copyDir("a/b", "a/c");
+    QVERIFY(backend->existsFile("a/b/note.md"));
+    QVERIFY(backend->existsFile("a/c/note.md"));
+
+    backend->copyDir("a/c", "d/c", true);
+    QVERIFY(!backend->exists("a/c"));
+    QCOMPARE(backend->readFile("d/c/note.md"), QByteArray("hello"));
+
+    backend->renameDir("d", "e");
+    QVERIFY(!backend->exists("d"));
+    QVERIFY(backend->existsFile("e/c/note.md"));
+
+    backend->removeFile("e/c/note.md");
+    backend->removeEmptyDir("e");
+    QVERIFY(backend->existsDir("e"));
+    QVERIFY(backend->isEmptyDir("e"));
+
+    QVERIFY(!backend->removeDirIfEmpty("a"));
+    backend->removeDir("a");
+    QVERIFY(!backend->exists("a/b/note.md"));
+}
+
+void TestNotebook::testInMemoryNotebookBackendLatency()
+{
+    InMemoryNotebookBackendFactory factory;
+    // Kept out of the New Notebook dialog.
+    QVERIFY(!factory.isCreatable());
+
+    InMemoryNotebookBackend::Latency latency;
+    latency.m_readUs = 20 * 1000;
+    latency.m_writeUs = 40 * 1000;
+    factory.setLatency(latency);
+
+    const auto rootPath = QDir::temp().filePath("vnotex_inmemory_backend_latency");
+    auto backend = factory.createNotebookBackend(rootPath);
+    auto inMemoryBackend = backend.dynamicCast<InMemoryNotebookBackend>();
+    QVERIFY(inMemoryBackend);
+    QCOMPARE(inMemoryBackend->getLatency().m_readUs, latency.m_readUs);
+    QCOMPARE(inMemoryBackend->getLatency().m_writeUs, latency.m_writeUs);
+
+    QElapsedTimer timer;
+    timer.start();
+    backend->writeFile("note.md", QString("hello"));
+    QVERIFY(timer.nsecsElapsed() >= latency.m_writeUs * 1000LL);
+
+    timer.restart();
+    QCOMPARE(backend->readTextFile("note.md"), QString("hello"));
+    QVERIFY(timer.nsecsElapsed() >= latency.m_readUs * 1000LL);
+
+    // Changed latency applies to following calls.
+    latency.m_readUs = 60 * 1000;
+    inMemoryBackend->setLatency(latency);
+    timer.restart();
+    QCOMPARE(backend->readFile("note.md"), QByteArray("hello"));
+    QVERIFY(timer.nsecsElapsed() >= latency.m_readUs * 1000LL);
+}
+
+void TestNotebook::testPackedNotebookBackend()
+{
+    QTemporaryDir srcDir;
+    QVERIFY(srcDir.isValid());
+    QDir dir(srcDir.path());
+    QVERIFY(dir.mkpath("vx_notebook"));
+    QVERIFY(dir.mkpath("a/b"));
+    FileUtils::writeFile(dir.filePath("a/b/note.md"), QString("hello"));
+    FileUtils::writeFile(dir.filePath("vx_notebook/vx_notebook.json"), QString("{}"));
+
+    QTemporaryDir rootDir;
+    QVERIFY(rootDir.isValid());
+    QVERIFY(QDir(rootDir.path()).mkpath("vx_notebook"));
+    const auto archivePath = QDir(rootDir.path()).filePath(PackedNotebookBackend::getArchivePath());
+    PackedNotebookBackend::createArchive(srcDir.path(), archivePath);
+
+    PackedNotebookBackendFactory factory;
+    auto backend = factory.createNotebookBackend(rootDir.path());
+    QVERIFY(backend->isReadOnly());
+    QVERIFY(!backend->isLocalFileSystem());
+
+    QVERIFY(backend->existsDir("a/b"));
+    QVERIFY(backend->existsFile("a/b/note.md"));
+    QVERIFY(!backend->exists("a/c"));
+    QCOMPARE(backend->readTextFile("a/b/note.md"), QString("hello"));
+    QCOMPARE(backend->readTextFile("vx_notebook/vx_notebook.json"), QString("{}"));
+    QVERIFY(backend->childExistsCaseInsensitive("a", "B"));
+
+    // Writes go to the overlay.
+    backend->writeFile("a/b/note.md", QString("world"));
+    QCOMPARE(backend->readTextFile("a/b/note.md"), QString("world"));
+    QVERIFY(QFileInfo::exists(QDir(rootDir.path()).filePath("a/b/note.md")));
+
+    backend->copyDir("a", "c");
+    QCOMPARE(backend->readTextFile("c/b/note.md"), QString("world"));
+    backend->removeDir("c");
+    QVERIFY(!backend->exists("c"));
+
+    // Entries of the archive could not be removed.
+    bool thrown = false;
+    try {
+        backend->removeDir("a");
+    } catch (Exception &p_e) {
+        Q_UNUSED(p_e);
+        thrown = true;
+    }
+    QVERIFY(thrown);
+    QVERIFY(backend->existsFile("a/b/note.md"));
+}
+
+void TestNotebook::testInstrumentedNotebookBackend()
+{
+    InMemoryNotebookBackendFactory factory;
+    auto backend = QSharedPointer<InstrumentedNotebookBackend>::create(
+        factory.createNotebookBackend(QDir::temp().filePath("vnotex_instrumented_backend")));
+    QCOMPARE(backend->getName(), factory.getName());
+
+    auto &stats = BackendIoStats::getInst();
+    stats.reset();
+
+    // Disabled.
+    backend->writeFile("a.md", QByteArray("hello"));
+    QVERIFY(stats.toJson()["operations"].toObject().isEmpty());
+
+    stats.setEnabled(true);
+    {
+        BackendIoStats::OperationScope scope("open_note");
+        backend->readFile("a.md");
+        backend->readFile("a.md");
+    }
+    backend->existsFile("a.md");
+    stats.setEnabled(false);
+
+    const auto operations = stats.toJson()["operations"].toObject();
+    const auto readObj = operations["open_note"].toObject()["readFile"].toObject();
+    QCOMPARE(readObj["count"].toInt(), 2);
+    QCOMPARE(readObj["bytes"].toInt(), 10);
+    QCOMPARE(operations["unattributed"].toObject()["existsFile"].toObject()["count"].toInt(), 1);
+
+    stats.reset();
+}
+
 QTEST_MAIN(tests::TestNotebook)
@@ -27,6 +27,16 @@ namespace tests
     private slots:
         // Define test cases here per slot.
         void testNotebookDatabase();
+
+        void testNodeFootprint();
+
+        void testInMemoryNotebookBackend();
+
+        void testInMemoryNotebookBackendLatency();
+
+        void testPackedNotebookBackend();
+
+        void testInstrumentedNotebookBackend();
     };
 } // ns tests
 
@@ -28,10 +28,12 @@ SOURCES += \
     dummynode.cpp \
     dummynotebook.cpp \
     test_notebook.cpp \
+    testnodefootprint.cpp \
     testnotebookdatabase.cpp
 
 HEADERS += \
     dummynode.h \
     dummynotebook.h \
     test_notebook.h \
+    testnodefootprint.h \
     testnotebookdatabase.h
@@ -0,0 +1,104 @@
+#include "testnodefootprint.h"
+
+#include <QtTest>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "dummynode.h"
+#include "dummynotebook.h"
+
+using namespace tests;
+
+using namespace vnotex;
+
+TestNodeFootprint::TestNodeFootprint()
+{
+    m_notebook.reset(new DummyNotebook("test_notebook"));
+}
+
+void TestNodeFootprint::test()
+{
+    const int tagCount = Node::getInternedTagCount();
+
+    // Tags are released once no node refers to them.
+    {
+        auto node = QSharedPointer<DummyNode>::create(Node::Flag::Content, 1, "a.md", m_notebook.data(), nullptr);
+        node->setTags({"foo", "bar"});
+        QCOMPARE(Node::getInternedTagCount(), tagCount + 2);
+
+        auto node2 = QSharedPointer<DummyNode>::create(Node::Flag::Content, 2, "b.md", m_notebook.data(), nullptr);
+        node2->setTags({"foo"});
+        QCOMPARE(Node::getInternedTagCount(), tagCount + 2);
+
+        node->setTags({"foo"});
+        QCOMPARE(Node::getInternedTagCount(), tagCount + 1);
+
+        node.reset();
+        QCOMPARE(Node::getInternedTagCount(), tagCount + 1);
+    }
+
+    QCOMPARE(Node::getInternedTagCount(), tagCount);
+
+    if (heapUsage() < 0) {
+        qInfo() << "skipped node footprint benchmark due to lack of heap statistics";
+        return;
+    }
+
+    const int cnt = 20000;
+
+    const auto legacyFootprint = measureFootprint(cnt, false);
+    const auto internedFootprint = measureFootprint(cnt, true);
+
+    qInfo() << "sizeof(Node)" << sizeof(Node);
+    qInfo() << "per-node footprint (bytes): legacy" << legacyFootprint << "interned tags" << internedFootprint;
+
+    QVERIFY(internedFootprint < legacyFootprint);
+
+    // Interned tags are released with the nodes.
+    QCOMPARE(Node::getInternedTagCount(), tagCount);
+
+    Node::setTagInterningEnabled(true);
+}
+
+qint64 TestNodeFootprint::measureFootprint(int p_count, bool p_intern)
+{
+    Node::setTagInterningEnabled(p_intern);
+
+    const auto before = heapUsage();
+
+    QScopedPointer<DummyNode> rootNode(new DummyNode(Node::Flag::Container, 0, "", m_notebook.data(), nullptr));
+    for (int i = 0; i < p_count; ++i) {
+        auto node = QSharedPointer<DummyNode>::create(Node::Flag::Content,
+                                                      i + 1,
+                                                      QStringLiteral("note_%1.md").arg(i),
+                                                      m_notebook.data(),
+                                                      rootNode.data());
+        // Each tag is a new string like those parsed from config files.
+        QStringList tags;
+        for (int j = 0; j < 3; ++j) {
+            tags << QStringLiteral("category/tag_%1").arg((i + j) % 50);
+        }
+        node->setTags(tags);
+        node->setAttachmentFolder(QStringLiteral("attachment_%1").arg(i));
+
+        rootNode->addChild(node);
+    }
+
+    const auto after = heapUsage();
+    return (after - before) / p_count;
+}
+
+qint64 TestNodeFootprint::heapUsage()
+{
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+    return static_cast<qint64>(mallinfo2().uordblks);
+#else
+    return static_cast<qint64>(mallinfo().uordblks);
+#endif
+#else
+    return -1;
+#endif
+}
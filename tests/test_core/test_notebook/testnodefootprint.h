@@ -0,0 +1,30 @@
+#ifndef TESTNODEFOOTPRINT_H
+#define TESTNODEFOOTPRINT_H
+
+#include <QScopedPointer>
+
+#include <notebook/notebook.h>
+
+namespace tests
+{
+    // Memory benchmark of the per-node footprint with and without tag interning.
+    class TestNodeFootprint
+    {
+    public:
+        TestNodeFootprint();
+
+        void test();
+
+    private:
+        // Return the bytes allocated per node for @p_count nodes.
+        // @p_intern: whether intern tags.
+        qint64 measureFootprint(int p_count, bool p_intern);
+
+        // Return the bytes allocated from heap currently, or -1 if not supported.
+        static qint64 heapUsage();
+
+        QScopedPointer<vnotex::Notebook> m_notebook;
+    };
+}
+
+#endif // TESTNODEFOOTPRINT_H
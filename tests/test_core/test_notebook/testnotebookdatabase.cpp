@@ -317,6 +317,13 @@ void TestNotebookDatabase::testNodeTag()
     checkStringListEqual(m_dbAccess->queryTagNodesRecursive("new2"), {node11->getId(), node12->getId(), node13->getId()});
     checkStringListEqual(m_dbAccess->queryTagNodesRecursive("22"), {node12->getId(), node13->getId()});
     checkStringListEqual(m_dbAccess->queryTagNodesRecursive("221"), {node13->getId()});
+
+    // Intersection of tags and their descendants.
+    checkStringListEqual(m_dbAccess->getNodesOfTags({"new2"}), {node11->fetchPath(), node12->fetchPath(), node13->fetchPath()});
+    checkStringListEqual(m_dbAccess->getNodesOfTags({"new2", "1"}), {node11->fetchPath()});
+    checkStringListEqual(m_dbAccess->getNodesOfTags({"22", "100", "22"}), {node12->fetchPath()});
+    QVERIFY(m_dbAccess->getNodesOfTags({"221", "1"}).isEmpty());
+    QVERIFY(m_dbAccess->getNodesOfTags({"221", "non-existing"}).isEmpty());
 }
 
 void TestNotebookDatabase::updateNodeTagsAndCheck(vnotex::Node *p_node)
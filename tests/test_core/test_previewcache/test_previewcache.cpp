@@ -0,0 +1,74 @@
+#include "test_previewcache.h"
+
+#include <previewcache.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+namespace
+{
+    QSharedPointer<const PreviewCache::Entry> createEntry(int p_width)
+    {
+        QPixmap image(p_width, 10);
+        image.fill(Qt::white);
+        return QSharedPointer<PreviewCache::Entry>::create(image, 0);
+    }
+}
+
+TestPreviewCache::TestPreviewCache(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestPreviewCache::testKey()
+{
+    const QString text("```dot\ndigraph G {a->b}\n```");
+    QCOMPARE(PreviewCache::makeKey(text, 1, 0), PreviewCache::makeKey(text, 1, 0));
+    QVERIFY(PreviewCache::makeKey(text, 1, 0) != PreviewCache::makeKey(text, 1.5, 0));
+    QVERIFY(PreviewCache::makeKey(text, 1, 0) != PreviewCache::makeKey(text, 1, 0xffffffff));
+    QVERIFY(PreviewCache::makeKey(text, 1, 0) != PreviewCache::makeKey(text + "\n", 1, 0));
+}
+
+void TestPreviewCache::testBudget()
+{
+    const auto entry = createEntry(10);
+    QVERIFY(entry->m_size > 0);
+
+    // Room for three entries.
+    PreviewCache cache(entry->m_size * 3);
+
+    cache.set("a", createEntry(10));
+    cache.set("b", createEntry(10));
+    cache.set("c", createEntry(10));
+    QVERIFY(cache.get("a"));
+    QVERIFY(!cache.get("x"));
+
+    // Evict the least recently used "b".
+    cache.set("d", createEntry(10));
+    QVERIFY(!cache.get("b"));
+    QVERIFY(cache.get("a"));
+    QVERIFY(cache.get("c"));
+    QVERIFY(cache.get("d"));
+
+    auto stats = cache.getStats();
+    QCOMPARE(stats.m_count, 3);
+    QCOMPARE(stats.m_totalSize, entry->m_size * 3);
+    QCOMPARE(stats.m_evictions, qint64(1));
+    QCOMPARE(stats.m_hits, qint64(4));
+    QCOMPARE(stats.m_misses, qint64(2));
+
+    // Shared entries are the same object.
+    const auto shared = cache.get("a");
+    QCOMPARE(cache.get("a").data(), shared.data());
+
+    // Too large.
+    cache.set("e", createEntry(40));
+    QVERIFY(!cache.get("e"));
+
+    cache.setBudget(entry->m_size);
+    QCOMPARE(cache.getStats().m_count, 1);
+    QVERIFY(cache.get("a"));
+}
+
+QTEST_MAIN(tests::TestPreviewCache)
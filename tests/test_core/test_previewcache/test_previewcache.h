@@ -0,0 +1,22 @@
+#ifndef TEST_PREVIEWCACHE_H
+#define TEST_PREVIEWCACHE_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestPreviewCache : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestPreviewCache(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testKey();
+
+        void testBudget();
+    };
+} // ns tests
+
+#endif // TEST_PREVIEWCACHE_H
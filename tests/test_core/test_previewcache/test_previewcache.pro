@@ -0,0 +1,18 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_previewcache
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+EDITORS_FOLDER = $$SRC_FOLDER/widgets/editors
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$EDITORS_FOLDER
+
+SOURCES += \
+    test_previewcache.cpp \
+    $$EDITORS_FOLDER/previewcache.cpp
+
+HEADERS += \
+    test_previewcache.h \
+    $$EDITORS_FOLDER/previewcache.h
@@ -227,4 +227,23 @@ void TestUtils::testIsText()
     }
 }
 
+void TestUtils::testWriteFile()
+{
+    QTemporaryDir dir;
+    const QString filePath(dir.filePath("note.md"));
+
+    FileUtils::writeFile(filePath, QStringLiteral("a long content to be replaced"));
+    QCOMPARE(FileUtils::readTextFile(filePath), QStringLiteral("a long content to be replaced"));
+
+    // Replace instead of writing in place.
+    FileUtils::writeFile(filePath, QStringLiteral("short"));
+    QCOMPARE(FileUtils::readTextFile(filePath), QStringLiteral("short"));
+
+    FileUtils::writeFile(filePath, QByteArray("bytes"));
+    QCOMPARE(FileUtils::readFile(filePath), QByteArray("bytes"));
+
+    // No temporary file left.
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files | QDir::Hidden), QStringList() << "note.md");
+}
+
 QTEST_MAIN(tests::TestUtils)
@@ -32,6 +32,8 @@ namespace tests
         void testRenameFile();
 
         void testIsText();
+
+        void testWriteFile();
     };
 } // ns tests
 